@@ -3162,6 +3162,153 @@ vlans_del(unsigned int gid, const char *oid, const char *ifname,
 #endif
 }
 
+#ifdef USE_LIBNETCONF
+/**
+ * Links and network addresses dumped once per configuration snapshot
+ * (see rcf_pch_cfg_snapshot()) and shared by interface accessors, so
+ * that getting of a subtree with many interfaces does not make a netlink
+ * dump or ioctl() for every leaf.
+ */
+static struct {
+    unsigned int    id;         /**< Snapshot identifier */
+    netconf_list   *links;      /**< Links or @c NULL if not dumped */
+    netconf_list   *addrs;      /**< Addresses or @c NULL if not dumped */
+    netconf_node   *last_link;  /**< Link found by the last lookup */
+} iface_snapshot;
+
+/**
+ * Drop dumps of the previous configuration snapshot if it is over.
+ */
+static void
+iface_snapshot_check(void)
+{
+    unsigned int id = rcf_pch_cfg_snapshot();
+
+    if (id == iface_snapshot.id)
+        return;
+
+    netconf_list_free(iface_snapshot.links);
+    netconf_list_free(iface_snapshot.addrs);
+    iface_snapshot.links = NULL;
+    iface_snapshot.addrs = NULL;
+    iface_snapshot.last_link = NULL;
+    iface_snapshot.id = id;
+}
+
+/**
+ * Get list of all links.
+ *
+ * @return Links dump which should be released with iface_snapshot_put()
+ *         or @c NULL in case of error (check errno for details).
+ */
+static netconf_list *
+iface_snapshot_links(void)
+{
+    iface_snapshot_check();
+    if (iface_snapshot.id == 0)
+        return netconf_link_dump(nh);
+
+    if (iface_snapshot.links == NULL)
+        iface_snapshot.links = netconf_link_dump(nh);
+
+    return iface_snapshot.links;
+}
+
+/**
+ * Get list of IPv4 and IPv6 addresses of all interfaces.
+ *
+ * @return Addresses dump which should be released with
+ *         iface_snapshot_put() or @c NULL in case of error (check errno
+ *         for details).
+ */
+static netconf_list *
+iface_snapshot_addrs(void)
+{
+    iface_snapshot_check();
+    if (iface_snapshot.id == 0)
+        return netconf_net_addr_dump(nh, AF_UNSPEC);
+
+    if (iface_snapshot.addrs == NULL)
+        iface_snapshot.addrs = netconf_net_addr_dump(nh, AF_UNSPEC);
+
+    return iface_snapshot.addrs;
+}
+
+/**
+ * Release a dump obtained with iface_snapshot_links() or
+ * iface_snapshot_addrs(). Dumps of the current snapshot are kept.
+ *
+ * @param list          Dump to release
+ */
+static void
+iface_snapshot_put(netconf_list *list)
+{
+    if (list != iface_snapshot.links && list != iface_snapshot.addrs)
+        netconf_list_free(list);
+}
+
+/**
+ * Find an interface in the links dump of the current configuration
+ * snapshot.
+ *
+ * @param ifname        Interface name
+ *
+ * @return Link or @c NULL if there is no snapshot, the dump failed or
+ *         there is no such interface (the caller should ask the system
+ *         directly in this case).
+ */
+static const netconf_link *
+iface_snapshot_link(const char *ifname)
+{
+    netconf_list *links;
+    netconf_node *node;
+
+    iface_snapshot_check();
+    if (iface_snapshot.id == 0)
+        return NULL;
+
+    /* Leaves of the same interface are usually got one after another */
+    node = iface_snapshot.last_link;
+    if (node != NULL && node->data.link.ifname != NULL &&
+        strcmp(node->data.link.ifname, ifname) == 0)
+        return &node->data.link;
+
+    if ((links = iface_snapshot_links()) == NULL)
+        return NULL;
+
+    for (node = links->head; node != NULL; node = node->next)
+    {
+        if (node->data.link.ifname != NULL &&
+            strcmp(node->data.link.ifname, ifname) == 0)
+        {
+            iface_snapshot.last_link = node;
+            return &node->data.link;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Get index of an interface.
+ *
+ * @param ifname        Interface name
+ *
+ * @return Interface index or @c 0 if there is no such interface
+ *         (errno is set).
+ */
+static unsigned int
+iface_snapshot_ifindex(const char *ifname)
+{
+    const netconf_link *link = iface_snapshot_link(ifname);
+
+    if (link != NULL)
+        return (unsigned int)link->ifindex;
+
+    return if_nametoindex(ifname);
+}
+#endif
+
 /**
  * Get instance value for object "agent/switchdev_name".
  *
@@ -3194,7 +3341,7 @@ switchdev_name_get(unsigned int gid, const char *oid, char *value,
         netconf_list       *links;
         const netconf_node *node;
 
-        links = netconf_link_dump(nh);
+        links = iface_snapshot_links();
         if (links == NULL)
             return TE_OS_RC(TE_TA_UNIX, errno);
 
@@ -3218,11 +3365,11 @@ switchdev_name_get(unsigned int gid, const char *oid, char *value,
 
                 free(switch_id);
                 free(port_name);
-                netconf_list_free(links);
+                iface_snapshot_put(links);
                 return rc;
             }
         }
-        netconf_list_free(links);
+        iface_snapshot_put(links);
     }
 
     ERROR("Failed to find rep for '%s/%s'", switch_id, port_name);
@@ -3261,7 +3408,7 @@ switchdev_name_list(unsigned int gid, const char *oid,
         netconf_list       *links;
         const netconf_node *node;
 
-        links = netconf_link_dump(nh);
+        links = iface_snapshot_links();
         if (links == NULL)
             return TE_OS_RC(TE_TA_UNIX, errno);
 
@@ -3275,7 +3422,7 @@ switchdev_name_list(unsigned int gid, const char *oid,
                                  link->port_name);
             }
         }
-        netconf_list_free(links);
+        iface_snapshot_put(links);
     }
 
     *list = buffer.ptr;
@@ -3314,7 +3461,31 @@ interface_list(unsigned int gid, const char *oid,
 
     buf[0] = '\0';
 
-#ifdef __linux__
+#if defined(__linux__) && defined(USE_LIBNETCONF)
+    {
+        netconf_list *links;
+        netconf_node *node;
+
+        if ((links = iface_snapshot_links()) == NULL)
+        {
+            ERROR("%s(): Cannot get list of interfaces", __FUNCTION__);
+            return TE_OS_RC(TE_TA_UNIX, errno);
+        }
+
+        for (node = links->head; node != NULL && off < sizeof(buf);
+             node = node->next)
+        {
+            const char *name = node->data.link.ifname;
+
+            if (name == NULL || CHECK_INTERFACE(name) != 0)
+                continue;
+
+            off += snprintf(buf + off, sizeof(buf) - off, "%s ", name);
+        }
+
+        iface_snapshot_put(links);
+    }
+#elif defined(__linux__)
     {
         FILE *f;
 
@@ -3504,7 +3675,11 @@ static te_errno
 ifindex_get(unsigned int gid, const char *oid, char *value,
             const char *ifname)
 {
-    unsigned int ifindex = if_nametoindex(ifname);;
+#ifdef USE_LIBNETCONF
+    unsigned int ifindex = iface_snapshot_ifindex(ifname);
+#else
+    unsigned int ifindex = if_nametoindex(ifname);
+#endif
     te_errno     rc;
 
     UNUSED(gid);
@@ -3601,7 +3776,7 @@ iface_get_property_netconf(const char *ifname,
     unsigned int     ifindex = 0;
     te_errno         rc = 0;
 
-    if ((ifindex = if_nametoindex(ifname)) == 0)
+    if ((ifindex = iface_snapshot_ifindex(ifname)) == 0)
     {
         rc = te_rc_os2te(errno);
         ERROR("%s(): cannot obtain interface index for '%s'",
@@ -3609,7 +3784,7 @@ iface_get_property_netconf(const char *ifname,
         return TE_RC(TE_TA_UNIX, rc);
     }
 
-    if ((list = netconf_link_dump(nh)) == NULL)
+    if ((list = iface_snapshot_links()) == NULL)
     {
         ERROR("%s(): Cannot get list of interfaces",
               __FUNCTION__);
@@ -3732,7 +3907,7 @@ iface_get_property_netconf(const char *ifname,
         }
     }
 
-    netconf_list_free(list);
+    iface_snapshot_put(list);
 
     if (node == NULL)
     {
@@ -4985,6 +5160,7 @@ net_addr_list(unsigned int gid, const char *oid,
     unsigned int        ifindex;
     netconf_list       *nlist;
     netconf_node       *t;
+    unsigned int        n_addrs = 0;
     unsigned int        len;
     char               *cur_ptr;
 
@@ -5004,33 +5180,38 @@ net_addr_list(unsigned int gid, const char *oid,
         return TE_RC(TE_TA_UNIX, rc);
     }
 
-    if ((ifindex = if_nametoindex(ifname)) == 0)
+    if ((ifindex = iface_snapshot_ifindex(ifname)) == 0)
     {
         ERROR("%s(): Device '%s' does not exist", __FUNCTION__, ifname);
         return TE_RC(TE_TA_UNIX, TE_ENODEV);
     }
 
     /* Get addresses of both families, IPv4 and IPv6 */
-    if ((nlist = netconf_net_addr_dump_iface(nh, AF_UNSPEC,
-                                            ifindex)) == NULL)
+    if ((nlist = iface_snapshot_addrs()) == NULL)
     {
         ERROR("%s(): Cannot get list of addresses", __FUNCTION__);
         return TE_OS_RC(TE_TA_UNIX, errno);
     }
 
+    for (t = nlist->head; t != NULL; t = t->next)
+    {
+        if (t->data.net_addr.ifindex == (int)ifindex)
+            n_addrs++;
+    }
+
     /* Calculate maximum space needed by list */
-    len = nlist->length * (INET6_ADDRSTRLEN + 1);
+    len = n_addrs * (INET6_ADDRSTRLEN + 1);
 
     if (len == 0)
     {
-        netconf_list_free(nlist);
+        iface_snapshot_put(nlist);
         *list = NULL;
         return 0;
     }
 
     if ((*list = malloc(len)) == NULL)
     {
-        netconf_list_free(nlist);
+        iface_snapshot_put(nlist);
         return TE_RC(TE_TA_UNIX, TE_ENOMEM);
     }
 
@@ -5041,6 +5222,9 @@ net_addr_list(unsigned int gid, const char *oid,
     {
         const netconf_net_addr *net_addr = &(t->data.net_addr);
 
+        if (net_addr->ifindex != (int)ifindex)
+            continue;
+
         assert(cur_ptr >= *list);
         assert((unsigned int)(cur_ptr - *list) <= len);
 
@@ -5055,14 +5239,14 @@ net_addr_list(unsigned int gid, const char *oid,
         {
             ERROR("%s(): Cannot save network address", __FUNCTION__);
             free(*list);
-            netconf_list_free(nlist);
+            iface_snapshot_put(nlist);
             return TE_RC(TE_TA_UNIX, TE_EINVAL);
         }
 
         cur_ptr += strlen(cur_ptr);
     }
 
-    netconf_list_free(nlist);
+    iface_snapshot_put(nlist);
 
     return 0;
 }
@@ -5267,7 +5451,7 @@ prefix_get(unsigned int gid, const char *oid, char *value,
 
         family = str_addr_family(addr);
 
-        if ((ifindex = if_nametoindex(ifname)) == 0)
+        if ((ifindex = iface_snapshot_ifindex(ifname)) == 0)
         {
             ERROR("%s(): Device '%s' does not exist",
                   __FUNCTION__, ifname);
@@ -5283,9 +5467,7 @@ prefix_get(unsigned int gid, const char *oid, char *value,
             return TE_RC(TE_TA_UNIX, TE_EINVAL);
         }
 
-        if ((list = netconf_net_addr_dump_iface(nh,
-                                                (unsigned char)family,
-                                                ifindex)) == NULL)
+        if ((list = iface_snapshot_addrs()) == NULL)
         {
             ERROR("%s(): Cannot get list of addresses", __FUNCTION__);
             return TE_OS_RC(TE_TA_UNIX, errno);
@@ -5296,6 +5478,10 @@ prefix_get(unsigned int gid, const char *oid, char *value,
         {
             const netconf_net_addr *net_addr = &(t->data.net_addr);
 
+            if (net_addr->ifindex != (int)ifindex ||
+                net_addr->family != family)
+                continue;
+
             if (memcmp(&ip_addr, net_addr->address, addrlen) == 0)
             {
                 found = true;
@@ -5304,7 +5490,7 @@ prefix_get(unsigned int gid, const char *oid, char *value,
             }
         }
 
-        netconf_list_free(list);
+        iface_snapshot_put(list);
 
         if (!found)
         {
@@ -5547,7 +5733,7 @@ broadcast_get(unsigned int gid, const char *oid, char *value,
             return TE_RC(TE_TA_UNIX, rc);
         }
 
-        if ((ifindex = if_nametoindex(ifname)) == 0)
+        if ((ifindex = iface_snapshot_ifindex(ifname)) == 0)
         {
             ERROR("%s(): Device '%s' does not exist",
                   __FUNCTION__, ifname);
@@ -5560,8 +5746,7 @@ broadcast_get(unsigned int gid, const char *oid, char *value,
             return TE_RC(TE_TA_UNIX, TE_EINVAL);
         }
 
-        if ((list = netconf_net_addr_dump_iface(nh, AF_INET,
-                                                ifindex)) == NULL)
+        if ((list = iface_snapshot_addrs()) == NULL)
         {
             ERROR("%s(): Cannot get list of addresses", __FUNCTION__);
             return TE_OS_RC(TE_TA_UNIX, errno);
@@ -5572,6 +5757,10 @@ broadcast_get(unsigned int gid, const char *oid, char *value,
         {
             const netconf_net_addr *net_addr = &(t->data.net_addr);
 
+            if (net_addr->ifindex != (int)ifindex ||
+                net_addr->family != AF_INET)
+                continue;
+
             if (memcmp(&ip_addr, net_addr->address,
                        sizeof(struct in_addr)) == 0)
             {
@@ -5591,7 +5780,7 @@ broadcast_get(unsigned int gid, const char *oid, char *value,
             }
         }
 
-        netconf_list_free(list);
+        iface_snapshot_put(list);
 
         if (!found)
         {
@@ -5871,6 +6060,20 @@ link_addr_get(unsigned int gid, const char *oid, char *value,
     if ((rc = CHECK_INTERFACE(ifname)) != 0)
         return TE_RC(TE_TA_UNIX, rc);
 
+#ifdef USE_LIBNETCONF
+    {
+        const netconf_link *link = iface_snapshot_link(ifname);
+
+        if (link != NULL && link->address != NULL &&
+            link->addrlen == ETHER_ADDR_LEN)
+        {
+            link_addr_n2a(link->address, link->addrlen,
+                          value, RCF_MAX_VAL);
+            return 0;
+        }
+    }
+#endif
+
 #ifdef MY_SIOCGIFHWADDR
     memset(&req, 0, sizeof(req));
     strcpy(req.my_ifr_name, ifname);
@@ -6123,6 +6326,18 @@ mtu_get(unsigned int gid, const char *oid, char *value,
     if ((rc = CHECK_INTERFACE(ifname)) != 0)
         return TE_RC(TE_TA_UNIX, rc);
 
+#ifdef USE_LIBNETCONF
+    {
+        const netconf_link *link = iface_snapshot_link(ifname);
+
+        if (link != NULL)
+        {
+            sprintf(value, "%u", link->mtu);
+            return 0;
+        }
+    }
+#endif
+
 #if defined(SIOCGIFMTU)  && defined(HAVE_STRUCT_IFREQ_IFR_MTU)   || \
     defined(SIOCGLIFMTU) && defined(HAVE_STRUCT_LIFREQ_LIFR_MTU)
     {
@@ -6241,6 +6456,18 @@ iff_flag_get(const char *ifname, int flag, bool *value)
     if ((rc = CHECK_INTERFACE(ifname)) != 0)
         return TE_RC(TE_TA_UNIX, rc);
 
+#ifdef USE_LIBNETCONF
+    {
+        const netconf_link *link = iface_snapshot_link(ifname);
+
+        if (link != NULL)
+        {
+            *value = ((link->flags & flag) != 0);
+            return 0;
+        }
+    }
+#endif
+
     strcpy(req.my_ifr_name, ifname);
     CFG_IOCTL(cfg_socket, MY_SIOCGIFFLAGS, &req);
 
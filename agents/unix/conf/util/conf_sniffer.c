@@ -44,6 +44,9 @@
 #include <fcntl.h>
 #include <sys/sendfile.h>
 #include <ftw.h>
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
 
 #include "te_stdint.h"
 #include "te_errno.h"
@@ -78,6 +81,7 @@
 #define SNIFFER_SSN_F               "next_sniffer_ssn"
 #define SNIFFER_MAX_ID_LEN          600
 #define SNIFFER_MAX_LOG_SIZE        2147483647
+#define SNIFFER_MAX_GZ_SIZE         (16 << 20)
 
 /* Sniffer states constant */
 #define SNIF_ST_START 0x01 /* Sniffer was launched */
@@ -140,6 +144,8 @@ typedef struct sniffer_t {
     char                   *curr_file_name;
     long                    curr_offset;
     unsigned char           state;
+    te_sniffer_stats        stats;      /**< Last known capture
+                                             statistics. */
 } sniffer_t;
 
 static snif_sets_t          snif_sets;
@@ -158,7 +164,8 @@ clean_pcap(const char *fpath, const struct stat *sb, int typeflag,
     UNUSED(typeflag);
     UNUSED(ftwbuf);
 
-    if (strstr(fpath, ".pcap") != NULL)
+    if (strstr(fpath, ".pcap") != NULL ||
+        strstr(fpath, SNIF_STATS_FNAME) != NULL)
         return remove(fpath);
 
     return 0;
@@ -516,6 +523,67 @@ sniffer_common_get(unsigned int gid, const char *oid, char *value,
     return 0;
 }
 
+/**
+ * Get capture statistics of the sniffer. The sniffer process periodically
+ * saves them to a file in the sniffer folder; the last known values are
+ * kept when the sniffer is stopped.
+ *
+ * @param gid           Group identifier (unused).
+ * @param oid           Full object instance identifier.
+ * @param value         Location for the value (OUT).
+ * @param ifname        Interface name.
+ * @param snifname      Sniffer name.
+ *
+ * @return Status code.
+ */
+static te_errno
+sniffer_stats_get(unsigned int gid, const char *oid, char *value,
+                  const char *ifname, const char *snifname)
+{
+    sniffer_t          *sniff;
+    te_sniffer_stats    stats;
+    char                fname[RCF_MAX_PATH];
+    FILE               *f;
+    int                 res;
+
+    UNUSED(gid);
+
+    sniff = sniffer_find(ifname, snifname);
+    if (sniff == NULL)
+    {
+        ERROR("sniffer_stats_get: Couldn't find the sniffer for oid %s",
+              oid);
+        return TE_RC(TE_TA_UNIX, TE_EINVAL);
+    }
+
+    if (value == NULL)
+    {
+       ERROR("A buffer for sniffer statistics get is not provided");
+       return TE_RC(TE_TA_UNIX, TE_EINVAL);
+    }
+
+    if (strlen(sniff->path) > 0)
+    {
+        res = snprintf(fname, sizeof(fname), "%s%s", sniff->path,
+                       SNIF_STATS_FNAME);
+        if (res > 0 && (size_t)res < sizeof(fname) &&
+            (f = fopen(fname, "r")) != NULL)
+        {
+            if (fread(&stats, sizeof(stats), 1, f) == 1)
+                sniff->stats = stats;
+            fclose(f);
+        }
+    }
+
+    if (strstr(oid, "/received:") != NULL)
+        sprintf(value, "%" PRIu64, sniff->stats.received);
+    else if (strstr(oid, "/dropped:") != NULL)
+        sprintf(value, "%" PRIu64,
+                sniff->stats.dropped + sniff->stats.ifdropped);
+
+    return 0;
+}
+
 /**
  * Common set function for the sniffer instance.
  *
@@ -709,8 +777,8 @@ sniffer_get_capture_fname(sniffer_t *snif, int *fnum, char **wp_fname,
     /* View capture logs file list and chose the oldest on newest. */
     while ((ent = readdir(dir)) != NULL)
     {
-        if ((strcmp(ent->d_name, ".") == 0) ||
-            (strcmp(ent->d_name, "..") == 0))
+        /* Skip ".", ".." and the capture statistics file. */
+        if (ent->d_name[0] == '.')
             continue;
 
         *fnum += 1;
@@ -908,6 +976,96 @@ sniffer_get_list_buf(char **buf, bool sync)
     return clen;
 }
 
+#ifdef HAVE_LIBZ
+/**
+ * Read a portion of new data from the capture log file and compress it
+ * in gzip format. If the portion does not include all the new data, it
+ * is cut at a packet boundary, so that the next portion starts with
+ * a packet header.
+ *
+ * @param fd            Descriptor of the capture log file.
+ * @param start         Offset of the portion in the file.
+ * @param size          Size of the portion (IN/OUT).
+ * @param truncated     Whether the portion does not include all the new
+ *                      data.
+ * @param zbuf          Location for the compressed data (OUT).
+ * @param zlen          Location for the length of compressed data (OUT).
+ *
+ * @return Status code.
+ */
+static te_errno
+sniffer_gz_portion(int fd, off_t start, size_t *size, bool truncated,
+                   uint8_t **zbuf, size_t *zlen)
+{
+    uint8_t        *raw;
+    uint8_t        *out = NULL;
+    size_t          got = 0;
+    size_t          pos;
+    ssize_t         res;
+    te_pcap_pkthdr  h;
+    z_stream        zs;
+    te_errno        rc = 0;
+
+    SNIFFER_MALLOC(raw, *size);
+
+    while (got < *size)
+    {
+        res = pread(fd, raw + got, *size - got, start + got);
+        if (res <= 0)
+        {
+            rc = res == 0 ? TE_RC(TE_TA_UNIX, TE_ENODATA) :
+                            TE_OS_RC(TE_TA_UNIX, errno);
+            goto out;
+        }
+        got += res;
+    }
+
+    if (truncated)
+    {
+        pos = start == 0 ? SNIF_PCAP_HSIZE : 0;
+        while (pos + sizeof(h) <= got)
+        {
+            memcpy(&h, raw + pos, sizeof(h));
+            if (pos + sizeof(h) + h.caplen > got)
+                break;
+            pos += sizeof(h) + h.caplen;
+        }
+        if (pos > 0)
+            *size = pos;
+    }
+
+    memset(&zs, 0, sizeof(zs));
+    /* 16 is added to window bits to get gzip header and trailer */
+    if (deflateInit2(&zs, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8,
+                     Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        rc = TE_RC(TE_TA_UNIX, TE_ENOMEM);
+        goto out;
+    }
+
+    *zlen = deflateBound(&zs, *size);
+    SNIFFER_MALLOC(out, *zlen);
+
+    zs.next_in = raw;
+    zs.avail_in = *size;
+    zs.next_out = out;
+    zs.avail_out = *zlen;
+    if (deflate(&zs, Z_FINISH) != Z_STREAM_END)
+    {
+        rc = TE_RC(TE_TA_UNIX, TE_EFAIL);
+        free(out);
+        out = NULL;
+    }
+    *zlen = zs.total_out;
+    deflateEnd(&zs);
+
+out:
+    free(raw);
+    *zbuf = out;
+    return rc;
+}
+#endif
+
 /**
  * Get sniffer capture log file.
  *
@@ -916,7 +1074,8 @@ sniffer_get_list_buf(char **buf, bool sync)
  * @param buflen        length of the command buffer
  * @param answer_plen   number of bytes in the command buffer to be
  *                      copied to the answer
- * @param buf           Buffer with the sniffer ID.
+ * @param buf           Buffer with the sniffer ID optionally followed by
+ *                      @c gzip to get new data compressed.
  *
  * return Status code.
  */
@@ -938,9 +1097,16 @@ sniffer_get_dump(struct rcf_comm_connection *handle, char *cbuf,
     char            *wp_fname;
     size_t           len            = answer_plen;
     bool first_launch = false;
+    bool partial = false;
+    bool compress;
+    const char      *opt;
+    uint8_t         *zbuf           = NULL;
+    size_t           zlen           = 0;
 
     if ((rc = sniffer_parse_sniff_id(buf, &id)) != 0)
         return rc;
+    opt = strrchr(buf, ' ');
+    compress = (opt != NULL && strcmp(opt + 1, "gzip") == 0);
     if ((snif = sniffer_find_by_id(&id)) == NULL)
     {
         WARN("Couldn't find the sniffer to get capture logs.");
@@ -1040,26 +1206,57 @@ sniffer_get_dump(struct rcf_comm_connection *handle, char *cbuf,
     {
         size = SNIFFER_MAX_LOG_SIZE;
         offst = snif->curr_offset + SNIFFER_MAX_LOG_SIZE;
+        partial = true;
     }
 
+#ifdef HAVE_LIBZ
+    if (compress)
+    {
+        if (size > SNIFFER_MAX_GZ_SIZE)
+        {
+            size = SNIFFER_MAX_GZ_SIZE;
+            partial = true;
+        }
+        te_rc = sniffer_gz_portion(fd, snif->curr_offset, &size, partial,
+                                   &zbuf, &zlen);
+        if (te_rc != 0)
+        {
+            WARN("Couldn't compress the capture log file %s: %r",
+                 fname, te_rc);
+            close(fd);
+            return te_rc;
+        }
+    }
+#else
+    UNUSED(compress);
+#endif
+
     if (lseek(fd, snif->curr_offset, SEEK_SET) == -1)
     {
         WARN("Couldn't to change offset of the capture log file: %s.", fname);
+        free(zbuf);
         return TE_RC(TE_TA_UNIX, TE_EINVAL);
     }
 
     len += snprintf(cbuf + answer_plen, buflen - answer_plen,
-                    "0 %llu attach %zd", snif->id.abs_offset, size) + 1;
+                    "0 %llu%s attach %zd", snif->id.abs_offset,
+                    zbuf != NULL ? " gzip" : "",
+                    zbuf != NULL ? zlen : size) + 1;
     if (len > buflen)
     {
         WARN("Too long rcf message. File is not passed.");
+        free(zbuf);
         return TE_RC(TE_TA_UNIX, TE_EINVAL);
     }
 
     errno = 0;
     RCF_CH_LOCK;
     rc = rcf_comm_agent_reply(handle, cbuf, len);
-    if (rc == 0)
+    if (rc == 0 && zbuf != NULL)
+    {
+        rc = rcf_comm_agent_reply(handle, zbuf, zlen);
+    }
+    else if (rc == 0)
     {
         res = sendfile(*((int *)handle), fd, 0, size);
         /* If data transmission failed, lock the file and try again. */
@@ -1089,6 +1286,7 @@ sniffer_get_dump(struct rcf_comm_connection *handle, char *cbuf,
         }
     }
     RCF_CH_UNLOCK;
+    free(zbuf);
 
     snif->curr_offset += size;
     snif->id.abs_offset += size;
@@ -1097,10 +1295,11 @@ sniffer_get_dump(struct rcf_comm_connection *handle, char *cbuf,
     snif->state &= ~SNIF_ST_HAS_L;
 
     /* Remove the fully passed file. */
-    if ((fnum > 1) || ((snif->state & SNIF_ST_DEL) == SNIF_ST_DEL))
+    if (!partial &&
+        ((fnum > 1) || ((snif->state & SNIF_ST_DEL) == SNIF_ST_DEL)))
         remove(snif->curr_file_name);
 
-    if (fnum > 1)
+    if (partial || fnum > 1)
         snif->state |= SNIF_ST_HAS_L;
     else if ((snif->state & SNIF_ST_DEL) == SNIF_ST_DEL)
         sniffer_cleanup(snif);
@@ -1364,6 +1563,7 @@ sniffer_set_enable(unsigned int gid, const char *oid, const char *value,
 
     if (enable == 1)
     {
+        memset(&sniff->stats, 0, sizeof(sniff->stats));
         if (sniffer_start_process(sniff) == 0)
         {
             snif_sets.lock = true;
@@ -1591,6 +1791,7 @@ sniffer_add(unsigned int gid, const char *oid, char *ssn,
     sniff->curr_offset      = 0;
     sniff->state            = 0;
 
+    memset(&sniff->stats, 0, sizeof(sniff->stats));
     memset(sniff->path, 0, RCF_MAX_PATH);
 
     /*
@@ -1748,8 +1949,14 @@ RCF_PCH_CFG_NODE_RW(node_filter_exp_str, "filter_exp_str", NULL,
 RCF_PCH_CFG_NODE_RW(node_enable, "enable", NULL, &node_filter_exp_str,
                     sniffer_common_get, sniffer_set_enable);
 
+RCF_PCH_CFG_NODE_RO(node_dropped, "dropped", NULL, &node_enable,
+                    sniffer_stats_get);
+
+RCF_PCH_CFG_NODE_RO(node_received, "received", NULL, &node_dropped,
+                    sniffer_stats_get);
+
 static rcf_pch_cfg_object node_sniffer_inst =
-    { "sniffer", 0, &node_enable, NULL,
+    { "sniffer", 0, &node_received, NULL,
       (rcf_ch_cfg_get)sniffer_get, (rcf_ch_cfg_set)sniffer_set,
       (rcf_ch_cfg_add)sniffer_add, (rcf_ch_cfg_del)sniffer_del,
       (rcf_ch_cfg_list)sniffers_list, NULL, NULL, NULL };
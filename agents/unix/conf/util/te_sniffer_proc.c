@@ -32,6 +32,15 @@
 /* Time to wait while memory is not freed, microseconds */
 #define SNIF_WAIT_MEM 500000
 
+/* Default size of the capture ring, megabytes */
+#define SNIF_DEF_BUFFER_SIZE 32
+
+/* Time after which a partially filled ring block is processed, ms */
+#define SNIF_BLOCK_TIMEOUT 100
+
+/* Minimal interval between capture statistics updates, seconds */
+#define SNIF_STATS_PERIOD 1
+
 /** Overfill type constants */
 typedef enum overfill_type {
     ROTATION   = 0, /**< Overfill type rotation */
@@ -61,6 +70,11 @@ typedef struct dump_info {
     pcap_dumper_t  *dumper;                 /**< Structure for capture file
                                                  descriptor */
     int             fd;                     /**< File descriptor */
+    size_t          offset;                 /**< Size of the current dump
+                                                 file including not yet
+                                                 flushed data */
+    bool            locked;                 /**< Whether the current dump
+                                                 file is locked */
     overfill_type   overfilltype;           /**< Overfill handle method:
                                                  0 - rotation (default),
                                                  1 - tail drop. */
@@ -73,6 +87,10 @@ static size_t              total_filled_mem;   /**< Total filled memory */
 static pcap_t             *handle = NULL;      /**< Session handle. */
 static bool fstop;              /**< Stop flag */
 static dump_info           dumpinfo;           /**< Dump files info */
+static te_sniffer_stats    stats;              /**< Capture statistics */
+static struct pcap_stat    last_ps;            /**< Last libpcap statistics */
+static time_t              stats_time;         /**< Time of the last
+                                                    statistics update */
 
 /** Capture files list */
 SIMPLEQ_HEAD(filelist, file_list_s) head_file_list;
@@ -281,14 +299,17 @@ cleanup_rf:
 /**
  * Insert the marker packet into the capture file.
  *
- * @param fd_o      A descriptor of the opened file.
+ * @param f     Stream of the capture file.
  * @param msg   String for a message of packet.
+ * @param ts    Time stamp of the packet or @c NULL to use current time.
+ *
+ * @return Number of bytes written.
  */
-static void
+static size_t
 insert_marker(FILE *f, const char *msg, struct timeval *ts)
 {
     char                proto[SNIF_MARK_PSIZE];    /**< Protocol */
-    int                 res;
+    size_t              written = 0;
     te_pcap_pkthdr      h;
     struct timeval      n_ts;
 
@@ -306,94 +327,152 @@ insert_marker(FILE *f, const char *msg, struct timeval *ts)
     memset(proto, 0 , SNIF_MARK_PSIZE);
     SNIFFER_MARK_H_INIT(proto, strlen(msg));
 
-    res = fwrite((void *)&h, sizeof(te_pcap_pkthdr), 1, f);
-    if (res == -1)
+    if (fwrite((void *)&h, sizeof(te_pcap_pkthdr), 1, f) != 1)
+        return written;
+    written += sizeof(te_pcap_pkthdr);
+    if (fwrite(proto, SNIF_MARK_PSIZE, 1, f) != 1)
+        return written;
+    written += SNIF_MARK_PSIZE;
+    written += fwrite(msg, 1, strlen(msg), f);
+
+    return written;
+}
+
+/**
+ * Lock the current dump file before writing a batch of packets.
+ * The lock is kept until dump_unlock() is called.
+ */
+static void
+dump_lock(void)
+{
+    struct flock lock;
+
+    if (dumpinfo.locked || dumpinfo.fd == -1)
         return;
-    res = fwrite(proto, SNIF_MARK_PSIZE, 1, f);
-    if (res == -1)
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_RDLCK;
+    lock.l_whence = SEEK_SET;
+    fcntl(dumpinfo.fd, F_SETLKW, &lock);
+    dumpinfo.locked = true;
+}
+
+/**
+ * Flush packets written to the current dump file and unlock it.
+ */
+static void
+dump_unlock(void)
+{
+    struct flock lock;
+
+    if (dumpinfo.dumper != NULL)
+        pcap_dump_flush(dumpinfo.dumper);
+
+    if (!dumpinfo.locked)
         return;
-    fwrite(msg, strlen(msg), 1, f);
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_UNLCK;
+    lock.l_whence = SEEK_SET;
+    if (dumpinfo.fd != -1)
+        fcntl(dumpinfo.fd, F_SETLK, &lock);
+    dumpinfo.locked = false;
+}
+
+/**
+ * Close the current dump file and open the next one.
+ *
+ * @return Status code.
+ */
+static int
+dump_rotate(void)
+{
+    unsigned fnum;
+
+    dump_unlock();
+    pcap_dump_close(dumpinfo.dumper);
+    dumpinfo.dumper = NULL;
+    if (dumpinfo.fd != -1)
+    {
+        close(dumpinfo.fd);
+        dumpinfo.fd = -1;
+    }
+
+    absolute_offset += dumpinfo.offset - SNIF_PCAP_HSIZE;
+    total_filled_mem += dumpinfo.offset;
+    dumpinfo.offset = 0;
+
+    if ((dumpinfo.file_name = make_file_name()) == NULL)
+    {
+        fprintf(stderr, "dump_rotate: Couldn't create file name\n");
+        return -1;
+    }
+    dumpinfo.dumper = pcap_dump_open(handle, dumpinfo.file_name);
+    if (dumpinfo.dumper == NULL)
+    {
+        fprintf(stderr, "dump_rotate: %s\n", pcap_geterr(handle));
+        return -1;
+    }
+    dumpinfo.offset = SNIF_PCAP_HSIZE;
+
+    if (file_list_put(dumpinfo.file_name) != 0)
+        fprintf(stderr, "Couldn't add dump file name to list!\n");
+    if ((dumpinfo.fd = open(dumpinfo.file_name, O_RDWR)) == -1)
+        fprintf(stderr, "Couldn't get file descriptor of the dump file\n");
+    fnum = count_fnum();
+    if ((dumpinfo.max_fnum != 0) && (fnum > dumpinfo.max_fnum) &&
+        (dumpinfo.overfilltype == ROTATION))
+    {
+        if (file_list_rm_first() == -1)
+            fprintf(stderr, "Can't remove dump file\n");
+        total_filled_mem = used_space();
+    }
+
+    dump_lock();
+    return 0;
 }
 
 /**
- * Dumping packet to file.
+ * Dumping packet to file. Packets are delivered by pcap_dispatch() a ring
+ * block at a time: the dump file is locked on the first packet of a block
+ * and flushed and unlocked by the caller once the whole block is written.
  *
  * @param user      User params.
  * @param h         Pcap packet header.
  * @param sp        Points to the first byte of a chunk of data containing
- *                  the entire packet, as sniffed by pcap_loop().
+ *                  the entire packet, as sniffed by pcap_dispatch().
  */
 static void
 dump_packet(unsigned char *user, const struct pcap_pkthdr *h,
             const unsigned char *sp)
 {
-    long            offset;
-    struct flock    lock;
-    unsigned        fnum;
+    size_t rec_len = sizeof(te_pcap_pkthdr) + h->caplen;
+
     UNUSED(user);
 
-    lock.l_type = F_RDLCK;
-    lock.l_whence = SEEK_SET;
-    lock.l_start = 0;
-    lock.l_len = 0;
-    if (dumpinfo.fd != -1)
-        fcntl(dumpinfo.fd, F_SETLKW, &lock);
-    lock.l_type = F_UNLCK;
+    if (dumpinfo.dumper == NULL)
+        return;
 
-    offset = pcap_dump_ftell(dumpinfo.dumper);
+    dump_lock();
 
     if ((dumpinfo.file_size != 0) &&
-        (offset + h->caplen + sizeof(struct pcap_pkthdr) >
-        dumpinfo.file_size))
+        (dumpinfo.offset + rec_len > dumpinfo.file_size))
     {
-        pcap_dump_close(dumpinfo.dumper);
-        dumpinfo.dumper = NULL;
-        if (dumpinfo.fd != -1)
+        if (dump_rotate() != 0)
         {
-            close(dumpinfo.fd);
-            dumpinfo.fd = -1;
-        }
-
-        absolute_offset += offset - SNIF_PCAP_HSIZE;
-        total_filled_mem += offset;
-        offset = 0;
-
-        if ((dumpinfo.file_name = make_file_name()) == NULL)
-        {
-            fprintf(stderr, "dump_packet: Couldn't create file name\n");
-            pcap_breakloop(handle);
-            return;
-        }
-        dumpinfo.dumper = pcap_dump_open(handle, dumpinfo.file_name);
-        if (dumpinfo.dumper == NULL)
-        {
-            fprintf(stderr, "dump_packet: %s\n", pcap_geterr(handle));
             pcap_breakloop(handle);
             return;
         }
-        if (file_list_put(dumpinfo.file_name) != 0)
-            fprintf(stderr, "Couldn't add dump file name to list!\n");
-        if ((dumpinfo.fd = open(dumpinfo.file_name, O_RDWR)) == -1)
-            fprintf(stderr,
-                    "Couldn't get file descriptor of the dump file\n");
-        fnum = count_fnum();
-        if ((dumpinfo.max_fnum != 0) && (fnum > dumpinfo.max_fnum) &&
-            (dumpinfo.overfilltype == ROTATION))
-        {
-            if (file_list_rm_first() == -1)
-                fprintf(stderr, "Can't remove dump file\n");
-            total_filled_mem = used_space();
-        }
     }
 
     if ((dumpinfo.total_size != 0) &&
-        ((total_filled_mem + offset + h->caplen) >= dumpinfo.total_size))
+        ((total_filled_mem + dumpinfo.offset + h->caplen) >=
+         dumpinfo.total_size))
     {
         total_filled_mem = used_space();
-        if (total_filled_mem + offset + h->caplen >= dumpinfo.total_size)
+        if (total_filled_mem + dumpinfo.offset + h->caplen >=
+            dumpinfo.total_size)
         {
-            if (dumpinfo.fd != -1)
-                fcntl(dumpinfo.fd, F_SETLK, &lock);
             if (dumpinfo.overfilltype == ROTATION)
             {
                 if (file_list_rm_first() == -1)
@@ -401,17 +480,142 @@ dump_packet(unsigned char *user, const struct pcap_pkthdr *h,
                 total_filled_mem = used_space();
             }
             else
-                wait_mem_free(dumpinfo.total_size, offset);
+            {
+                dump_unlock();
+                wait_mem_free(dumpinfo.total_size, dumpinfo.offset);
+                dump_lock();
+            }
         }
     }
 
     pcap_dump((unsigned char *)dumpinfo.dumper, h, sp);
-    pcap_dump_flush(dumpinfo.dumper);
+    dumpinfo.offset += rec_len;
+}
 
-    if (dumpinfo.fd != -1)
-        fcntl(dumpinfo.fd, F_SETLK, &lock);
+/**
+ * Save capture statistics to the file in the capture folder, where
+ * they are read by the Agent to export them via Configurator.
+ */
+static void
+save_stats(void)
+{
+    char    name[SNIF_MAX_NAME + 1];
+    char    tmp_name[SNIF_MAX_NAME + 1];
+    FILE   *f;
+    int     res;
+
+    res = snprintf(name, sizeof(name), "%s%s", dumpinfo.file_path,
+                   SNIF_STATS_FNAME);
+    if (res < 0 || (size_t)res >= sizeof(name))
+        return;
+    res = snprintf(tmp_name, sizeof(tmp_name), "%s.tmp", name);
+    if (res < 0 || (size_t)res >= sizeof(tmp_name))
+        return;
+
+    f = fopen(tmp_name, "w");
+    if (f == NULL)
+        return;
+    res = fwrite(&stats, sizeof(stats), 1, f);
+    fclose(f);
+
+    /* Rename to never let the Agent see partially written statistics */
+    if (res != 1 || rename(tmp_name, name) != 0)
+        remove(tmp_name);
+}
+
+/**
+ * Update capture statistics and save them. If the kernel dropped some
+ * packets since the previous update, a marker packet with the number
+ * of dropped packets is put to the capture, so that lossy captures
+ * are visible in the log.
+ *
+ * @param force     Update statistics regardless of the time passed
+ *                  since the previous update.
+ */
+static void
+update_stats(bool force)
+{
+    struct pcap_stat    ps;
+    struct timeval      now;
+    uint32_t            dropped;
+    uint32_t            ifdropped;
+    char                msg[SNIF_MAX_NAME];
+
+    gettimeofday(&now, 0);
+    if (!force && now.tv_sec - stats_time < SNIF_STATS_PERIOD)
+        return;
+    stats_time = now.tv_sec;
+
+    if (pcap_stats(handle, &ps) != 0)
+        return;
+
+    /* libpcap counters are 32-bit and may wrap */
+    dropped = ps.ps_drop - last_ps.ps_drop;
+    ifdropped = ps.ps_ifdrop - last_ps.ps_ifdrop;
+    stats.received += (uint32_t)(ps.ps_recv - last_ps.ps_recv);
+    stats.dropped += dropped;
+    stats.ifdropped += ifdropped;
+    last_ps = ps;
+
+    if ((dropped != 0 || ifdropped != 0) && dumpinfo.dumper != NULL)
+    {
+        snprintf(msg, sizeof(msg),
+                 "%" PRIu32 " packets were dropped by the capture ring, "
+                 "%" PRIu32 " by the interface (%" PRIu64 " and %"
+                 PRIu64 " in total).", dropped, ifdropped,
+                 stats.dropped, stats.ifdropped);
+        dump_lock();
+        dumpinfo.offset += insert_marker((FILE *)dumpinfo.dumper, msg,
+                                         &now);
+        dump_unlock();
+    }
+
+    save_stats();
 }
 
+/**
+ * Create and activate a capture handle. On Linux libpcap captures
+ * packets to a memory mapped TPACKET_V3 ring of blocks, the ring size
+ * is defined by the buffer size.
+ *
+ * @param interface     Interface name.
+ * @param snaplen       Snapshot length.
+ * @param promisc       Enable promiscuous mode.
+ * @param buffer_size   Capture buffer size in bytes.
+ * @param ebuf          Buffer for the error message.
+ *
+ * @return Activated capture handle or @c NULL.
+ */
+static pcap_t *
+open_handle(const char *interface, int snaplen, bool promisc,
+            size_t buffer_size, char *ebuf)
+{
+    pcap_t *p;
+
+    p = pcap_create(interface, ebuf);
+    if (p == NULL)
+        return NULL;
+
+    if (pcap_set_snaplen(p, snaplen) != 0 ||
+        pcap_set_promisc(p, promisc) != 0 ||
+        pcap_set_timeout(p, SNIF_BLOCK_TIMEOUT) != 0 ||
+        pcap_set_buffer_size(p, buffer_size) != 0)
+    {
+        fprintf(stderr, "Couldn't configure capture: %s\n",
+                pcap_geterr(p));
+        pcap_close(p);
+        return NULL;
+    }
+
+    /* Warnings (positive values) are not fatal */
+    if (pcap_activate(p) < 0)
+    {
+        pcap_close(p);
+        return NULL;
+    }
+
+    return p;
+}
 
 /**
  * Make a clean exit on interrupts
@@ -434,6 +638,8 @@ usage(void)
     printf("Example: te_sniffer -i any -s 300 -p -f 'ip' -P tmp/ -c 6000"
            " -C 2000 -q 1 -a snname -o\n");
     printf("    -a name                 Sniffer name, required arg\n");
+    printf("    -b buffer_size          Capture buffer size in megabytes, "
+           "default %d\n", SNIF_DEF_BUFFER_SIZE);
     printf("    -C file_size            Max dump file size, defualt 0 "
            "(unlimited)\n");
     printf("    -c total_size           Max total files size, defualt 0"
@@ -471,6 +677,10 @@ wrong_arg(char optopt)
             fprintf(stderr, "-%c without sniffer name\n", optopt);
             break;
 
+        case 'b':
+            fprintf(stderr, "-%c without buffer size\n", optopt);
+            break;
+
         case 'c':
             fprintf(stderr, "-%c without total files size\n", optopt);
             break;
@@ -533,10 +743,16 @@ global_init(void)
     dumpinfo.overfilltype       = ROTATION;
     dumpinfo.dumper             = NULL;
     dumpinfo.fd                 = -1;
+    dumpinfo.offset             = 0;
+    dumpinfo.locked             = false;
 
     total_filled_mem            = 0;
     fstop                       = 0;
     absolute_offset             = 0;
+    stats_time                  = 0;
+
+    memset(&stats, 0, sizeof(stats));
+    memset(&last_ps, 0, sizeof(last_ps));
 }
 
 /* See description in te_sniffer_proc.h */
@@ -548,7 +764,8 @@ te_sniffer_process(int argc, char *argv[])
     char *conf_file_name            = NULL;
     char *filter_exp                = NULL;
     char *sniffer_name              = NULL;
-    int   snaplen                   = 0;
+    int   snaplen                   = MAXIMUM_SNAPLEN;
+    size_t buffer_size              = (size_t)SNIF_DEF_BUFFER_SIZE << 20;
 
     struct timeval ts;
 
@@ -562,7 +779,7 @@ te_sniffer_process(int argc, char *argv[])
     global_init();
     SIMPLEQ_INIT(&head_file_list);
 
-    while ((op = getopt(argc, argv, ":a:c:C:f:F:hi:opP:q:r:s:w:")) != -1)
+    while ((op = getopt(argc, argv, ":a:b:c:C:f:F:hi:opP:q:r:s:w:")) != -1)
     {
         switch(op)
         {
@@ -570,6 +787,11 @@ te_sniffer_process(int argc, char *argv[])
                 sniffer_name = optarg;
                 break;
 
+            case 'b':
+                if (atol(optarg) > 0)
+                    buffer_size = (size_t)atol(optarg) << 20;
+                break;
+
             case 'c':
                 dumpinfo.total_size = atol(optarg) << 20;
                 break;
@@ -669,7 +891,7 @@ te_sniffer_process(int argc, char *argv[])
     while (handle == NULL && !fstop)
     {
         gettimeofday(&ts, 0);
-        handle = pcap_open_live(interface, snaplen, pflag, 1000, ebuf);
+        handle = open_handle(interface, snaplen, pflag, buffer_size, ebuf);
         usleep(SNIF_WAIT_IF_UP);
     }
     if (handle == NULL)
@@ -697,6 +919,7 @@ te_sniffer_process(int argc, char *argv[])
         fprintf(stderr, "Couldn't open dump file %s", pcap_geterr(handle));
         goto cleanup;
     }
+    dumpinfo.offset = SNIF_PCAP_HSIZE;
 
     if (file_list_put(dumpinfo.file_name) != 0)
             fprintf(stderr, "Can't add dump file name to list!\n");
@@ -716,25 +939,40 @@ te_sniffer_process(int argc, char *argv[])
     sigaction(SIGTERM, &act, NULL);
     sigaction(SIGINT, &act, NULL);
 
-    insert_marker((FILE *)dumpinfo.dumper,
-                  "The sniffer process has been started.", &ts);
+    dumpinfo.offset += insert_marker((FILE *)dumpinfo.dumper,
+                                     "The sniffer process has been started.",
+                                     &ts);
+    dump_unlock();
+    save_stats();
 
+    /*
+     * Every pcap_dispatch() call processes the packets of a single
+     * ring block, so the dump file is flushed and unlocked once per
+     * block rather than once per packet.
+     */
     while (!fstop)
     {
-        loop_rc = pcap_loop(handle, 0, dump_packet, NULL);
-        if (loop_rc == 0)
+        loop_rc = pcap_dispatch(handle, -1, dump_packet, NULL);
+        dump_unlock();
+        if (loop_rc >= 0)
+        {
+            update_stats(false);
             continue;
+        }
         if (loop_rc == PCAP_ERROR_BREAK)
             break;
 
-        fprintf(stderr, "pcap_loop() failed: %s\n", pcap_geterr(handle));
+        fprintf(stderr, "pcap_dispatch() failed: %s\n",
+                pcap_geterr(handle));
         break;
     }
 
     if (dumpinfo.dumper != NULL)
     {
-        insert_marker((FILE *)dumpinfo.dumper,
-                      "Shutting down the sniffer process.", NULL);
+        update_stats(true);
+        dumpinfo.offset += insert_marker((FILE *)dumpinfo.dumper,
+                                         "Shutting down the sniffer process.",
+                                         NULL);
     }
 
 cleanup:
@@ -323,6 +323,8 @@ Generic options:
                                 main configuration file(s).
   --cs-print-trees              Print configurator trees.
   --cs-log-diff                 Log backup diff unconditionally.
+  --cs-xml-backups              Write XML file for every configuration
+                                backup on creation.
 
   --builder-debug               Be more verbose when build.
 
@@ -354,6 +356,12 @@ Generic options:
   --tester-no-cs                Don't interact with Configurator.
   --tester-no-cfg-track         Don't track configuration changes.
   --tester-no-logues            Disable prologues and epilogues globally.
+  --tester-no-simultaneous      Run all tests in series ignoring
+                                'simultaneous' attribute of sessions.
+  --tester-simultaneous-workers=<number>
+                                Maximum number of test scripts of
+                                a simultaneous session to run at the same
+                                time (1 by default).
   --tester-only-req-logues      Run only prologues/epilogues under which
                                 at least one test will be run according to
                                 requirements passed in command line. This
@@ -436,6 +444,8 @@ Generic options:
                                 Test Agents (useful for Logger debugging).
   --logger-check                Check that log messages received from other TE components are
                                 properly formatted before storing them in the raw log file.
+  --logger-ta-log-files         Get Test Agents logs via temporary files on every polling
+                                period instead of streaming them to Logger directly.
   --logger-listener=<confstr>   Enable streaming live results to the specified listener.
                                 Config string has the following format: <name>[:<runid>].
   --logger-meta-file=<path>     Send meta information to listeners. This option may only be specified
@@ -548,9 +558,9 @@ Environment variables defining where raw log is stored:
     TE_LOG_RAW          Where to save raw log file, by default tmp_raw_log
                         in directory specified by --log-dir (if provided)
                         or in the current directory.
-    TE_LOG_BUNDLE       Where to save raw log bundle (tarball compressed
-                        with pixz). If it is not set, raw log bundle is not
-                        created.
+    TE_LOG_BUNDLE       Where to save raw log bundle (see
+                        rgt-log-bundle-create). If it is not set, raw log
+                        bundle is not created.
 
     The script exits with a status of zero if everything does smoothly and
     all tests, if any tests are run, give expected results. A status of two
@@ -1249,29 +1249,68 @@ put_object(FILE *f, cfg_object *obj)
         put_object(f, obj);
 }
 
+/**
+ * Put description of the object instance to the configuration file.
+ *
+ * @param f         opened configuration file
+ * @param oid       object instance identifier
+ * @param val_str   instance value or @c NULL
+ *
+ * @return 0 (success) or TE_ENOMEM
+ */
+static int
+put_instance_value(FILE *f, const char *oid, const char *val_str)
+{
+    fprintf(f, "\n  <instance oid=\"%s\"", oid);
+
+    if (val_str != NULL)
+    {
+        xmlChar *xml_str;
+
+        xml_str = xmlEncodeEntitiesReentrant(NULL, (const xmlChar *)val_str);
+        if (xml_str == NULL)
+            return TE_ENOMEM;
+
+        fprintf(f, " value=\"%s\"", xml_str);
+        free(xml_str);
+    }
+    fprintf(f, "/>\n");
+
+    return 0;
+}
+
 /**
  * Put description of the object instance and its (grand-...)children to
  * the configuration file.
  *
  * @param f      opened configuration file
  * @param inst   object instance
+ * @param image  snapshot image to take instances state from or @c NULL
+ *               to put the current state
  *
  * @return 0 (success) or TE_ENOMEM
  */
 static int
-put_instance(FILE *f, cfg_instance *inst)
+put_instance(FILE *f, cfg_instance *inst, const cfg_snapshot_image *image)
 {
-    if (inst != &cfg_inst_root && !cfg_inst_agent(inst) &&
-        !cfg_instance_volatile(inst))
+    const cfg_snapshot_rec *rec = NULL;
+
+    if (image != NULL)
+        rec = cfg_snapshot_image_find(image, inst->oid);
+
+    if (rec != NULL)
     {
-        fprintf(f, "\n  <instance oid=\"%s\"", inst->oid);
+        if (rec->existed && put_instance_value(f, rec->oid, rec->value) != 0)
+            return TE_ENOMEM;
+    }
+    else if (inst != &cfg_inst_root && !cfg_inst_agent(inst) &&
+             !cfg_instance_volatile(inst))
+    {
+        char *val_str = NULL;
+        int   rc;
 
         if (inst->obj->type != CVT_NONE)
         {
-            char    *val_str = NULL;
-            xmlChar *xml_str;
-            int      rc;
-
             rc = cfg_types[inst->obj->type].val2str(inst->val, &val_str);
             if (rc != 0)
             {
@@ -1279,37 +1318,72 @@ put_instance(FILE *f, cfg_instance *inst)
                        inst->oid, inst->obj->type);
                 return rc;
             }
+        }
 
-            xml_str = xmlEncodeEntitiesReentrant(NULL, (xmlChar *)val_str);
-            free(val_str);
-            if (xml_str == NULL)
-                return TE_ENOMEM;
-
-            fprintf(f, " value=\"%s\"", xml_str);
-            free(xml_str);
-         }
-         fprintf(f, "/>\n");
+        rc = put_instance_value(f, inst->oid, val_str);
+        free(val_str);
+        if (rc != 0)
+            return rc;
     }
     for (inst = inst->son; inst != NULL; inst = inst->brother)
-        if (put_instance(f, inst) != 0)
+        if (put_instance(f, inst, image) != 0)
             return TE_ENOMEM;
 
     return 0;
 }
 
 static te_errno
-put_instance_by_oid(FILE *f, const char *oid)
+put_instance_by_oid(FILE *f, const char *oid, const cfg_snapshot_image *image)
 {
     cfg_instance *inst;
 
     inst = cfg_get_ins_by_ins_id_str(oid);
     if (inst == NULL)
     {
+        /* The subtree may be deleted after the snapshot creation */
+        if (image != NULL && cfg_snapshot_image_find(image, oid) != NULL)
+            return 0;
+
         ERROR("Failed to find instance with OID %s", oid);
         return TE_ENOENT;
     }
 
-    return put_instance(f, inst);
+    return put_instance(f, inst, image);
+}
+
+/**
+ * Put instances deleted after the snapshot creation to the
+ * configuration file.
+ *
+ * @param f         opened configuration file
+ * @param subtrees  Vector of the subtrees or @c NULL
+ * @param image     snapshot image
+ *
+ * @return 0 (success) or TE_ENOMEM
+ */
+static int
+put_deleted_instances(FILE *f, const te_vec *subtrees,
+                      const cfg_snapshot_image *image)
+{
+    unsigned int i;
+
+    for (i = 0; i < image->n_recs; i++)
+    {
+        const cfg_snapshot_rec *rec = image->recs[i];
+
+        /* Lookup which does not fill in the OID cache */
+        if (!rec->existed || cfg_get_ins_by_ins_id_str(rec->oid) != NULL)
+            continue;
+
+        if (subtrees != NULL && te_vec_size(subtrees) != 0 &&
+            !check_oid_contains_subtrees(subtrees, rec->oid))
+            continue;
+
+        if (put_instance_value(f, rec->oid, rec->value) != 0)
+            return TE_ENOMEM;
+    }
+
+    return 0;
 }
 
 /**
@@ -1318,11 +1392,14 @@ put_instance_by_oid(FILE *f, const char *oid)
  * @param filename      name of the file to be created
  * @param subtrees      Vector of the subtrees to create a backup file.
  *                      @c NULL to create backup fo all the subtrees
+ * @param image         snapshot image or @c NULL for the current
+ *                      configuration
  *
  * @return status code (errno.h)
  */
-int
-cfg_backup_create_file(const char *filename, const te_vec *subtrees)
+static int
+create_file(const char *filename, const te_vec *subtrees,
+            const cfg_snapshot_image *image)
 {
     FILE *f= fopen(filename, "w");
     te_errno rc;
@@ -1341,7 +1418,7 @@ cfg_backup_create_file(const char *filename, const te_vec *subtrees)
 
         TE_VEC_FOREACH(subtrees, subtree)
         {
-            rc = put_instance_by_oid(f, *subtree);
+            rc = put_instance_by_oid(f, *subtree, image);
             if (rc != 0)
             {
                 fclose(f);
@@ -1352,7 +1429,18 @@ cfg_backup_create_file(const char *filename, const te_vec *subtrees)
     }
     else
     {
-        rc = put_instance(f, &cfg_inst_root);
+        rc = put_instance(f, &cfg_inst_root, image);
+        if (rc != 0)
+        {
+            fclose(f);
+            unlink(filename);
+            return rc;
+        }
+    }
+
+    if (image != NULL)
+    {
+        rc = put_deleted_instances(f, subtrees, image);
         if (rc != 0)
         {
             fclose(f);
@@ -1366,6 +1454,21 @@ cfg_backup_create_file(const char *filename, const te_vec *subtrees)
     return 0;
 }
 
+/* See the description in conf_backup.h */
+int
+cfg_backup_create_file(const char *filename, const te_vec *subtrees)
+{
+    return create_file(filename, subtrees, NULL);
+}
+
+/* See the description in conf_backup.h */
+int
+cfg_backup_create_image_file(const char *filename, const te_vec *subtrees,
+                             const cfg_snapshot_image *image)
+{
+    return create_file(filename, subtrees, image);
+}
+
 te_errno
 cfg_backup_create_filter_file(const char *filename, const te_vec *subtrees)
 {
@@ -52,6 +52,22 @@ extern int cfg_backup_restore_ta(char *ta);
 extern int cfg_backup_create_file(const char *filename,
                                   const te_vec *subtrees);
 
+/**
+ * Create "backup" configuration file with the state of the configuration
+ * at the moment of a snapshot creation. Instances deleted after the
+ * snapshot creation are put after all the other instances.
+ *
+ * @param filename   name of the file to be created
+ * @param subtrees   Vector of the subtrees to create a backup file.
+ *                   @c NULL to create backup fo all the subtrees
+ * @param image      snapshot image
+ *
+ * @return status code (errno.h)
+ */
+extern int cfg_backup_create_image_file(const char *filename,
+                                        const te_vec *subtrees,
+                                        const cfg_snapshot_image *image);
+
 /**
  * Create file XML file with subtrees to filter backup file
  *
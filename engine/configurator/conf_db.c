@@ -10,8 +10,12 @@
 
 #include "conf_defs.h"
 #include "te_alloc.h"
+#include "te_hash.h"
 #include "te_string.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+
 /* These must not be greater than CFG_HANDLE_MAX_INDEX + 1 */
 #define CFG_OBJ_NUM     64      /**< Number of objects */
 #define CFG_INST_NUM    128     /**< Number of object instances */
@@ -124,6 +128,12 @@ uint32_t cfg_inst_seq_num = 1;
 /** Delay for configuration changes accommodation */
 uint32_t cfg_conf_delay;
 
+/** Generation of the database */
+uint32_t cfg_db_gen = CFG_GEN_NONE + 1;
+
+/** Shared memory where the generation is published for clients */
+static uint32_t *cfg_db_gen_shm = NULL;
+
 /* Locals */
 static int pattern_match(char *pattern, char *str);
 
@@ -152,6 +162,445 @@ static cfg_orphan *orphaned_objects;
  */
 static cfg_object *topological_order;
 
+/** Minimum number of sons of a node to build the son index */
+#define CFG_SON_INDEX_MIN   16
+
+/** Slot of a son index */
+typedef struct cfg_son_index_slot {
+    uint32_t  hash;     /**< Hash of the son key */
+    void     *son;      /**< Son object or instance, @c NULL if free */
+} cfg_son_index_slot;
+
+/** Number of entries in the cache of resolved OIDs (power of 2) */
+#define CFG_OID_CACHE_SIZE  4096
+
+/** Entry of the cache of resolved OIDs */
+typedef struct cfg_oid_cache_entry {
+    char       *oid;        /**< OID or @c NULL if the entry is free */
+    cfg_handle  handle;     /**< Handle of the object or instance */
+    bool        inst;       /**< Whether OID is an instance identifier */
+} cfg_oid_cache_entry;
+
+/**
+ * Direct-mapped cache of OIDs resolved by cfg_db_find(). Entries are
+ * verified against the database on hit, so a stale entry results in
+ * a usual lookup only.
+ */
+static cfg_oid_cache_entry *cfg_oid_cache = NULL;
+
+/** The lowest index in cfg_all_inst which may be free */
+static uint64_t cfg_all_inst_free = 1;
+
+/**
+ * Continue hash calculation over a string including its terminating
+ * NUL, so that concatenated keys do not clash.
+ *
+ * @param hash      Hash of preceding keys
+ * @param str       String to hash
+ *
+ * @return Updated hash.
+ */
+static inline uint32_t
+cfg_str_hash(uint32_t hash, const char *str)
+{
+    return te_hash_fnv32_buf(hash, str, strlen(str) + 1);
+}
+
+/** Calculate hash of an object son key */
+static inline uint32_t
+cfg_obj_son_hash(const char *subid)
+{
+    return cfg_str_hash(TE_HASH_FNV32_INIT, subid);
+}
+
+/** Calculate hash of an instance son key */
+static inline uint32_t
+cfg_inst_son_hash(const char *subid, const char *name)
+{
+    return cfg_str_hash(cfg_str_hash(TE_HASH_FNV32_INIT, subid), name);
+}
+
+/** Put a son to the index which is known to have a free slot */
+static void
+cfg_son_index_put(cfg_son_index *index, uint32_t hash, void *son)
+{
+    unsigned int mask = index->size - 1;
+    unsigned int i;
+
+    for (i = hash & mask; index->slots[i].son != NULL; i = (i + 1) & mask);
+
+    index->slots[i].hash = hash;
+    index->slots[i].son = son;
+    index->used++;
+}
+
+/**
+ * Allocate son index slots and re-insert sons present in the index.
+ *
+ * @param index     Son index
+ * @param n_sons    Number of sons the index should accommodate
+ */
+static void
+cfg_son_index_resize(cfg_son_index *index, unsigned int n_sons)
+{
+    cfg_son_index_slot *old_slots = index->slots;
+    unsigned int        old_size = index->size;
+    unsigned int        size = CFG_SON_INDEX_MIN * 2;
+    unsigned int        i;
+
+    /* Keep load factor not greater than 3/4 */
+    while (n_sons * 4 > size * 3)
+        size *= 2;
+
+    index->slots = TE_ALLOC(size * sizeof(*index->slots));
+    index->size = size;
+    index->used = 0;
+
+    for (i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].son != NULL)
+            cfg_son_index_put(index, old_slots[i].hash, old_slots[i].son);
+    }
+    free(old_slots);
+}
+
+/** Add a son to the index if it is built */
+static void
+cfg_son_index_add(cfg_son_index *index, uint32_t hash, void *son)
+{
+    if (index->size == 0)
+        return;
+
+    if ((index->used + 1) * 4 > index->size * 3)
+        cfg_son_index_resize(index, index->used + 1);
+
+    cfg_son_index_put(index, hash, son);
+}
+
+/** Remove a son from the index if it is built */
+static void
+cfg_son_index_del(cfg_son_index *index, uint32_t hash, void *son)
+{
+    unsigned int mask = index->size - 1;
+    unsigned int home;
+    unsigned int i;
+    unsigned int j;
+
+    if (index->size == 0)
+        return;
+
+    for (i = hash & mask; index->slots[i].son != son; i = (i + 1) & mask)
+    {
+        if (index->slots[i].son == NULL)
+        {
+            ERROR("%s(): son is not found in the index", __FUNCTION__);
+            return;
+        }
+    }
+
+    /*
+     * Shift back the following slots of the cluster which would
+     * become unreachable from their home positions otherwise.
+     */
+    for (j = (i + 1) & mask; index->slots[j].son != NULL; j = (j + 1) & mask)
+    {
+        home = index->slots[j].hash & mask;
+        if (i <= j ? (home <= i || home > j) : (home <= i && home > j))
+        {
+            index->slots[i] = index->slots[j];
+            i = j;
+        }
+    }
+    index->slots[i].son = NULL;
+    index->used--;
+}
+
+/** Release the son index */
+static void
+cfg_son_index_free(cfg_son_index *index)
+{
+    free(index->slots);
+    index->slots = NULL;
+    index->size = 0;
+    index->used = 0;
+}
+
+/**
+ * Find a son of an object by its sub-identifier. The son index
+ * is built when the object is found to have many sons.
+ *
+ * @param father    Father object
+ * @param subid     Sub-identifier of the son
+ *
+ * @return Son object or @c NULL if it is not found.
+ */
+static cfg_object *
+cfg_obj_find_son(cfg_object *father, const char *subid)
+{
+    cfg_son_index *index = &father->son_index;
+    cfg_object    *son;
+    unsigned int   n_sons = 0;
+    uint32_t       hash;
+    unsigned int   i;
+
+    if (index->size == 0)
+    {
+        for (son = father->son; son != NULL; son = son->brother, n_sons++)
+        {
+            if (strcmp(son->subid, subid) == 0)
+                return son;
+        }
+        if (n_sons < CFG_SON_INDEX_MIN)
+            return NULL;
+
+        cfg_son_index_resize(index, n_sons);
+        for (son = father->son; son != NULL; son = son->brother)
+            cfg_son_index_put(index, cfg_obj_son_hash(son->subid), son);
+
+        return NULL;
+    }
+
+    hash = cfg_obj_son_hash(subid);
+    for (i = hash & (index->size - 1);
+         (son = index->slots[i].son) != NULL;
+         i = (i + 1) & (index->size - 1))
+    {
+        if (index->slots[i].hash == hash && strcmp(son->subid, subid) == 0)
+            return son;
+    }
+
+    return NULL;
+}
+
+/**
+ * Find a son of an instance by sub-identifier and name. Instances
+ * scheduled for removal are skipped. The son index is built when
+ * the instance is found to have many sons.
+ *
+ * @param father    Father instance
+ * @param subid     Sub-identifier of the son
+ * @param name      Name of the son
+ *
+ * @return Son instance or @c NULL if it is not found.
+ */
+static cfg_instance *
+cfg_inst_find_son(cfg_instance *father, const char *subid, const char *name)
+{
+    cfg_son_index *index = &father->son_index;
+    cfg_instance  *son;
+    unsigned int   n_sons = 0;
+    uint32_t       hash;
+    unsigned int   i;
+
+    if (index->size == 0)
+    {
+        for (son = father->son; son != NULL; son = son->brother, n_sons++)
+        {
+            if (strcmp(son->obj->subid, subid) == 0 &&
+                strcmp(son->name, name) == 0 && !son->remove)
+                return son;
+        }
+        if (n_sons < CFG_SON_INDEX_MIN)
+            return NULL;
+
+        cfg_son_index_resize(index, n_sons);
+        for (son = father->son; son != NULL; son = son->brother)
+        {
+            cfg_son_index_put(index,
+                              cfg_inst_son_hash(son->obj->subid, son->name),
+                              son);
+        }
+
+        return NULL;
+    }
+
+    hash = cfg_inst_son_hash(subid, name);
+    for (i = hash & (index->size - 1);
+         (son = index->slots[i].son) != NULL;
+         i = (i + 1) & (index->size - 1))
+    {
+        if (index->slots[i].hash == hash &&
+            strcmp(son->obj->subid, subid) == 0 &&
+            strcmp(son->name, name) == 0 && !son->remove)
+            return son;
+    }
+
+    return NULL;
+}
+
+/* See the description in conf_db.h */
+void
+cfg_inst_link_son(cfg_instance *father, cfg_instance *prev,
+                  cfg_instance *son)
+{
+    son->father = father;
+    son->son = NULL;
+    if (prev != NULL)
+    {
+        son->brother = prev->brother;
+        prev->brother = son;
+    }
+    else
+    {
+        son->brother = father->son;
+        father->son = son;
+    }
+    if (son->brother == NULL)
+        father->last_son = son;
+
+    cfg_son_index_add(&father->son_index,
+                      cfg_inst_son_hash(son->obj->subid, son->name), son);
+}
+
+/**
+ * Get the index of a free slot in the pool of instances growing
+ * the pool if necessary.
+ *
+ * @param index     Location for the slot index
+ *
+ * @return Status code.
+ */
+static te_errno
+cfg_inst_get_free_index(uint64_t *index)
+{
+    uint64_t i;
+
+    for (i = cfg_all_inst_free;
+         i < cfg_all_inst_size && cfg_all_inst[i] != NULL;
+         i++);
+
+    if (i > CFG_HANDLE_MAX_INDEX)
+    {
+        ERROR("%s(): no more instance indexes is available",
+              __FUNCTION__);
+        return TE_ETOOMANY;
+    }
+
+    if (i == cfg_all_inst_size)
+    {
+        void *tmp = realloc(cfg_all_inst,
+            sizeof(void *) * (cfg_all_inst_size + CFG_INST_NUM));
+
+        if (tmp == NULL)
+            return TE_ENOMEM;
+
+        memset(tmp + sizeof(void *) * cfg_all_inst_size, 0,
+               sizeof(void *) * CFG_INST_NUM);
+
+        cfg_all_inst = (cfg_instance **)tmp;
+        cfg_all_inst_size += CFG_INST_NUM;
+    }
+
+    cfg_all_inst_free = i;
+    *index = i;
+
+    return 0;
+}
+
+/** Get the OID cache entry for the OID */
+static cfg_oid_cache_entry *
+cfg_oid_cache_entry_get(const char *oid_s)
+{
+    if (cfg_oid_cache == NULL)
+    {
+        cfg_oid_cache = TE_ALLOC(CFG_OID_CACHE_SIZE *
+                                 sizeof(*cfg_oid_cache));
+    }
+
+    return &cfg_oid_cache[cfg_str_hash(TE_HASH_FNV32_INIT, oid_s) &
+                          (CFG_OID_CACHE_SIZE - 1)];
+}
+
+/**
+ * Look up an OID in the cache of resolved OIDs.
+ *
+ * @param oid_s     OID in string representation
+ * @param handle    Location for the handle
+ *
+ * @return @c true if the OID is found and still valid.
+ */
+static bool
+cfg_oid_cache_lookup(const char *oid_s, cfg_handle *handle)
+{
+    cfg_oid_cache_entry *entry = cfg_oid_cache_entry_get(oid_s);
+    cfg_instance        *inst;
+    cfg_object          *obj;
+
+    if (entry->oid == NULL || strcmp(entry->oid, oid_s) != 0)
+        return false;
+
+    if (entry->inst)
+    {
+        inst = CFG_GET_INST(entry->handle);
+        if (inst == NULL || strcmp(inst->oid, oid_s) != 0)
+            return false;
+
+        /* Lookup does not go through instances scheduled for removal */
+        for (; inst != NULL; inst = inst->father)
+        {
+            if (inst->remove)
+                return false;
+        }
+    }
+    else
+    {
+        obj = CFG_GET_OBJ(entry->handle);
+        if (obj == NULL || strcmp(obj->oid, oid_s) != 0)
+            return false;
+    }
+
+    *handle = entry->handle;
+    return true;
+}
+
+/** Remember a resolved OID in the cache */
+static void
+cfg_oid_cache_update(const char *oid_s, cfg_handle handle, bool inst)
+{
+    cfg_oid_cache_entry *entry = cfg_oid_cache_entry_get(oid_s);
+
+    if (entry->oid == NULL || strcmp(entry->oid, oid_s) != 0)
+    {
+        free(entry->oid);
+        entry->oid = TE_STRDUP(oid_s);
+    }
+    entry->handle = handle;
+    entry->inst = inst;
+}
+
+/** Forget an OID in the cache */
+static void
+cfg_oid_cache_forget(const char *oid_s)
+{
+    cfg_oid_cache_entry *entry;
+
+    if (cfg_oid_cache == NULL)
+        return;
+
+    entry = cfg_oid_cache_entry_get(oid_s);
+    if (entry->oid != NULL && strcmp(entry->oid, oid_s) == 0)
+    {
+        free(entry->oid);
+        entry->oid = NULL;
+    }
+}
+
+/** Release the cache of resolved OIDs */
+static void
+cfg_oid_cache_free(void)
+{
+    unsigned int i;
+
+    if (cfg_oid_cache == NULL)
+        return;
+
+    for (i = 0; i < CFG_OID_CACHE_SIZE; i++)
+        free(cfg_oid_cache[i].oid);
+
+    free(cfg_oid_cache);
+    cfg_oid_cache = NULL;
+}
+
 static te_errno
 get_value_for_substitution(const char *oid, char **value)
 {
@@ -446,6 +895,69 @@ cfg_destroy_deps(cfg_dependency *deps)
     }
 }
 
+/**
+ * Create the shared memory object to publish the database generation.
+ * Clients do not cache replies if it does not exist.
+ */
+static void
+cfg_db_gen_shm_create(void)
+{
+    const char *name = cs_gen_shm_name();
+    void       *ptr;
+    int         fd;
+
+    /* Remove a stale object left by a crashed Configurator */
+    (void)shm_unlink(name);
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0)
+    {
+        WARN("Failed to create shared memory object %s: %r",
+             name, TE_OS_RC(TE_CS, errno));
+        return;
+    }
+
+    if (ftruncate(fd, sizeof(*cfg_db_gen_shm)) != 0 ||
+        (ptr = mmap(NULL, sizeof(*cfg_db_gen_shm), PROT_READ | PROT_WRITE,
+                    MAP_SHARED, fd, 0)) == MAP_FAILED)
+    {
+        WARN("Failed to map shared memory object %s: %r",
+             name, TE_OS_RC(TE_CS, errno));
+        close(fd);
+        (void)shm_unlink(name);
+        return;
+    }
+    close(fd);
+
+    cfg_db_gen_shm = ptr;
+    __atomic_store_n(cfg_db_gen_shm, cfg_db_gen, __ATOMIC_RELEASE);
+}
+
+/* See the description in conf_db.h */
+void
+cfg_db_gen_bump(void)
+{
+    if (++cfg_db_gen == CFG_GEN_NONE)
+        cfg_db_gen++;
+
+    if (cfg_db_gen_shm != NULL)
+        __atomic_store_n(cfg_db_gen_shm, cfg_db_gen, __ATOMIC_RELEASE);
+}
+
+/* See the description in conf_db.h */
+void
+cfg_db_gen_release(void)
+{
+    if (cfg_db_gen_shm == NULL)
+        return;
+
+    /* Make sure that clients do not trust their caches any more */
+    cfg_db_gen_bump();
+    munmap(cfg_db_gen_shm, sizeof(*cfg_db_gen_shm));
+    cfg_db_gen_shm = NULL;
+    (void)shm_unlink(cs_gen_shm_name());
+}
+
 /**
  * Initialize the database during startup or re-initialization.
  *
@@ -455,6 +967,10 @@ int
 cfg_db_init(void)
 {
     cfg_db_destroy();
+
+    cfg_db_gen_bump();
+    if (cfg_db_gen_shm == NULL)
+        cfg_db_gen_shm_create();
     if ((cfg_all_obj = (cfg_object **)calloc(CFG_OBJ_NUM,
                                              sizeof(void *))) == NULL)
     {
@@ -486,8 +1002,10 @@ cfg_db_init(void)
         return TE_ENOMEM;
     }
     cfg_all_inst_size = CFG_INST_NUM;
+    cfg_all_inst_free = 1;
     cfg_all_inst[0] = &cfg_inst_root;
     cfg_inst_root.son = NULL;
+    cfg_inst_root.last_son = NULL;
 
     cfg_create_dep(&cfg_obj_agent_rsrc, &cfg_obj_agent_rsrc_shared, true);
     cfg_create_dep(&cfg_obj_agent_rsrc, &cfg_obj_agent_rsrc_timeout, true);
@@ -508,13 +1026,19 @@ cfg_db_destroy(void)
     if (cfg_all_obj == NULL)
         return;
 
+    /* Backups should survive re-initialization */
+    cfg_snapshot_materialize_all();
+    cfg_oid_cache_free();
+
     INFO("Destroy instances");
+    cfg_son_index_free(&cfg_inst_root.son_index);
     for (i = 1; i < cfg_all_inst_size; i++)
     {
         if (cfg_all_inst[i] != NULL)
         {
             cfg_types[cfg_all_inst[i]->obj->type].
                 free(cfg_all_inst[i]->val);
+            cfg_son_index_free(&cfg_all_inst[i]->son_index);
             free(cfg_all_inst[i]->oid);
             free(cfg_all_inst[i]);
         }
@@ -523,10 +1047,13 @@ cfg_db_destroy(void)
     cfg_all_inst = NULL;
 
     INFO("Destroy objects");
+    for (i = 0; i < CFG_OBJ_HANDLE_NUM_RSRVD; i++)
+        cfg_son_index_free(&cfg_all_obj[i]->son_index);
     for (i = CFG_OBJ_HANDLE_NUM_RSRVD; i < cfg_all_obj_size; i++)
     {
         if (cfg_all_obj[i] != NULL)
         {
+            cfg_son_index_free(&cfg_all_obj[i]->son_index);
             free(cfg_all_obj[i]->oid);
             free(cfg_all_obj[i]->def_val);
             cfg_destroy_deps(cfg_all_obj[i]->depends_on);
@@ -597,18 +1124,10 @@ cfg_process_msg_register(cfg_register_msg *msg)
     }
 
     /* Look for the father first */
-    while (true)
+    for (i = 1; i < (uint64_t)oid->len - 1 && father != NULL; i++)
     {
-       for (;
-            father != NULL &&
-            strcmp(father->subid,
-                   ((cfg_object_subid *)(oid->ids))[i].subid) != 0;
-            father = father->brother);
-
-       if (++i == oid->len - 1 || father == NULL)
-           break;
-
-       father = father->son;
+        father = cfg_obj_find_son(father,
+                                  ((cfg_object_subid *)(oid->ids))[i].subid);
     }
 
     if (father == NULL)
@@ -628,11 +1147,7 @@ cfg_process_msg_register(cfg_register_msg *msg)
     }
 
     /* Check for an obj with the same name */
-    for (obj = father->son;
-         obj != NULL && \
-         strcmp(obj->subid,
-                ((cfg_object_subid *)(oid->ids))[i].subid) != 0;
-         obj = obj->brother);
+    obj = cfg_obj_find_son(father, ((cfg_object_subid *)(oid->ids))[i].subid);
 
     if (obj != NULL)
     {
@@ -643,6 +1158,9 @@ cfg_process_msg_register(cfg_register_msg *msg)
         return;
     }
 
+    /* Snapshots do not track objects */
+    cfg_snapshot_materialize_all();
+
     /* Now look for an empty slot in the objects array */
     for (i = 0; i < cfg_all_obj_size && cfg_all_obj[i] != NULL; i++);
 
@@ -715,6 +1233,9 @@ cfg_process_msg_register(cfg_register_msg *msg)
     cfg_all_obj[i]->son = NULL;
     cfg_all_obj[i]->brother = father->son;
     father->son = cfg_all_obj[i];
+    cfg_son_index_add(&father->son_index,
+                      cfg_obj_son_hash(cfg_all_obj[i]->subid),
+                      cfg_all_obj[i]);
 
     cfg_all_obj[i]->substitution = msg->substitution;
 
@@ -864,6 +1385,9 @@ cfg_db_unregister_obj_by_id_str(char *id,
         return TE_RC(TE_CS, TE_EINVAL);
     }
 
+    /* Snapshots do not track objects */
+    cfg_snapshot_materialize_all();
+
     /*
      * Cut off all the dependants by brutal force
      * (normally, should not happen):
@@ -962,10 +1486,12 @@ cfg_db_unregister_obj_by_id_str(char *id,
         assert(brother != NULL);
         brother->brother = obj->brother;
     }
+    cfg_son_index_del(&father->son_index, cfg_obj_son_hash(obj->subid), obj);
 
     /* Delete from the array of objects */
     cfg_all_obj[obj->handle] = NULL;
 
+    cfg_son_index_free(&obj->son_index);
     free(obj->oid);
     free(obj->def_val);
     free(obj);
@@ -995,6 +1521,9 @@ cfg_process_msg_add_dependency(cfg_add_dependency_msg *msg)
          msg->object_wide ? "object-wide" : "instance-wide",
          msg->oid, obj->oid);
 
+    /* Snapshots do not track objects */
+    cfg_snapshot_materialize_all();
+
 
     rc = cfg_db_find(msg->oid, &master_handle);
     if (rc != 0 && rc != TE_ENOENT)
@@ -1421,32 +1950,11 @@ cfg_add_with_obj_and_parent(cfg_instance *par_inst, cfg_object *obj,
     if (ret != (int)oid_s_len)
         return TE_ENOBUFS;
 
-    for (i = 0; i < cfg_all_inst_size && cfg_all_inst[i] != NULL; i++);
-
-    if (i > CFG_HANDLE_MAX_INDEX)
+    ret = cfg_inst_get_free_index(&i);
+    if (ret != 0)
     {
-        ERROR("%s(): no more instance indexes is available",
-              __FUNCTION__);
         free(oid_s);
-        return TE_ETOOMANY;
-    }
-
-    if (i == cfg_all_inst_size)
-    {
-        void *tmp = realloc(cfg_all_inst,
-            sizeof(void *) * (cfg_all_inst_size + CFG_INST_NUM));
-
-        if (tmp == NULL)
-        {
-            free(oid_s);
-            return TE_ENOMEM;
-        }
-
-        memset(tmp + sizeof(void *) * cfg_all_inst_size, 0,
-             sizeof(void *) * CFG_INST_NUM);
-
-        cfg_all_inst = (cfg_instance **)tmp;
-        cfg_all_inst_size += CFG_INST_NUM;
+        return ret;
     }
 
     cfg_all_inst[i] = (cfg_instance *)calloc(sizeof(cfg_instance), 1);
@@ -1480,10 +1988,8 @@ cfg_add_with_obj_and_parent(cfg_instance *par_inst, cfg_object *obj,
     CFG_NEW_INST_HANDLE(cfg_all_inst[i]->handle, i);
     cfg_all_inst[i]->name[0] = '\0';
     cfg_all_inst[i]->obj = obj;
-    cfg_all_inst[i]->father = par_inst;
-    cfg_all_inst[i]->son = NULL;
-    cfg_all_inst[i]->brother = par_inst->son;
-    par_inst->son =  cfg_all_inst[i];
+    cfg_inst_link_son(par_inst, NULL, cfg_all_inst[i]);
+    cfg_snapshot_note_change(cfg_all_inst[i], false);
     *inst = cfg_all_inst[i];
 
     return 0;
@@ -1610,6 +2116,7 @@ cfg_db_add(const char *oid_s, cfg_handle *handle,
     cfg_instance   *prev;
     cfg_inst_subid *s;
     uint64_t        i = 0;
+    te_errno        rc;
 
     if (oid == NULL)
     {
@@ -1629,30 +2136,14 @@ cfg_db_add(const char *oid_s, cfg_handle *handle,
     s = (cfg_inst_subid *)(oid->ids);
 
     /* Look for the father first */
-    while (true)
-    {
-        for (;
-             father != NULL &&
-                 (strcmp(father->obj->subid, s->subid) != 0 ||
-                  strcmp(father->name, s->name) != 0 ||
-                  father->remove);
-             father = father->brother);
-
-        s++;
-
-        if (++i == oid->len - 1 || father == NULL)
-            break;
-
-        father = father->son;
-    }
+    for (i = 1, s++; i < (uint64_t)oid->len - 1 && father != NULL; i++, s++)
+        father = cfg_inst_find_son(father, s->subid, s->name);
 
     if (father == NULL)
         RET(TE_ENOENT);
 
     /* Find an object for the instance */
-    for (obj = father->obj->son;
-         obj != NULL && strcmp(obj->subid, s->subid) != 0;
-         obj = obj->brother);
+    obj = cfg_obj_find_son(father->obj, s->subid);
 
     if (obj == NULL)
         RET(TE_ENOENT);
@@ -1677,38 +2168,29 @@ cfg_db_add(const char *oid_s, cfg_handle *handle,
     }
 
     /* Try to find instance with the same name */
-    for (inst = father->son, prev = NULL;
-         inst != NULL && (strcmp(inst->oid, oid_s) < 0 || inst->remove);
-         prev = inst, inst = inst->brother);
-
-    if (inst != NULL && strcmp(inst->oid, oid_s) == 0)
+    if (cfg_inst_find_son(father, s->subid, s->name) != NULL)
         RET(TE_EEXIST);
 
-    /* Now look for empty slot in the object instances array */
-    for (i = 0; i < cfg_all_inst_size && cfg_all_inst[i] != NULL; i++);
-
-    if (i > CFG_HANDLE_MAX_INDEX)
+    /*
+     * Find the place to keep sons sorted by OID. New instances are
+     * usually added in order, so check the last son first.
+     */
+    if (father->last_son != NULL && strcmp(father->last_son->oid, oid_s) < 0)
     {
-        ERROR("%s(): no more instance indexes is available",
-              __FUNCTION__);
-        RET(TE_ETOOMANY);
+        prev = father->last_son;
     }
-
-    if (i == cfg_all_inst_size)
+    else
     {
-        void *tmp = realloc(cfg_all_inst,
-            sizeof(void *) * (cfg_all_inst_size + CFG_INST_NUM));
-
-        if (tmp == NULL)
-            RET(TE_ENOMEM);
-
-        memset(tmp + sizeof(void *) * cfg_all_inst_size, 0,
-               sizeof(void *) * CFG_INST_NUM);
-
-        cfg_all_inst = (cfg_instance **)tmp;
-        cfg_all_inst_size += CFG_INST_NUM;
+        for (inst = father->son, prev = NULL;
+             inst != NULL && (strcmp(inst->oid, oid_s) < 0 || inst->remove);
+             prev = inst, inst = inst->brother);
     }
 
+    /* Now look for empty slot in the object instances array */
+    rc = cfg_inst_get_free_index(&i);
+    if (rc != 0)
+        RET(rc);
+
     inst = cfg_all_inst[i] =
         (cfg_instance *)calloc(sizeof(cfg_instance), 1);
 
@@ -1752,19 +2234,8 @@ cfg_db_add(const char *oid_s, cfg_handle *handle,
     CFG_NEW_INST_HANDLE(inst->handle, i);
     strcpy(inst->name, s->name);
     inst->obj = obj;
-    inst->father = father;
-    inst->son = NULL;
-
-    if (prev)
-    {
-        inst->brother = prev->brother;
-        prev->brother = inst;
-    }
-    else
-    {
-        inst->brother = father->son;
-        father->son = inst;
-    }
+    cfg_inst_link_son(father, prev, inst);
+    cfg_snapshot_note_change(inst, false);
 
     *handle = inst->handle;
     if (cfg_all_inst_max < i)
@@ -1835,6 +2306,8 @@ delete_son(cfg_instance *father, cfg_instance *son)
     cfg_instance *next;
     cfg_instance *brother;
 
+    cfg_snapshot_note_change(son, true);
+
     for (tmp = son->son; tmp != NULL; tmp = next)
     {
         next = tmp->brother;
@@ -1844,6 +2317,7 @@ delete_son(cfg_instance *father, cfg_instance *son)
     if (father->son == son)
     {
         father->son = son->brother;
+        brother = NULL;
     }
     else
     {
@@ -1854,14 +2328,22 @@ delete_son(cfg_instance *father, cfg_instance *son)
         assert(brother != NULL);
         brother->brother = son->brother;
     }
+    if (father->last_son == son)
+        father->last_son = brother;
+    cfg_son_index_del(&father->son_index,
+                      cfg_inst_son_hash(son->obj->subid, son->name), son);
 
     /* Delete from the array of object instances */
     cfg_all_inst[CFG_INST_HANDLE_TO_INDEX(son->handle)] = NULL;
+    if (cfg_all_inst_free > CFG_INST_HANDLE_TO_INDEX(son->handle))
+        cfg_all_inst_free = CFG_INST_HANDLE_TO_INDEX(son->handle);
 
     /* Free memory allocated for the instance */
     if (son->obj->type != CVT_NONE)
         cfg_types[son->obj->type].free(son->val);
 
+    cfg_oid_cache_forget(son->oid);
+    cfg_son_index_free(&son->son_index);
     free(son->oid);
     free(son);
 }
@@ -1899,6 +2381,7 @@ cfg_db_set(cfg_handle handle, cfg_inst_val val)
         if (err)
             return err;
 
+        cfg_snapshot_note_change(inst, true);
         cfg_types[inst->obj->type].free(inst->val);
         inst->val = val0;
     }
@@ -1961,14 +2444,18 @@ cfg_db_find(const char *oid_s, cfg_handle *handle)
     cfg_oid *oid = NULL;
     int      i = 0;
 
+    if (cfg_oid_cache_lookup(oid_s, handle))
+        return 0;
+
     if ((oid = cfg_convert_oid_str(oid_s)) == NULL)
        return TE_EINVAL;
 
 #define RET(_handle) \
-    do {                   \
-        cfg_free_oid(oid); \
-        *handle = _handle; \
-        return 0;          \
+    do {                                                \
+        cfg_oid_cache_update(oid_s, _handle, oid->inst); \
+        cfg_free_oid(oid);                              \
+        *handle = _handle;                              \
+        return 0;                                       \
     } while (0)
 
 #define RETERR(_rc) \
@@ -1983,33 +2470,26 @@ cfg_db_find(const char *oid_s, cfg_handle *handle)
         cfg_instance *last_subinst = NULL;
         bool not_added_ancestor = false;
 
-        while (true)
+        /*
+         * Instance which is scheduled for removal after commit
+         * is skipped here. It does not make sense to perform
+         * some operations on a deleted instance.
+         */
+        for (i = 1; i < oid->len; i++)
         {
-            /*
-             * Instance which is scheduled for removal after commit
-             * is skipped here. It does not make sense to perform
-             * some operations on a deleted instance.
-             */
-            for (;
-                 tmp != NULL &&
-                 (!(strcmp(tmp->obj->subid,
-                           ((cfg_inst_subid *)(oid->ids))[i].subid) == 0 &&
-                    strcmp(tmp->name,
-                           ((cfg_inst_subid *)(oid->ids))[i].name) == 0)
-                  || tmp->remove);
-                 tmp = tmp->brother);
-
-            if (++i == oid->len || tmp == NULL)
-            {
-                break;
-            }
-
             if (tmp->obj->access == CFG_READ_CREATE && !tmp->added)
                 not_added_ancestor = true;
 
             last_subinst = tmp;
 
-            tmp = tmp->son;
+            tmp = cfg_inst_find_son(tmp,
+                                 ((cfg_inst_subid *)(oid->ids))[i].subid,
+                                 ((cfg_inst_subid *)(oid->ids))[i].name);
+            if (tmp == NULL)
+            {
+                i++;
+                break;
+            }
         }
         if (tmp == NULL)
         {
@@ -2065,18 +2545,11 @@ cfg_db_find(const char *oid_s, cfg_handle *handle)
     else
     {
         cfg_object *tmp = &cfg_obj_root;
-        while (true)
-        {
-           for (;
-                tmp != NULL &&
-                strcmp(tmp->subid,
-                       ((cfg_object_subid *)(oid->ids))[i].subid) != 0;
-                tmp = tmp->brother);
-
-           if (++i == oid->len || tmp == NULL)
-               break;
 
-           tmp = tmp->son;
+        for (i = 1; i < oid->len && tmp != NULL; i++)
+        {
+            tmp = cfg_obj_find_son(tmp,
+                                   ((cfg_object_subid *)(oid->ids))[i].subid);
         }
         if (tmp == NULL)
             RETERR(TE_ENOENT);
@@ -2113,19 +2586,8 @@ cfg_get_object(const char *oid_s)
 
     s = (cfg_inst_subid *)(oid->ids);
 
-    while (true)
-    {
-       for (;
-            tmp != NULL &&
-            strcmp(tmp->subid, s->subid) != 0;
-            tmp = tmp->brother);
-
-       if (++i == oid->len || tmp == NULL)
-           break;
-
-       tmp = tmp->son;
-       s++;
-    }
+    for (i = 1; i < oid->len && tmp != NULL; i++)
+        tmp = cfg_obj_find_son(tmp, s[i].subid);
 
     cfg_free_oid(oid);
 
@@ -2158,16 +2620,8 @@ cfg_get_obj_by_obj_id_str(const char *obj_id_str)
 
     ids = (cfg_object_subid *)(idsplit->ids);
 
-    for (i = 0;;)
-    {
-        while (obj != NULL && strcmp(obj->subid, ids->subid) != 0)
-            obj = obj->brother;
-        if (++i == idsplit->len || obj == NULL)
-            break;
-
-        obj = obj->son;
-        ids++;
-    }
+    for (i = 1; i < idsplit->len && obj != NULL; i++)
+        obj = cfg_obj_find_son(obj, ids[i].subid);
 
     cfg_free_oid(idsplit);
     return obj;
@@ -2199,27 +2653,13 @@ cfg_get_ins_by_ins_id_str(const char *ins_id_str)
 
     ids = (cfg_inst_subid *)(idsplit->ids);
 
-    for (i = 0;;)
-    {
-        /*
-         * Instance which is scheduled for removal after commit
-         * is skipped here. It does not make sense to perform
-         * some operations on a deleted instance.
-         */
-        while (ins != NULL &&
-               (strcmp(ins->obj->subid, ids->subid) != 0 ||
-                strcmp(ins->name, ids->name ) != 0 ||
-                ins->remove))
-        {
-            ins = ins->brother;
-        }
-
-        if (++i == idsplit->len || ins == NULL)
-            break;
-
-        ins = ins->son;
-        ids++;
-    }
+    /*
+     * Instance which is scheduled for removal after commit
+     * is skipped here. It does not make sense to perform
+     * some operations on a deleted instance.
+     */
+    for (i = 1; i < idsplit->len && ins != NULL; i++)
+        ins = cfg_inst_find_son(ins, ids[i].subid, ids[i].name);
 
     cfg_free_oid(idsplit);
     return ins;
@@ -49,6 +49,21 @@ typedef struct cfg_dependency {
     struct cfg_dependency *next;
 } cfg_dependency;
 
+/**
+ * Hash index of sons of a configuration tree node.
+ *
+ * It is built lazily when a node gets many sons and then maintained
+ * on every link/unlink of a son, so that lookup of a son by its
+ * sub-identifier (and name) does not require walking the whole list
+ * of brothers.
+ */
+typedef struct cfg_son_index {
+    unsigned int             size;  /**< Number of slots (power of 2)
+                                         or @c 0 if not built */
+    unsigned int             used;  /**< Number of occupied slots */
+    struct cfg_son_index_slot *slots; /**< Open addressing table */
+} cfg_son_index;
+
 /* Configurator object */
 typedef struct cfg_object {
     cfg_handle         handle;  /**< Handle of the object */
@@ -88,6 +103,7 @@ typedef struct cfg_object {
     bool unit_part; /**< @c true means the object is a descendant of an
                             object having unit=true */
 
+    cfg_son_index son_index; /**< Index of sons by sub-identifier */
 } cfg_object;
 
 #define CFG_DEP_INITIALIZER  0, NULL, NULL, NULL, NULL
@@ -135,6 +151,11 @@ typedef struct cfg_instance {
                                          be restored from backup */
 
     union  cfg_inst_val  val;
+
+    cfg_son_index        son_index; /**< Index of sons by sub-identifier
+                                         and name */
+    struct cfg_instance *last_son;  /**< Link to the last son or @c NULL
+                                         if it is not known */
 } cfg_instance;
 
 extern cfg_instance cfg_inst_root;
@@ -318,6 +339,18 @@ extern int cfg_db_set(cfg_handle handle, cfg_inst_val val);
  */
 extern int cfg_db_get(cfg_handle handle, cfg_inst_val *val);
 
+/**
+ * Link a new son instance to its father keeping the son index of
+ * the father up to date.
+ *
+ * @param father    Father instance
+ * @param prev      Brother to insert the son after or @c NULL to
+ *                  insert it as the first son
+ * @param son       Son instance with object and name filled in
+ */
+extern void cfg_inst_link_son(cfg_instance *father, cfg_instance *prev,
+                              cfg_instance *son);
+
 /**
  * Find instance in the database.
  *
@@ -370,6 +403,23 @@ extern bool cfg_oid_match_volatile(const char *oid_s, char **oid_out);
 /** Delay for configuration changes accommodation */
 extern uint32_t cfg_conf_delay;
 
+/**
+ * Generation of the database. It is changed before processing of
+ * every request which may modify the database and is sent in replies,
+ * so that clients may cache replies while it is not changed.
+ */
+extern uint32_t cfg_db_gen;
+
+/**
+ * Change the database generation and publish it for clients.
+ */
+extern void cfg_db_gen_bump(void);
+
+/**
+ * Stop publishing the database generation.
+ */
+extern void cfg_db_gen_release(void);
+
 /**
  * Update the current configuration delay after adding/deleting/changing
  * an instance.
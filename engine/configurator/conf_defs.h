@@ -55,6 +55,7 @@
 #include "conf_types.h"
 #include "conf_db.h"
 #include "conf_dh.h"
+#include "conf_snapshot.h"
 #include "conf_backup.h"
 #include "conf_ta.h"
 
@@ -34,12 +34,17 @@ typedef struct cfg_dh_entry {
     int                  seq;     /**< Sequence number for debugging */
     bool committed; /**< Whether the command kept in this
                                          entry is committed or not */
+    bool                 unit;    /**< Whether the command belongs to
+                                       the unit being recorded */
 } cfg_dh_entry;
 
 static cfg_dh_entry *first = NULL;
 static cfg_dh_entry *last = NULL;
 static cfg_backup   *begin_backup = NULL;
 
+/** Whether a unit of commands is being recorded */
+static bool unit_started = false;
+
 /** Release memory allocated for backup list */
 static inline void
 free_entry_backup(cfg_dh_entry *entry)
@@ -1163,76 +1168,28 @@ has_backup(cfg_dh_entry *entry, char *filename)
 }
 
 /**
- * Restore backup with specified name using reversed command
- * of the dynamic history. Processed commands are removed
- * from the history.
+ * Reverse commands of the dynamic history from the last one up to
+ * the specified one. Processed commands are removed from the history.
  *
- * @param filename      name of the backup file
+ * @param limit         the first command which is not reversed or
+ *                      @c NULL to reverse all commands
  * @param hard_check    whether hard check should be applied
- *                      on restore backup. For instance if on deleting
- *                      some instance we got ESRCH or ENOENT, we should
- *                      keep processing without any error.
- * @param shutdown      if @c true - the configurator shuts down.
- *                      Do no stop restoring backup when error @c ENOENT
- *                      occurs (for example for @c CFG_SET command).
+ *                      (see cfg_dh_restore_backup())
+ * @param shutdown      if @c true - the configurator shuts down
+ * @param unreg_obj_LL  log level of object unregistration failures
  *
  * @return status code (see te_errno.h)
- * @retval TE_ENOENT       there is not command in dynamic history to which
- *                      the specified backup is attached
  */
 static int
-cfg_dh_restore_backup_ext(char *filename, bool hard_check, bool shutdown)
+cfg_dh_reverse(cfg_dh_entry *limit, bool hard_check, bool shutdown,
+               int unreg_obj_LL)
 {
-    cfg_dh_entry *limit = NULL;
     cfg_dh_entry *tmp;
-    cfg_backup   *tmp_bkp;
     cfg_dh_entry *prev;
     char         *id;
 
     int rc;
     int result = 0;
-    int unreg_obj_LL;
-
-    cfg_dh_optimize();
-
-    /* At first, look for an instance with the backup */
-    if (filename != NULL)
-    {
-        for (limit = first; limit != NULL; limit = limit->next)
-        {
-            if (limit->backup != NULL && has_backup(limit, filename))
-                break;
-        }
-
-        if (limit == NULL)
-        {
-            for (tmp_bkp = begin_backup; tmp_bkp != NULL; tmp_bkp = tmp_bkp->next)
-            {
-                if (strcmp(tmp_bkp->filename, filename) == 0)
-                    break;
-            }
-        }
-
-        if (limit == NULL && tmp_bkp == NULL)
-        {
-            ERROR("Position of the backup in dynamic history is not found");
-            return TE_ENOENT;
-        }
-    }
-
-    if (filename != NULL)
-    {
-        if (limit != NULL)
-            VERB("Restore backup %s up to command %d", filename, limit->seq);
-        else
-            VERB("Restore backup %s up to beginning", filename);
-    }
-
-    /* If reversing the start up history, sweep warnings under the rug: */
-    if (filename == NULL)
-        unreg_obj_LL = TE_LL_VERB;
-    else
-        unreg_obj_LL = TE_LL_WARN;
 
     for (tmp = last; tmp != limit; tmp = prev)
     {
@@ -1429,6 +1386,76 @@ cfg_dh_restore_backup_ext(char *filename, bool hard_check, bool shutdown)
     return result;
 }
 
+/**
+ * Restore backup with specified name using reversed command
+ * of the dynamic history. Processed commands are removed
+ * from the history.
+ *
+ * @param filename      name of the backup file
+ * @param hard_check    whether hard check should be applied
+ *                      on restore backup. For instance if on deleting
+ *                      some instance we got ESRCH or ENOENT, we should
+ *                      keep processing without any error.
+ * @param shutdown      if @c true - the configurator shuts down.
+ *                      Do no stop restoring backup when error @c ENOENT
+ *                      occurs (for example for @c CFG_SET command).
+ *
+ * @return status code (see te_errno.h)
+ * @retval TE_ENOENT       there is not command in dynamic history to which
+ *                      the specified backup is attached
+ */
+static int
+cfg_dh_restore_backup_ext(char *filename, bool hard_check, bool shutdown)
+{
+    cfg_dh_entry *limit = NULL;
+    cfg_backup   *tmp_bkp;
+
+    int unreg_obj_LL;
+
+    cfg_dh_optimize();
+
+    /* At first, look for an instance with the backup */
+    if (filename != NULL)
+    {
+        for (limit = first; limit != NULL; limit = limit->next)
+        {
+            if (limit->backup != NULL && has_backup(limit, filename))
+                break;
+        }
+
+        if (limit == NULL)
+        {
+            for (tmp_bkp = begin_backup; tmp_bkp != NULL; tmp_bkp = tmp_bkp->next)
+            {
+                if (strcmp(tmp_bkp->filename, filename) == 0)
+                    break;
+            }
+        }
+
+        if (limit == NULL && tmp_bkp == NULL)
+        {
+            ERROR("Position of the backup in dynamic history is not found");
+            return TE_ENOENT;
+        }
+    }
+
+    if (filename != NULL)
+    {
+        if (limit != NULL)
+            VERB("Restore backup %s up to command %d", filename, limit->seq);
+        else
+            VERB("Restore backup %s up to beginning", filename);
+    }
+
+    /* If reversing the start up history, sweep warnings under the rug: */
+    if (filename == NULL)
+        unreg_obj_LL = TE_LL_VERB;
+    else
+        unreg_obj_LL = TE_LL_WARN;
+
+    return cfg_dh_reverse(limit, hard_check, shutdown, unreg_obj_LL);
+}
+
 /* See description in conf_dh.h */
 int
 cfg_dh_restore_backup(char *filename, bool hard_check)
@@ -1467,6 +1494,7 @@ cfg_dh_push_command(cfg_msg *msg, bool local, const cfg_inst_val *old_val)
 
     /* Local commands are not comitted yet, and vice versa */
     entry->committed = !local;
+    entry->unit = unit_started;
 
     memcpy(entry->cmd, msg, msg->len);
     if (msg->type == CFG_ADD)
@@ -1541,6 +1569,33 @@ cfg_dh_push_command(cfg_msg *msg, bool local, const cfg_inst_val *old_val)
 #undef RETERR
 }
 
+/* See description in conf_dh.h */
+void
+cfg_dh_unit_start(void)
+{
+    unit_started = true;
+}
+
+/* See description in conf_dh.h */
+int
+cfg_dh_unit_end(bool rollback)
+{
+    cfg_dh_entry *limit;
+
+    unit_started = false;
+
+    for (limit = last; limit != NULL && limit->unit; limit = limit->prev)
+        limit->unit = false;
+
+    if (!rollback || limit == last)
+        return 0;
+
+    VERB("Roll back unit of commands after command %d",
+         limit == NULL ? 0 : limit->seq);
+
+    return cfg_dh_reverse(limit, false, false, TE_LL_WARN);
+}
+
 /**
  * Delete last command from the history.
  */
@@ -1754,11 +1809,12 @@ int
 cfg_dh_release_backup(char *filename)
 {
     cfg_dh_entry *tmp;
+    cfg_backup   *cur, *prev;
+
+    cfg_snapshot_release(filename);
 
     for (tmp = first; tmp != NULL; tmp = tmp->next)
     {
-        cfg_backup *cur, *prev;
-
         for (cur = tmp->backup, prev = NULL;
              cur != NULL && strcmp(cur->filename, filename) != 0;
              prev = cur, cur = cur->next);
@@ -1777,6 +1833,21 @@ cfg_dh_release_backup(char *filename)
         return 0;
     }
 
+    for (cur = begin_backup, prev = NULL;
+         cur != NULL && strcmp(cur->filename, filename) != 0;
+         prev = cur, cur = cur->next);
+
+    if (cur != NULL)
+    {
+        if (prev)
+            prev->next = cur->next;
+        else
+            begin_backup = cur->next;
+
+        free(cur->filename);
+        free(cur);
+    }
+
     return 0;
 }
 
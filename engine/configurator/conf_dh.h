@@ -99,6 +99,22 @@ extern int cfg_dh_push_command(cfg_msg *msg, bool local,
  */
 extern int cfg_dh_apply_commit(const char *oid);
 
+/**
+ * Start recording a unit of commands: commands pushed to the history
+ * until cfg_dh_unit_end() is called may be rolled back together.
+ */
+extern void cfg_dh_unit_start(void);
+
+/**
+ * Stop recording a unit of commands.
+ *
+ * @param rollback      if @c true, reverse commands of the unit and
+ *                      remove them from the history
+ *
+ * @return status code (see te_errno.h)
+ */
+extern int cfg_dh_unit_end(bool rollback);
+
 /**
  * Delete last command from the history.
  */
@@ -70,6 +70,7 @@ static char **cs_includes = NULL;
                                      failed */
 #define CS_FOREGROUND   0x4     /**< Run Configurator in foreground */
 #define CS_SHUTDOWN     0x8     /**< Shutdown after message processing */
+#define CS_XML_BACKUPS  0x10    /**< Write backup files on creation */
 /*@}*/
 
 /** Configurator global flags */
@@ -83,6 +84,9 @@ static te_errno process_backup_op(const char *name, uint8_t op);
 static te_errno release_backup(const char *name);
 static te_errno restore_backup(const char *name);
 static te_errno parse_config(const char *fname, te_kvpair_h *expand_vars);
+static te_errno filter_backup_by_subtrees(const char *current_backup,
+                                          const te_vec *subtrees,
+                                          te_string *target_backup);
 
 /**
  Put environment variables in list for expansion in file
@@ -1538,6 +1542,306 @@ process_del(cfg_del_msg *msg, bool update_dh)
         cfg_db_del(handle);
 }
 
+/**
+ * Get the name of Test Agent an operation of a batch is applied to.
+ *
+ * @param op            operation record
+ * @param ta            location for Test Agent name
+ * @param ta_size       size of @p ta
+ *
+ * @return @c true if the instance is in agent subtree.
+ */
+static bool
+batch_op_ta(const cfg_batch_op *op, char *ta, size_t ta_size)
+{
+    cfg_msg      *sub = CFG_BATCH_OP_MSG(op);
+    const char   *oid = CFG_BATCH_OP_OID(op);
+    cfg_instance *inst;
+    size_t        len;
+
+    if (sub->type == CFG_ADD)
+    {
+        oid = (const char *)sub + ((cfg_add_msg *)sub)->oid_offset;
+    }
+    else if (*oid == '\0')
+    {
+        cfg_handle handle = sub->type == CFG_SET ?
+                            ((cfg_set_msg *)sub)->handle :
+                            ((cfg_del_msg *)sub)->handle;
+
+        inst = CFG_GET_INST(handle);
+        if (inst == NULL)
+            return false;
+        oid = inst->oid;
+    }
+
+    if (strcmp_start(CFG_TA_PREFIX, oid) != 0)
+        return false;
+
+    oid += strlen(CFG_TA_PREFIX);
+    len = strcspn(oid, "/");
+    if (len == 0 || len >= ta_size)
+        return false;
+
+    memcpy(ta, oid, len);
+    ta[len] = '\0';
+
+    return true;
+}
+
+/**
+ * Check that operations of a batch are well-formed.
+ *
+ * @param msg           message pointer
+ *
+ * @return Status code.
+ */
+static te_errno
+batch_check(const cfg_batch_msg *msg)
+{
+    const cfg_batch_op *op;
+    const cfg_msg      *sub;
+    size_t              off = sizeof(*msg);
+    size_t              min_len;
+    uint32_t            i;
+    bool                local;
+
+    if (msg->len < sizeof(*msg))
+        return TE_EINVAL;
+
+    for (i = 0; i < msg->n_ops; i++, off += op->len)
+    {
+        op = (const cfg_batch_op *)((const uint8_t *)msg + off);
+        if (off + sizeof(*op) > msg->len ||
+            op->len < sizeof(*op) + sizeof(cfg_msg) ||
+            op->len % CFG_BATCH_ALIGN != 0 || op->len > msg->len - off)
+            return TE_EINVAL;
+
+        sub = CFG_BATCH_OP_MSG(op);
+        switch (sub->type)
+        {
+            case CFG_ADD:
+                min_len = sizeof(cfg_add_msg);
+                local = ((const cfg_add_msg *)sub)->local;
+                break;
+
+            case CFG_SET:
+                min_len = sizeof(cfg_set_msg);
+                local = ((const cfg_set_msg *)sub)->local;
+                break;
+
+            case CFG_DEL:
+                min_len = sizeof(cfg_del_msg);
+                local = ((const cfg_del_msg *)sub)->local;
+                break;
+
+            default:
+                return TE_EINVAL;
+        }
+
+        /* Local changes are committed by user, not by the batch */
+        if (local || sub->len < min_len || sub->len > CFG_BUF_LEN ||
+            sub->len > op->len - sizeof(*op) ||
+            op->oid_offset < sizeof(*op) + sub->len ||
+            op->oid_offset >= op->len ||
+            memchr((const char *)op + op->oid_offset, '\0',
+                   op->len - op->oid_offset) == NULL)
+            return TE_EINVAL;
+    }
+
+    return 0;
+}
+
+/**
+ * Process batch of add, set and delete user requests.
+ *
+ * Operations are applied in order with configuration groups started
+ * on all Test Agents they touch, so Test Agents commit changes once
+ * at the end of the batch. Synchronization of touched instances is
+ * postponed until the groups are ended. Operations are recorded in
+ * dynamic history as one unit, so if an operation fails, all the batch
+ * is rolled back before the commit. If a commit or a synchronization
+ * fails, the database is synchronized with Test Agents and the unit is
+ * rolled back after the groups are ended. Operations following
+ * the failed one are not processed and get @c TE_ECANCELED status.
+ *
+ * @param msg           message pointer
+ * @param update_dh     if true, add the commands to dynamic history
+ */
+static void
+process_batch(cfg_batch_msg *msg, bool update_dh)
+{
+    te_vec        tas = TE_VEC_INIT_AUTOPTR(char *);
+    char          ta[RCF_MAX_NAME];
+    int          *op_ta = NULL;
+    cfg_msg      *sub_msg = NULL;
+    cfg_batch_op *op;
+    cfg_msg      *sub;
+    cfg_handle    handle;
+    char        **name;
+    uint32_t      i;
+    bool          failed = false;
+    te_errno      rc;
+
+    msg->rc = batch_check(msg);
+    if (msg->rc != 0)
+    {
+        ERROR("Malformed batch of configuration changes");
+        return;
+    }
+
+    if (msg->n_ops == 0)
+        return;
+
+    op_ta = TE_ALLOC(msg->n_ops * sizeof(*op_ta));
+    sub_msg = TE_ALLOC(sizeof(cfg_add_msg) + CFG_MAX_INST_VALUE +
+                       CFG_BUF_LEN);
+
+    for (i = 0, op = (cfg_batch_op *)msg->ops; i < msg->n_ops;
+         i++, op = (cfg_batch_op *)((uint8_t *)op + op->len))
+    {
+        op_ta[i] = -1;
+        if (!batch_op_ta(op, ta, sizeof(ta)))
+            continue;
+
+        TE_VEC_FOREACH(&tas, name)
+        {
+            if (strcmp(*name, ta) == 0)
+            {
+                op_ta[i] = te_vec_get_index(&tas, name);
+                break;
+            }
+        }
+        if (op_ta[i] >= 0)
+            continue;
+
+        rc = cfg_ta_batch_start(ta);
+        if (rc == 0)
+            rc = te_vec_append_str_fmt(&tas, "%s", ta);
+        if (rc != 0)
+        {
+            /* Operations on the agent are likely to fail as well */
+            WARN("Failed to start configuration group on TA '%s': %r",
+                 ta, rc);
+            continue;
+        }
+        op_ta[i] = te_vec_size(&tas) - 1;
+    }
+
+    if (update_dh)
+        cfg_dh_unit_start();
+
+    for (i = 0, op = (cfg_batch_op *)msg->ops; i < msg->n_ops;
+         i++, op = (cfg_batch_op *)((uint8_t *)op + op->len))
+    {
+        sub = CFG_BATCH_OP_MSG(op);
+        if (failed)
+        {
+            sub->rc = TE_RC(TE_CS, TE_ECANCELED);
+            continue;
+        }
+
+        memcpy(sub_msg, sub, sub->len);
+        sub_msg->rc = 0;
+
+        if (sub->type != CFG_ADD && *CFG_BATCH_OP_OID(op) != '\0')
+        {
+            rc = cfg_db_find(CFG_BATCH_OP_OID(op), &handle);
+            if (rc != 0)
+            {
+                sub->rc = TE_RC(TE_CS, rc);
+                msg->rc = sub->rc;
+                failed = true;
+                continue;
+            }
+
+            if (sub->type == CFG_SET)
+                ((cfg_set_msg *)sub_msg)->handle = handle;
+            else
+                ((cfg_del_msg *)sub_msg)->handle = handle;
+        }
+
+        cfg_process_msg(&sub_msg, update_dh);
+
+        sub->rc = sub_msg->rc;
+        if (sub->type == CFG_ADD)
+            ((cfg_add_msg *)sub)->handle = ((cfg_add_msg *)sub_msg)->handle;
+
+        if (sub->rc != 0)
+        {
+            msg->rc = sub->rc;
+            failed = true;
+        }
+    }
+
+    /* Reverse applied operations before the commit */
+    if (failed && update_dh)
+    {
+        rc = cfg_dh_unit_end(true);
+        if (rc != 0)
+            ERROR("Failed to roll back batch of configuration changes: %r",
+                  rc);
+    }
+
+    TE_VEC_FOREACH(&tas, name)
+    {
+        rc = cfg_ta_batch_end(*name);
+        if (rc == 0 || failed)
+        {
+            if (rc != 0)
+                ERROR("Failed to commit rollback on TA '%s': %r",
+                      *name, rc);
+            continue;
+        }
+
+        ERROR("Failed to commit batch of configuration changes on "
+              "TA '%s': %r", *name, rc);
+        msg->rc = TE_RC(TE_CS, rc);
+
+        /* Report commit status for operations on the agent */
+        for (i = 0, op = (cfg_batch_op *)msg->ops; i < msg->n_ops;
+             i++, op = (cfg_batch_op *)((uint8_t *)op + op->len))
+        {
+            sub = CFG_BATCH_OP_MSG(op);
+            if (op_ta[i] == (int)te_vec_get_index(&tas, name))
+                sub->rc = msg->rc;
+            else if (sub->rc == 0)
+                sub->rc = TE_RC(TE_CS, TE_ECANCELED);
+        }
+    }
+
+    /* Changes are committed now, so the database may be synchronized */
+    rc = cfg_ta_batch_sync();
+    if (rc != 0 && !failed && msg->rc == 0)
+    {
+        msg->rc = TE_RC(TE_CS, rc);
+        for (i = 0, op = (cfg_batch_op *)msg->ops; i < msg->n_ops;
+             i++, op = (cfg_batch_op *)((uint8_t *)op + op->len))
+        {
+            sub = CFG_BATCH_OP_MSG(op);
+            if (op_ta[i] >= 0)
+                sub->rc = msg->rc;
+        }
+    }
+
+    /*
+     * If a commit or a synchronization failed, the database reflects
+     * the state of Test Agents now, reverse the operations which were
+     * committed partially.
+     */
+    if (!failed && update_dh)
+    {
+        rc = cfg_dh_unit_end(msg->rc != 0);
+        if (rc != 0)
+            ERROR("Failed to roll back batch of configuration changes: %r",
+                  rc);
+    }
+
+    te_vec_free(&tas);
+    free(sub_msg);
+    free(op_ta);
+}
+
 /**
  * Process get user request.
  *
@@ -1934,16 +2238,59 @@ log_msg(cfg_msg *msg, bool before)
             cfg_db_tree_print_msg_log((cfg_tree_print_msg *)msg, level);
             break;
 
+        case CFG_BATCH:
+            LOG_MSG(level, "Batch of %u configuration changes%s",
+                    ((cfg_batch_msg *)msg)->n_ops, addon);
+            break;
+
         default:
             ERROR("Unknown command %x", msg->type);
     }
 #undef GET_STRS
 }
 
+/**
+ * Check if the current DB changes from the backup snapshot.
+ *
+ * @param backup        backup filename
+ * @param log           if @c true, log changes
+ * @param msg           if not NULL, log failure with specified message
+ * @param subtrees      Subtree to verification. @c NULL to verify all trees
+ *
+ * @return 0 if DB state does not differ from backup;
+ *         @c TE_ENOENT if there is no usable snapshot;
+ *         status code otherwise
+ */
+static te_errno
+verify_snapshot(const char *backup, bool log, const char *msg,
+                const te_vec *subtrees)
+{
+    te_string diff = TE_STRING_INIT;
+    te_errno  rc;
+
+    rc = cfg_snapshot_verify(backup, subtrees, &diff);
+    if (rc == TE_EBACKUP)
+    {
+        if (msg != NULL)
+            WARN("%s\n%s", msg, diff.ptr);
+        else if (log)
+        {
+            if (cs_flags & CS_LOG_DIFF)
+                TE_LOG(TE_LL_INFO, TE_LGR_ENTITY, TE_LGR_USER,
+                       "Backup diff:\n%s", diff.ptr);
+            else
+                INFO("Backup diff:\n%s", diff.ptr);
+        }
+    }
+    te_string_free(&diff);
+
+    return rc;
+}
+
 /**
  * Check if the current DB changes from the backup.
  *
- * @param filename      backup filename
+ * @param backup        backup filename
  * @param log           if @c true, log changes
  * @param error_msg     if not NULL, log failure with specified message
  * @param subtrees       Subtree to verification. @c NULL to verify all trees
@@ -1954,15 +2301,36 @@ static inline te_errno
 verify_backup(const char *backup, bool log, const char *msg,
               const te_vec *subtrees)
 {
-    char diff_file[RCF_MAX_PATH];
-    int  rc;
+    te_string filtered = TE_STRING_INIT;
+    char      diff_file[RCF_MAX_PATH];
+    int       rc;
+
+    rc = verify_snapshot(backup, log, msg, subtrees);
+    if (rc != TE_ENOENT)
+        return rc;
+
+    /*
+     * If subtrees is NULL @p filtered string will contain
+     * filename specified by the user
+     */
+    rc = filter_backup_by_subtrees(backup, subtrees, &filtered);
+    if (rc != 0)
+    {
+        ERROR("Backup verification failed: %r", rc);
+        te_string_free(&filtered);
+        return rc;
+    }
 
     if ((rc = cfg_backup_create_file(filename, subtrees)) != 0)
+    {
+        te_string_free(&filtered);
         return rc;
+    }
 
     TE_SPRINTF(diff_file, "%s/te_cs.diff", getenv("TE_TMP"));
-    sprintf(tmp_buf, "diff -u %s %s >%s 2>&1", backup,
+    sprintf(tmp_buf, "diff -u %s %s >%s 2>&1", filtered.ptr,
             filename, diff_file);
+    te_string_free(&filtered);
 
     rc = ((system(tmp_buf) == 0) ? 0 : TE_EBACKUP);
     if (rc != 0)
@@ -2075,6 +2443,11 @@ filter_backup_by_subtrees(const char *current_backup, const te_vec *subtrees,
     te_string filter_filename = TE_STRING_INIT;
     te_errno rc;
 
+    /* The backup file of a snapshot is written on demand */
+    rc = cfg_snapshot_export(current_backup);
+    if (rc != 0)
+        return rc;
+
     if (subtrees == NULL || te_vec_size(subtrees) == 0)
     {
         te_string_append(target_backup, "%s", current_backup);
@@ -2291,14 +2664,28 @@ process_backup(cfg_backup_msg *msg, bool release_dh)
             sprintf(backup_filename, CONF_BACKUP_NAME,
                     tmp_dir, getpid(), get_time_ms());
 
-            if ((msg->rc = cfg_backup_create_file(backup_filename,
-                                                  &subtrees_vec)) != 0)
+            /*
+             * The backup is kept in memory, the file is written only
+             * if it is required (e.g. to restore configuration from it).
+             */
+            if ((msg->rc = cfg_snapshot_create(backup_filename,
+                                               &subtrees_vec)) != 0)
             {
-                break;;
+                break;
+            }
+
+            if ((cs_flags & CS_XML_BACKUPS) &&
+                (msg->rc = cfg_snapshot_export(backup_filename)) != 0)
+            {
+                cfg_snapshot_release(backup_filename);
+                break;
             }
 
             if ((msg->rc = cfg_dh_attach_backup(backup_filename)) != 0)
+            {
+                cfg_snapshot_release(backup_filename);
                 unlink(backup_filename);
+            }
 
             msg->len += strlen(backup_filename) + 1;
 
@@ -2373,42 +2760,26 @@ process_backup(cfg_backup_msg *msg, bool release_dh)
         case CFG_BACKUP_VERIFY:
         {
             te_errno rc;
-            te_string backup = TE_STRING_INIT;
-
-            /*
-             * If subtrees is NULL @p backup string will contain
-             * filename specified by the user
-             */
-            rc = filter_backup_by_subtrees(backup_filename, &subtrees_vec,
-                                           &backup);
-            if (rc != 0)
-            {
-                ERROR("Backup verification failed: %r", rc);
-                msg->rc = rc;
-                te_string_free(&backup);
-                break;
-            }
 
             rc = check_agents();
             if (rc != 0){
                 ERROR("Backup verification failed: %r", rc);
                 msg->rc = rc;
-                te_string_free(&backup);
                 break;
             }
 
-            msg->rc = verify_backup(backup.ptr, true, NULL, &subtrees_vec);
+            msg->rc = verify_backup(backup_filename, true, NULL,
+                                    &subtrees_vec);
             if (msg->rc != 0)
             {
                 cfg_ta_sync("/:", true);
-                msg->rc = verify_backup(backup.ptr, true, NULL, &subtrees_vec);
+                msg->rc = verify_backup(backup_filename, true, NULL,
+                                        &subtrees_vec);
             }
 
             if (msg->rc == 0 && release_dh)
                 cfg_dh_release_after(backup_filename);
 
-            te_string_free(&backup);
-
             break;
         }
 
@@ -2612,6 +2983,73 @@ process_register(cfg_register_msg *msg, bool update_dh)
     }
 }
 
+/**
+ * Check whether a request does not modify the database by itself.
+ * Synchronization with Test Agents done while processing such
+ * requests changes the database generation in cfg_ta_sync().
+ *
+ * @param msg           message with user request
+ *
+ * @return @c true if the request does not modify the database.
+ */
+static bool
+cfg_msg_read_only(const cfg_msg *msg)
+{
+    switch (msg->type)
+    {
+        case CFG_FIND:
+        case CFG_GET_DESCR:
+        case CFG_GET_OID:
+        case CFG_GET_ID:
+        case CFG_PATTERN:
+        case CFG_FAMILY:
+        case CFG_GET:
+        case CFG_CONF_DELAY:
+        case CFG_TREE_PRINT:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * Check whether a reply to a request may be cached by the client
+ * while the database generation is not changed.
+ *
+ * @param msg           message with user request
+ *
+ * @return @c true if the reply may be cached.
+ */
+static bool
+cfg_msg_cacheable(const cfg_msg *msg)
+{
+    const cfg_get_msg *get_msg;
+    cfg_instance      *inst;
+
+    switch (msg->type)
+    {
+        case CFG_FIND:
+            /* Volatile subtrees are synchronized on every lookup */
+            return !cfg_oid_match_volatile(((const cfg_find_msg *)msg)->oid,
+                                           NULL);
+
+        case CFG_GET_DESCR:
+        case CFG_GET_OID:
+        case CFG_GET_ID:
+        case CFG_FAMILY:
+            return true;
+
+        case CFG_GET:
+            get_msg = (const cfg_get_msg *)msg;
+            inst = CFG_GET_INST(get_msg->handle);
+            return !get_msg->sync && inst != NULL && !inst->obj->vol;
+
+        default:
+            return false;
+    }
+}
+
 /**
  * Process message with user request.
  *
@@ -2622,8 +3060,14 @@ process_register(cfg_register_msg *msg, bool update_dh)
 void
 cfg_process_msg(cfg_msg **msg, bool update_dh)
 {
+    bool cacheable;
+
     log_msg(*msg, true);
 
+    if (!cfg_msg_read_only(*msg))
+        cfg_db_gen_bump();
+    cacheable = cfg_msg_cacheable(*msg);
+
     switch ((*msg)->type)
     {
         case CFG_REGISTER:
@@ -2689,6 +3133,10 @@ cfg_process_msg(cfg_msg **msg, bool update_dh)
             process_set((cfg_set_msg *)(*msg), update_dh);
             break;
 
+        case CFG_BATCH:
+            process_batch((cfg_batch_msg *)(*msg), update_dh);
+            break;
+
         case CFG_COMMIT:
             (*msg)->rc = cfg_tas_commit(((cfg_commit_msg *)(*msg))->oid);
             break;
@@ -2786,6 +3234,7 @@ cfg_process_msg(cfg_msg **msg, bool update_dh)
     }
 
     (*msg)->rc = TE_RC(TE_CS, (*msg)->rc);
+    (*msg)->gen = cacheable ? cfg_db_gen : CFG_GEN_NONE;
 
     log_msg(*msg, false);
 }
@@ -2796,10 +3245,14 @@ cfg_process_msg(cfg_msg **msg, bool update_dh)
 static void
 free_resources(void)
 {
+    VERB("Destroy snapshots");
+    cfg_snapshot_destroy();
+
     VERB("Destroy history");
     cfg_dh_destroy();
 
     VERB("Destroy database");
+    cfg_db_gen_release();
     cfg_db_destroy();
 
     VERB("Free resources");
@@ -2843,6 +3296,10 @@ process_cmd_line_opts(int argc, char **argv)
         { "log-diff", '\0', POPT_ARG_NONE | POPT_BIT_SET, &cs_flags,
           CS_LOG_DIFF, "Log diff if backup verification failed.", NULL },
 
+        { "xml-backups", '\0', POPT_ARG_NONE | POPT_BIT_SET, &cs_flags,
+          CS_XML_BACKUPS, "Write XML file for every backup on creation "
+          "(useful for debugging).", NULL },
+
         { "foreground", 'f', POPT_ARG_NONE | POPT_BIT_SET, &cs_flags,
           CS_FOREGROUND,
           "Run in foreground (useful for debugging).", NULL },
@@ -3129,7 +3586,20 @@ main(int argc, char **argv)
         cfg_msg *msg = (cfg_msg *)buf;
         size_t   len = CFG_BUF_LEN;
 
-        if ((rc = ipc_receive_message(server, buf, &len, &user)) != 0)
+        rc = ipc_receive_message(server, buf, &len, &user);
+        if (TE_RC_GET_ERROR(rc) == TE_ESMALLBUF)
+        {
+            /* Batches of changes may exceed the buffer */
+            size_t rest = len;
+
+            msg = TE_ALLOC(CFG_BUF_LEN + rest);
+            memcpy(msg, buf, CFG_BUF_LEN);
+            rc = ipc_receive_message(server, (char *)msg + CFG_BUF_LEN,
+                                     &rest, &user);
+            if (rc != 0)
+                free(msg);
+        }
+        if (rc != 0)
         {
             ERROR("Failed receive user request: errno=%r", rc);
             continue;
@@ -0,0 +1,507 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Configurator
+ *
+ * In-memory configuration snapshots used for backups.
+ *
+ * Snapshots are kept in the order of creation. Changes are saved in
+ * the newest snapshot only, so that the state of the database at the
+ * moment of a snapshot creation is defined by the first saved state of
+ * every instance in this snapshot and all newer ones.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include "conf_defs.h"
+#include "te_alloc.h"
+#include "te_hash.h"
+#include "te_queue.h"
+
+/** Configuration snapshot */
+typedef struct cfg_snapshot {
+    TAILQ_ENTRY(cfg_snapshot) links;    /**< List links */
+
+    unsigned int      id;       /**< Snapshot identifier */
+    char             *name;     /**< Backup name */
+    te_vec            subtrees; /**< Subtrees of the backup */
+    bool              usable;   /**< Whether the snapshot may be used
+                                     for verification */
+    bool              exported; /**< Whether the backup file is written */
+
+    cfg_snapshot_rec *recs;     /**< Instances changed while the snapshot
+                                     is the newest one */
+    unsigned int      n_recs;   /**< Number of records */
+    unsigned int      max_recs; /**< Number of allocated records */
+    unsigned int     *slots;    /**< Hash table of records: index + 1
+                                     or @c 0 for empty slots */
+    unsigned int      size;     /**< Number of slots (power of 2) */
+} cfg_snapshot;
+
+/** List of snapshots, the oldest first */
+static TAILQ_HEAD(cfg_snapshots, cfg_snapshot) snapshots =
+    TAILQ_HEAD_INITIALIZER(snapshots);
+
+/** Identifier of the next snapshot */
+static unsigned int next_id = 1;
+
+/** Calculate hash of an OID */
+static inline uint32_t
+snapshot_oid_hash(const char *oid)
+{
+    return te_hash_fnv32_str(TE_HASH_FNV32_INIT, oid);
+}
+
+/** Find a record for the instance in the snapshot */
+static cfg_snapshot_rec *
+snapshot_find_rec(const cfg_snapshot *snap, const char *oid)
+{
+    unsigned int mask = snap->size - 1;
+    unsigned int i;
+
+    if (snap->size == 0)
+        return NULL;
+
+    for (i = snapshot_oid_hash(oid) & mask; snap->slots[i] != 0;
+         i = (i + 1) & mask)
+    {
+        cfg_snapshot_rec *rec = &snap->recs[snap->slots[i] - 1];
+
+        if (strcmp(rec->oid, oid) == 0)
+            return rec;
+    }
+
+    return NULL;
+}
+
+/** Put the record with specified index to the hash table */
+static void
+snapshot_hash_rec(cfg_snapshot *snap, unsigned int index)
+{
+    unsigned int mask = snap->size - 1;
+    unsigned int i;
+
+    for (i = snapshot_oid_hash(snap->recs[index].oid) & mask;
+         snap->slots[i] != 0; i = (i + 1) & mask);
+
+    snap->slots[i] = index + 1;
+}
+
+/**
+ * Add a record to the snapshot. The snapshot takes ownership of
+ * strings in the record.
+ */
+static void
+snapshot_add_rec(cfg_snapshot *snap, const cfg_snapshot_rec *rec)
+{
+    unsigned int i;
+
+    if (snap->n_recs == snap->max_recs)
+    {
+        snap->max_recs = snap->max_recs == 0 ? 64 : snap->max_recs * 2;
+        TE_REALLOC(snap->recs, snap->max_recs * sizeof(*snap->recs));
+    }
+    snap->recs[snap->n_recs++] = *rec;
+
+    if (snap->n_recs * 2 > snap->size)
+    {
+        free(snap->slots);
+        snap->size = snap->max_recs * 2;
+        snap->slots = TE_ALLOC(snap->size * sizeof(*snap->slots));
+        for (i = 0; i < snap->n_recs; i++)
+            snapshot_hash_rec(snap, i);
+    }
+    else
+    {
+        snapshot_hash_rec(snap, snap->n_recs - 1);
+    }
+}
+
+/** Release records of the snapshot */
+static void
+snapshot_free_recs(cfg_snapshot *snap)
+{
+    unsigned int i;
+
+    for (i = 0; i < snap->n_recs; i++)
+    {
+        free(snap->recs[i].oid);
+        free(snap->recs[i].value);
+    }
+    free(snap->recs);
+    free(snap->slots);
+    snap->recs = NULL;
+    snap->slots = NULL;
+    snap->n_recs = snap->max_recs = snap->size = 0;
+}
+
+/** Find a snapshot by backup name */
+static cfg_snapshot *
+snapshot_find(const char *name)
+{
+    cfg_snapshot *snap;
+
+    TAILQ_FOREACH(snap, &snapshots, links)
+    {
+        if (strcmp(snap->name, name) == 0)
+            return snap;
+    }
+
+    return NULL;
+}
+
+/** Check that the OID belongs to one of subtrees */
+static bool
+snapshot_oid_in_subtrees(const te_vec *subtrees, const char *oid)
+{
+    char * const *subtree;
+
+    if (subtrees == NULL || te_vec_size(subtrees) == 0)
+        return true;
+
+    TE_VEC_FOREACH(subtrees, subtree)
+    {
+        if (strcmp_start(*subtree, oid) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+/** Comparison function for sorting records by OID */
+static int
+snapshot_rec_compare(const void *pa, const void *pb)
+{
+    const cfg_snapshot_rec *a = *(const cfg_snapshot_rec * const *)pa;
+    const cfg_snapshot_rec *b = *(const cfg_snapshot_rec * const *)pb;
+
+    return strcmp(a->oid, b->oid);
+}
+
+/**
+ * Get states of instances at the moment of a snapshot creation
+ * for all instances changed after it.
+ *
+ * @param snap      snapshot
+ * @param subtrees  subtrees to take into account
+ * @param image     image to fill in (records are sorted by OID)
+ */
+static void
+snapshot_get_image(const cfg_snapshot *snap, const te_vec *subtrees,
+                   cfg_snapshot_image *image)
+{
+    const cfg_snapshot *layer;
+    const cfg_snapshot *prev;
+    unsigned int        n_max = 0;
+    unsigned int        i;
+
+    for (layer = snap; layer != NULL; layer = TAILQ_NEXT(layer, links))
+        n_max += layer->n_recs;
+
+    image->recs = TE_ALLOC((n_max + 1) * sizeof(*image->recs));
+    image->n_recs = 0;
+
+    for (layer = snap; layer != NULL; layer = TAILQ_NEXT(layer, links))
+    {
+        for (i = 0; i < layer->n_recs; i++)
+        {
+            const cfg_snapshot_rec *rec = &layer->recs[i];
+
+            if (!snapshot_oid_in_subtrees(subtrees, rec->oid))
+                continue;
+
+            /* The state is saved in an older snapshot */
+            for (prev = snap; prev != layer;
+                 prev = TAILQ_NEXT(prev, links))
+            {
+                if (snapshot_find_rec(prev, rec->oid) != NULL)
+                    break;
+            }
+            if (prev == layer)
+                image->recs[image->n_recs++] = rec;
+        }
+    }
+
+    qsort(image->recs, image->n_recs, sizeof(*image->recs),
+          snapshot_rec_compare);
+}
+
+/* See the description in conf_snapshot.h */
+const cfg_snapshot_rec *
+cfg_snapshot_image_find(const cfg_snapshot_image *image, const char *oid)
+{
+    cfg_snapshot_rec         key = { .oid = (char *)oid };
+    const cfg_snapshot_rec  *p_key = &key;
+    const cfg_snapshot_rec **found;
+
+    found = bsearch(&p_key, image->recs, image->n_recs,
+                    sizeof(*image->recs), snapshot_rec_compare);
+
+    return found == NULL ? NULL : *found;
+}
+
+/* See the description in conf_snapshot.h */
+te_errno
+cfg_snapshot_create(const char *name, const te_vec *subtrees)
+{
+    cfg_snapshot *snap = TE_ALLOC(sizeof(*snap));
+    char * const *subtree;
+
+    snap->id = next_id++;
+    snap->name = TE_STRDUP(name);
+    snap->subtrees = TE_VEC_INIT(char *);
+    snap->usable = true;
+    if (subtrees != NULL)
+    {
+        TE_VEC_FOREACH(subtrees, subtree)
+            te_vec_append_str_fmt(&snap->subtrees, "%s", *subtree);
+    }
+
+    TAILQ_INSERT_TAIL(&snapshots, snap, links);
+    VERB("Snapshot %u is created for backup '%s'", snap->id, name);
+
+    return 0;
+}
+
+/**
+ * Append a line of backup diff for the state of an instance.
+ *
+ * @param diff      diff to append to
+ * @param sign      @c '-' for the backup state, @c '+' for the current
+ * @param oid       object instance identifier
+ * @param value     instance value or @c NULL
+ */
+static void
+snapshot_diff_line(te_string *diff, char sign, const char *oid,
+                   const char *value)
+{
+    te_string_append(diff, "%c  <instance oid=\"%s\"", sign, oid);
+    if (value != NULL)
+    {
+        xmlChar *xml_str;
+
+        /* Values are escaped like in backup files */
+        xml_str = xmlEncodeEntitiesReentrant(NULL, (const xmlChar *)value);
+        te_string_append(diff, " value=\"%s\"",
+                         xml_str != NULL ? (const char *)xml_str : value);
+        free(xml_str);
+    }
+    te_string_append(diff, "/>\n");
+}
+
+/**
+ * Start the difference with unified diff header lines like diff(1)
+ * run on the backup file and the current configuration file did.
+ *
+ * @param diff      difference being built
+ * @param snap      snapshot
+ * @param n_diffs   number of differences found so far
+ */
+static void
+snapshot_diff_header(te_string *diff, const cfg_snapshot *snap,
+                     unsigned int n_diffs)
+{
+    if (n_diffs == 0)
+        te_string_append(diff, "--- %s\n+++ current configuration\n",
+                         snap->name);
+}
+
+/* See the description in conf_snapshot.h */
+te_errno
+cfg_snapshot_verify(const char *name, const te_vec *subtrees,
+                    te_string *diff)
+{
+    cfg_snapshot       *snap = snapshot_find(name);
+    cfg_snapshot_image  image;
+    unsigned int        n_diffs = 0;
+    unsigned int        i;
+    te_errno            rc = 0;
+
+    if (snap == NULL || !snap->usable)
+        return TE_ENOENT;
+
+    if (subtrees == NULL || te_vec_size(subtrees) == 0)
+        subtrees = &snap->subtrees;
+
+    snapshot_get_image(snap, subtrees, &image);
+    for (i = 0; i < image.n_recs && rc == 0; i++)
+    {
+        const cfg_snapshot_rec *rec = image.recs[i];
+        cfg_instance           *inst;
+        char                   *value = NULL;
+
+        /* Verification must not change the OID cache */
+        inst = cfg_get_ins_by_ins_id_str(rec->oid);
+        if (inst == NULL)
+        {
+            if (!rec->existed)
+                continue;
+
+            if (diff != NULL)
+            {
+                snapshot_diff_header(diff, snap, n_diffs);
+                snapshot_diff_line(diff, '-', rec->oid, rec->value);
+            }
+            n_diffs++;
+            continue;
+        }
+        if (inst->obj->type != CVT_NONE)
+        {
+            rc = cfg_types[inst->obj->type].val2str(inst->val, &value);
+            if (rc != 0)
+            {
+                ERROR("Conversion failed for instance %s type %d",
+                      inst->oid, inst->obj->type);
+                break;
+            }
+        }
+
+        if (!rec->existed || (value != NULL) != (rec->value != NULL) ||
+            (value != NULL && strcmp(value, rec->value) != 0))
+        {
+            if (diff != NULL)
+            {
+                snapshot_diff_header(diff, snap, n_diffs);
+                if (rec->existed)
+                    snapshot_diff_line(diff, '-', rec->oid, rec->value);
+                snapshot_diff_line(diff, '+', rec->oid, value);
+            }
+            n_diffs++;
+        }
+        free(value);
+    }
+    free(image.recs);
+
+    VERB("Snapshot %u: %u changed instances, %u differ", snap->id,
+         image.n_recs, n_diffs);
+
+    if (rc != 0)
+        return rc;
+
+    return n_diffs == 0 ? 0 : TE_EBACKUP;
+}
+
+/* See the description in conf_snapshot.h */
+te_errno
+cfg_snapshot_export(const char *name)
+{
+    cfg_snapshot       *snap = snapshot_find(name);
+    cfg_snapshot_image  image;
+    te_errno            rc;
+
+    if (snap == NULL || snap->exported)
+        return 0;
+
+    snapshot_get_image(snap, &snap->subtrees, &image);
+    rc = cfg_backup_create_image_file(snap->name, &snap->subtrees, &image);
+    free(image.recs);
+
+    if (rc != 0)
+    {
+        ERROR("Failed to write backup file '%s' for snapshot %u: %r",
+              snap->name, snap->id, rc);
+        return rc;
+    }
+
+    snap->exported = true;
+    return 0;
+}
+
+/* See the description in conf_snapshot.h */
+void
+cfg_snapshot_release(const char *name)
+{
+    cfg_snapshot *snap = snapshot_find(name);
+    cfg_snapshot *prev;
+    unsigned int  i;
+
+    if (snap == NULL)
+        return;
+
+    /*
+     * Saved states are required for older snapshots as well, so move
+     * them to the previous snapshot unless it has its own ones.
+     */
+    prev = TAILQ_PREV(snap, cfg_snapshots, links);
+    if (prev != NULL)
+    {
+        for (i = 0; i < snap->n_recs; i++)
+        {
+            if (snapshot_find_rec(prev, snap->recs[i].oid) != NULL)
+                continue;
+
+            snapshot_add_rec(prev, &snap->recs[i]);
+            snap->recs[i].oid = NULL;
+            snap->recs[i].value = NULL;
+        }
+    }
+
+    VERB("Snapshot %u of backup '%s' is released", snap->id, snap->name);
+
+    TAILQ_REMOVE(&snapshots, snap, links);
+    snapshot_free_recs(snap);
+    te_vec_deep_free(&snap->subtrees);
+    free(snap->name);
+    free(snap);
+}
+
+/* See the description in conf_snapshot.h */
+void
+cfg_snapshot_note_change(cfg_instance *inst, bool existed)
+{
+    cfg_snapshot     *last = TAILQ_LAST(&snapshots, cfg_snapshots);
+    cfg_snapshot_rec  rec = { .existed = existed };
+
+    /* The same instances are skipped when a backup file is written */
+    if (last == NULL || inst->father == NULL || cfg_inst_agent(inst) ||
+        cfg_instance_volatile(inst))
+    {
+        return;
+    }
+
+    if (snapshot_find_rec(last, inst->oid) != NULL)
+        return;
+
+    if (existed && inst->obj->type != CVT_NONE &&
+        cfg_types[inst->obj->type].val2str(inst->val, &rec.value) != 0)
+    {
+        /* The instance is reported as changed on verification */
+        ERROR("Conversion failed for instance %s type %d",
+              inst->oid, inst->obj->type);
+        rec.value = NULL;
+    }
+    rec.oid = TE_STRDUP(inst->oid);
+
+    snapshot_add_rec(last, &rec);
+}
+
+/* See the description in conf_snapshot.h */
+void
+cfg_snapshot_materialize_all(void)
+{
+    cfg_snapshot *snap;
+
+    TAILQ_FOREACH(snap, &snapshots, links)
+    {
+        if (!snap->usable)
+            continue;
+
+        cfg_snapshot_export(snap->name);
+        snap->usable = false;
+    }
+}
+
+/* See the description in conf_snapshot.h */
+void
+cfg_snapshot_destroy(void)
+{
+    cfg_snapshot *snap;
+
+    while ((snap = TAILQ_FIRST(&snapshots)) != NULL)
+    {
+        TAILQ_REMOVE(&snapshots, snap, links);
+        snapshot_free_recs(snap);
+        te_vec_deep_free(&snap->subtrees);
+        free(snap->name);
+        free(snap);
+    }
+}
@@ -0,0 +1,133 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Configurator
+ *
+ * In-memory configuration snapshots used for backups.
+ *
+ * A snapshot does not copy the configuration database on creation.
+ * Instead, the previous state of every instance is saved the first
+ * time the instance is added, changed or deleted after the snapshot
+ * creation (copy-on-write). Verification of a snapshot compares only
+ * saved instances with the current database, and the backup XML file
+ * is written only if it is really needed.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#ifndef __TE_CONF_SNAPSHOT_H__
+#define __TE_CONF_SNAPSHOT_H__
+
+#include "te_vector.h"
+#include "te_string.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** State of an instance at the moment of a snapshot creation */
+typedef struct cfg_snapshot_rec {
+    char   *oid;        /**< Object instance identifier */
+    bool    existed;    /**< Whether the instance existed */
+    char   *value;      /**< Value of the instance converted to string
+                             or @c NULL if it has no value */
+} cfg_snapshot_rec;
+
+/**
+ * Difference between a snapshot and the current database: states of
+ * all instances changed after the snapshot creation sorted by OID.
+ */
+typedef struct cfg_snapshot_image {
+    const cfg_snapshot_rec **recs;      /**< Sorted array of records */
+    unsigned int             n_recs;    /**< Number of records */
+} cfg_snapshot_image;
+
+/**
+ * Find a record for an instance in the snapshot image.
+ *
+ * @param image     snapshot image
+ * @param oid       object instance identifier
+ *
+ * @return Record or @c NULL if the instance is not changed after
+ *         the snapshot creation.
+ */
+extern const cfg_snapshot_rec *cfg_snapshot_image_find(
+                                    const cfg_snapshot_image *image,
+                                    const char *oid);
+
+/**
+ * Create a snapshot of the current configuration.
+ *
+ * @param name      backup name (file to write XML to if required)
+ * @param subtrees  Vector of subtrees the backup is created for.
+ *                  @c NULL or empty for all the subtrees
+ *
+ * @return Status code.
+ */
+extern te_errno cfg_snapshot_create(const char *name,
+                                    const te_vec *subtrees);
+
+/**
+ * Check whether the current configuration differs from a snapshot.
+ *
+ * @param name      backup name
+ * @param subtrees  Vector of subtrees to verify, @c NULL or empty
+ *                  to verify subtrees the snapshot was created for
+ * @param diff      location for human-readable difference or @c NULL
+ *
+ * The difference has unified diff header lines followed by removed
+ * ('-') and added ('+') instance lines as they appear in backup files.
+ * Unlike diff(1) output used for backup files, there are no hunk
+ * headers and context lines. The database is not changed, in particular
+ * the OID cache is not filled in.
+ *
+ * @return Status code.
+ * @retval 0            configuration does not differ
+ * @retval TE_EBACKUP   configuration differs
+ * @retval TE_ENOENT    there is no usable snapshot with such name,
+ *                      backup file should be used
+ */
+extern te_errno cfg_snapshot_verify(const char *name,
+                                    const te_vec *subtrees,
+                                    te_string *diff);
+
+/**
+ * Make sure that the backup file of a snapshot is written.
+ *
+ * @param name      backup name
+ *
+ * @return Status code (@c 0 if there is no snapshot with such name).
+ */
+extern te_errno cfg_snapshot_export(const char *name);
+
+/**
+ * Forget a snapshot.
+ *
+ * @param name      backup name
+ */
+extern void cfg_snapshot_release(const char *name);
+
+/**
+ * Save the state of an instance before it is changed or deleted or
+ * right after it is added if it is required by existing snapshots.
+ *
+ * @param inst      object instance
+ * @param existed   @c false if the instance is just added
+ */
+extern void cfg_snapshot_note_change(cfg_instance *inst, bool existed);
+
+/**
+ * Write backup files of all snapshots and stop using them for
+ * verification. It should be called before changes which are not
+ * tracked by snapshots (e.g. objects registration).
+ */
+extern void cfg_snapshot_materialize_all(void);
+
+/**
+ * Release all snapshots.
+ */
+extern void cfg_snapshot_destroy(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* __TE_CONF_SNAPSHOT_H__ */
@@ -6,12 +6,11 @@
  * TA interaction auxiliary routines
  */
 
-#include <search.h>
 #include "te_str.h"
 #include "conf_defs.h"
 #include "rcf_api.h"
-#include "te_queue.h"
 #include "te_alloc.h"
+#include "te_hash.h"
 
 #define TA_LIST_SIZE    64
 
@@ -30,6 +29,159 @@ bool local_cmd_seq = false;
 char max_commit_subtree[CFG_INST_NAME_MAX] = {};
 char *local_cmd_bkp = NULL;
 
+/** Names of Test Agents with configuration group started for a batch */
+static te_vec batch_tas = TE_VEC_INIT_AUTOPTR(char *);
+
+/** Synchronization postponed until the end of a batch */
+typedef struct batch_sync_req {
+    char *oid;      /**< Object instance identifier */
+    bool  subtree;  /**< Whether the subtree should be synchronized */
+} batch_sync_req;
+
+/** Synchronizations postponed until the end of a batch */
+static te_vec batch_syncs = TE_VEC_INIT(batch_sync_req);
+
+/**
+ * Find Test Agent in the list of Test Agents with configuration group
+ * started for a batch.
+ *
+ * @param ta    Test Agent name
+ *
+ * @return Index in the list or @c -1.
+ */
+static int
+batch_ta_find(const char *ta)
+{
+    char **name;
+
+    TE_VEC_FOREACH(&batch_tas, name)
+    {
+        if (strcmp(*name, ta) == 0)
+            return te_vec_get_index(&batch_tas, name);
+    }
+
+    return -1;
+}
+
+/**
+ * Start or end configuration group on the Test Agent. Nothing is done
+ * if the group is started for a batch: it is ended by cfg_ta_batch_end().
+ *
+ * @param ta        Test Agent name
+ * @param is_start  Start or end group
+ *
+ * @return Status code.
+ */
+static te_errno
+cfg_ta_group(const char *ta, bool is_start)
+{
+    if (batch_ta_find(ta) >= 0)
+        return 0;
+
+    return rcf_ta_cfg_group(ta, 0, is_start);
+}
+
+/* See description in conf_ta.h */
+te_errno
+cfg_ta_batch_start(const char *ta)
+{
+    te_errno rc;
+
+    if (batch_ta_find(ta) >= 0)
+        return 0;
+
+    rc = rcf_ta_cfg_group(ta, 0, true);
+    if (rc != 0)
+        return rc;
+
+    rc = te_vec_append_str_fmt(&batch_tas, "%s", ta);
+    if (rc != 0)
+        rcf_ta_cfg_group(ta, 0, false);
+
+    return rc;
+}
+
+/**
+ * Postpone synchronization until the end of a batch, since Test Agents
+ * do not commit changes of the batch until their groups are ended.
+ * Synchronization of the same instance or of an instance in a subtree
+ * which is synchronized already is not repeated.
+ *
+ * @param oid       identifier of the object instance or subtree
+ * @param subtree   whether the subtree should be synchronized
+ *
+ * @return Status code.
+ */
+static te_errno
+batch_sync_postpone(const char *oid, bool subtree)
+{
+    batch_sync_req *req;
+    batch_sync_req  new_req;
+    size_t          len;
+
+    TE_VEC_FOREACH(&batch_syncs, req)
+    {
+        if (strcmp(req->oid, oid) == 0)
+        {
+            req->subtree = req->subtree || subtree;
+            return 0;
+        }
+
+        len = strlen(req->oid);
+        if (req->subtree && strncmp(req->oid, oid, len) == 0 &&
+            oid[len] == '/')
+            return 0;
+    }
+
+    new_req.oid = TE_STRDUP(oid);
+    new_req.subtree = subtree;
+
+    return te_vec_append(&batch_syncs, &new_req);
+}
+
+/* See description in conf_ta.h */
+te_errno
+cfg_ta_batch_sync(void)
+{
+    te_vec          syncs = batch_syncs;
+    batch_sync_req *req;
+    te_errno        result = 0;
+    te_errno        rc;
+
+    assert(te_vec_size(&batch_tas) == 0);
+    batch_syncs = TE_VEC_INIT(batch_sync_req);
+
+    TE_VEC_FOREACH(&syncs, req)
+    {
+        rc = cfg_ta_sync(req->oid, req->subtree);
+        if (rc != 0)
+        {
+            ERROR("Failed to synchronize %s after batch: %r",
+                  req->oid, rc);
+            if (result == 0)
+                result = rc;
+        }
+        free(req->oid);
+    }
+    te_vec_free(&syncs);
+
+    return result;
+}
+
+/* See description in conf_ta.h */
+te_errno
+cfg_ta_batch_end(const char *ta)
+{
+    int i = batch_ta_find(ta);
+
+    if (i < 0)
+        return 0;
+
+    te_vec_remove_index(&batch_tas, i);
+
+    return rcf_ta_cfg_group(ta, 0, false);
+}
+
 /**
  * Get list of Test Agents.
  *
@@ -138,11 +290,9 @@ cfg_ta_add_agent_instances()
         sprintf(cfg_all_inst[i]->oid, CFG_TA_PREFIX"%s", ta);
         CFG_NEW_INST_HANDLE(cfg_all_inst[i]->handle, i);
         cfg_all_inst[i]->obj = cfg_all_obj[1];
-        if (i == 1)
-            cfg_all_inst[0]->son = cfg_all_inst[i];
-        else
-            cfg_all_inst[i - 1]->brother = cfg_all_inst[i];
-        cfg_all_inst[i]->father = &cfg_inst_root;
+        cfg_inst_link_son(&cfg_inst_root,
+                          i == 1 ? NULL : cfg_all_inst[i - 1],
+                          cfg_all_inst[i]);
     }
     free(ta_list.list);
     return 0;
@@ -182,11 +332,13 @@ cfg_ta_log_syncing(bool flag)
  *
  * @param ta      Test Agent name
  * @param oid     object instance identifier
+ * @param value   value of the instance got from the TA together with
+ *                the list of instances or @c NULL if it should be got
  *
  * @return status code (see te_errno.h)
  */
 static int
-sync_ta_instance(const char *ta, const char *oid)
+sync_ta_instance(const char *ta, const char *oid, char *value)
 {
     cfg_object   *obj = cfg_get_object(oid);
     cfg_handle    handle = CFG_HANDLE_INVALID;
@@ -221,7 +373,7 @@ sync_ta_instance(const char *ta, const char *oid)
         return rc;
     }
 
-    while (true)
+    while (value == NULL)
     {
         rc = rcf_ta_cfg_get(ta, 0, oid, cfg_get_buf, cfg_get_buf_len);
         if (TE_RC_GET_ERROR(rc) == TE_ESMALLBUF)
@@ -247,22 +399,26 @@ sync_ta_instance(const char *ta, const char *oid)
         }
     }
 
-    if (rc != 0)
+    if (value == NULL)
     {
-        if (handle != CFG_HANDLE_INVALID)
-            cfg_db_del(handle);
-        return 0;
+        if (rc != 0)
+        {
+            if (handle != CFG_HANDLE_INVALID)
+                cfg_db_del(handle);
+            return 0;
+        }
+        value = cfg_get_buf;
     }
 
     if (do_log_syncing)
     {
-        RING("Syncing %s on %s -> %s", ta, oid, cfg_get_buf);
+        RING("Syncing %s on %s -> %s", ta, oid, value);
     }
 
-    if ((rc = cfg_types[obj->type].str2val(cfg_get_buf, &val)) != 0)
+    if ((rc = cfg_types[obj->type].str2val(value, &val)) != 0)
     {
         ERROR("Conversion of '%s' to value type %s(%d) for OID '%s' "
-                "failed", cfg_get_buf,
+                "failed", value,
                 te_enum_map_from_any_value(cfg_cvt_mapping, obj->type,
                                            "unknown type"),
                 obj->type, oid);
@@ -292,140 +448,255 @@ sync_ta_instance(const char *ta, const char *oid)
     return rc;
 }
 
-/* Remove entries, which do not mention in the list, from database */
-static void
-remove_excessive(cfg_instance *inst, char *list)
+/** Instance reported by a Test Agent */
+typedef struct ta_oid_entry {
+    char       *oid;        /**< Instance OID */
+    char       *value;      /**< Instance value or @c NULL if it
+                                 is not got together with the OID */
+} ta_oid_entry;
+
+/** Set of instance OIDs reported by a Test Agent */
+typedef struct ta_oid_set {
+    ta_oid_entry *oids;     /**< Sorted array of unique OIDs */
+    unsigned int  n_oids;   /**< Number of OIDs */
+    unsigned int  max_oids; /**< Number of allocated entries */
+    bool          own;      /**< Whether OIDs and values are owned
+                                 by the set */
+    const char  **slots;    /**< Hash table of OIDs */
+    unsigned int  size;     /**< Number of slots (power of 2) */
+} ta_oid_set;
+
+/** Calculate hash of an OID */
+static inline uint32_t
+ta_oid_hash(const char *oid)
 {
-    cfg_instance *tmp;
-    cfg_instance *next;
-    int len = strlen(inst->oid);
-    char *s;
+    return te_hash_fnv32_str(TE_HASH_FNV32_INIT, oid);
+}
 
-    for (tmp = inst->son; tmp != NULL; tmp = next)
+/** Comparison function for sorting OIDs */
+static int
+ta_oid_compare(const void *pa, const void *pb)
+{
+    const ta_oid_entry *a = pa;
+    const ta_oid_entry *b = pb;
+    int                 rc = strcmp(a->oid, b->oid);
+
+    /* Prefer entries with values among duplicates */
+    if (rc == 0)
+        rc = (a->value == NULL) - (b->value == NULL);
+
+    return rc;
+}
+
+/** Check whether an OID is in the set */
+static bool
+ta_oid_set_has(const ta_oid_set *set, const char *oid)
+{
+    unsigned int mask = set->size - 1;
+    unsigned int i;
+
+    for (i = ta_oid_hash(oid) & mask; set->slots[i] != NULL;
+         i = (i + 1) & mask)
     {
-        next = tmp->brother;
-        remove_excessive(tmp, list);
+        if (strcmp(set->slots[i], oid) == 0)
+            return true;
     }
 
-    if (cfg_inst_agent(inst))
-        return;
+    return false;
+}
 
-    for (s = strstr(list, inst->oid);
-         s != NULL;
-         s = strstr(s + 1, inst->oid))
+/** Add an OID to the set being filled in */
+static void
+ta_oid_set_add(ta_oid_set *set, char *oid, char *value)
+{
+    if (set->n_oids == set->max_oids)
     {
-        if (*(s + len) == ' ' || *(s + len) == 0)
-            break;
+        set->max_oids = set->max_oids == 0 ? 64 : set->max_oids * 2;
+        TE_REALLOC(set->oids, set->max_oids * sizeof(*set->oids));
     }
-    if (s == NULL)
-        cfg_db_del(inst->handle);
+    set->oids[set->n_oids].oid = oid;
+    set->oids[set->n_oids].value = value;
+    set->n_oids++;
 }
 
-/* Element of OID queue */
-typedef struct oid_queue_entry_t {
-    TAILQ_ENTRY(oid_queue_entry_t) links;
-    char oid[CFG_OID_MAX];
-} oid_queue_entry_t;
-
-/* Head of OID queue */
-typedef TAILQ_HEAD(oid_queue_head_t, oid_queue_entry_t) oid_queue_head_t;
-
-/*
- * TODO: get rid of this global variable once we stop support
- * of glibc earlier than 2.30 (released in 08.2019) for TE.
- * In glibc 2.30 twalk_r() was added which allows to pass user data
- * to action callback.
+/**
+ * Sort the OIDs added to the set, remove duplicates and build
+ * the hash table.
  *
- * WARNING: here it is assumed that Configurator does not use
- * multithreading.
+ * @param set       Set filled in by ta_oid_set_add()
  */
-static oid_queue_head_t oid_queue = TAILQ_HEAD_INITIALIZER(oid_queue);
-
-/* Insert OID to queue */
 static void
-insert_entry(const char *oid, oid_queue_head_t *queue)
+ta_oid_set_finish(ta_oid_set *set)
 {
-    oid_queue_entry_t *new_elm;
+    unsigned int n_unique = 1;
+    unsigned int i;
 
-    new_elm = TE_ALLOC(sizeof(*new_elm));
+    /* Instances are synchronized in order, so that fathers go first */
+    qsort(set->oids, set->n_oids, sizeof(*set->oids), ta_oid_compare);
+    for (i = 1; i < set->n_oids; i++)
+    {
+        if (strcmp(set->oids[i].oid, set->oids[n_unique - 1].oid) != 0)
+        {
+            set->oids[n_unique++] = set->oids[i];
+        }
+        else if (set->own)
+        {
+            free(set->oids[i].oid);
+            free(set->oids[i].value);
+        }
+    }
+    set->n_oids = n_unique;
+
+    for (set->size = 16; set->size < set->n_oids * 2; set->size *= 2);
+    set->slots = TE_ALLOC(set->size * sizeof(*set->slots));
+    for (i = 0; i < set->n_oids; i++)
+    {
+        unsigned int j;
 
-    te_strlcpy(new_elm->oid, oid, CFG_OID_MAX);
-    TAILQ_INSERT_TAIL(queue, new_elm, links);
+        for (j = ta_oid_hash(set->oids[i].oid) & (set->size - 1);
+             set->slots[j] != NULL;
+             j = (j + 1) & (set->size - 1));
+
+        set->slots[j] = set->oids[i].oid;
+    }
 }
 
-/* Remove and release all entries in OID queue */
-static inline void
-free_oid_queue(oid_queue_head_t *head)
+/**
+ * Parse the list of instances returned by a Test Agent for a wildcard
+ * request into a set. The list is modified in place, the set refers
+ * to its contents.
+ *
+ * @param list      Space-separated list of OIDs
+ * @param root      OID of the subtree root to be added to the set
+ * @param set       Set to fill in
+ */
+static void
+ta_oid_set_parse(char *list, const char *root, ta_oid_set *set)
 {
-    oid_queue_entry_t *cur;
-    oid_queue_entry_t *aux;
+    char *tmp;
+    char *next;
 
-    TAILQ_FOREACH_SAFE(cur, head, links, aux)
+    memset(set, 0, sizeof(*set));
+    ta_oid_set_add(set, (char *)root, NULL);
+    for (tmp = list; *tmp != '\0'; tmp = next)
     {
-        TAILQ_REMOVE(head, cur, links);
-        free(cur);
+        next = strchr(tmp, ' ');
+        if (next != NULL)
+            *next++ = '\0';
+        else
+            next = tmp + strlen(tmp);
+
+        if (*tmp != '\0')
+            ta_oid_set_add(set, tmp, NULL);
     }
+
+    ta_oid_set_finish(set);
 }
 
-/* Comparison function for creating tree of OIDs */
-static int
-oid_tree_compare(const void *pa, const void *pb)
+/** Callback for rcf_ta_cfg_get_tree() filling in the set of OIDs */
+static te_errno
+ta_oid_set_tree_cb(const char *oid, const char *value, void *opaque)
 {
-    return strcmp((char *)pa, (char *)pb);
+    ta_oid_set *set = opaque;
+
+    /*
+     * Instances without value on the TA are considered to have
+     * empty value like rcf_ta_cfg_get() reports.
+     */
+    ta_oid_set_add(set, TE_STRDUP(oid),
+                   TE_STRDUP(value == NULL ? "" : value));
+
+    return 0;
 }
 
-/* Callback to use with twalk() to fill sorted queue of OIDs */
+/**
+ * Get all instances of the subtree together with their values from
+ * a Test Agent by a single bulk request.
+ *
+ * @param ta        Test Agent name
+ * @param oid       OID of the subtree root
+ * @param set       Set to fill in
+ *
+ * @return Status code.
+ */
+static te_errno
+ta_oid_set_get_tree(const char *ta, const char *oid, ta_oid_set *set)
+{
+    te_string wildcard_oid = TE_STRING_INIT;
+    te_errno  rc;
+
+    memset(set, 0, sizeof(*set));
+    set->own = true;
+
+    te_string_append(&wildcard_oid, "%s/...", oid);
+    rc = rcf_ta_cfg_get_tree(ta, 0, wildcard_oid.ptr, ta_oid_set_tree_cb,
+                             set);
+    te_string_free(&wildcard_oid);
+    if (rc != 0)
+        return rc;
+
+    /* The root is synchronized even if the TA does not report it */
+    ta_oid_set_add(set, TE_STRDUP(oid), NULL);
+    ta_oid_set_finish(set);
+
+    return 0;
+}
+
+/** Release the set of OIDs */
 static void
-oid_tree_action(const void *elm, VISIT which, int depth)
+ta_oid_set_free(ta_oid_set *set)
 {
-    UNUSED(depth);
+    unsigned int i;
 
-    switch (which)
+    if (set->own)
     {
-        case preorder:
-            return;
-        case endorder:
-            return;
-        default:
-            break;
+        for (i = 0; i < set->n_oids; i++)
+        {
+            free(set->oids[i].oid);
+            free(set->oids[i].value);
+        }
     }
-
-    insert_entry(*(char **)elm, &oid_queue);
+    free(set->oids);
+    free(set->slots);
 }
 
-/* Dummy free function for tdestroy() */
+/* Remove entries, which are not mentioned in the set, from database */
 static void
-oid_tree_free(void *unused)
+remove_excessive(cfg_instance *inst, const ta_oid_set *set)
 {
-    UNUSED(unused);
+    cfg_instance *tmp;
+    cfg_instance *next;
+
+    for (tmp = inst->son; tmp != NULL; tmp = next)
+    {
+        next = tmp->brother;
+        remove_excessive(tmp, set);
+    }
+
+    if (cfg_inst_agent(inst))
+        return;
+
+    if (!ta_oid_set_has(set, inst->oid))
+        cfg_db_del(inst->handle);
 }
 
 /**
- * Synchronize tree of object instances on the TA.
+ * Get the list of instances of the subtree from a Test Agent and parse
+ * it into a set. Values of instances are not got.
  *
- * @param ta      Test Agent name
- * @param oid     root object instance identifier
+ * @param ta        Test Agent name
+ * @param oid       OID of the subtree root
+ * @param set       Set to fill in
+ * @param list      Location for the list the set refers to
  *
- * @return status code (see te_errno.h)
+ * @return Status code.
  */
-static int
-sync_ta_subtree(const char *ta, const char *oid)
+static te_errno
+ta_oid_set_get_list(const char *ta, const char *oid, ta_oid_set *set,
+                    char **list)
 {
-    char  *tmp;
-    char  *next;
-    char  *limit;
-    char  *wildcard_oid;
-    int    rc;
-
-    void *oid_tree_root = NULL;
-    oid_queue_entry_t *entry = NULL;
-
-    cfg_handle *handles = NULL;
-    int         h_num;
-    int         i;
-
-    if (do_log_syncing)
-        RING("Synchronize TA '%s' subtree '%s'", ta, oid);
+    char     *wildcard_oid;
+    te_errno  rc;
 
     /* Take all instances from the TA */
     if ((wildcard_oid = malloc(strlen(oid) + sizeof("/..."))) == NULL)
@@ -435,14 +706,6 @@ sync_ta_subtree(const char *ta, const char *oid)
     }
     sprintf(wildcard_oid, "%s/...", oid);
 
-    rc = rcf_ta_cfg_group(ta, 0, true);
-    if (rc != 0)
-    {
-        ERROR("rcf_ta_cfg_group() failed");
-        free(wildcard_oid);
-        return TE_ENOMEM;
-    }
-
     cfg_get_buf[0] = 0;
     while (true)
     {
@@ -456,7 +719,6 @@ sync_ta_subtree(const char *ta, const char *oid)
             if (cfg_get_buf == NULL)
             {
                 ERROR("Memory allocation failure");
-                rcf_ta_cfg_group(ta, 0, false);
                 free(wildcard_oid);
                 return TE_ENOMEM;
             }
@@ -466,7 +728,6 @@ sync_ta_subtree(const char *ta, const char *oid)
         else
         {
             ERROR("rcf_ta_cfg_get() failed: TA=%s, error=%r", ta, rc);
-            rcf_ta_cfg_group(ta, 0, false);
             free(wildcard_oid);
             return rc;
         }
@@ -475,67 +736,102 @@ sync_ta_subtree(const char *ta, const char *oid)
 
     VERB("%s instances:\n%s", ta, cfg_get_buf);
 
-    rc = cfg_db_find_pattern(oid, (unsigned int *)&h_num, &handles);
-    if (rc != 0)
-    {
-        rcf_ta_cfg_group(ta, 0, false);
-        return rc;
-    }
+    /*
+     * The list is copied since cfg_get_buf is reused to get values
+     * of instances.
+     */
+    *list = TE_STRDUP(cfg_get_buf);
+    ta_oid_set_parse(*list, oid, set);
 
-    if (cfg_get_buf_len < (int)strlen(cfg_get_buf) + (int)strlen(oid) + 2)
-    {
-        cfg_get_buf_len <<= 1;
+    return 0;
+}
 
-        cfg_get_buf = (char *)realloc(cfg_get_buf, cfg_get_buf_len);
-        if (cfg_get_buf == NULL)
-        {
-            ERROR("Memory allocation failure");
-            rcf_ta_cfg_group(ta, 0, false);
-            free(handles);
-            return TE_ENOMEM;
-        }
-    }
+/**
+ * Synchronize tree of object instances on the TA.
+ *
+ * @param ta      Test Agent name
+ * @param oid     root object instance identifier
+ *
+ * @return status code (see te_errno.h)
+ */
+static int
+sync_ta_subtree(const char *ta, const char *oid)
+{
+    char  *list = NULL;
+    int    rc;
 
-    limit = cfg_get_buf + strlen(cfg_get_buf);
-    sprintf(limit, " %s", oid);
+    ta_oid_set  set;
+    cfg_handle *handles = NULL;
+    int         h_num;
+    int         i;
 
-    for (i = 0; i < h_num; i++)
-        remove_excessive(CFG_GET_INST(handles[i]), cfg_get_buf);
+    if (do_log_syncing)
+        RING("Synchronize TA '%s' subtree '%s'", ta, oid);
 
-    /* Calculate number of OIDs to be synchronized */
-    for (tmp = cfg_get_buf; tmp < limit; tmp = next)
+    rc = cfg_ta_group(ta, true);
+    if (rc != 0)
     {
-        void *tree_entry;
+        ERROR("rcf_ta_cfg_group() failed");
+        return TE_ENOMEM;
+    }
 
-        next = strchr(tmp, ' ');
-        if (next != NULL)
-            *next++ = 0;
+    /*
+     * Get the instances together with their values at once if the TA
+     * supports it, otherwise get the list and then value by value.
+     */
+    rc = ta_oid_set_get_tree(ta, oid, &set);
+    if (rc != 0)
+    {
+        ta_oid_set_free(&set);
+        /*
+         * Fall back to the old way if the TA does not support the
+         * request, fails to answer in time or has lost the request
+         * in progress.
+         */
+        if (TE_RC_GET_ERROR(rc) == TE_EFMT ||
+            TE_RC_GET_ERROR(rc) == TE_EOPNOTSUPP ||
+            TE_RC_GET_ERROR(rc) == TE_EIPC ||
+            TE_RC_GET_ERROR(rc) == TE_ETIMEDOUT ||
+            TE_RC_GET_ERROR(rc) == TE_ESTALE)
+        {
+            rc = ta_oid_set_get_list(ta, oid, &set, &list);
+        }
         else
-            next = limit;
+        {
+            ERROR("rcf_ta_cfg_get_tree() failed: TA=%s, error=%r",
+                  ta, rc);
+        }
 
-        tree_entry = tsearch(tmp, &oid_tree_root, oid_tree_compare);
-        if (tree_entry == NULL)
+        if (rc != 0)
         {
-            ERROR("%s(): failed to add OID to a search tree",
-                  __FUNCTION__);
-            tdestroy(oid_tree_root, oid_tree_free);
-            free(handles);
-            rcf_ta_cfg_group(ta, 0, false);
+            cfg_ta_group(ta, false);
             return rc;
         }
     }
 
-    twalk(oid_tree_root, oid_tree_action);
-    TAILQ_FOREACH(entry, &oid_queue, links)
+    rc = cfg_db_find_pattern(oid, (unsigned int *)&h_num, &handles);
+    if (rc != 0)
     {
-        if ((rc = sync_ta_instance(ta, entry->oid)) != 0)
+        cfg_ta_group(ta, false);
+        ta_oid_set_free(&set);
+        free(list);
+        return rc;
+    }
+
+    for (i = 0; i < h_num; i++)
+        remove_excessive(CFG_GET_INST(handles[i]), &set);
+
+    for (i = 0; i < (int)set.n_oids; i++)
+    {
+        if ((rc = sync_ta_instance(ta, set.oids[i].oid,
+                                   set.oids[i].value)) != 0)
             break;
     }
 
-    rcf_ta_cfg_group(ta, 0, false);
+    cfg_ta_group(ta, false);
 
-    tdestroy(oid_tree_root, oid_tree_free);
-    free_oid_queue(&oid_queue);
+    ta_oid_set_free(&set);
+    free(list);
     free(handles);
 
     return rc;
@@ -558,9 +854,15 @@ cfg_ta_sync(char *oid, bool subtree)
     int       rc = 0;
     ta_list_t ta_list = TA_LIST_INITIALIZER;
 
+    if (te_vec_size(&batch_tas) != 0)
+        return batch_sync_postpone(oid, subtree);
+
     if ((rc = ta_list_get(&ta_list)) != 0)
         return rc;
 
+    /* Synchronization may change the database */
+    cfg_db_gen_bump();
+
     if ((tmp_oid = cfg_convert_oid_str(oid)) == NULL ||
         !tmp_oid->inst ||
         (tmp_oid->len > 1 && strcmp_start("/agent", oid) != 0))
@@ -604,7 +906,7 @@ cfg_ta_sync(char *oid, bool subtree)
         if (found) /** This is the normal case */
         {
             rc = subtree ? sync_ta_subtree(ta, oid) :
-                           sync_ta_instance(ta, oid);
+                           sync_ta_instance(ta, oid, NULL);
         }
         else /** The specified agent is deleted by RCF */
         {
@@ -839,7 +1141,7 @@ cfg_ta_commit(const char *ta, cfg_instance *inst)
     ENTRY("ta=%s inst=0x%X", ta, inst);
     VERB("Commit to TA '%s' start at '%s'", ta, inst->oid);
 
-    rc = rcf_ta_cfg_group(ta, 0, true);
+    rc = cfg_ta_group(ta, true);
     if (rc != 0)
     {
         ERROR("Failed(%r) to start group on TA '%s'", rc, ta);
@@ -900,7 +1202,7 @@ cfg_ta_commit(const char *ta, cfg_instance *inst)
         }
     }
 
-    rc = rcf_ta_cfg_group(ta, 0, false);
+    rc = cfg_ta_group(ta, false);
     if (rc != 0)
     {
         ERROR("Failed(%r) to end group on TA '%s'", rc, ta);
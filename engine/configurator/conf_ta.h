@@ -153,6 +153,39 @@ if (local_cmd_seq) \
  */
 extern te_errno conf_ta_reboot_agents(const te_vec *agents);
 
+/**
+ * Start configuration group on the Test Agent for a batch of changes.
+ * Groups started and ended by synchronization and commit routines are
+ * nested into it, so all commits on the Test Agent are postponed until
+ * cfg_ta_batch_end() is called. Synchronizations requested while
+ * a group is started for a batch are postponed until
+ * cfg_ta_batch_sync() is called.
+ *
+ * @param ta    Test Agent name
+ *
+ * @return Status code.
+ */
+extern te_errno cfg_ta_batch_start(const char *ta);
+
+/**
+ * End configuration group started by cfg_ta_batch_start() and do
+ * all postponed commits.
+ *
+ * @param ta    Test Agent name
+ *
+ * @return Status code of postponed commits.
+ */
+extern te_errno cfg_ta_batch_end(const char *ta);
+
+/**
+ * Do synchronizations postponed during a batch, one per instance
+ * or subtree. It should be called when groups on all Test Agents
+ * touched by the batch are ended.
+ *
+ * @return Status code of the first failed synchronization.
+ */
+extern te_errno cfg_ta_batch_sync(void);
+
 #ifdef __cplusplus
 }
 #endif
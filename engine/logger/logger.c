@@ -27,6 +27,7 @@
 #error popt library (development version) is required for Logger
 #endif
 
+#include "te_alloc.h"
 #include "te_str.h"
 #include "te_raw_log.h"
 #include "te_log_fmt.h"
@@ -35,20 +36,15 @@
 #include "logger_ten.h"
 #include "logger_listener.h"
 #include "logger_stream.h"
+#include "logger_raw.h"
 
 #define LGR_TA_MAX_BUF      0x4000 /* FIXME */
 
 /** Initial (minimum) Logger message buffer size */
 #define LGR_MSG_BUF_MIN     0x100
 
-#define FREAD(_fd, _buf, _len) \
-    fread((_buf), sizeof(uint8_t), (_len), (_fd))
-
 #define SET_MSEC(_poll) ((_poll) % 1000000)
 
-/* Raw log file length checking period */
-#define RAW_FILE_CHECK_PERIOD 100
-
 /* Finished TA checking period */
 #define TA_FINISH_CHECK_PERIOD 50
 
@@ -62,10 +58,6 @@ snif_polling_sets_t snifp_sets;
 /* Path to the directory for logs */
 const char *te_log_dir = NULL;
 
-/* Raw log file */
-static FILE    *raw_file = NULL;
-/* Mutex protecting raw log file */
-static pthread_mutex_t raw_file_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* Raw log file location */
 static char    *te_log_raw = NULL;
 
@@ -78,9 +70,6 @@ static int64_t raw_log_max_size = (1LLU << 32);
 /* Is the raw log file length bigger than raw_log_max_size */
 static bool raw_log_too_big = false;
 
-/* raw log file check counter */
-static int      raw_file_check_cnt = 0;
-
 /** Logger PID */
 static pid_t    pid;
 
@@ -95,6 +84,8 @@ static unsigned int         lgr_flags = 0;
                                          with RCF */
 #define LOGGER_CHECK        0x04    /**< Check messages before store in
                                          raw log file */
+#define LOGGER_TA_LOG_FILES 0x08    /**< Get TA logs via temporary files
+                                         instead of streaming */
 #define LOGGER_SHUTDOWN     0x10    /**< Logger is shuting down */
 /*@}*/
 
@@ -182,14 +173,7 @@ append_err_message(const char *fmt, ...)
     }
     else
     {
-        pthread_mutex_lock(&raw_file_mutex);
-
-        if (fwrite(data.buf, data.ptr - data.buf, 1, raw_file) != 1)
-            perror("fwrite() failure");
-        if (fflush(raw_file) != 0)
-            perror("fflush(raw_file) failed");
-
-        pthread_mutex_unlock(&raw_file_mutex);
+        lgr_raw_write(data.buf, data.ptr - data.buf);
     }
 
     free(data.buf);
@@ -205,7 +189,6 @@ append_err_message(const char *fmt, ...)
 void
 lgr_register_message(const void *buf, size_t len)
 {
-    struct stat            raw_file_stat;
     te_errno               rc;
 
     if (((lgr_flags & LOGGER_CHECK) && !lgr_message_valid(buf, len)))
@@ -219,39 +202,25 @@ lgr_register_message(const void *buf, size_t len)
                   stderr);
     }
 
-    if (raw_log_too_big)
+    if (__atomic_load_n(&raw_log_too_big, __ATOMIC_RELAXED))
         return;
 
-    if (raw_log_max_size >= 0 && raw_file_check_cnt-- <= 0)
+    /* RAW log is too big now, ignore new messages */
+    if (raw_log_max_size >= 0 &&
+        lgr_raw_size() > (uint64_t)raw_log_max_size)
     {
-        raw_file_check_cnt = RAW_FILE_CHECK_PERIOD;
-        rc = stat(te_log_raw, &raw_file_stat);
-        if (rc < 0)
-        {
-            ERROR("FATAL ERROR: raw log file '%s' stat() failure: "
-                  "errno=%d", te_log_raw, errno);
+        if (__atomic_exchange_n(&raw_log_too_big, true, __ATOMIC_RELAXED))
             return;
-        }
-        /* RAW log is too big now, ignore new messages */
-        if (raw_file_stat.st_size > (off64_t)raw_log_max_size)
-        {
-            raw_log_too_big = true;
 
-            fprintf(stderr, "\nRAW LOG HAS REACHED SIZE LIMIT, ALL THE "
-                    "NEXT MESSAGES WILL BE LOST\n");
-            append_err_message("Raw log has reached limit of %llu bytes, "
-                               "new log messages are ignored and lost now",
-                               (long long unsigned)raw_log_max_size);
-            return;
-        }
+        fprintf(stderr, "\nRAW LOG HAS REACHED SIZE LIMIT, ALL THE "
+                "NEXT MESSAGES WILL BE LOST\n");
+        append_err_message("Raw log has reached limit of %llu bytes, "
+                           "new log messages are ignored and lost now",
+                           (long long unsigned)raw_log_max_size);
+        return;
     }
 
-    pthread_mutex_lock(&raw_file_mutex);
-    if (fwrite(buf, len, 1, raw_file) != 1)
-        perror("fwrite() failure");
-    if (fflush(raw_file) != 0)
-        perror("fflush(raw_file) failed");
-    pthread_mutex_unlock(&raw_file_mutex);
+    lgr_raw_write(buf, len);
 }
 
 static pthread_mutex_t add_remove_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -513,6 +482,10 @@ ta_flush_done(struct ipc_server *srv)
         ERROR("FATAL ERROR: Failed to read flush request: %r", rc);
         return rc;
     }
+
+    /* Make sure that flushed messages are really in the raw log */
+    lgr_raw_sync();
+
     rc = ipc_send_answer(srv, ipcsc_p, buf, len);
     if (rc != 0)
     {
@@ -524,12 +497,304 @@ ta_flush_done(struct ipc_server *srv)
     return 0;
 }
 
+/** State of TA log flush operation */
+typedef struct ta_flush_state {
+    bool            active;         /**< Flush is in progress */
+    bool            done;           /**< Flush is done, requester should
+                                         be replied */
+    unsigned int    msg_max;        /**< Number of messages to be got
+                                         before flush is interrupted */
+    struct timeval  ts;             /**< Time stamp when flush has been
+                                         started */
+    bool            barrier_set;    /**< Is sequence number barrier
+                                         known? */
+    uint32_t        barrier;        /**< Sequence number of the last
+                                         message registered on TA when
+                                         flush has been requested */
+} ta_flush_state;
+
+/**
+ * Start TA log flush operation.
+ *
+ * @param flush     Flush state
+ */
+static void
+ta_flush_start(ta_flush_state *flush)
+{
+    flush->active = true;
+    flush->msg_max = LGR_FLUSH_TA_MSG_MAX;
+    flush->barrier_set = false;
+    gettimeofday(&flush->ts, NULL);
+}
+
+/**
+ * Finish TA log flush operation (if it is in progress).
+ *
+ * @param flush     Flush state
+ */
+static void
+ta_flush_finish(ta_flush_state *flush)
+{
+    if (flush->active)
+    {
+        flush->active = false;
+        flush->done = true;
+    }
+}
+
+/**
+ * Check whether a message received from TA completes flush operation.
+ *
+ * If TA has reported the sequence number barrier, flush is completed
+ * when the message with the barrier sequence number is received.
+ * Otherwise the message timestamp is compared with the flush start
+ * time.
+ *
+ * @param inst      TA instance
+ * @param flush     Flush state
+ * @param sequence  Message sequence number
+ * @param hdr       Message header in raw log format
+ */
+static void
+ta_flush_check_msg(ta_inst *inst, ta_flush_state *flush,
+                   uint32_t sequence, const uint8_t *hdr)
+{
+    te_log_ts_sec   msg_ts_sec;
+    te_log_ts_usec  msg_ts_usec;
+
+    if (!flush->active)
+        return;
+
+    if (flush->barrier_set)
+    {
+        if ((int32_t)(sequence - flush->barrier) >= 0)
+            ta_flush_finish(flush);
+        return;
+    }
+
+    /* Message is started */
+    flush->msg_max--;
+
+    memcpy(&msg_ts_sec, hdr + sizeof(te_log_version),
+           sizeof(te_log_ts_sec));
+    msg_ts_sec = ntohl(msg_ts_sec);
+    memcpy(&msg_ts_usec,
+           hdr + sizeof(te_log_version) + sizeof(te_log_ts_sec),
+           sizeof(te_log_ts_usec));
+    msg_ts_usec = ntohl(msg_ts_usec);
+
+    /* Check timestamp value */
+    if ((msg_ts_sec > (te_log_ts_sec)flush->ts.tv_sec) ||
+        ((msg_ts_sec == (te_log_ts_sec)flush->ts.tv_sec) &&
+         (msg_ts_usec > (te_log_ts_usec)flush->ts.tv_usec)) ||
+        (flush->msg_max == 0))
+    {
+        ta_flush_finish(flush);
+        if (flush->msg_max == 0)
+        {
+            WARN("TA %s: Flush operation was interrupted",
+                 inst->agent);
+        }
+    }
+}
+
+/**
+ * Register messages from the bulk of TA log in the raw log.
+ *
+ * The bulk consists of messages in TE raw log format each prefixed
+ * with the message sequence number. Log ID of each message is replaced
+ * with @c TE_LOG_ID_UNDEFINED and TA name with @c '@' prefix is added
+ * as the entity name.
+ *
+ * @param inst      TA instance
+ * @param bulk      Log bulk
+ * @param bulk_len  Log bulk length
+ * @param flush     Flush state
+ *
+ * @return Status code.
+ */
+static te_errno
+ta_log_process_bulk(ta_inst *inst, const uint8_t *bulk, size_t bulk_len,
+                    ta_flush_state *flush)
+{
+    const uint8_t  *p = bulk;
+    const uint8_t  *end = bulk + bulk_len;
+    size_t          ta_name_len = strlen(inst->agent);
+    uint8_t         buf[LGR_TA_MAX_BUF];
+
+    while (p < end)
+    {
+        const uint8_t  *hdr;
+        const uint8_t  *fields;
+        uint8_t        *p_buf = buf;
+        uint32_t        sequence;
+        int             lost;
+        size_t          len;
+
+        /* Get message sequence number */
+        if ((size_t)(end - p) < sizeof(uint32_t) + TE_LOG_MSG_COMMON_HDR_SZ)
+            goto bad_bulk;
+        memcpy(&sequence, p, sizeof(sequence));
+        sequence = ntohl(sequence);
+        p += sizeof(uint32_t);
+
+        lost = sequence - inst->sequence - 1;
+        if (lost > 0)
+            WARN("TA %s: Lost %d messages", inst->agent, lost);
+        inst->sequence = sequence;
+
+        hdr = p;
+        p += TE_LOG_MSG_COMMON_HDR_SZ;
+
+        /* Find the end of the message fields */
+        fields = p;
+        do {
+            if ((size_t)(end - p) < sizeof(te_log_nfl))
+                goto bad_bulk;
+            len = te_log_raw_get_nfl(p);
+            p += sizeof(te_log_nfl);
+            if (len == TE_LOG_RAW_EOR_LEN)
+                break;
+            if ((size_t)(end - p) < len)
+                goto bad_bulk;
+            p += len;
+        } while (true);
+
+        ta_flush_check_msg(inst, flush, sequence, hdr);
+
+        if (TE_LOG_MSG_COMMON_HDR_SZ + sizeof(te_log_id) +
+            sizeof(te_log_nfl) + 1 + ta_name_len +
+            (size_t)(p - fields) > sizeof(buf))
+        {
+            ERROR("TA %s: Too long log message %u is skipped",
+                  inst->agent, sequence);
+            continue;
+        }
+
+        memcpy(p_buf, hdr, TE_LOG_MSG_COMMON_HDR_SZ);
+        p_buf += TE_LOG_MSG_COMMON_HDR_SZ;
+
+        /*
+         * Add log ID equal to TE_LOG_ID_UNDEFINED,
+         * as we log from Engine application - "Logger" itself.
+         */
+#if SIZEOF_TE_LOG_ID == 4
+        LGR_32_TO_NET(TE_LOG_ID_UNDEFINED, p_buf);
+#else
+#error Unsupported sizeof(te_log_id)
+#endif
+        p_buf += sizeof(te_log_id);
+
+        /* Add TA name with @ prefix and corresponding NFL to the message */
+        LGR_NFL_PUT(ta_name_len + 1, p_buf);
+        p_buf[0] = '@';
+        p_buf++;
+        memcpy(p_buf, inst->agent, ta_name_len);
+        p_buf += ta_name_len;
+
+        memcpy(p_buf, fields, p - fields);
+        p_buf += p - fields;
+
+        lgr_register_message(buf, p_buf - buf);
+    }
+
+    return 0;
+
+bad_bulk:
+    ERROR("TA %s: Invalid bulk of logs", inst->agent);
+    return TE_RC(TE_LOGGER, TE_EFMT);
+}
+
+/**
+ * Get the bulk of TA log via temporary file (legacy mode).
+ *
+ * @param inst      TA instance
+ * @param bulk      Location for the log bulk (should be freed by caller)
+ * @param bulk_len  Location for the log bulk length
+ *
+ * @return Status code.
+ */
+static te_errno
+ta_log_get_file(ta_inst *inst, uint8_t **bulk, size_t *bulk_len)
+{
+    char        log_file[RCF_MAX_PATH];
+    struct stat log_file_stat;
+    FILE       *ta_file;
+    size_t      len;
+    te_errno    rc;
+
+    *log_file = '\0';
+    rc = rcf_ta_get_log(inst->agent, log_file);
+    if (rc != 0)
+        return rc;
+
+    if (stat(log_file, &log_file_stat) < 0)
+    {
+        rc = TE_OS_RC(TE_LOGGER, errno);
+        ERROR("FATAL ERROR: TA %s: log file '%s' stat() failure: %r",
+              inst->agent, log_file, rc);
+        return rc;
+    }
+
+    *bulk_len = log_file_stat.st_size;
+    if (*bulk_len == 0)
+    {
+        /* File is empty */
+        ERROR("TA %s: log file '%s' is empty", inst->agent, log_file);
+        *bulk = NULL;
+    }
+    else
+    {
+        ta_file = fopen(log_file, "r");
+        if (ta_file == NULL)
+        {
+            rc = TE_OS_RC(TE_LOGGER, errno);
+            ERROR("FATAL ERROR: TA %s: fopen(%s) failure: %r",
+                  inst->agent, log_file, rc);
+            return rc;
+        }
+
+        *bulk = TE_ALLOC_UNINITIALIZED(*bulk_len);
+
+        len = fread(*bulk, 1, *bulk_len, ta_file);
+        if (len != *bulk_len)
+        {
+            ERROR("TA %s: Failed to read file '%s' with logs",
+                  inst->agent, log_file);
+            /* Continue with what has been read */
+            *bulk_len = len;
+        }
+
+        if (fclose(ta_file) != 0)
+        {
+            ERROR("TA %s: fclose() of '%s' failed: errno=%d",
+                  inst->agent, log_file, errno);
+            /* Continue */
+        }
+    }
+
+    if (remove(log_file) != 0)
+    {
+        ERROR("TA %s: Failed to delete file '%s': errno=%d",
+              inst->agent, log_file, errno);
+        /* Continue */
+    }
+
+    return 0;
+}
 
 /**
  * This is an entry point of TA log message gatherer.
  * This routine periodically polls appropriate TA to get
  * TA local log. Besides, log is solicited if flush is requested.
  *
+ * In streaming mode (default) log bulks are passed by RCF directly
+ * in memory, and TA is polled once again without waiting for polling
+ * timeout while it reports that some messages are left in its log
+ * buffer. Flush is completed when the message with the sequence
+ * number reported by TA on the first poll after flush request is
+ * received (or TA log buffer becomes empty).
+ *
  * @param  ta   Location of TA parameters.
  *
  * @return NULL
@@ -541,7 +806,7 @@ ta_handler(void *ta)
     ta_inst            *inst = (ta_inst *)ta;
     char                srv_name[LGR_MAX_NAME];
     struct ipc_server  *srv = NULL;
-    int                 fd_server;
+    int                 max_fd;
     fd_set              rfds;
     int                 rc;
     pthread_t           sniffer_thread;
@@ -551,22 +816,15 @@ ta_handler(void *ta)
     unsigned long int   polling;
     struct timeval      poll_ts;    /**< The last poll time stamp */
     struct timeval      now;        /**< Current time */
+    bool                drain = false;
 
-    /* Flush variavles */
-    bool do_flush = false;
-    bool flush_done = false;
-    unsigned int        flush_msg_max = 0;
-    struct timeval      flush_ts;   /**< Time stamp when flush has been
-                                         started */
-    te_log_ts_sec       msg_ts_sec;
-    te_log_ts_usec      msg_ts_usec;
+    /* Flush variables */
+    ta_flush_state      flush = { .active = false, .done = false };
 
-    /* Log file processing variables */
-    char                log_file[RCF_MAX_PATH];
-    struct stat         log_file_stat;
-    size_t              ta_name_len = strlen(inst->agent);
-    FILE               *ta_file;
-    uint8_t             buf[LGR_TA_MAX_BUF];
+    /* Log bulk processing variables */
+    uint8_t            *bulk;
+    size_t              bulk_len;
+    rcf_ta_log_status   status;
 
 
     /* Register IPC Server for the TA */
@@ -579,7 +837,6 @@ ta_handler(void *ta)
         return NULL;
     }
     assert(srv != NULL);
-    fd_server = ipc_get_server_fd(srv);
 
     /* Do not allow to poll in flood mode */
     if (inst->polling == 0)
@@ -603,18 +860,19 @@ ta_handler(void *ta)
     while (1)
     {
         /* If flush operation is done, reply to requester */
-        if (flush_done)
+        if (flush.done)
         {
-            flush_done = false;
+            flush.done = false;
             if (ta_flush_done(srv) != 0)
                 break;
         }
 
         /*
          * If we are not flushing, wait for polling timeout or
-         * flush request
+         * flush request (just check for flush request if TA log
+         * buffer is being drained)
          */
-        if (!do_flush)
+        if (!flush.active)
         {
             struct timeval delay = { 0, 0 };
 
@@ -633,7 +891,7 @@ ta_handler(void *ta)
              * Calculate period of time we should wait
              * before next get log.
              */
-            if (poll_ts.tv_sec >= now.tv_sec)
+            if (!drain && poll_ts.tv_sec >= now.tv_sec)
             {
                 delay.tv_sec = poll_ts.tv_sec - now.tv_sec;
 
@@ -649,49 +907,45 @@ ta_handler(void *ta)
                 }
             }
 
+            /*
+             * Connection-oriented IPC server has a socket per client
+             * in addition to the listening one.
+             */
             FD_ZERO(&rfds);
-            FD_SET(fd_server, &rfds);
+            max_fd = ipc_get_server_fds(srv, &rfds);
 
-            rc = select(fd_server + 1, &rfds, NULL, NULL, &delay);
+            rc = select(max_fd + 1, &rfds, NULL, NULL, &delay);
             if (rc < 0)
             {
                 break;
             }
-            else if (rc > 0)
+            else if (rc > 0 && ipc_is_server_ready(srv, &rfds, max_fd))
             {
-                if (FD_ISSET(fd_server, &rfds))
-                {
-                    /* Go into the logs flush mode */
-                    do_flush = true;
-                    flush_msg_max = LGR_FLUSH_TA_MSG_MAX;
-                    gettimeofday(&flush_ts, NULL);
-                }
-                else
-                {
-                    ERROR("FATAL ERROR: TA %s: select() returns %d, "
-                          "but server fd is not readable",
-                          inst->agent, rc);
-                    break;
-                }
+                /* Go into the logs flush mode */
+                ta_flush_start(&flush);
             }
-
-            /* Get time for filtering incoming messages */
         }
 
         /* Make time stamp when we poll TA */
         gettimeofday(&poll_ts, NULL);
 
-        *log_file = '\0';
-        if ((rc = rcf_ta_get_log(inst->agent, log_file)) != 0)
+        bulk = NULL;
+        bulk_len = 0;
+        memset(&status, 0, sizeof(status));
+        if (lgr_flags & LOGGER_TA_LOG_FILES)
+            rc = ta_log_get_file(inst, &bulk, &bulk_len);
+        else
+            rc = rcf_ta_get_log_data(inst->agent, &bulk, &bulk_len,
+                                     &status);
+        drain = false;
+        if (rc != 0)
         {
             /* Any error interrupts flush operation */
-            if (do_flush)
-            {
-                do_flush = false;
-                flush_done = true;
-            }
+            ta_flush_finish(&flush);
+
             if (/* No log messages */
                 (rc == TE_RC(TE_RCF_PCH, TE_ENOENT)) ||
+                (rc == TE_RC(TE_RCF_API, TE_ENOENT)) ||
                 /* RCF request to TA is timed out */
                 (rc == TE_RC(TE_RCF, TE_ETIMEDOUT)) ||
                 /* TA has been rebooted */
@@ -706,175 +960,33 @@ ta_handler(void *ta)
             else
             {
                 /* The rest of errors are considered as fatal */
-                ERROR("rcf_ta_get_log(ta_name='%s') returned fatal error "
-                      "%r, stop gathering logs from this TA",
+                ERROR("Failed to get log from TA '%s': %r, "
+                      "stop gathering logs from this TA",
                       inst->agent, rc);
                 break;
             }
         }
 
-        rc = stat(log_file, &log_file_stat);
-        if (rc < 0)
-        {
-            ERROR("FATAL ERROR: TA %s: log file '%s' stat() failure: "
-                  "errno=%d", inst->agent, log_file, errno);
-            break;
-        }
-        else if (log_file_stat.st_size == 0)
-        {
-            /* File is empty */
-            ERROR("TA %s: log file '%s' is empty", inst->agent, log_file);
-
-            if (remove(log_file) != 0)
-            {
-                ERROR("Failed to delete log file '%s': errno=%d",
-                      log_file, errno);
-                /* Continue */
-            }
-            if (do_flush)
-            {
-                do_flush = false;
-                flush_done = true;
-            }
-            continue;
-        }
-
-        ta_file = fopen(log_file, "r");
-        if (ta_file == NULL)
+        if (flush.active && status.valid && !flush.barrier_set)
         {
-            ERROR("FATAL ERROR: TA %s: fopen(%s) failure: errno=%d",
-                  inst->agent, log_file, errno);
-            break;
+            flush.barrier_set = true;
+            flush.barrier = status.last_seqno;
         }
 
-        do { /* messages reading loop */
-
-            uint8_t    *p_buf = buf;
-            uint32_t    sequence;
-            int         lost;
-            size_t      len;
-
-            /* Get message sequence number */
-            if (FREAD(ta_file, (uint8_t *)&sequence, sizeof(uint32_t)) !=
-                    sizeof(uint32_t))
-            {
-                break;
-            }
-            sequence = ntohl(sequence);
-            lost = sequence - inst->sequence - 1;
-            if (lost > 0)
-                WARN("TA %s: Lost %d messages", inst->agent, lost);
-            inst->sequence = sequence;
-
-            /* Read control fields value */
-            len = TE_LOG_MSG_COMMON_HDR_SZ;
-            if (FREAD(ta_file, p_buf, len) != len)
-            {
-                break;
-            }
-
-            /* Get message timestamp value */
-            if (do_flush)
-            {
-                /* Message is started */
-                flush_msg_max--;
-
-                memcpy(&msg_ts_sec,
-                       p_buf + sizeof(te_log_version),
-                       sizeof(te_log_ts_sec));
-                msg_ts_sec = ntohl(msg_ts_sec);
-                memcpy(&msg_ts_usec,
-                       p_buf + sizeof(te_log_version) +
-                       sizeof(te_log_ts_sec), sizeof(te_log_ts_usec));
-                msg_ts_usec = ntohl(msg_ts_usec);
-
-                /* Check timestamp value */
-                if ((msg_ts_sec > (te_log_ts_sec)flush_ts.tv_sec) ||
-                    ((msg_ts_sec == (te_log_ts_sec)flush_ts.tv_sec) &&
-                     (msg_ts_usec > (te_log_ts_usec)flush_ts.tv_usec)) ||
-                    (flush_msg_max == 0))
-                {
-                    do_flush = false;
-                    flush_done = true;
-                    if (flush_msg_max == 0)
-                    {
-                        WARN("TA %s: Flush operation was interrupted",
-                             inst->agent);
-                    }
-                }
-            }
-            p_buf += TE_LOG_MSG_COMMON_HDR_SZ;
+        if (bulk_len == 0)
+            ta_flush_finish(&flush);
+        else
+            (void)ta_log_process_bulk(inst, bulk, bulk_len, &flush);
 
-            /*
-             * Add log ID equal to TE_LOG_ID_UNDEFINED,
-             * as we log from Engine application - "Logger" itself.
-             */
-#if SIZEOF_TE_LOG_ID == 4
-            LGR_32_TO_NET(TE_LOG_ID_UNDEFINED, p_buf);
-#else
-#error Unsupported sizeof(te_log_id)
-#endif
-            p_buf += sizeof(te_log_id);
-
-            /* Add TA name with @ prefix and corresponding NFL to the message */
-            LGR_NFL_PUT(ta_name_len + 1, p_buf);
-            p_buf[0] = '@';
-            p_buf++;
-            memcpy(p_buf, inst->agent, ta_name_len);
-            p_buf += ta_name_len;
-
-            /* Read the first NFL after header */
-            if (FREAD(ta_file, p_buf, sizeof(te_log_nfl)) !=
-                    sizeof(te_log_nfl))
-            {
-                break;
-            }
-            len = te_log_raw_get_nfl(p_buf);
-            p_buf += sizeof(te_log_nfl);
-
-            while (len != TE_LOG_RAW_EOR_LEN)
-            {
-                /* Read the field in accordance with NFL */
-                if (len > 0 && FREAD(ta_file, p_buf, len) != len)
-                {
-                    break;
-                }
-                p_buf += len;
-
-                /* Read the next NFL */
-                if (FREAD(ta_file, p_buf, sizeof(te_log_nfl)) !=
-                        sizeof(te_log_nfl))
-                {
-                    break;
-                }
-                len = te_log_raw_get_nfl(p_buf);
-                p_buf += sizeof(te_log_nfl);
-            };
-            if (len != TE_LOG_RAW_EOR_LEN)
-                break;
-
-            lgr_register_message(buf, p_buf - buf);
-
-        } while (true);
+        free(bulk);
 
-        if (feof(ta_file) == 0)
+        if (status.valid)
         {
-            ERROR("TA %s: Invalid file '%s' with logs",
-                  inst->agent, log_file);
-            /* Continue */
-        }
-
-        if (fclose(ta_file) != 0)
-        {
-            ERROR("TA %s: fclose() of '%s' failed: errno=%d",
-                  inst->agent, log_file, errno);
-            /* Continue */
-        }
-        if (remove(log_file) != 0)
-        {
-            ERROR("TA %s: Failed to delete file '%s': errno=%d",
-                  inst->agent, log_file, errno);
-            /* Continue */
+            /* Nothing is left on TA, so the barrier cannot be reached */
+            if (!status.pending)
+                ta_flush_finish(&flush);
+            else
+                drain = true;
         }
 
     } /* end of forever loop */
@@ -885,7 +997,7 @@ ta_handler(void *ta)
         ERROR("pthread_join() failed: %s\n", err_buf);
     }
 
-    if (do_flush || flush_done)
+    if (flush.active || flush.done)
     {
         (void)ta_flush_done(srv);
     }
@@ -944,6 +1056,12 @@ process_cmd_line_opts(int argc, const char **argv)
           "properly formatted before storing them in the raw log file.",
           NULL },
 
+        { "ta-log-files", '\0',
+          POPT_ARG_NONE | POPT_BIT_SET, &lgr_flags, LOGGER_TA_LOG_FILES,
+          "Get Test Agents logs via temporary files on every polling "
+          "period instead of streaming them to Logger directly.",
+          NULL },
+
         { "listener", '\0',
           POPT_ARG_STRING, &listener_conf, LOGGER_OPT_LISTENER,
           "Enable a listener.", "confstr" },
@@ -1079,6 +1197,7 @@ sniffer_polling_sets_start_init(void)
     snifp_sets.rotation = 0;
     snifp_sets.period   = 0;
     snifp_sets.ofill    = ROTATION;
+    snifp_sets.compress = false;
     snifp_sets.errors   = false;
 
     sniffers_init();
@@ -1191,10 +1310,11 @@ main(int argc, const char *argv[])
         return EXIT_FAILURE;
     }
     /* Open raw log file for addition */
-    raw_file = fopen(te_log_raw, "ab");
-    if (raw_file == NULL)
+    rc = lgr_raw_open(te_log_raw);
+    if (rc != 0)
     {
-        perror("fopen() failure");
+        fprintf(stderr, "Failed to open raw log file '%s': %s\n",
+                te_log_raw, te_rc_err2str(rc));
         return EXIT_FAILURE;
     }
     /* Further we must goto 'exit' in the case of failure */
@@ -1248,6 +1368,14 @@ main(int argc, const char *argv[])
     /* Store my PID in global variable */
     pid = getpid();
 
+    /* Start writing of the raw log in background */
+    rc = lgr_raw_start();
+    if (rc != 0)
+    {
+        ERROR("Failed to start raw log writer: %r", rc);
+        goto exit;
+    }
+
     /* Apply default sniffer settings */
     sniffer_polling_sets_start_init();
     /* Parse configuration file */
@@ -1459,14 +1587,11 @@ exit:
 
     RING("Shutdown is completed");
 
-    if (fflush(raw_file) != 0)
-    {
-        perror("fflush() failed");
-        result = EXIT_FAILURE;
-    }
-    if (fclose(raw_file) != 0)
+    rc = lgr_raw_close();
+    if (rc != 0)
     {
-        perror("fclose() failed");
+        fprintf(stderr, "Failed to close raw log file: %s\n",
+                te_rc_err2str(rc));
         result = EXIT_FAILURE;
     }
 
@@ -459,6 +459,23 @@ handle_sniffers(yaml_document_t *d, yaml_node_t *section)
                 return -1;
             }
         }
+        else if (strcmp(key, "compression") == 0)
+        {
+            if (strcmp(value, "gzip") == 0)
+            {
+                snifp_sets.compress = true;
+            }
+            else if (strcmp(value, "none") == 0)
+            {
+                snifp_sets.compress = false;
+            }
+            else
+            {
+                ERROR("%s: Invalid value for \"compression\": %s",
+                      __FUNCTION__, value);
+                return -1;
+            }
+        }
     }
 
     return 0;
@@ -820,6 +837,8 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
     yaml_node_t      *buffer_size = NULL;
     yaml_node_t      *buffers_num = NULL;
     yaml_node_t      *trail_slash = NULL;
+    yaml_node_t      *spool_size  = NULL;
+    yaml_node_t      *compression = NULL;
     const char       *name_str    = NULL;
     const char       *url_str     = NULL;
     const char       *enabled_str = NULL;
@@ -828,6 +847,8 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
     const char       *buffer_size_str = NULL;
     const char       *buffers_num_str = NULL;
     const char       *trail_slash_str = NULL;
+    const char       *spool_size_str  = NULL;
+    const char       *compression_str = NULL;
     unsigned long     tmp;
 
     log_listener_conf *current_conf;
@@ -864,6 +885,10 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
             buffers_num = v;
         else if (strcmp(key, "trailing_slash") == 0)
             trail_slash = v;
+        else if (strcmp(key, "spool_size") == 0)
+            spool_size = v;
+        else if (strcmp(key, "compression") == 0)
+            compression = v;
     }
 
     current = &listeners[listeners_num];
@@ -1016,6 +1041,47 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
     if (te_yaml_value_is_true(trail_slash_str))
         current->trailing_slash = true;
 
+    current->spool_size = LOG_DEF_LISTENER_SPOOL_SIZE;
+    spool_size_str = te_yaml_scalar_value(spool_size);
+    if (spool_size != NULL && spool_size_str == NULL)
+    {
+        ERROR("%s(%s): Spool size is not a scalar", __FUNCTION__, name_str);
+        return -1;
+    }
+    if (spool_size_str != NULL)
+    {
+        rc = te_strtoul(spool_size_str, 0, &tmp);
+        if (rc != 0)
+        {
+            ERROR("%s(%s): Incorrect value of 'spool_size' attribute: %s (%r)",
+                  __FUNCTION__, name_str, spool_size_str, rc);
+            return -1;
+        }
+        current->spool_size = tmp;
+    }
+    current->spool_fd = -1;
+
+    current->compression = LISTENER_COMPRESSION_NONE;
+    compression_str = te_yaml_scalar_value(compression);
+    if (compression != NULL && compression_str == NULL)
+    {
+        ERROR("%s(%s): Compression is not a scalar", __FUNCTION__, name_str);
+        return -1;
+    }
+    if (compression_str != NULL)
+    {
+        if (strcmp(compression_str, "gzip") == 0)
+        {
+            current->compression = LISTENER_COMPRESSION_GZIP;
+        }
+        else if (strcmp(compression_str, "none") != 0)
+        {
+            ERROR("%s(%s): Unsupported compression: %s",
+                  __FUNCTION__, name_str, compression_str);
+            return -1;
+        }
+    }
+
     msg_buffer_init(&current->buffer);
     current->state = LISTENER_INIT;
     current->curl_handle = curl_easy_init();
@@ -1028,6 +1094,7 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
     current->buffer_in = (te_dbuf)TE_DBUF_INIT(100);
 
     current->buffer_out = (te_string)TE_STRING_INIT;
+    current->buffer_gz = (te_dbuf)TE_DBUF_INIT(TE_DBUF_DEFAULT_GROW_FACTOR);
 
 #define SET_CURL_OPT(OPT, ARG) \
     do {                                                                  \
@@ -1111,6 +1178,24 @@ add_listener(yaml_document_t *d, yaml_node_t *listener)
         ERROR("%s(%s): curl_slist_append failed", __FUNCTION__, name_str);
         return -1;
     }
+
+    /* /feed requests may carry compressed data */
+    current->feed_headers = curl_slist_append(NULL,
+                                              "Content-Type: application/json");
+    if (current->feed_headers != NULL)
+        current->feed_headers = curl_slist_append(current->feed_headers,
+                                                  "Expect:");
+    if (current->feed_headers != NULL &&
+        current->compression == LISTENER_COMPRESSION_GZIP)
+    {
+        current->feed_headers = curl_slist_append(current->feed_headers,
+                                                  "Content-Encoding: gzip");
+    }
+    if (current->feed_headers == NULL)
+    {
+        ERROR("%s(%s): curl_slist_append failed", __FUNCTION__, name_str);
+        return -1;
+    }
     SET_CURL_OPT(CURLOPT_HTTPHEADER, current->headers);
 #undef SET_CURL_OPT
 
@@ -1338,6 +1423,7 @@ config_parser(const char *filename)
     VERB("snifp_sets.osize    %u\n", snifp_sets.osize);
     VERB("snifp_sets.ofill    %u\n", snifp_sets.ofill);
     VERB("snifp_sets.period   %u\n", snifp_sets.period);
+    VERB("snifp_sets.compress %u\n", snifp_sets.compress);
 
     for (i = 0; i < listener_confs_num; i++)
     {
@@ -95,6 +95,7 @@ typedef struct snif_polling_sets_t {
     unsigned        period;             /**< Period for capture logs
                                              polling */
     overfill_type   ofill;              /**< Overfill handle method */
+    bool compress;           /**< Compress capture logs on agents */
     bool errors;             /**< Errors flag */
 } snif_polling_sets_t;
 
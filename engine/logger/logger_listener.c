@@ -11,7 +11,12 @@
 
 #include <stddef.h>
 #include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/time.h>
+#include <sys/uio.h>
+#include <zlib.h>
 
 #include "te_defs.h"
 #include "te_str.h"
@@ -19,6 +24,8 @@
 #include "logger_internal.h"
 #include "logger_listener.h"
 
+extern const char *te_log_dir;
+
 log_listener_conf listener_confs[LOG_MAX_LISTENERS];
 size_t            listener_confs_num;
 log_listener      listeners[LOG_MAX_LISTENERS];
@@ -26,6 +33,7 @@ size_t            listeners_num;
 
 static te_errno
 listener_prepare_request(log_listener *listener, const char *url_suffix,
+                         struct curl_slist *headers,
                          void *data, long data_len)
 {
     char *url;
@@ -49,7 +57,7 @@ listener_prepare_request(log_listener *listener, const char *url_suffix,
         }                                                             \
     } while (0)
 
-    SET_CURL_OPT(CURLOPT_HTTPHEADER, listener->headers);
+    SET_CURL_OPT(CURLOPT_HTTPHEADER, headers);
     SET_CURL_OPT(CURLOPT_POSTFIELDSIZE, data_len);
     SET_CURL_OPT(CURLOPT_POSTFIELDS, data);
     SET_CURL_OPT(CURLOPT_POST, 1L);
@@ -175,6 +183,7 @@ listener_init(log_listener *listener, json_t *data)
 
     rc = listener_prepare_request(listener,
                                   listener->trailing_slash ? "init/" : "init",
+                                  listener->headers,
                                   listener->buffer_out.ptr,
                                   listener->buffer_out.len);
     if (rc != 0)
@@ -189,6 +198,101 @@ listener_init(log_listener *listener, json_t *data)
     return 0;
 }
 
+/**
+ * Open the spool file of a listener if it is not opened yet.
+ *
+ * @param listener          listener description
+ *
+ * @returns Status code
+ */
+static te_errno
+listener_spool_open(log_listener *listener)
+{
+    te_errno rc;
+
+    if (listener->spool_fd >= 0)
+        return 0;
+
+    free(listener->spool_path);
+    listener->spool_path = te_string_fmt("%s/listener_%s.spool",
+                                         te_log_dir, listener->name);
+    if (listener->spool_path == NULL)
+        return TE_ENOMEM;
+
+    listener->spool_fd = open(listener->spool_path,
+                              O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (listener->spool_fd < 0)
+    {
+        rc = te_rc_os2te(errno);
+        ERROR("Listener %s: failed to create spool file %s, "
+              "spooling is disabled: %r",
+              listener->name, listener->spool_path, rc);
+        listener->spool_size = 0;
+        return rc;
+    }
+
+    listener->spool_rd = 0;
+    listener->spool_wr = 0;
+    RING("Listener %s: buffer is full, spooling messages to %s",
+         listener->name, listener->spool_path);
+    return 0;
+}
+
+/**
+ * Move the oldest message from listener's buffer to the spool file.
+ * The message is dropped if the spooled messages which are not sent yet
+ * already take the maximum size or the spool file cannot be written.
+ *
+ * Spool file is a sequence of messages, each prefixed with its length
+ * (32 bits in host byte order).
+ *
+ * @param listener          listener description
+ */
+static void
+listener_spool_first(log_listener *listener)
+{
+    refcnt_buffer *item = TAILQ_FIRST(&listener->buffer.items);
+    uint32_t       len = item->len;
+    struct iovec   iov[2];
+    ssize_t        ret;
+
+    if (listener->spool_size == 0 ||
+        (size_t)(listener->spool_wr - listener->spool_rd) +
+            sizeof(len) + len > listener->spool_size ||
+        listener_spool_open(listener) != 0)
+    {
+        if (listener->dropped++ == 0)
+        {
+            WARN("Listener %s: buffer%s is full, dropping messages",
+                 listener->name, listener->spool_size == 0 ? "" :
+                                 " and spool file");
+        }
+        msg_buffer_remove_first(&listener->buffer);
+        return;
+    }
+
+    iov[0].iov_base = &len;
+    iov[0].iov_len = sizeof(len);
+    iov[1].iov_base = item->buf;
+    iov[1].iov_len = item->len;
+    ret = pwritev(listener->spool_fd, iov, TE_ARRAY_LEN(iov),
+                  listener->spool_wr);
+    if (ret != (ssize_t)(sizeof(len) + len))
+    {
+        ERROR("Listener %s: failed to write spool file, "
+              "spooling is disabled: %s", listener->name,
+              ret < 0 ? strerror(errno) : "short write");
+        listener->spool_size = 0;
+        listener->dropped++;
+    }
+    else
+    {
+        listener->spool_wr += ret;
+    }
+
+    msg_buffer_remove_first(&listener->buffer);
+}
+
 /* See description in logger_listener.h */
 te_errno
 listener_add_msg(log_listener *listener, const refcnt_buffer *msg)
@@ -202,7 +306,148 @@ listener_add_msg(log_listener *listener, const refcnt_buffer *msg)
     while (listener->buffer.n_items > 1 &&
            listener->buffer.total_length >
              listener->buffer_size * listener->buffers_num)
-        msg_buffer_remove_first(&listener->buffer);
+        listener_spool_first(listener);
+
+    return 0;
+}
+
+/* See description in logger_listener.h */
+size_t
+listener_pending(const log_listener *listener)
+{
+    return listener->buffer.total_length +
+           (listener->spool_wr - listener->spool_rd);
+}
+
+/**
+ * Append a message to the outgoing JSON array.
+ *
+ * @param listener          listener description
+ * @param msg               message
+ * @param len               length of the message
+ */
+static void
+listener_out_append(log_listener *listener, const char *msg, size_t len)
+{
+    /* The first byte is the opening bracket */
+    if (listener->buffer_out.len > 1)
+        te_string_append(&listener->buffer_out, ",");
+    te_string_append_buf(&listener->buffer_out, msg, len);
+}
+
+/**
+ * Move spooled messages to the outgoing buffer (they are older than
+ * messages in listener's buffer, so they are sent first).
+ *
+ * @param listener          listener description
+ *
+ * @returns Status code
+ */
+static te_errno
+listener_out_append_spooled(log_listener *listener)
+{
+    te_string *out = &listener->buffer_out;
+    uint32_t   len;
+    te_errno   rc;
+
+    errno = 0;
+    while (listener->spool_rd < listener->spool_wr &&
+           out->len <= listener->buffer_size)
+    {
+        if (pread(listener->spool_fd, &len, sizeof(len),
+                  listener->spool_rd) != sizeof(len))
+            goto fail;
+
+        if (out->len > 1)
+            te_string_append(out, ",");
+        te_string_reserve(out, out->len + len + 1);
+        if (pread(listener->spool_fd, out->ptr + out->len, len,
+                  listener->spool_rd + sizeof(len)) != (ssize_t)len)
+            goto fail;
+        out->len += len;
+        out->ptr[out->len] = '\0';
+
+        listener->spool_rd += sizeof(len) + len;
+    }
+
+    /* Start from scratch once everything is read */
+    if (listener->spool_rd == listener->spool_wr && listener->spool_wr > 0)
+    {
+        if (ftruncate(listener->spool_fd, 0) != 0)
+            WARN("Listener %s: failed to truncate spool file: %s",
+                 listener->name, strerror(errno));
+        listener->spool_rd = 0;
+        listener->spool_wr = 0;
+    }
+#ifdef FALLOC_FL_PUNCH_HOLE
+    /*
+     * Otherwise release disk space taken by messages which are read,
+     * so that the spool file takes no more than its maximum size
+     * while new messages are appended to it.
+     */
+    else if (listener->spool_rd > 0 &&
+             fallocate(listener->spool_fd,
+                       FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                       0, listener->spool_rd) != 0 && errno != EOPNOTSUPP)
+    {
+        WARN("Listener %s: failed to release read part of spool file: %s",
+             listener->name, strerror(errno));
+    }
+#endif
+
+    return 0;
+
+fail:
+    rc = errno == 0 ? TE_EIO : te_rc_os2te(errno);
+    ERROR("Listener %s: failed to read spool file: %r", listener->name, rc);
+    return rc;
+}
+
+/**
+ * Compress the outgoing buffer with gzip.
+ *
+ * @param listener          listener description
+ *
+ * @returns Status code
+ */
+static te_errno
+listener_out_compress(log_listener *listener)
+{
+    te_dbuf  *gz = &listener->buffer_gz;
+    z_stream  zs;
+    uLong     bound;
+    int       ret;
+
+    memset(&zs, 0, sizeof(zs));
+    /* Adding 16 to window bits makes zlib write gzip header */
+    ret = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                       Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK)
+    {
+        ERROR("Listener %s: failed to initialize compression: %d",
+              listener->name, ret);
+        return TE_EFAIL;
+    }
+
+    te_dbuf_reset(gz);
+    bound = deflateBound(&zs, listener->buffer_out.len);
+    if (gz->size < bound)
+        te_dbuf_expand(gz, bound - gz->size);
+
+    zs.next_in = (Bytef *)listener->buffer_out.ptr;
+    zs.avail_in = listener->buffer_out.len;
+    zs.next_out = gz->ptr;
+    zs.avail_out = gz->size;
+    ret = deflate(&zs, Z_FINISH);
+    gz->len = zs.total_out;
+    deflateEnd(&zs);
+
+    if (ret != Z_STREAM_END)
+    {
+        ERROR("Listener %s: failed to compress data: %d",
+              listener->name, ret);
+        return TE_EFAIL;
+    }
 
     return 0;
 }
@@ -216,27 +461,48 @@ listener_dump(log_listener *listener)
     refcnt_buffer *tmp;
     char          *url_suffix;
 
-    /* Fill the out buffer. TODO: get rid of this bufferring? */
     te_string_reset(&listener->buffer_out);
     te_string_append(&listener->buffer_out, "[");
+
+    rc = listener_out_append_spooled(listener);
+    if (rc != 0)
+    {
+        listener_free(listener);
+        return rc;
+    }
+
     TAILQ_FOREACH_SAFE(item, &listener->buffer.items, links, tmp)
     {
-        te_string_append(&listener->buffer_out, "%.*s", item->len, item->buf);
-        /* No need to store another copy of the message */
-        msg_buffer_remove_first(&listener->buffer);
         if (listener->buffer_out.len > listener->buffer_size)
             break;
-        if (!TAILQ_EMPTY(&listener->buffer.items))
-            te_string_append(&listener->buffer_out, ",");
+        listener_out_append(listener, item->buf, item->len);
+        /* No need to store another copy of the message */
+        msg_buffer_remove_first(&listener->buffer);
     }
     te_string_append(&listener->buffer_out, "]");
 
     /* Prepare HTTP request */
-    url_suffix = te_string_fmt("feed%.*s?run=%s",
+    url_suffix = te_string_fmt("feed%.*s?run=%s&seq=%" TE_PRINTF_64 "u",
                                listener->trailing_slash ? 1 : 0, "/",
-                               listener->runid);
-    rc = listener_prepare_request(listener, url_suffix, listener->buffer_out.ptr,
-                                  (long)listener->buffer_out.len);
+                               listener->runid, listener->feed_seq);
+    if (listener->compression == LISTENER_COMPRESSION_GZIP)
+    {
+        rc = listener_out_compress(listener);
+        if (rc == 0)
+        {
+            rc = listener_prepare_request(listener, url_suffix,
+                                          listener->feed_headers,
+                                          listener->buffer_gz.ptr,
+                                          (long)listener->buffer_gz.len);
+        }
+    }
+    else
+    {
+        rc = listener_prepare_request(listener, url_suffix,
+                                      listener->feed_headers,
+                                      listener->buffer_out.ptr,
+                                      (long)listener->buffer_out.len);
+    }
     free(url_suffix);
     if (rc != 0)
     {
@@ -430,6 +696,7 @@ listener_finish_request(log_listener *listener, CURLcode result)
          * should not occupy our computational resources. They will also
          * not get in the way of Logger exiting once it's told to shutdown.
          */
+        te_dbuf_reset(&listener->buffer_in);
         listener->need_retry = true;
         gettimeofday(&listener->next_tv, NULL);
         listener->next_tv.tv_sec += listener->interval;
@@ -450,6 +717,20 @@ listener_finish_request(log_listener *listener, CURLcode result)
         case LISTENER_INIT_WAITING:
             return listener_finish_request_init(listener, response_code);
         case LISTENER_TRANSFERRING:
+            /*
+             * The listener may be restarting or overloaded, send
+             * the same data (with the same sequence number) later.
+             */
+            if (response_code >= 500 || response_code == 429)
+            {
+                WARN("Listener %s: /feed returned %d, will retry",
+                     listener->name, response_code);
+                te_dbuf_reset(&listener->buffer_in);
+                listener->need_retry = true;
+                gettimeofday(&listener->next_tv, NULL);
+                listener->next_tv.tv_sec += listener->interval;
+                return 0;
+            }
             /* Check response code */
             if (response_code != 200 && response_code != 204)
             {
@@ -461,9 +742,10 @@ listener_finish_request(log_listener *listener, CURLcode result)
             }
             if (response_code == 200)
                 check_dump_response_body(listener);
+            listener->feed_seq++;
             gettimeofday(&listener->next_tv, NULL);
             /* Don't delay next dump if there are already enough messages for it */
-            if (listener->buffer.total_length < listener->buffer_size)
+            if (listener_pending(listener) < listener->buffer_size)
                 listener->next_tv.tv_sec += listener->interval;
             listener->state = LISTENER_GATHERING;
             break;
@@ -519,7 +801,7 @@ listener_finish(log_listener *listener)
     url_suffix = te_string_fmt("finish%.*s?run=%s",
                                listener->trailing_slash ? 1 : 0, "/",
                                listener->runid);
-    rc = listener_prepare_request(listener, url_suffix,
+    rc = listener_prepare_request(listener, url_suffix, listener->headers,
                                   listener->buffer_out.ptr,
                                   listener->buffer_out.len);
     free(url_suffix);
@@ -540,12 +822,40 @@ listener_finish(log_listener *listener)
 void
 listener_free(log_listener *listener)
 {
+    size_t pending = listener_pending(listener);
+
+    if (listener->dropped > 0)
+    {
+        ERROR("Listener %s: %" TE_PRINTF_64 "u messages were dropped",
+              listener->name, listener->dropped);
+        listener->dropped = 0;
+    }
+    if (pending > 0)
+    {
+        ERROR("Listener %s: %zu bytes of messages were not sent",
+              listener->name, pending);
+    }
+
     curl_easy_cleanup(listener->curl_handle);
     listener->curl_handle = NULL;
     curl_slist_free_all(listener->headers);
     listener->headers = NULL;
+    curl_slist_free_all(listener->feed_headers);
+    listener->feed_headers = NULL;
     te_dbuf_free(&listener->buffer_in);
     te_string_free(&listener->buffer_out);
+    te_dbuf_free(&listener->buffer_gz);
     msg_buffer_free(&listener->buffer);
+
+    if (listener->spool_fd >= 0)
+    {
+        close(listener->spool_fd);
+        listener->spool_fd = -1;
+        unlink(listener->spool_path);
+    }
+    free(listener->spool_path);
+    listener->spool_path = NULL;
+    listener->spool_rd = 0;
+    listener->spool_wr = 0;
     listener->state = LISTENER_FINISHED;
 }
@@ -11,6 +11,7 @@
 #define __TE_LOGGER_LISTENER_H__
 
 #include <stdio.h>
+#include <sys/types.h>
 #include <curl/curl.h>
 #include <jansson.h>
 
@@ -30,6 +31,8 @@ extern "C" {
 #define LOG_MAX_LISTENER_RUNID      32
 #define LOG_MAX_LISTENER_URL        256
 #define LOG_MAX_LISTENER_DUMP_LEN   (10 * 1024)
+/** Default maximum size of listener's spool file */
+#define LOG_DEF_LISTENER_SPOOL_SIZE (256 * 1024 * 1024)
 
 /** Listener operation state */
 typedef enum listener_state {
@@ -44,6 +47,13 @@ typedef enum listener_state {
     LISTENER_FINISHED      /**< Listener has finished its operation */
 } listener_state;
 
+/** Compression of data sent to listener */
+typedef enum listener_compression {
+    LISTENER_COMPRESSION_NONE, /**< Data is sent as is */
+    LISTENER_COMPRESSION_GZIP, /**< Data is sent with gzip
+                                    content-encoding */
+} listener_compression;
+
 /** Listener configuration supplied through command-line options */
 typedef struct log_listener_conf {
     char name[LOG_MAX_LISTENER_NAME];   /**< Name */
@@ -70,9 +80,32 @@ typedef struct log_listener {
     size_t             buffer_size; /**< Virtual buffer size */
     size_t             buffers_num; /**< Number of virtual message buffers */
     struct curl_slist *headers;     /**< HTTP headers for CURL requests */
+    struct curl_slist *feed_headers; /**< HTTP headers for /feed requests */
+    listener_compression compression; /**< Compression of /feed data */
+    uint64_t           feed_seq;    /**< Sequence number of the next
+                                         /feed request (it is not changed
+                                         when a request is retried, so
+                                         the listener may detect
+                                         duplicates) */
+
+    size_t             spool_size;  /**< Maximum total size of spooled
+                                         messages which are not sent yet
+                                         (if @c 0, messages which do not
+                                         fit into the buffer are dropped) */
+    char              *spool_path;  /**< Path to the spool file */
+    int                spool_fd;    /**< Spool file descriptor (@c -1
+                                         if it is not opened yet) */
+    off_t              spool_rd;    /**< Offset of the first message
+                                         in the spool file which is not
+                                         sent yet */
+    off_t              spool_wr;    /**< Offset of the end of the spool
+                                         file */
+    uint64_t           dropped;     /**< Number of dropped messages */
 
     te_dbuf            buffer_in;   /**< Buffer for HTTP responses */
     te_string          buffer_out;  /**< Buffer for outgoing data */
+    te_dbuf            buffer_gz;   /**< Buffer for compressed outgoing
+                                         data */
     bool trailing_slash; /**< Whether to add a trailing slash to
                                             URLs (for Django compatibility) */
 } log_listener;
@@ -91,6 +124,9 @@ extern te_errno listener_init(log_listener *listener,
 /**
  * Add message to listener's buffer.
  *
+ * If the buffer is full, the oldest messages are moved to the spool
+ * file; they are dropped only if the spool file is full as well.
+ *
  * @param listener          listener description
  * @param msg               message
  *
@@ -99,6 +135,16 @@ extern te_errno listener_init(log_listener *listener,
 extern te_errno listener_add_msg(log_listener *listener,
                                  const refcnt_buffer *msg);
 
+/**
+ * Get total length of messages not yet sent to listener (including
+ * the spooled ones).
+ *
+ * @param listener          listener description
+ *
+ * @returns Number of bytes.
+ */
+extern size_t listener_pending(const log_listener *listener);
+
 /**
  * Dump messages to listener.
  *
@@ -129,7 +175,9 @@ extern te_errno listener_finish_request(log_listener *listener,
 extern te_errno listener_finish(log_listener *listener);
 
 /**
- * Deinitialize listener and free its resources.
+ * Deinitialize listener and free its resources. Messages which are not
+ * sent yet are lost; the number of dropped messages and the size of
+ * messages which were not sent are logged.
  *
  * @param listener          listener description
  */
@@ -0,0 +1,654 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief TE project. Logger subsystem.
+ *
+ * Raw log file writer.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include "te_config.h"
+
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif
+#ifdef HAVE_STRING_H
+#include <string.h>
+#endif
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#ifdef HAVE_SYS_STAT_H
+#include <sys/stat.h>
+#endif
+#ifdef HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+#include <sched.h>
+
+#include "logger_raw.h"
+
+/** Maximum number of chunks written by a single writev() call */
+#ifdef IOV_MAX
+#define LGR_RAW_IOV_MAX     IOV_MAX
+#else
+#define LGR_RAW_IOV_MAX     1024
+#endif
+
+/** Header of a message in a staging buffer */
+typedef struct lgr_raw_rec {
+    uint64_t    seqno;  /**< Sequence number of the message */
+    size_t      len;    /**< Length of the message following the header */
+} lgr_raw_rec;
+
+/**
+ * Staging buffer of a thread.
+ *
+ * It is a ring buffer with a single producer (the thread owning it)
+ * and a single consumer (a thread holding file_mutex). Both positions
+ * grow monotonically, a position in the buffer is taken modulo its size.
+ */
+typedef struct lgr_raw_stage {
+    struct lgr_raw_stage   *next;   /**< Next buffer in the list */
+    uint8_t                *buf;    /**< Buffer of LGR_RAW_STAGE_SIZE */
+    size_t                  head;   /**< End of staged data, changed by
+                                         the producer only */
+    size_t                  tail;   /**< Start of staged data, changed
+                                         under file_mutex only */
+    size_t                  pos;    /**< Position of the next message
+                                         to write, used by drain */
+    size_t                  end;    /**< End of staged data seen by
+                                         drain */
+    bool                    dead;   /**< The owner thread has exited */
+} lgr_raw_stage;
+
+/** Raw log file descriptor */
+static int raw_fd = -1;
+
+/** Size of the raw log including staged messages */
+static uint64_t raw_size = 0;
+
+/**
+ * Sequence number of the next registered message. Messages are
+ * written to the file in the order of sequence numbers.
+ */
+static uint64_t raw_seqno = 0;
+/**
+ * Sequence number of the next message to be written to the file,
+ * changed under file_mutex only
+ */
+static uint64_t raw_next = 0;
+
+/** Mutex protecting direct writes to the file (and writer passes) */
+static pthread_mutex_t file_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** List of staging buffers */
+static lgr_raw_stage *stages = NULL;
+/** Mutex protecting the list of staging buffers */
+static pthread_mutex_t stages_mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Key to release a staging buffer on the owner thread exit */
+static pthread_key_t stage_key;
+
+/** Mutex protecting the writer state below */
+static pthread_mutex_t writer_mutex = PTHREAD_MUTEX_INITIALIZER;
+/** Condition to wake up the writer */
+static pthread_cond_t writer_cond = PTHREAD_COND_INITIALIZER;
+/** Condition signalled after every writer pass */
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+/** Writer thread */
+static pthread_t writer_thread;
+/** Is the writer thread running? */
+static bool writer_running = false;
+/** Writer pass is requested without waiting for the period */
+static bool writer_kick = false;
+/** Messages before this sequence number should be synchronized */
+static uint64_t sync_req = 0;
+/** Messages before this sequence number are synchronized */
+static uint64_t sync_done = 0;
+
+/**
+ * Write data to the raw log file completely.
+ *
+ * @param iov       chunks of data (modified)
+ * @param iovcnt    number of chunks
+ */
+static void
+lgr_raw_writev_all(struct iovec *iov, int iovcnt)
+{
+    ssize_t rc;
+
+    while (iovcnt > 0)
+    {
+        rc = writev(raw_fd, iov, iovcnt);
+        if (rc < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("writev() to raw log failed");
+            return;
+        }
+
+        while (iovcnt > 0 && (size_t)rc >= iov->iov_len)
+        {
+            rc -= iov->iov_len;
+            iov++;
+            iovcnt--;
+        }
+        if (iovcnt > 0)
+        {
+            iov->iov_base = (uint8_t *)iov->iov_base + rc;
+            iov->iov_len -= rc;
+        }
+    }
+}
+
+/**
+ * Copy data to a staging buffer.
+ *
+ * @param stage     staging buffer
+ * @param pos       position in the buffer
+ * @param data      data to copy
+ * @param len       length of data
+ */
+static void
+lgr_raw_stage_put(lgr_raw_stage *stage, size_t pos, const void *data,
+                  size_t len)
+{
+    size_t off = pos & (LGR_RAW_STAGE_SIZE - 1);
+
+    if (off + len > LGR_RAW_STAGE_SIZE)
+    {
+        memcpy(stage->buf + off, data, LGR_RAW_STAGE_SIZE - off);
+        memcpy(stage->buf, (const uint8_t *)data + LGR_RAW_STAGE_SIZE - off,
+               off + len - LGR_RAW_STAGE_SIZE);
+    }
+    else
+    {
+        memcpy(stage->buf + off, data, len);
+    }
+}
+
+/**
+ * Copy data from a staging buffer.
+ *
+ * @param stage     staging buffer
+ * @param pos       position in the buffer
+ * @param data      where to copy data
+ * @param len       length of data
+ */
+static void
+lgr_raw_stage_take(const lgr_raw_stage *stage, size_t pos, void *data,
+                   size_t len)
+{
+    size_t off = pos & (LGR_RAW_STAGE_SIZE - 1);
+
+    if (off + len > LGR_RAW_STAGE_SIZE)
+    {
+        memcpy(data, stage->buf + off, LGR_RAW_STAGE_SIZE - off);
+        memcpy((uint8_t *)data + LGR_RAW_STAGE_SIZE - off, stage->buf,
+               off + len - LGR_RAW_STAGE_SIZE);
+    }
+    else
+    {
+        memcpy(data, stage->buf + off, len);
+    }
+}
+
+/**
+ * Release a staging buffer of an exited thread. The buffer is
+ * freed by the writer when all its messages are written.
+ *
+ * @param data      staging buffer
+ */
+static void
+lgr_raw_stage_release(void *data)
+{
+    lgr_raw_stage *stage = data;
+
+    __atomic_store_n(&stage->dead, true, __ATOMIC_RELEASE);
+}
+
+/**
+ * Get the staging buffer of the current thread, create it if required.
+ *
+ * @return Staging buffer or @c NULL if messages should be written
+ *         directly.
+ */
+static lgr_raw_stage *
+lgr_raw_stage_get(void)
+{
+    lgr_raw_stage *stage;
+
+    if (!__atomic_load_n(&writer_running, __ATOMIC_ACQUIRE))
+        return NULL;
+
+    stage = pthread_getspecific(stage_key);
+    if (stage != NULL)
+        return stage;
+
+    stage = calloc(1, sizeof(*stage));
+    if (stage == NULL)
+        return NULL;
+    stage->buf = malloc(LGR_RAW_STAGE_SIZE);
+    if (stage->buf == NULL || pthread_setspecific(stage_key, stage) != 0)
+    {
+        free(stage->buf);
+        free(stage);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&stages_mutex);
+    stage->next = stages;
+    stages = stage;
+    pthread_mutex_unlock(&stages_mutex);
+
+    return stage;
+}
+
+/** Wake up the writer. It should be called under writer_mutex. */
+static void
+lgr_raw_kick(void)
+{
+    writer_kick = true;
+    pthread_cond_signal(&writer_cond);
+}
+
+/**
+ * Write chunks of staged messages to the file and release the space
+ * they occupy in staging buffers. It should be called under file_mutex.
+ *
+ * @param list      list of staging buffers
+ * @param iov       chunks of data (modified)
+ * @param iovcnt    number of chunks
+ */
+static void
+lgr_raw_flush(lgr_raw_stage *list, struct iovec *iov, int iovcnt)
+{
+    lgr_raw_stage *stage;
+
+    lgr_raw_writev_all(iov, iovcnt);
+    for (stage = list; stage != NULL; stage = stage->next)
+        __atomic_store_n(&stage->tail, stage->pos, __ATOMIC_RELEASE);
+}
+
+/**
+ * Write messages from all staging buffers to the file in the order
+ * of sequence numbers. It should be called under file_mutex.
+ */
+static void
+lgr_raw_drain(void)
+{
+    struct iovec    iov[LGR_RAW_IOV_MAX];
+    int             iovcnt = 0;
+    lgr_raw_rec     rec;
+    size_t          off;
+    lgr_raw_stage **p;
+    lgr_raw_stage  *list;
+    lgr_raw_stage  *stage;
+
+    pthread_mutex_lock(&stages_mutex);
+    list = stages;
+    pthread_mutex_unlock(&stages_mutex);
+
+    /*
+     * Buffers are added to the head of the list and removed under
+     * file_mutex only, so the list may be walked without the lock.
+     */
+    for (stage = list; stage != NULL; stage = stage->next)
+    {
+        stage->pos = stage->tail;
+        stage->end = __atomic_load_n(&stage->head, __ATOMIC_ACQUIRE);
+    }
+
+    /*
+     * Messages of a buffer are ordered, so the next message to write
+     * is the first unwritten one of some buffer. Stop if there is no
+     * such message: it is still being staged or written directly.
+     */
+    while (true)
+    {
+        for (stage = list; stage != NULL; stage = stage->next)
+        {
+            if (stage->pos == stage->end)
+                continue;
+
+            lgr_raw_stage_take(stage, stage->pos, &rec, sizeof(rec));
+            if (rec.seqno == raw_next)
+                break;
+        }
+        if (stage == NULL)
+            break;
+
+        if (iovcnt + 2 > LGR_RAW_IOV_MAX)
+        {
+            lgr_raw_flush(list, iov, iovcnt);
+            iovcnt = 0;
+        }
+
+        stage->pos += sizeof(rec);
+        off = stage->pos & (LGR_RAW_STAGE_SIZE - 1);
+        iov[iovcnt].iov_base = stage->buf + off;
+        if (off + rec.len > LGR_RAW_STAGE_SIZE)
+        {
+            iov[iovcnt].iov_len = LGR_RAW_STAGE_SIZE - off;
+            iovcnt++;
+            iov[iovcnt].iov_base = stage->buf;
+            iov[iovcnt].iov_len = off + rec.len - LGR_RAW_STAGE_SIZE;
+        }
+        else
+        {
+            iov[iovcnt].iov_len = rec.len;
+        }
+        iovcnt++;
+
+        stage->pos += rec.len;
+        raw_next++;
+    }
+
+    lgr_raw_flush(list, iov, iovcnt);
+
+    /* Free drained buffers of exited threads */
+    pthread_mutex_lock(&stages_mutex);
+    for (p = &stages; (stage = *p) != NULL; )
+    {
+        if (__atomic_load_n(&stage->dead, __ATOMIC_ACQUIRE) &&
+            __atomic_load_n(&stage->head, __ATOMIC_ACQUIRE) == stage->tail)
+        {
+            *p = stage->next;
+            free(stage->buf);
+            free(stage);
+        }
+        else
+        {
+            p = &stage->next;
+        }
+    }
+    pthread_mutex_unlock(&stages_mutex);
+}
+
+/**
+ * Writer thread: write staged messages at least every
+ * LGR_RAW_FLUSH_PERIOD milliseconds or when it is requested.
+ *
+ * @param arg       unused
+ *
+ * @return @c NULL.
+ */
+static void *
+lgr_raw_writer(void *arg)
+{
+    struct timespec deadline;
+    uint64_t        req;
+    uint64_t        written;
+    bool            stop;
+
+    UNUSED(arg);
+
+    pthread_mutex_lock(&writer_mutex);
+    while (true)
+    {
+        if (!writer_kick && writer_running)
+        {
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += LGR_RAW_FLUSH_PERIOD * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L)
+            {
+                deadline.tv_sec++;
+                deadline.tv_nsec -= 1000000000L;
+            }
+            pthread_cond_timedwait(&writer_cond, &writer_mutex, &deadline);
+        }
+        writer_kick = false;
+        stop = !writer_running;
+        req = sync_req;
+        pthread_mutex_unlock(&writer_mutex);
+
+        pthread_mutex_lock(&file_mutex);
+        lgr_raw_drain();
+        written = raw_next;
+        if (req > sync_done && fdatasync(raw_fd) != 0)
+            perror("fdatasync() of raw log failed");
+        pthread_mutex_unlock(&file_mutex);
+
+        pthread_mutex_lock(&writer_mutex);
+        if (req > sync_done)
+            sync_done = written;
+        pthread_cond_broadcast(&done_cond);
+        if (stop)
+            break;
+    }
+    pthread_mutex_unlock(&writer_mutex);
+
+    return NULL;
+}
+
+/**
+ * Write a message to the file bypassing staging buffers.
+ *
+ * @param buf       message
+ * @param len       message length
+ */
+static void
+lgr_raw_write_direct(const void *buf, size_t len)
+{
+    struct iovec    iov;
+    uint64_t        seqno;
+
+    seqno = __atomic_fetch_add(&raw_seqno, 1, __ATOMIC_RELAXED);
+
+    /* Write messages registered before this one first */
+    while (true)
+    {
+        pthread_mutex_lock(&file_mutex);
+        lgr_raw_drain();
+        if (raw_next == seqno)
+            break;
+        pthread_mutex_unlock(&file_mutex);
+        sched_yield();
+    }
+
+    iov.iov_base = (void *)buf;
+    iov.iov_len = len;
+    lgr_raw_writev_all(&iov, 1);
+    raw_next++;
+    pthread_mutex_unlock(&file_mutex);
+}
+
+/* See the description in logger_raw.h */
+void
+lgr_raw_write(const void *buf, size_t len)
+{
+    lgr_raw_stage  *stage;
+    lgr_raw_rec     rec;
+    size_t          need = sizeof(rec) + len;
+    size_t          head;
+    size_t          tail;
+
+    __atomic_add_fetch(&raw_size, len, __ATOMIC_RELAXED);
+
+    stage = lgr_raw_stage_get();
+    if (stage == NULL || len > LGR_RAW_STAGE_SIZE / 2)
+    {
+        lgr_raw_write_direct(buf, len);
+        return;
+    }
+
+    head = stage->head;
+    tail = __atomic_load_n(&stage->tail, __ATOMIC_ACQUIRE);
+    if (LGR_RAW_STAGE_SIZE - (head - tail) < need)
+    {
+        /* The writer is late, wait for it */
+        pthread_mutex_lock(&writer_mutex);
+        while (writer_running &&
+               LGR_RAW_STAGE_SIZE - (head - tail) < need)
+        {
+            lgr_raw_kick();
+            pthread_cond_wait(&done_cond, &writer_mutex);
+            tail = __atomic_load_n(&stage->tail, __ATOMIC_ACQUIRE);
+        }
+        pthread_mutex_unlock(&writer_mutex);
+
+        if (LGR_RAW_STAGE_SIZE - (head - tail) < need)
+        {
+            lgr_raw_write_direct(buf, len);
+            return;
+        }
+    }
+
+    /*
+     * The sequence number is taken when the space is available, so
+     * the drain does not wait for a message which cannot be staged.
+     */
+    rec.seqno = __atomic_fetch_add(&raw_seqno, 1, __ATOMIC_RELAXED);
+    rec.len = len;
+    lgr_raw_stage_put(stage, head, &rec, sizeof(rec));
+    lgr_raw_stage_put(stage, head + sizeof(rec), buf, len);
+    __atomic_store_n(&stage->head, head + need, __ATOMIC_RELEASE);
+
+    /* Do not wait for the period if the buffer becomes half-full */
+    if (head - tail < LGR_RAW_STAGE_SIZE / 2 &&
+        head + need - tail >= LGR_RAW_STAGE_SIZE / 2)
+    {
+        pthread_mutex_lock(&writer_mutex);
+        lgr_raw_kick();
+        pthread_mutex_unlock(&writer_mutex);
+    }
+}
+
+/* See the description in logger_raw.h */
+uint64_t
+lgr_raw_size(void)
+{
+    return __atomic_load_n(&raw_size, __ATOMIC_RELAXED);
+}
+
+/* See the description in logger_raw.h */
+void
+lgr_raw_sync(void)
+{
+    uint64_t req = __atomic_load_n(&raw_seqno, __ATOMIC_RELAXED);
+
+    pthread_mutex_lock(&writer_mutex);
+    if (writer_running)
+    {
+        /*
+         * A pass may stop before a message being staged concurrently,
+         * request passes until all messages before the call are synced.
+         */
+        while (writer_running && sync_done < req)
+        {
+            if (sync_req < req)
+                sync_req = req;
+            lgr_raw_kick();
+            pthread_cond_wait(&done_cond, &writer_mutex);
+        }
+        pthread_mutex_unlock(&writer_mutex);
+        return;
+    }
+    pthread_mutex_unlock(&writer_mutex);
+
+    pthread_mutex_lock(&file_mutex);
+    if (raw_fd >= 0 && fdatasync(raw_fd) != 0)
+        perror("fdatasync() of raw log failed");
+    pthread_mutex_unlock(&file_mutex);
+}
+
+/* See the description in logger_raw.h */
+te_errno
+lgr_raw_open(const char *path)
+{
+    struct stat st;
+
+    raw_fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0666);
+    if (raw_fd < 0)
+        return TE_OS_RC(TE_LOGGER, errno);
+
+    if (fstat(raw_fd, &st) != 0)
+    {
+        te_errno rc = TE_OS_RC(TE_LOGGER, errno);
+
+        close(raw_fd);
+        raw_fd = -1;
+        return rc;
+    }
+    raw_size = st.st_size;
+
+    return 0;
+}
+
+/* See the description in logger_raw.h */
+te_errno
+lgr_raw_start(void)
+{
+    int rc;
+
+    rc = pthread_key_create(&stage_key, lgr_raw_stage_release);
+    if (rc != 0)
+        return TE_OS_RC(TE_LOGGER, rc);
+
+    writer_running = true;
+    rc = pthread_create(&writer_thread, NULL, lgr_raw_writer, NULL);
+    if (rc != 0)
+    {
+        writer_running = false;
+        pthread_key_delete(stage_key);
+        return TE_OS_RC(TE_LOGGER, rc);
+    }
+
+    return 0;
+}
+
+/* See the description in logger_raw.h */
+te_errno
+lgr_raw_close(void)
+{
+    te_errno        rc = 0;
+    lgr_raw_stage  *stage;
+    bool            started;
+
+    pthread_mutex_lock(&writer_mutex);
+    started = writer_running;
+    writer_running = false;
+    pthread_cond_broadcast(&writer_cond);
+    pthread_cond_broadcast(&done_cond);
+    pthread_mutex_unlock(&writer_mutex);
+
+    if (started)
+    {
+        pthread_join(writer_thread, NULL);
+
+        /* Messages staged after the last writer pass */
+        pthread_mutex_lock(&file_mutex);
+        lgr_raw_drain();
+        pthread_mutex_unlock(&file_mutex);
+
+        while ((stage = stages) != NULL)
+        {
+            stages = stage->next;
+            free(stage->buf);
+            free(stage);
+        }
+        pthread_key_delete(stage_key);
+    }
+
+    if (raw_fd < 0)
+        return 0;
+
+    if (fdatasync(raw_fd) != 0)
+        rc = TE_OS_RC(TE_LOGGER, errno);
+    if (close(raw_fd) != 0 && rc == 0)
+        rc = TE_OS_RC(TE_LOGGER, errno);
+    raw_fd = -1;
+
+    return rc;
+}
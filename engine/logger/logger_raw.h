@@ -0,0 +1,91 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief TE project. Logger subsystem.
+ *
+ * Raw log file writer.
+ *
+ * Threads registering messages copy them to their own staging buffers
+ * without any locks, every message is tagged with a global sequence
+ * number. A dedicated writer thread collects messages from all staging
+ * buffers and writes them to the raw log file in the order of sequence
+ * numbers with a single vectored write at least every
+ * @ref LGR_RAW_FLUSH_PERIOD milliseconds.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#ifndef __TE_LOGGER_RAW_H__
+#define __TE_LOGGER_RAW_H__
+
+#include "te_defs.h"
+#include "te_errno.h"
+#include "te_stdint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of a per-thread staging buffer (must be a power of 2) */
+#define LGR_RAW_STAGE_SIZE      0x40000
+
+/** Maximum delay of writing of a staged message in milliseconds */
+#define LGR_RAW_FLUSH_PERIOD    50
+
+/**
+ * Open the raw log file for appending.
+ *
+ * Messages are written to the file directly until the writer thread
+ * is started.
+ *
+ * @param path      raw log file path
+ *
+ * @return Status code.
+ */
+extern te_errno lgr_raw_open(const char *path);
+
+/**
+ * Start the writer thread.
+ *
+ * @return Status code.
+ */
+extern te_errno lgr_raw_start(void);
+
+/**
+ * Append a message to the raw log.
+ *
+ * The message is copied, it is written to the file later by the writer
+ * thread. Messages are written in the order of registration by all
+ * threads.
+ *
+ * @param buf       message
+ * @param len       message length
+ */
+extern void lgr_raw_write(const void *buf, size_t len);
+
+/**
+ * Get the size of the raw log including messages which are not
+ * written yet.
+ *
+ * @return Size in bytes.
+ */
+extern uint64_t lgr_raw_size(void);
+
+/**
+ * Wait until all messages appended before the call are written
+ * to the raw log file and synchronized with the storage device.
+ */
+extern void lgr_raw_sync(void);
+
+/**
+ * Stop the writer thread, write all pending messages and close
+ * the raw log file. It should be called when no other threads
+ * append messages.
+ *
+ * @return Status code.
+ */
+extern te_errno lgr_raw_close(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* __TE_LOGGER_RAW_H__ */
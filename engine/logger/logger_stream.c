@@ -186,6 +186,10 @@ listeners_conf_dump(void)
         te_log_buf_append(buffer, "  interval: %d\n", listener->interval);
         te_log_buf_append(buffer, "  buffer_size: %lu\n", listener->buffer_size);
         te_log_buf_append(buffer, "  buffers_num: %lu\n", listener->buffers_num);
+        te_log_buf_append(buffer, "  spool_size: %lu\n", listener->spool_size);
+        te_log_buf_append(buffer, "  compression: %s\n",
+                          listener->compression == LISTENER_COMPRESSION_GZIP ?
+                          "gzip" : "none");
         te_log_buf_append(buffer, "\n");
     }
 
@@ -788,10 +792,10 @@ listeners_thread(void *arg)
              *      (there's no point in buffering messages).
              */
             if (listener->state == LISTENER_GATHERING &&
-                (listener->buffer.total_length >= listener->buffer_size ||
+                (listener_pending(listener) >= listener->buffer_size ||
                  timercmp(&listener->next_tv, &now, <) ||
                  ((events_happened & QEVENT_FINISH) &&
-                  listener->buffer.total_length > 0)))
+                  listener_pending(listener) > 0)))
             {
                 rc = listener_dump(listener);
                 if (rc != 0)
@@ -803,7 +807,7 @@ listeners_thread(void *arg)
             /* Finish once all messages have been sent */
             if (listener->state == LISTENER_GATHERING &&
                 (events_happened & QEVENT_FINISH) &&
-                listener->buffer.total_length == 0)
+                listener_pending(listener) == 0)
             {
                 listener_finish(listener);
                 curl_multi_add_handle(curl_mhandle, listener->curl_handle);
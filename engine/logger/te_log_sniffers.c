@@ -37,6 +37,7 @@
 #endif
 
 #include <sys/sendfile.h>
+#include <zlib.h>
 
 #include "te_raw_log.h"
 #include "te_str.h"
@@ -52,6 +53,9 @@
 #define SNIF_MIN_LIST_SIZE 1024
 #define SNIF_MAX_PATH_LENGTH RCF_MAX_PATH
 
+/* Size of the buffer to decompress capture logs */
+#define SNIF_COPY_BUF_SIZE 65536
+
 /* The PCAP file header. */
 static char pcap_hbuf[SNIF_PCAP_HSIZE];
 
@@ -82,6 +86,13 @@ typedef struct snif_id_l {
     bool first_launch;
     flist_h_t   flist_h;
     unsigned    cap_file_ind;
+    off_t       res_size;       /**< Size of the current capture file */
+    unsigned long long total_size;  /**< Total size of capture files */
+    unsigned    pulls;          /**< Number of capture logs portions
+                                     received from the agent */
+    unsigned long long wire_bytes;  /**< Bytes received from the agent */
+    unsigned long long raw_bytes;   /**< Uncompressed bytes received */
+    unsigned long long pull_us;     /**< Total time of pulls */
     SLIST_ENTRY(snif_id_l)  ent_l;
 } snif_id_l;
 SLIST_HEAD(snifidl_h_t, snif_id_l);
@@ -419,6 +430,13 @@ sniffer_parse_list_buf(char *buf, size_t len, snifidl_h_t *sniflist_head,
             if (sniffer_make_file_name(agent, snif) != 0)
                 WRONG_SNIF_ID("Couldn't make capture file name.");
 
+            snif->res_size = 0;
+            snif->total_size = 0;
+            snif->pulls = 0;
+            snif->wire_bytes = 0;
+            snif->raw_bytes = 0;
+            snif->pull_us = 0;
+
             SLIST_INIT(&snif->flist_h);
             SNIFFER_MALLOC(lfile, sizeof(file_list_s));
             strcpy(lfile->name, snif->res_fname);
@@ -551,26 +569,183 @@ sniffer_save_info(const char *agent, snif_id_l *snif, int fd_o)
 }
 
 /**
- * Capture files processing.
+ * Update size of the current capture file of the sniffer and the
+ * space occupied by capture files.
  *
- * @param fname     Name of the received file as it is saved.
  * @param snif      Location of sniffer parameters.
- * @param ta_name   Test agent name.
+ * @param fd        Descriptor of the current capture file.
+ */
+static void
+sniffer_update_res_size(snif_id_l *snif, int fd)
+{
+    struct stat st;
+    off_t       delta;
+
+    if (fstat(fd, &st) != 0)
+        return;
+
+    delta = st.st_size - snif->res_size;
+    snif->res_size = st.st_size;
+    snif->total_size += delta;
+    filled_space += delta;
+}
+
+/**
+ * Get sizes of capture logs received from the agent.
+ *
+ * @param fd            Descriptor of the received file.
+ * @param compressed    Whether the data are compressed with gzip.
+ * @param wire_size     Location for the size of the received file.
+ * @param size          Location for the size of the capture data.
  *
  * @return Status code.
  */
 static te_errno
-sniffer_capture_file_proc(const char *fname, snif_id_l *snif,
-                          const char *agent)
+sniffer_dump_size(int fd, bool compressed, off_t *wire_size, off_t *size)
 {
-    int             fd_o;
-    int             fd_n;
-    off_t           size;
+    uint8_t trailer[4];
+    off_t   len;
+
+    len = lseek(fd, 0, SEEK_END);
+    if (len == -1)
+        return TE_OS_RC(TE_LOGGER, errno);
+    *wire_size = len;
+
+    if (compressed)
+    {
+        /*
+         * gzip trailer ends with the size of uncompressed data modulo
+         * 2^32, agents never compress larger portions.
+         */
+        if (len < (off_t)sizeof(trailer) ||
+            pread(fd, trailer, sizeof(trailer),
+                  len - sizeof(trailer)) != sizeof(trailer))
+            return TE_RC(TE_LOGGER, TE_EINVAL);
+
+        len = (uint32_t)trailer[0] | (uint32_t)trailer[1] << 8 |
+              (uint32_t)trailer[2] << 16 | (uint32_t)trailer[3] << 24;
+    }
+
+    if (lseek(fd, 0, SEEK_SET) == -1)
+        return TE_OS_RC(TE_LOGGER, errno);
+
+    *size = len;
+    return 0;
+}
+
+/**
+ * Read capture logs received from the agent.
+ *
+ * @param fd        Descriptor of the received file.
+ * @param gz        Decompression stream or @c NULL if the data are not
+ *                  compressed.
+ * @param buf       Buffer for the data.
+ * @param len       Number of bytes to read.
+ *
+ * @return Status code.
+ */
+static te_errno
+sniffer_dump_read(int fd, gzFile gz, void *buf, size_t len)
+{
+    ssize_t res;
+
+    if (gz != NULL)
+        res = gzread(gz, buf, len);
+    else
+        res = read(fd, buf, len);
+
+    if (res < 0 || (size_t)res != len)
+        return TE_RC(TE_LOGGER, TE_EIO);
+
+    return 0;
+}
+
+/**
+ * Append capture logs received from the agent to the capture file.
+ * Compressed data are decompressed on the fly.
+ *
+ * @param fd_o      Descriptor of the capture file.
+ * @param fd_n      Descriptor of the received file.
+ * @param gz        Decompression stream or @c NULL if the data are not
+ *                  compressed.
+ * @param len       Number of bytes to append.
+ *
+ * @return Status code.
+ */
+static te_errno
+sniffer_dump_append(int fd_o, int fd_n, gzFile gz, off_t len)
+{
+    char    buf[SNIF_COPY_BUF_SIZE];
+    ssize_t res;
+
+    while (len > 0)
+    {
+        if (gz == NULL)
+        {
+            res = sendfile(fd_o, fd_n, NULL, len);
+        }
+        else
+        {
+            res = gzread(gz, buf, MIN(len, (off_t)sizeof(buf)));
+            if (res > 0 && write(fd_o, buf, res) != res)
+                return TE_OS_RC(TE_LOGGER, errno);
+        }
+        if (res <= 0)
+            return TE_RC(TE_LOGGER, TE_EIO);
+        len -= res;
+    }
+
+    return 0;
+}
+
+/**
+ * Capture files processing: append received capture logs to the
+ * capture file of the sniffer inserting marker packets on the way.
+ *
+ * @param fd_n          Descriptor of the received file.
+ * @param compressed    Whether the data are compressed with gzip.
+ * @param size          Size of the capture data.
+ * @param snif          Location of sniffer parameters.
+ * @param agent         Test agent name.
+ *
+ * @return Status code.
+ */
+static te_errno
+sniffer_capture_file_proc(int fd_n, bool compressed, off_t size,
+                          snif_id_l *snif, const char *agent)
+{
+    int             fd_o = -1;
+    gzFile          gz = NULL;
     off_t           cur_size;
     int             res;
     snif_mark_l    *mark;
+    char            hbuf[SNIF_PCAP_HSIZE];
     te_errno        rc = 0;
 
+    if (compressed)
+    {
+        gz = gzdopen(dup(fd_n), "rb");
+        if (gz == NULL)
+        {
+            ERROR("Couldn't open compressed capture logs of %s;%s;%s",
+                  agent, snif->id.ifname, snif->id.snifname);
+            return TE_RC(TE_LOGGER, TE_ENOMEM);
+        }
+    }
+
+    if (snif->first_launch)
+    {
+        /* Capture logs start with the capture file header. */
+        rc = sniffer_dump_read(fd_n, gz, hbuf, SNIF_PCAP_HSIZE);
+        if (rc != 0 || size < SNIF_PCAP_HSIZE)
+        {
+            rc = TE_RC(TE_LOGGER, TE_ENODATA);
+            ERROR("%s(): failed to read PCAP header: %r", __FUNCTION__, rc);
+            goto cleanup_snif_fproc;
+        }
+        size -= SNIF_PCAP_HSIZE;
+    }
+
     errno = 0;
     fd_o = open(snif->res_fname, O_WRONLY);
     if ((fd_o == -1) && (errno == ENOENT))
@@ -580,36 +755,11 @@ sniffer_capture_file_proc(const char *fname, snif_id_l *snif,
         if (fd_o == -1)
         {
             ERROR("Couldn't open new file: %s", snif->res_fname);
-            return TE_RC(TE_TA_UNIX, TE_EINVAL);
+            rc = TE_RC(TE_TA_UNIX, TE_EINVAL);
+            goto cleanup_snif_fproc;
         }
         if (snif->first_launch)
-        {
-            /* Save capture file header. */
-            fd_n = open(fname, O_RDONLY);
-            if (fd_n == -1)
-            {
-                ERROR("Couldn't open received file: %s", fname);
-                goto cleanup_snif_fproc;
-            }
-
-            res = read(fd_n, (void *)pcap_hbuf, SNIF_PCAP_HSIZE);
-            if (res < 0)
-            {
-                rc = TE_OS_RC(TE_LOGGER, errno);
-                ERROR("%s(): failed to read PCAP header, errno=%r",
-                      __FUNCTION__, rc);
-                goto cleanup_snif_fproc;
-            }
-            else if (res != SNIF_PCAP_HSIZE)
-            {
-                rc = TE_RC(TE_LOGGER, TE_ENODATA);
-                ERROR("%s(): %d bytes instead of %d were read for "
-                      "PCAP header", __FUNCTION__, res, SNIF_PCAP_HSIZE);
-                goto cleanup_snif_fproc;
-            }
-
-            close(fd_n);
-        }
+            memcpy(pcap_hbuf, hbuf, SNIF_PCAP_HSIZE);
 
         res = write(fd_o, pcap_hbuf, SNIF_PCAP_HSIZE);
         sniffer_save_info(agent, snif, fd_o);
@@ -617,16 +767,11 @@ sniffer_capture_file_proc(const char *fname, snif_id_l *snif,
     else if (fd_o == -1)
     {
         WARN("Couldn't open the old capture log file: %s", snif->res_fname);
-        return TE_RC(TE_TA_UNIX, TE_EINVAL);
+        rc = TE_RC(TE_TA_UNIX, TE_EINVAL);
+        goto cleanup_snif_fproc;
     }
+    snif->first_launch = false;
 
-    fd_n = open(fname, O_RDWR);
-    if (fd_n == -1)
-    {
-        WARN("Couldn't open the new capture log file: %s.", fname);
-        close(fd_o);
-        return TE_RC(TE_TA_UNIX, TE_EINVAL);
-    }
     res = lseek(fd_o, 0, SEEK_END);
     if (res == -1)
     {
@@ -634,27 +779,13 @@ sniffer_capture_file_proc(const char *fname, snif_id_l *snif,
         rc = TE_RC(TE_TA_UNIX, TE_EINVAL);
         goto cleanup_snif_fproc;
     }
-    size = lseek(fd_n, 0, SEEK_END);
-    if (size == -1)
-    {
-        WARN("Couldn't read the new capture log file: %s.", fname);
-        rc = TE_RC(TE_TA_UNIX, TE_EINVAL);
-        goto cleanup_snif_fproc;
-    }
-
-    if (snif->first_launch)
-    {
-        lseek(fd_n, SNIF_PCAP_HSIZE, SEEK_SET);
-        snif->first_launch = false;
-        size -= SNIF_PCAP_HSIZE;
-    }
-    else
-        lseek(fd_n, 0, SEEK_SET);
 
     while ((mark = sniffer_check_markers(size, snif, agent)) != NULL)
     {
         cur_size = mark->id.abs_offset - snif->id.abs_offset;
-        res = sendfile(fd_o, fd_n, 0, cur_size);
+        rc = sniffer_dump_append(fd_o, fd_n, gz, cur_size);
+        if (rc != 0)
+            break;
         size -= cur_size;
         sniffer_insert_marker(fd_o, mark);
 
@@ -662,21 +793,23 @@ sniffer_capture_file_proc(const char *fname, snif_id_l *snif,
         free(mark);
         snif->id.abs_offset += cur_size;
     }
-    res = sendfile(fd_o, fd_n, 0, size);
-    if ((res == -1) || (res < size))
+    if (rc == 0)
+        rc = sniffer_dump_append(fd_o, fd_n, gz, size);
+    if (rc != 0)
     {
-        WARN("Couldn't copy capture log res %d: %s --> %s: %s", res, fname,
-             snif->res_fname, strerror(errno));
-        rc = TE_RC(TE_TA_UNIX, TE_EINVAL);
+        WARN("Couldn't copy capture log to %s: %r", snif->res_fname, rc);
         goto cleanup_snif_fproc;
     }
     snif->id.abs_offset += size;
-    filled_space += size;
 
 cleanup_snif_fproc:
-    close(fd_o);
-    close(fd_n);
-    remove(fname);
+    if (fd_o != -1)
+    {
+        sniffer_update_res_size(snif, fd_o);
+        close(fd_o);
+    }
+    if (gz != NULL)
+        gzclose(gz);
     return rc;
 }
 
@@ -690,21 +823,13 @@ sniffer_check_overall_space(unsigned fsize)
 {
     snif_ta_l           *snif_ta;
     snif_id_l           *snif;
-    file_list_s         *f;
-    struct stat         st;
 
     filled_space = 0;
     /* Calculate used space. */
     SLIST_FOREACH(snif_ta, &snif_ta_h, ent_l_ta)
     {
         SLIST_FOREACH(snif, &snif_ta->snif_hl, ent_l)
-        {
-            SLIST_FOREACH(f, &snif->flist_h, ent_l_f)
-            {
-                if (stat(f->name, &st) == 0)
-                    filled_space += st.st_size;
-            }
-        }
+            filled_space += snif->total_size;
     }
 
     if (filled_space + fsize > snifp_sets.osize)
@@ -714,18 +839,19 @@ sniffer_check_overall_space(unsigned fsize)
 
 /**
  * Check and free the space occupied by capture log files.
+ * Sizes of capture files are tracked in memory, so the files are
+ * not examined on every pull.
  *
  * @param snif      Location of sniffer parameters.
- * @param fname     Name of the received file as it is saved.
+ * @param size      Size of the received capture data.
  * @param agent     Test agent name.
  *
  * @return Status code. @c true is a free space, else @c false.
  */
 static bool
-sniffer_check_capture_space(snif_id_l *snif, const char *fname,
+sniffer_check_capture_space(snif_id_l *snif, off_t size,
                             const char * agent)
 {
-    size_t              total    = 0;
     bool overflow = false;
     struct stat         st;
     int                 res;
@@ -735,12 +861,8 @@ sniffer_check_capture_space(snif_id_l *snif, const char *fname,
     unsigned            fnum;
 
     /* Check the current file size + received log file. */
-    if (stat(snif->res_fname, &st) == 0)
-        total += st.st_size;
-    if (stat(fname, &st) == 0)
-        total += st.st_size;
-
-    if ((snifp_sets.fsize > 0) && (total > snifp_sets.fsize))
+    if ((snifp_sets.fsize > 0) &&
+        (snif->res_size + size > (off_t)snifp_sets.fsize))
     {
         int sysrc;
 
@@ -768,6 +890,8 @@ sniffer_check_capture_space(snif_id_l *snif, const char *fname,
             return false;
         }
         sniffer_save_info(agent, snif, fd_n);
+        snif->res_size = 0;
+        sniffer_update_res_size(snif, fd_n);
         close(fd_n);
 
         strcpy(f->name, snif->res_fname);
@@ -775,33 +899,31 @@ sniffer_check_capture_space(snif_id_l *snif, const char *fname,
     }
 
     if (snifp_sets.osize > 0 &&
-        filled_space + st.st_size > snifp_sets.osize)
-        overflow = sniffer_check_overall_space(st.st_size);
+        filled_space + size > snifp_sets.osize)
+        overflow = sniffer_check_overall_space(size);
 
     if (snifp_sets.sn_space == 0 && overflow == false)
         return true;
 
-    total = 0;
     fnum  = 0;
-    /* Calculate used space. */
     SLIST_FOREACH(f, &snif->flist_h, ent_l_f)
     {
-        if (stat(f->name, &st) == 0)
-            total += st.st_size;
         fnum++;
         flast = f;
     }
-    if (stat(fname, &st) == 0)
-        total += st.st_size;
 
-    if (total < snifp_sets.sn_space && overflow == false &&
+    if (snif->total_size + size < snifp_sets.sn_space &&
+        overflow == false &&
         ((fnum <= snifp_sets.rotation) || (snifp_sets.rotation == 0)))
         return true;
     if ((snifp_sets.ofill == TAIL_DROP) || (fnum < 2))
         return false;
 
     if (stat(flast->name, &st) == 0)
+    {
         filled_space -= st.st_size;
+        snif->total_size -= st.st_size;
+    }
     /* Remove the oldest capture file to rotation. */
     remove(flast->name);
     SLIST_REMOVE(&snif->flist_h, flast, file_list_s, ent_l_f);
@@ -812,6 +934,7 @@ sniffer_check_capture_space(snif_id_l *snif, const char *fname,
 
 /**
  * Get sniffer dump function performed *rcf_get_sniffer_dump* call.
+ * Only the data captured since the previous call are received.
  *
  * @param ta_name   Test agent name.
  * @param snif      Location of sniffer parameters.
@@ -824,7 +947,14 @@ ten_get_sniffer_dump(const char *ta_name, snif_id_l *snif)
     char                idbuf[RCF_MAX_ID];
     char                fname[RCF_MAX_PATH];
     int                 rc;
+    int                 fd_n;
     unsigned long long  offset;
+    bool compressed = false;
+    off_t               wire_size;
+    off_t               size;
+    struct timeval      tv_start;
+    struct timeval      tv_end;
+    long long           pull_us;
 
     rc = snprintf(idbuf, RCF_MAX_ID, "%s %s %u", snif->id.snifname,
                   snif->id.ifname, snif->id.ssn);
@@ -844,7 +974,10 @@ ten_get_sniffer_dump(const char *ta_name, snif_id_l *snif)
     }
 
     offset = 0;
-    rc = rcf_get_sniffer_dump(ta_name, idbuf, fname, &offset);
+    gettimeofday(&tv_start, NULL);
+    rc = rcf_get_sniffer_dump(ta_name, idbuf, fname, &offset,
+                              snifp_sets.compress, &compressed);
+    gettimeofday(&tv_end, NULL);
     if (rc != 0 && rc != TE_RC(TE_RCF_API, TE_ENODATA))
     {
         if (rc != TE_RC(TE_RCF_API, TE_EIPC))
@@ -858,12 +991,40 @@ ten_get_sniffer_dump(const char *ta_name, snif_id_l *snif)
 
     snif->id.abs_offset = offset;
 
-    rc = 0;
-    if(sniffer_check_capture_space(snif, fname, ta_name))
-        rc = sniffer_capture_file_proc(fname, snif, ta_name);
-    else
+    fd_n = open(fname, O_RDONLY);
+    if (fd_n == -1)
+    {
+        WARN("Couldn't open the received capture log file: %s.", fname);
         remove(fname);
+        return TE_RC(TE_TA_UNIX, TE_EINVAL);
+    }
 
+    rc = sniffer_dump_size(fd_n, compressed, &wire_size, &size);
+    if (rc != 0)
+    {
+        WARN("Couldn't get size of the received capture log file %s: %r",
+             fname, rc);
+    }
+    else
+    {
+        pull_us = TE_SEC2US(tv_end.tv_sec - tv_start.tv_sec) +
+                  tv_end.tv_usec - tv_start.tv_usec;
+        snif->pulls++;
+        snif->wire_bytes += wire_size;
+        snif->raw_bytes += size;
+        snif->pull_us += pull_us;
+        INFO("Capture logs of %s;%s;%s: received %lld bytes (%lld bytes "
+             "of capture%s) in %lld us", ta_name, snif->id.ifname,
+             snif->id.snifname, (long long)wire_size, (long long)size,
+             compressed ? ", compressed" : "", pull_us);
+
+        if (sniffer_check_capture_space(snif, size, ta_name))
+            rc = sniffer_capture_file_proc(fd_n, compressed, size,
+                                           snif, ta_name);
+    }
+
+    close(fd_n);
+    remove(fname);
     return rc;
 }
 
@@ -1013,6 +1174,13 @@ sniffer_clean_list(snifidl_h_t *sniflist_h)
 
     while((sniff = SLIST_FIRST(sniflist_h)) != NULL)
     {
+        if (sniff->pulls > 0)
+        {
+            RING("Capture logs of %s;%s: %u pulls, %llu bytes received, "
+                 "%llu bytes of capture, %llu us spent",
+                 sniff->id.ifname, sniff->id.snifname, sniff->pulls,
+                 sniff->wire_bytes, sniff->raw_bytes, sniff->pull_us);
+        }
         free(sniff->id.snifname);
         free(sniff->id.ifname);
         SLIST_REMOVE_HEAD(sniflist_h, ent_l);
@@ -1166,6 +1166,65 @@ save_attachment(ta *agent, rcf_msg *msg, size_t cmdlen, char *ba)
 }
 
 
+/**
+ * Save binary attachment to the additional data of the user request
+ * message (instead of a local file as save_attachment() does).
+ *
+ * @param agent         Test Agent structure
+ * @param req           user request; its message is reallocated to
+ *                      fit the attachment
+ * @param cmdlen        command length (including binary attachment)
+ * @param ba            pointer to the first byte after end marker
+ *
+ * @return Message with the attachment (@c NULL if the attachment is
+ *         not received completely)
+ */
+static rcf_msg *
+save_attachment_data(ta *agent, usrreq *req, size_t cmdlen, char *ba)
+{
+    rcf_msg *msg = req->message;
+    rcf_msg *new_msg;
+    size_t   copy_len;
+    size_t   len;
+
+    assert((ba - cmd) >= 0);
+    assert(cmdlen >= (size_t)(ba - cmd));
+    len = cmdlen - (ba - cmd);
+    VERB("Save attachment data length=%u", (unsigned)len);
+
+    new_msg = TE_ALLOC(sizeof(rcf_msg) + len);
+    *new_msg = *msg;
+    free(msg);
+    msg = req->message = new_msg;
+
+    copy_len = (cmdlen > sizeof(cmd)) ? (sizeof(cmd) - (ba - cmd)) : len;
+    memcpy(msg->data, ba, copy_len);
+    msg->data_len = copy_len;
+
+    while (msg->data_len < len)
+    {
+        size_t maxlen = sizeof(cmd);
+        int    rc;
+
+        rc = (agent->m.receive)(agent->handle, cmd, &maxlen, NULL);
+        if (rc != 0 && rc != TE_RC(TE_COMM, TE_EPENDING))
+        {
+            ERROR("Failed receive rest of binary attachment TA %s - "
+                  "cutting\n", agent->name);
+            return NULL;
+        }
+
+        copy_len = MIN(len - msg->data_len, sizeof(cmd));
+        memcpy(msg->data + msg->data_len, cmd, copy_len);
+        msg->data_len += copy_len;
+    }
+
+    msg->flags |= BINARY_ATTACHMENT;
+
+    return msg;
+}
+
+
 /**
  * Send pending command for specified SID.
  *
@@ -1431,6 +1490,20 @@ process_reply(ta *agent)
                     read_str(&ptr, msg->value);
                 break;
 
+            case RCFOP_CONFGET_TREE:
+                /* Position of the next chunk */
+                te_strlcpy(msg->value, ptr, sizeof(msg->value));
+                if (ba != NULL)
+                {
+                    msg = save_attachment_data(agent, req, len, ba);
+                    if (msg == NULL)
+                    {
+                        rcf_set_ta_dead(agent);
+                        return;
+                    }
+                }
+                break;
+
             case RCFOP_VREAD:
             case RCFOP_CSAP_PARAM:
                 read_str(&ptr, msg->value);
@@ -1438,7 +1511,8 @@ process_reply(ta *agent)
 
             case RCFOP_GET_SNIF_DUMP:
             {
-                read_str(&ptr, msg->value);
+                /* Offset optionally followed by data encoding */
+                te_strlcpy(msg->value, ptr, sizeof(msg->value));
                 if (ba != NULL)
                     save_attachment(agent, msg, len, ba);
                 break;
@@ -1479,6 +1553,25 @@ process_reply(ta *agent)
             }
 
             case RCFOP_GET_LOG:
+                if (ba == NULL)
+                    goto bad_protocol;
+                /* Log buffer status reported by TA (if any) */
+                te_strlcpy(msg->value, ptr, sizeof(msg->value));
+                if (msg->intparm & RCF_GET_LOG_INLINE)
+                {
+                    msg = save_attachment_data(agent, req, len, ba);
+                    if (msg == NULL)
+                    {
+                        rcf_set_ta_dead(agent);
+                        return;
+                    }
+                }
+                else
+                {
+                    save_attachment(agent, msg, len, ba);
+                }
+                break;
+
             case RCFOP_FGET:
                 if (ba == NULL)
                     goto bad_protocol;
@@ -1892,6 +1985,11 @@ rcf_send_cmd(ta *agent, usrreq *req)
             req->timeout = RCF_CMD_TIMEOUT;
             break;
 
+        case RCFOP_CONFGET_TREE:
+            PUT(TE_PROTO_CONFGET_TREE " %s %d", msg->id, msg->intparm);
+            req->timeout = RCF_CMD_TIMEOUT_HUGE;
+            break;
+
         case RCFOP_CONFDEL:
             PUT(TE_PROTO_CONFDEL " %s", msg->id);
             req->timeout = RCF_CMD_TIMEOUT;
@@ -2005,10 +2103,11 @@ rcf_send_cmd(ta *agent, usrreq *req)
             break;
 
         case RCFOP_TRRECV_START:
-            PUT(TE_PROTO_TRRECV_START " %u %u %u%s%s%s%s", msg->handle,
+            PUT(TE_PROTO_TRRECV_START " %u %u %u%s%s%s%s%s", msg->handle,
                 msg->num, msg->timeout,
                 (msg->intparm & TR_RESULTS) ? " results" : "",
                 (msg->intparm & TR_NO_PAYLOAD) ? " no-payload" : "",
+                (msg->intparm & TR_BINARY) ? " binary" : "",
                 (msg->intparm & TR_SEQ_MATCH) ? " seq-match" : "",
                 (msg->intparm & TR_MISMATCH) ? " mismatch" : "");
             req->timeout = RCF_CMD_TIMEOUT_HUGE;
@@ -27,6 +27,7 @@
 #endif
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <signal.h>
 #if HAVE_PTHREAD_H
 #include <pthread.h>
 #endif
@@ -152,6 +153,12 @@ typedef struct tester_ctx {
 
     struct tester_ctx  *keepalive_ctx;  /**< Keep-alive context */
 
+    bool simultaneous;   /**< Test scripts of the session may be
+                              run in parallel */
+    bool deferred;       /**< Current test script is run in
+                              background, its result is processed
+                              when the job is finished */
+
 #if WITH_TRC
     te_trc_db_walker   *trc_walker;     /**< Current position in TRC
                                              database */
@@ -162,6 +169,25 @@ typedef struct tester_ctx {
 #endif
 } tester_ctx;
 
+/** Test script run in background within a simultaneous session */
+typedef struct tester_job {
+    TAILQ_ENTRY(tester_job) links;  /**< List links */
+
+    tester_ctx         *ctx;        /**< Context of the session */
+    const run_item     *ri;         /**< Run item of the test script */
+    const char         *execute;    /**< Test script executable */
+    unsigned int        tin;        /**< Test iteration number */
+    int                 plan_id;    /**< ID of the run item in the plan */
+    pid_t               pid;        /**< Test script process ID or
+                                         @c -1 if it has been waited */
+    bool                killed;     /**< Test script has been asked
+                                         to terminate */
+    tester_test_result  result;     /**< Result of the test */
+} tester_job;
+
+/** Queue of background test scripts in submission order */
+typedef TAILQ_HEAD(tester_jobs, tester_job) tester_jobs;
+
 /**
  * Opaque data for all configuration traverse callbacks.
  */
@@ -207,6 +233,11 @@ typedef struct tester_run_data {
 
     SLIST_HEAD(, tester_ctx)    ctxs;       /**< Stack of contexts */
 
+    tester_jobs                 jobs;       /**< Test scripts of
+                                                 a simultaneous session
+                                                 run in background */
+    unsigned int                n_jobs;     /**< Number of jobs */
+
 } tester_run_data;
 
 /**
@@ -226,6 +257,8 @@ static enum interactive_mode_opts tester_run_interactive(
 
 /* Forward declarations */
 static json_t *persons_info_to_json(const persons_info *persons);
+static tester_cfg_walk_ctl run_jobs_join(tester_run_data *gctx,
+                                         unsigned int max_jobs);
 
 /* Check whether run item has keepalive handler */
 static bool
@@ -2430,48 +2463,40 @@ prepare_test_script_arguments(te_vec *params, tester_flags flags,
 
 }
 
+/**
+ * Start a test script process.
+ *
+ * @param exec_id       Test execution ID
+ * @param args          Command line of the script
+ * @param fderr         File descriptor to redirect standard error output
+ *                      of the script to or @c -1
+ * @param pid           Location for process ID
+ *
+ * @return Status code.
+ */
 static te_errno
-execute_test_script(tester_flags flags, test_id exec_id, char **args, int *code)
+start_test_script(test_id exec_id, char **args, int fderr, pid_t *pid)
 {
-    char vg_filename[PATH_MAX];
-    int fderr = -1;
-    pid_t pid;
-    te_errno rc = 0;
-
-    if (flags & TESTER_VALGRIND)
-    {
-        TE_SPRINTF(vg_filename, TESTER_VG_FILENAME_FMT, exec_id);
-        fderr = open(vg_filename, O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
-        if (fderr < 0)
-        {
-            rc = TE_OS_RC(TE_TESTER, errno);
-            ERROR("Failed to open valgrind output file %s: %r",
-                  vg_filename, rc);
-
-            return rc;
-        }
-    }
+    te_errno rc;
 
     VERB("ID=%d execvp(%s, ...)", exec_id, args[0]);
-    pid = fork();
-    if (pid < 0)
+    *pid = fork();
+    if (*pid < 0)
     {
         rc = TE_OS_RC(TE_TESTER, errno);
         ERROR("Cannot fork: %r", rc);
-        if (fderr >= 0)
-            close(fderr);
         return rc;
     }
 
-    if (pid == 0)
+    if (*pid == 0)
     {
         /* TODO: is it really safe to call TE logging in a child process? */
         if (fderr >= 0)
         {
             if (dup2(fderr, STDERR_FILENO) < 0)
             {
-                ERROR("valgrind: failed to duplicate %s fd to stderr: %r",
-                      vg_filename, TE_OS_RC(TE_TESTER, errno));
+                ERROR("valgrind: failed to duplicate fd %d to stderr: %r",
+                      fderr, TE_OS_RC(TE_TESTER, errno));
                 _Exit(EXIT_FAILURE);
             }
             close(fderr);
@@ -2485,8 +2510,37 @@ execute_test_script(tester_flags flags, test_id exec_id, char **args, int *code)
         /* unreachable */
         TE_FATAL_ERROR("Cannot happen");
     }
+
+    return 0;
+}
+
+static te_errno
+execute_test_script(tester_flags flags, test_id exec_id, char **args, int *code)
+{
+    char vg_filename[PATH_MAX];
+    int fderr = -1;
+    pid_t pid;
+    te_errno rc = 0;
+
+    if (flags & TESTER_VALGRIND)
+    {
+        TE_SPRINTF(vg_filename, TESTER_VG_FILENAME_FMT, exec_id);
+        fderr = open(vg_filename, O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+        if (fderr < 0)
+        {
+            rc = TE_OS_RC(TE_TESTER, errno);
+            ERROR("Failed to open valgrind output file %s: %r",
+                  vg_filename, rc);
+
+            return rc;
+        }
+    }
+
+    rc = start_test_script(exec_id, args, fderr, &pid);
     if (fderr >= 0)
         close(fderr);
+    if (rc != 0)
+        return rc;
 
     tester_set_serial_pid(pid);
     pid = waitpid(pid, code, 0);
@@ -2716,6 +2770,110 @@ cleanup:
 }
 #endif /* WITH_TRC */
 
+/** Flags which require test scripts to be run one by one */
+#define TESTER_SERIAL_FLAGS \
+    (TESTER_NO_SIMULT | TESTER_FAKE | TESTER_VALGRIND | TESTER_GDB | \
+     TESTER_INTERACTIVE | TESTER_INLOGUE | TESTER_PRERUN | \
+     TESTER_ASSEMBLE_PLAN | TESTER_RUN_WHILE_PASSED | \
+     TESTER_RUN_WHILE_FAILED | TESTER_RUN_WHILE_EXPECTED | \
+     TESTER_RUN_WHILE_UNEXPECTED | TESTER_RUN_UNTIL_VERDICT)
+
+/**
+ * Check whether the test script may be run in background, i.e.
+ * concurrently with other scripts of the same simultaneous session.
+ *
+ * @param gctx          Tester run data
+ * @param ctx           Current context
+ * @param ri            Run item
+ *
+ * @return @c true if the script may be run in background.
+ */
+static bool
+run_job_allowed(const tester_run_data *gctx, const tester_ctx *ctx,
+                const run_item *ri)
+{
+    tester_flags flags = gctx->flags | ctx->flags;
+
+    if (gctx->act != NULL)
+        flags |= gctx->act->flags;
+
+    return ctx->simultaneous && ri->type == RUN_ITEM_SCRIPT &&
+           (flags & TESTER_SERIAL_FLAGS) == 0 &&
+           gctx->force_skip == 0 && gctx->exception == 0;
+}
+
+/**
+ * Start the test script in background.
+ *
+ * The result of the current test is moved from the context to the job
+ * in the storage of results of tests which are in progress, since
+ * the context result is reused by the next iterations while the test
+ * is still running. Expected result is obtained here since TRC walker
+ * of the context is moved to the next iterations as well.
+ *
+ * @param gctx          Tester run data
+ * @param ctx           Current context
+ * @param ri            Run item
+ * @param script        Test script to run
+ * @param cfg_id_off    Configuration ID of the test
+ * @param flags         Flags
+ *
+ * @return Status code.
+ */
+static te_errno
+run_job_submit(tester_run_data *gctx, tester_ctx *ctx, const run_item *ri,
+               test_script *script, unsigned int cfg_id_off,
+               tester_flags flags)
+{
+    te_vec      params = TE_VEC_INIT_AUTOPTR(char *);
+    tester_job *job;
+    te_errno    rc;
+
+    prepare_test_script_arguments(&params, flags, script,
+                                  ctx->current_result.id,
+                                  ri->name != NULL ? ri->name : script->name,
+                                  rand(), ctx->n_args, ctx->args);
+
+    job = TE_ALLOC(sizeof(*job));
+    job->ctx = ctx;
+    job->ri = ri;
+    job->execute = script->execute;
+    job->tin = cfg_id_off;
+    job->plan_id = ri->plan_id;
+    job->result = ctx->current_result;
+    te_test_result_init(&job->result.result);
+    job->result.status = TESTER_TEST_INCOMPLETE;
+#if WITH_TRC
+    if (ctx->do_trc_walker && test_get_name(ri) != NULL)
+    {
+        job->result.exp_result =
+            trc_db_walker_get_exp_result(ctx->trc_walker,
+                                         &gctx->trc_tags);
+    }
+#endif
+
+    tester_test_result_del(&gctx->results, &ctx->current_result);
+    tester_test_result_add(&gctx->results, &job->result);
+
+    rc = start_test_script(job->result.id, te_vec_get(&params, 0), -1,
+                           &job->pid);
+    te_vec_free(&params);
+    if (rc != 0)
+    {
+        tester_test_result_del(&gctx->results, &job->result);
+        tester_test_result_add(&gctx->results, &ctx->current_result);
+        free(job);
+        return rc;
+    }
+
+    VERB("ID=%u is started in background, %u test(s) running",
+         (unsigned int)job->result.id, gctx->n_jobs + 1);
+    TAILQ_INSERT_TAIL(&gctx->jobs, job, links);
+    gctx->n_jobs++;
+
+    return 0;
+}
+
 static tester_cfg_walk_ctl
 run_script(run_item *ri, test_script *script,
            unsigned int cfg_id_off, void *opaque)
@@ -2748,14 +2906,46 @@ run_script(run_item *ri, test_script *script,
 
     assert(ri != NULL);
     assert(ri->n_args == ctx->n_args);
-    if (run_test_script(script, ri->name, ctx->current_result.id,
-                        ctx->n_args, ctx->args,
-                        gctx->act == NULL ? def_flags : /* FIXME */
-                           (gctx->act->flags | def_flags),
-                        &ctx->current_result.status) != 0)
+    if (ctx->backup == NULL && run_job_allowed(gctx, ctx, ri))
     {
+        /* Keep no more than the allowed number of scripts running */
+        ctl = run_jobs_join(gctx,
+                            tester_global_context.simult_workers - 1);
+        if (ctl != TESTER_CFG_WALK_CONT)
+        {
+            EXIT("%u", ctl);
+            return ctl;
+        }
+
+        if (run_job_submit(gctx, ctx, ri, script, cfg_id_off,
+                           gctx->act == NULL ? def_flags :
+                               (gctx->act->flags | def_flags)) == 0)
+        {
+            ctx->deferred = true;
+            EXIT("CONT - deferred");
+            return TESTER_CFG_WALK_CONT;
+        }
         ctx->current_result.status = TESTER_TEST_ERROR;
     }
+    else
+    {
+        /* Scripts run in series must not overlap with background ones */
+        ctl = run_jobs_join(gctx, 0);
+        if (ctl != TESTER_CFG_WALK_CONT)
+        {
+            EXIT("%u", ctl);
+            return ctl;
+        }
+
+        if (run_test_script(script, ri->name, ctx->current_result.id,
+                            ctx->n_args, ctx->args,
+                            gctx->act == NULL ? def_flags : /* FIXME */
+                               (gctx->act->flags | def_flags),
+                            &ctx->current_result.status) != 0)
+        {
+            ctx->current_result.status = TESTER_TEST_ERROR;
+        }
+    }
 
     switch (ctx->current_result.status)
     {
@@ -3072,12 +3262,28 @@ run_item_start(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
 
     }
 
+    if (gctx->n_jobs > 0 && !run_job_allowed(gctx, ctx, ri))
+    {
+        tester_cfg_walk_ctl ctl = run_jobs_join(gctx, 0);
+
+        if (ctl != TESTER_CFG_WALK_CONT)
+        {
+            EXIT("%u", ctl);
+            return ctl;
+        }
+    }
+
     if (!(gctx->flags & (TESTER_FAKE | TESTER_PRERUN | TESTER_ASSEMBLE_PLAN)))
         start_cmd_monitors(&ri->cmd_monitors);
 
     if (~flags & TESTER_CFG_WALK_SERVICE)
     {
-        if (ctx->backup == NULL)
+        /*
+         * Configuration changes of scripts run in background cannot be
+         * attributed to a particular test, they are tracked by
+         * the backup of the whole simultaneous session.
+         */
+        if (ctx->backup == NULL && !run_job_allowed(gctx, ctx, ri))
             run_create_cfg_backup(ctx, test_get_attrs(ri)->track_conf);
     }
 
@@ -3190,6 +3396,17 @@ run_session_start(run_item *ri, test_session *session,
 
     tester_get_sticky_reqs(&ctx->reqs, &session->reqs);
 
+    /*
+     * Keep-alive validation and exception handler are run between
+     * items, so items of such sessions are always run in series.
+     */
+    ctx->simultaneous = session->simultaneous &&
+                        tester_global_context.simult_workers > 1 &&
+                        session->keepalive == NULL &&
+                        session->exception == NULL &&
+                        ((gctx->flags | ctx->flags) &
+                         TESTER_SERIAL_FLAGS) == 0;
+
 #if WITH_TRC
     if (~ctx->flags & TESTER_NO_TRC)
     {
@@ -3216,6 +3433,7 @@ run_session_end(run_item *ri, test_session *session,
 {
     tester_run_data    *gctx = opaque;
     tester_ctx         *ctx;
+    tester_cfg_walk_ctl ctl;
 
     UNUSED(ri);
     UNUSED(session);
@@ -3225,6 +3443,9 @@ run_session_end(run_item *ri, test_session *session,
     assert(ctx != NULL);
     LOG_WALK_ENTRY(cfg_id_off, gctx);
 
+    /* Results of the scripts run in background belong to this session */
+    ctl = run_jobs_join(gctx, 0);
+
 #if WITH_TRC
     if (~ctx->flags & TESTER_NO_TRC)
     {
@@ -3238,8 +3459,8 @@ run_session_end(run_item *ri, test_session *session,
 
     tester_run_destroy_ctx(gctx);
 
-    EXIT("CONT");
-    return TESTER_CFG_WALK_CONT;
+    EXIT("%u", ctl);
+    return ctl;
 }
 
 static tester_cfg_walk_ctl
@@ -3398,6 +3619,17 @@ run_epilogue_start(run_item *ri, unsigned int cfg_id_off, void *opaque)
         return TESTER_CFG_WALK_SKIP;
     }
 
+    /*
+     * Epilogue must not overlap with the session items and inherits
+     * the session result, so wait for scripts run in background.
+     * Epilogue is run even if testing is stopped.
+     */
+    if (run_jobs_join(gctx, 0) == TESTER_CFG_WALK_FAULT)
+    {
+        EXIT("FAULT");
+        return TESTER_CFG_WALK_FAULT;
+    }
+
     ctx = tester_run_more_ctx(gctx, false);
 
     VERB("Running test session epilogue...");
@@ -4296,6 +4528,89 @@ trc_exp_result_to_log_buf(te_log_buf *lb, const trc_exp_result *result)
 }
 #endif
 
+#if WITH_TRC
+/**
+ * Compare obtained test result with the expected one and update
+ * expectations status of the result.
+ *
+ * @param ri            Run item
+ * @param result        Test result with expected result filled in
+ */
+static void
+run_check_exp_result(const run_item *ri, tester_test_result *result)
+{
+    if (result->result.status == TE_TEST_EMPTY)
+    {
+        assert(run_item_container(ri));
+        assert(result->exp_status == TRC_VERDICT_UNKNOWN);
+        /*
+         * No tests have been run in this package/session,
+         * we don't want to scream that result is unexpected.
+         */
+        result->exp_status = TRC_VERDICT_EXPECTED;
+    }
+    else if (result->exp_result == NULL &&
+             (/* Any test with specified name w/o record in TRC DB */
+              test_get_name(ri) != NULL ||
+              /* Noname session with only unknown tests inside */
+              result->exp_status == TRC_VERDICT_UNKNOWN))
+    {
+        te_log_buf *lb = te_log_buf_alloc();
+
+        te_log_buf_append(lb, "\nObtained result is:\n");
+        te_test_result_to_log_buf(lb, &result->result);
+        RING("%s", te_log_buf_get(lb));
+        te_log_buf_free(lb);
+
+        assert(result->exp_status == TRC_VERDICT_UNKNOWN);
+        if (result->error == NULL)
+            result->error = "Unknown test/iteration";
+    }
+    else if (ri->type != RUN_ITEM_SCRIPT &&
+             ((test_get_name(ri) == NULL) ||
+              (result->result.status != TE_TEST_SKIPPED)))
+    {
+        /*
+         * Expectations status can be either unknown, if
+         * everything is skipped inside or only unknown
+         * tests are run, or known otherwise.
+         */
+
+        if (result->exp_status == TRC_VERDICT_UNEXPECTED &&
+            result->error == NULL)
+        {
+            result->error = "Unexpected test result(s)";
+        }
+    }
+    /* assert(result->exp_result != NULL) */
+    else
+    {
+        /* Even for expected test result, we want to see what we've
+         * got and what we expect */
+        te_log_buf *lb = te_log_buf_alloc();
+
+        te_log_buf_append(lb, "\nObtained result is:\n");
+        te_test_result_to_log_buf(lb, &result->result);
+        te_log_buf_append(lb, "\nExpected results are: ");
+        trc_exp_result_to_log_buf(lb, result->exp_result);
+        RING("%s", te_log_buf_get(lb));
+        te_log_buf_free(lb);
+
+        if (trc_is_result_expected(result->exp_result,
+                                   &result->result) != NULL)
+        {
+            result->exp_status = TRC_VERDICT_EXPECTED;
+        }
+        else
+        {
+            result->exp_status = TRC_VERDICT_UNEXPECTED;
+            if (result->error == NULL)
+                result->error = "Unexpected test result";
+        }
+    }
+}
+#endif
+
 static bool
 result_has_verdict(te_test_result *result, const char *verdict_str)
 {
@@ -4310,6 +4625,134 @@ result_has_verdict(te_test_result *result, const char *verdict_str)
     return false;
 }
 
+/**
+ * Wait for the test script run in background and process its result
+ * in the same way as run_repeat_end() does for scripts run in series.
+ *
+ * @param gctx          Tester run data
+ * @param job           Job to finish
+ *
+ * @return Walk control.
+ */
+static tester_cfg_walk_ctl
+run_job_finish(tester_run_data *gctx, tester_job *job)
+{
+    tester_ctx         *ctx = job->ctx;
+    tester_test_result *result = &job->result;
+    int                 code;
+
+    if (waitpid(job->pid, &code, 0) < 0)
+    {
+        ERROR("waitpid failed: %r", TE_OS_RC(TE_TESTER, errno));
+        result->status = TESTER_TEST_ERROR;
+    }
+    else
+    {
+        result->status = translate_script_exit_code(job->execute,
+                                                    result->id, code);
+    }
+    job->pid = -1;
+
+    /* Test execution has been finished */
+    tester_test_result_del(&gctx->results, result);
+
+    tester_test_status_to_te_test_result(result->status, &result->result,
+                                         &result->error, result->id);
+#if WITH_TRC
+    if (~ctx->flags & TESTER_NO_TRC)
+        run_check_exp_result(job->ri, result);
+#endif
+
+    log_test_result(ctx->group_result.id, result, job->plan_id);
+
+    tester_term_out_done(ctx->flags, RUN_ITEM_SCRIPT,
+                         run_item_name(job->ri), job->tin,
+                         ctx->group_result.id, result->id, result->status,
+#if WITH_TRC
+                         result->exp_status
+#else
+                         TRC_VERDICT_UNKNOWN
+#endif
+                         );
+
+    te_test_result_clean(&result->result);
+
+    /* Update result of the group */
+    tester_group_result(&ctx->group_result, result);
+    if (ctx->group_result.status == TESTER_TEST_ERROR)
+        return TESTER_CFG_WALK_FAULT;
+
+    if (result->status == TESTER_TEST_STOPPED)
+        return TESTER_CFG_WALK_STOP;
+
+    return TESTER_CFG_WALK_CONT;
+}
+
+/**
+ * Ask all test scripts run in background to terminate. They are
+ * interrupted by SIGINT in the same way as scripts run in series are
+ * interrupted from the terminal, so that they can clean up.
+ *
+ * @param gctx          Tester run data
+ */
+static void
+run_jobs_kill(tester_run_data *gctx)
+{
+    tester_job *job;
+
+    TAILQ_FOREACH(job, &gctx->jobs, links)
+    {
+        if (job->pid < 0 || job->killed)
+            continue;
+
+        if (kill(job->pid, SIGINT) < 0 && errno != ESRCH)
+        {
+            ERROR("ID=%u: kill(%d, SIGINT) failed: %r",
+                  (unsigned int)job->result.id, (int)job->pid,
+                  TE_OS_RC(TE_TESTER, errno));
+        }
+        job->killed = true;
+    }
+}
+
+/**
+ * Finish test scripts run in background in the order they have been
+ * started (i.e. in the testing plan order) until no more than
+ * the specified number of them is left. If Tester is interrupted,
+ * all the scripts are asked to terminate first.
+ *
+ * @param gctx          Tester run data
+ * @param max_jobs      Maximum number of jobs to leave running
+ *
+ * @return Walk control.
+ */
+static tester_cfg_walk_ctl
+run_jobs_join(tester_run_data *gctx, unsigned int max_jobs)
+{
+    tester_cfg_walk_ctl ctl = TESTER_CFG_WALK_CONT;
+    tester_cfg_walk_ctl job_ctl;
+    tester_job         *job;
+
+    if (tester_sigint_received)
+        run_jobs_kill(gctx);
+
+    while (gctx->n_jobs > max_jobs)
+    {
+        job = TAILQ_FIRST(&gctx->jobs);
+        assert(job != NULL);
+        TAILQ_REMOVE(&gctx->jobs, job, links);
+        gctx->n_jobs--;
+
+        job_ctl = run_job_finish(gctx, job);
+        if (ctl == TESTER_CFG_WALK_CONT)
+            ctl = job_ctl;
+
+        free(job);
+    }
+
+    return ctl;
+}
+
 static tester_cfg_walk_ctl
 run_repeat_end(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
                void *opaque)
@@ -4318,6 +4761,7 @@ run_repeat_end(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
     tester_ctx         *ctx;
     unsigned int        step;
     bool has_verdict = false;
+    bool deferred;
     te_errno            rc;
 
     assert(gctx != NULL);
@@ -4325,7 +4769,17 @@ run_repeat_end(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
     assert(ctx != NULL);
     LOG_WALK_ENTRY(cfg_id_off, gctx);
 
-    if (gctx->force_skip > 0 ||
+    deferred = ctx->deferred;
+    ctx->deferred = false;
+
+    if (deferred)
+    {
+        /*
+         * The test script is still running in background, its result
+         * is processed by run_jobs_join().
+         */
+    }
+    else if (gctx->force_skip > 0 ||
         ctx->current_result.status == TESTER_TEST_INCOMPLETE)
     {
         ctx->current_result.status = TESTER_TEST_EMPTY;
@@ -4412,81 +4866,7 @@ run_repeat_end(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
                                                  &gctx->trc_tags);
             }
 
-            if (ctx->current_result.result.status == TE_TEST_EMPTY)
-            {
-                assert(run_item_container(ri));
-                assert(ctx->current_result.exp_status ==
-                       TRC_VERDICT_UNKNOWN);
-                /*
-                 * No tests have been run in this package/session,
-                 * we don't want to scream that result is unexpected.
-                 */
-                ctx->current_result.exp_status = TRC_VERDICT_EXPECTED;
-            }
-            else if (ctx->current_result.exp_result == NULL &&
-                (/* Any test with specified name w/o record in TRC DB */
-                 test_get_name(ri) != NULL ||
-                 /* Noname session with only unknown tests inside */
-                 ctx->current_result.exp_status == TRC_VERDICT_UNKNOWN))
-            {
-                te_log_buf *lb = te_log_buf_alloc();
-
-                te_log_buf_append(lb, "\nObtained result is:\n");
-                te_test_result_to_log_buf(lb, &ctx->current_result.result);
-                RING("%s", te_log_buf_get(lb));
-                te_log_buf_free(lb);
-
-                assert(ctx->current_result.exp_status ==
-                           TRC_VERDICT_UNKNOWN);
-                if (ctx->current_result.error == NULL)
-                    ctx->current_result.error = "Unknown test/iteration";
-            }
-            else if (ri->type != RUN_ITEM_SCRIPT &&
-                     ((test_get_name(ri) == NULL) ||
-                      (ctx->current_result.result.status !=
-                           TE_TEST_SKIPPED)))
-            {
-                /*
-                 * Expectations status can be either unknown, if
-                 * everything is skipped inside or only unknown
-                 * tests are run, or known otherwise.
-                 */
-
-                if (ctx->current_result.exp_status ==
-                        TRC_VERDICT_UNEXPECTED &&
-                    ctx->current_result.error == NULL)
-                {
-                    ctx->current_result.error = "Unexpected test result(s)";
-                }
-            }
-            /* assert(ctx->current_result.exp_result != NULL) */
-            else
-            {
-                /* Even for expected test result, we want to see what we've
-                 * got and what we expect */
-                te_log_buf *lb = te_log_buf_alloc();
-
-                te_log_buf_append(lb, "\nObtained result is:\n");
-                te_test_result_to_log_buf(lb, &ctx->current_result.result);
-                te_log_buf_append(lb, "\nExpected results are: ");
-                trc_exp_result_to_log_buf(lb,
-                                          ctx->current_result.exp_result);
-                RING("%s", te_log_buf_get(lb));
-                te_log_buf_free(lb);
-
-                if (trc_is_result_expected(
-                         ctx->current_result.exp_result,
-                         &ctx->current_result.result) != NULL)
-                {
-                    ctx->current_result.exp_status = TRC_VERDICT_EXPECTED;
-                }
-                else
-                {
-                    ctx->current_result.exp_status = TRC_VERDICT_UNEXPECTED;
-                    if (ctx->current_result.error == NULL)
-                        ctx->current_result.error = "Unexpected test result";
-                }
-            }
+            run_check_exp_result(ri, &ctx->current_result);
         }
 #endif
 
@@ -4526,7 +4906,8 @@ run_repeat_end(run_item *ri, unsigned int cfg_id_off, unsigned int flags,
     }
 
     /* Update result of the group */
-    tester_group_result(&ctx->group_result, &ctx->current_result);
+    if (!deferred)
+        tester_group_result(&ctx->group_result, &ctx->current_result);
     if (ctx->group_result.status == TESTER_TEST_ERROR)
     {
         EXIT("FAULT");
@@ -4795,6 +5176,7 @@ tester_run(testing_scenario   *scenario,
     data.act = TAILQ_FIRST(scenario);
     data.act_id = (data.act != NULL) ? data.act->first : 0;
     data.direction = TESTING_FORWARD;
+    TAILQ_INIT(&data.jobs);
 #if WITH_TRC
     data.trc_db = trc_db;
     TAILQ_INIT(&data.trc_tags);
@@ -4933,6 +5315,12 @@ tester_run(testing_scenario   *scenario,
             rc = TE_RC(TE_TESTER, TE_EFAULT);
     }
 
+    /* Scripts run in background are left if the walk is aborted */
+    if (!TAILQ_EMPTY(&data.jobs))
+    {
+        run_jobs_kill(&data);
+        (void)run_jobs_join(&data, 0);
+    }
     tester_run_destroy_ctx(&data);
     scenario_free(&data.fixed_scen);
 #if WITH_TRC
@@ -102,6 +102,8 @@ tester_global_init(tester_global *global)
 
     global->dial = -1.0;
 
+    global->simult_workers = 1;
+
     return 0;
 }
 
@@ -185,6 +187,7 @@ process_cmd_line_opts(tester_global *global, int argc, char **argv)
         TESTER_OPT_NO_CFG_TRACK,
         TESTER_OPT_NO_LOGUES,
         TESTER_OPT_NO_SIMULT,
+        TESTER_OPT_SIMULT_WORKERS,
         TESTER_OPT_ONLY_REQ_LOGUES,
 
         TESTER_OPT_REQ,
@@ -238,6 +241,9 @@ process_cmd_line_opts(tester_global *global, int argc, char **argv)
         TESTER_OPT_CMD_MONITOR,
     };
 
+    /* popt parses integers into int, it is checked and then assigned */
+    int simult_workers = global->simult_workers;
+
     /* Option Table */
     const struct poptOption options_table[] = {
         { "interactive", 'i', POPT_ARG_NONE, NULL, TESTER_OPT_INTERACTIVE,
@@ -274,12 +280,14 @@ process_cmd_line_opts(tester_global *global, int argc, char **argv)
           "command line. This may not work well if your prologues "
           "can add requirements on their own in /local:/reqs:", NULL },
 
-#if 0
         { "no-simultaneous", '\0', POPT_ARG_NONE, NULL,
           TESTER_OPT_NO_SIMULT,
           "Force to run all tests in series. Useful for debugging.",
           NULL },
-#endif
+        { "simultaneous-workers", '\0', POPT_ARG_INT,
+          &simult_workers, TESTER_OPT_SIMULT_WORKERS,
+          "Maximum number of test scripts of a simultaneous session "
+          "to run at the same time (1 by default).", "<number>" },
 
         { "req", 'R', POPT_ARG_STRING, NULL, TESTER_OPT_REQ,
           "Requirements to be tested (logical expression).",
@@ -461,6 +469,17 @@ process_cmd_line_opts(tester_global *global, int argc, char **argv)
                 global->flags |= TESTER_NO_SIMULT;
                 break;
 
+            case TESTER_OPT_SIMULT_WORKERS:
+                if (simult_workers < 1)
+                {
+                    ERROR("Incorrect --simultaneous-workers value %d, "
+                          "must be positive", simult_workers);
+                    poptFreeContext(optCon);
+                    return TE_EINVAL;
+                }
+                global->simult_workers = simult_workers;
+                break;
+
             case TESTER_OPT_NO_RUN:
                 global->flags |= TESTER_NO_RUN;
                 break;
@@ -47,6 +47,12 @@ typedef struct tester_global {
     /** Percentage of all test iterations to choose randomly */
     double dial;
 
+    /**
+     * Maximum number of test scripts of a simultaneous session
+     * run at the same time
+     */
+    unsigned int simult_workers;
+
     cmd_monitor_descrs  cmd_monitors;   /**< Command monitors specifier via
                                              command line */
 } tester_global;
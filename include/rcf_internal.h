@@ -48,12 +48,38 @@ extern "C" {
 #define COLD_REBOOT            32   /**< Cold reboot host */
 /*@}*/
 
+/** @name Get log flags (passed in intparm of RCFOP_GET_LOG) */
+#define RCF_GET_LOG_INLINE      1   /**< Return log in message data
+                                         instead of a local file */
+/*@}*/
+
+/**
+ * @name Configuration tree records
+ *
+ * The answer to RCFOP_CONFGET_TREE carries a binary attachment with
+ * a sequence of records, one per object instance:
+ * - OID length (32-bit, network byte order) and OID itself;
+ * - value length (32-bit, network byte order) or
+ *   @c RCF_CFG_TREE_NO_VALUE if the object has no value,
+ *   and value itself.
+ *
+ * Strings are not NUL-terminated. Instances are split into chunks
+ * of at most @c RCF_CFG_TREE_CHUNK records. The answer contains
+ * the position to request the next chunk from (passed in intparm)
+ * or zero if there are no more instances.
+ */
+#define RCF_CFG_TREE_NO_VALUE   UINT32_MAX  /**< No value length mark */
+#define RCF_CFG_TREE_CHUNK      10000       /**< Maximum number of records
+                                                 in one answer */
+/*@}*/
+
 /** @name Traffic flags */
 #define TR_POSTPONED            1
 #define TR_RESULTS              2
 #define TR_NO_PAYLOAD           4
 #define TR_SEQ_MATCH            8
 #define TR_MISMATCH             0x10
+#define TR_BINARY               0x20
 /*@}*/
 
 
@@ -98,6 +124,7 @@ typedef enum {
     RCFOP_TADEAD,           /**< Inform RCF that TA is dead */
     RCFOP_GET_SNIFFERS,     /**< Obtain the list of sniffers */
     RCFOP_GET_SNIF_DUMP,    /**< Pull out capture logs of the sniffer */
+    RCFOP_CONFGET_TREE,     /**< Configuration command "get tree" */
 } rcf_op_t;
 
 
@@ -191,6 +218,7 @@ rcf_op_to_string(rcf_op_t op)
         case RCFOP_SESSION:         return "session";
         case RCFOP_REBOOT:          return "reboot";
         case RCFOP_CONFGET:         return "configure get";
+        case RCFOP_CONFGET_TREE:    return "configure get tree";
         case RCFOP_CONFSET:         return "configure set";
         case RCFOP_CONFADD:         return "configure add";
         case RCFOP_CONFDEL:         return "configure delete";
@@ -50,6 +50,22 @@
 #define CSAP_PARAM_LAST_PACKET_TIME     "last_pkt_time"
 #define CSAP_PARAM_NO_MATCH_PKTS        "no_match_pkts"
 
+/**
+ * Header of a received packet record in binary reports.
+ *
+ * If binary reporting of received packets is requested, packets are
+ * reported in attachments which consist of records. Every record is
+ * the header with all fields in network byte order followed by @p len
+ * bytes of the received frame.
+ */
+typedef struct tad_bin_pkt_hdr {
+    uint32_t    len;        /**< Length of the frame */
+    uint32_t    ts_sec;     /**< Timestamp: seconds */
+    uint32_t    ts_usec;    /**< Timestamp: microseconds */
+    int32_t     match_unit; /**< Index of matched pattern unit or @c -1
+                                 if the packet does not match */
+} tad_bin_pkt_hdr;
+
 /**
  * Type for CSAP handle, should have semantic unsigned integer,
  * because TAD Users Guide specify CSAP ID as positive integer, and
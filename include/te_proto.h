@@ -16,6 +16,7 @@
 #define TE_PROTO_SHUTDOWN       "shutdown"
 #define TE_PROTO_REBOOT         "reboot"
 #define TE_PROTO_CONFGET        "configure get"
+#define TE_PROTO_CONFGET_TREE   "configure get_tree"
 #define TE_PROTO_CONFSET        "configure set"
 #define TE_PROTO_CONFADD        "configure add"
 #define TE_PROTO_CONFDEL        "configure del"
@@ -59,6 +59,21 @@ typedef struct te_pcap_pkthdr {
     uint32_t len;    /**< length this packet (off wire) */
 } te_pcap_pkthdr;
 
+/**
+ * Name of the file with capture statistics in the sniffer folder.
+ * It starts with a dot to be skipped when capture files are listed.
+ */
+#define SNIF_STATS_FNAME ".stats"
+
+/** Capture statistics periodically saved by the sniffer process */
+typedef struct te_sniffer_stats {
+    uint64_t received;  /**< Packets received by the capture filter */
+    uint64_t dropped;   /**< Packets dropped because there was no room
+                             in the capture ring */
+    uint64_t ifdropped; /**< Packets dropped by the interface or its
+                             driver */
+} te_sniffer_stats;
+
 /**
  * Safe copy of the time stamp
  *
@@ -11,6 +11,8 @@
 #ifndef __TE_ASN_IMPL_H__
 #define __TE_ASN_IMPL_H__
 
+#include <stddef.h>
+
 #include "asn_usr.h"
 
 #ifdef __cplusplus
@@ -148,6 +150,49 @@ struct asn_value
                         Root container is a container which was passed to
                         asn_walk_depth. Use asn_get_value_path from
                         walk_func to obtain this path */
+    asn_arena *arena; /**< Arena the value and its data are allocated
+                           from, @c NULL if they are allocated on heap */
+};
+
+/**
+ * Chunk of memory of ASN.1 values arena.
+ */
+typedef struct asn_arena_chunk {
+    struct asn_arena_chunk *next;   /**< Previously allocated chunk */
+    size_t                  size;   /**< Size of the chunk data */
+    size_t                  used;   /**< Number of used bytes */
+    max_align_t             data[]; /**< Chunk data */
+} asn_arena_chunk;
+
+/**
+ * Arena of ASN.1 values: memory of all values of a tree is carved out
+ * of a few big chunks and is released at once when the root value
+ * is freed.
+ */
+struct asn_arena {
+    asn_value       *root;          /**< Root value owning the arena */
+    size_t           chunk_size;    /**< Size of data of new chunks */
+    asn_arena_chunk *chunks;        /**< List of chunks, the current
+                                         one goes first */
+};
+
+/**
+ * Step of compiled path to ASN.1 subvalue.
+ */
+typedef struct asn_path_step {
+    int             index;  /**< Index of the child in named entries of
+                                 the container type or index in array
+                                 for 'SEQUENCE OF' and 'SET OF' */
+    const asn_type *type;   /**< Type of the child */
+} asn_path_step;
+
+/**
+ * Path to ASN.1 subvalue compiled for a certain root type.
+ */
+struct asn_path {
+    const asn_type *type;       /**< Type of the root value */
+    unsigned int    len;        /**< Number of steps */
+    asn_path_step   steps[];    /**< Steps from the root to the subvalue */
 };
 
 /* See description in 'asn_usr.h' */
@@ -271,6 +316,17 @@ extern te_errno asn_get_child_by_index(const asn_value *container,
 
 extern bool asn_clean_count(asn_value *value);
 
+/**
+ * Init empty ASN.1 value of specified type allocating it from arena.
+ *
+ * @param type      ASN.1 type to which value should belong.
+ * @param arena     Arena or @c NULL to allocate the value on heap.
+ *
+ * @return pointer to new asn_value instance or @c NULL if error occurred.
+ */
+extern asn_value *asn_impl_init_value(const asn_type *type,
+                                      asn_arena *arena);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <stdarg.h>
 
 #include <errno.h>
 
@@ -1125,589 +1126,618 @@ asn_count_len_objid(const asn_value *value)
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value ENUMERATED
- * and put it into specified buffer.
+ * Count required length of string for textual presentation of
+ * specified value.
  *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to print, should have ENUMERATED type.
+ * @param value         ASN.1 value.
+ * @param indent        current indent
  *
- * @return number characters written to buffer or -1 if error occurred.
+ * @return length of required string.
  */
-static int
-asn_snprint_enum(char *buffer, size_t buf_len, const asn_value *value)
+size_t
+asn_count_txt_len(const asn_value *value, unsigned int indent)
 {
-    int          used;
-    unsigned int i, need;
-    const char  *val_label = NULL;
+    if (value == NULL)
+        return 0;
 
-    if (value->syntax != ENUMERATED)
-        return -1;
+    switch (value->syntax)
+    {
+        case BOOL:
+            if (value->data.integer)
+                return strlen("TRUE");
+            else
+                return strlen("FALSE");
 
+        case INTEGER:
+        case UINTEGER:
+            return value->txt_len;
 
-    for (i = 0; i < value->asn_type->len; i++)
-    {
-        if (value->data.integer ==
-            value->asn_type->sp.enum_entries[i].value)
-        {
-            val_label = value->asn_type->sp.enum_entries[i].name;
-            break;
-        }
-    }
-    if (i < value->asn_type->len)
-        used = snprintf(buffer, buf_len, "%s", val_label);
-    else
-        used = snprintf(buffer, buf_len, "%d", value->data.integer);
+        case ENUMERATED:
+            return asn_count_len_enum(value);
 
-    if (buf_len <= (need = asn_count_len_enum(value)))
-        return need;
+        case CHAR_STRING:
+            return value->txt_len;
+
+        case OCT_STRING:
+            return value->txt_len;
+
+        case PR_ASN_NULL:
+            return strlen("NULL");
 
+        case LONG_INT:
+        case BIT_STRING:
+        case REAL:
+            return 0; /* not implemented yet.*/
+
+        case OID:
+            return asn_count_len_objid(value);
 
-    return used;
+        /* Due to some (not found) bugs in counting length, obtained value
+         * is a bit less then really need, so the following ugly hacks
+         * are made.
+         * TODO: found and fix bugs. */
+        case CHOICE:
+            return asn_count_len_choice(value, indent);
+
+        case TAGGED:
+            return asn_count_len_tagged(value, indent);
+
+        case SEQUENCE:
+        case SEQUENCE_OF:
+        case SET:
+        case SET_OF:
+            return asn_count_len_array_fields(value, indent);
+
+        default:
+            return 0; /* nothing to do. */
+    }
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value Character String
- * and put it into specified buffer.
- * NOTE: see description for asn_sprint_value(), this function is very
- * similar, just syntax-specific.
+ * Count required length of string for textual presentation
+ * of specified value.
  *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to be printed, should have INTEGER type.
+ * @param value         ASN.1 value.
+ * @param indent        current indent
  *
- * @return number characters written to buffer or -1 if error occurred.
+ * @return length of required string.
  */
-static int
-asn_snprint_charstring(char *buffer, size_t buf_len, const asn_value *value)
+size_t
+asn_count_len_array_fields(const asn_value *value, unsigned int indent)
 {
-    const char quote[] = "\"";
-    char *string;
-    char *buf_place = buffer;
-    size_t total_syms = 0;
+    int *txt_len_p;
 
-    if (value->syntax != CHAR_STRING)
+    if (value == NULL)
+        return 0;
+    /* Explicit discards of 'const' qualifier, whereas field 'txt_len'
+     * should have 'mutable' semantic */
+    txt_len_p = (int *)&(value->txt_len);
+
+    if ((value->syntax & ASN_SYN_ARRAY) == 0 ||
+        (value->syntax & COMPOUND) == 0)
         return -1;
 
-#define PUT_PIECE(_src, _len) \
-    do {                                                    \
-        size_t loc_len = (_len);                            \
-        size_t buf_left = buf_len - total_syms;             \
-                                                            \
-        memcpy(buf_place, (_src), MIN(buf_left, loc_len));  \
-        if (buf_left <= loc_len)                            \
-            goto finish;                                    \
-        total_syms += loc_len;                              \
-        buf_place += loc_len;                               \
-    } while (0)
-
-    PUT_PIECE(quote, strlen(quote));
-
-    string = value->data.other;
-    while (string != NULL && string[0] != '\0')
+
+    if (value->txt_len < 0)
     {
-        const char escaped_quote[] = "\\\"";
-        char *quote_place;
+        unsigned int i;
 
-        quote_place = index(string, '"');
-        if (quote_place == NULL)
-            break;
+        int all_used = 1; /* for "{" */
+        int elems = 0;
 
-        PUT_PIECE(string, quote_place - string);
+        for (i = 0; i < value->len; i++)
+        {
+            asn_value *v_el = value->data.array[i];
 
-        PUT_PIECE(escaped_quote, strlen(escaped_quote));
+            if (v_el)
+            {
+                if (value->syntax & ASN_SYN_NAMED)
+                {
+                    all_used += strlen(v_el->name) + 1;
+                }
+                all_used += asn_count_txt_len(v_el, indent + 2);
+                elems ++;
+            }
+        }
+        all_used +=   elems * (indent + 2) /* indents before subvalues */
+                    + elems + 1            /* new line symbols */
+                    + (elems ? (elems - 1) : 0)/* commas */
+                    + indent + 1;          /* closing brace wint indent */
 
-        string = quote_place + 1;
+        *txt_len_p = all_used;
     }
 
-    /* Put rest of the string to buffer */
-    if (string != NULL && string[0] != '\0')
-        PUT_PIECE(string, strlen(string));
-
-    /* Put close double quote */
-    PUT_PIECE(quote, strlen(quote));
+    return value->txt_len;
+}
 
-    /* PUT_PIECE jumps to finish if there is no space for terminating NUL */
-    buf_place[0] = '\0';
+/** Size of buffer in which printed text is collected for the callback */
+#define ASN_PRINT_BUF 0x1000
 
-#undef PUT_PIECE
+/** Context of ASN.1 value printing in one traversal */
+typedef struct asn_print_ctx {
+    asn_print_cb   *cb;     /**< Callback for pieces of text */
+    void           *opaque; /**< Opaque data for the callback */
+    te_errno        rc;     /**< The first error occurred */
+    char           *buf;    /**< Buffer of @c ASN_PRINT_BUF bytes where
+                                 text is collected for the callback */
+    size_t          len;    /**< Number of bytes collected in buffer */
+} asn_print_ctx;
 
-finish:
-    buffer[buf_len - 1] = '\0';
-    return value->txt_len; /* assume, that for character string 'txt_len'
-                              is always correct - it is updated when
-                              value is changed */
+/**
+ * Pass collected text to the callback.
+ *
+ * @param ctx           printing context
+ */
+static void
+asn_print_flush(asn_print_ctx *ctx)
+{
+    if (ctx->rc == 0 && ctx->len > 0)
+        ctx->rc = ctx->cb(ctx->buf, ctx->len, ctx->opaque);
+    ctx->len = 0;
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value OCTET STRING
- * and put it into specified buffer.
- *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to be printed, should have INTEGER type.
+ * Put piece of text to the output.
  *
- * @return number characters written to buffer or -1 if error occurred.
+ * @param ctx           printing context
+ * @param text          text to be put
+ * @param len           length of the text
  */
-static int
-asn_snprint_octstring(char *buffer, size_t buf_len, const asn_value *value)
+static void
+asn_print_put(asn_print_ctx *ctx, const char *text, size_t len)
 {
-    char        *pb = buffer;
-    char        *last_b = buffer + buf_len - 1;
-    unsigned int i;
-    static char  hex_digits[] = {'0', '1', '2', '3', '4', '5', '6', '7',
-                                 '8', '9', 'A', 'B', 'C', 'D', 'E', 'F', };
-    uint8_t     *cur_byte;
-
-    if (value->syntax != OCT_STRING)
-        return -1;
+    if (ctx->rc != 0 || len == 0)
+        return;
 
-#define PUT_OCT_SYM(_byte) \
-    do {                        \
-        if (pb == last_b)       \
-            goto finish;        \
-        *pb++ = (_byte);        \
-    } while (0)
-
-    PUT_OCT_SYM('\'');
-
-    for (i = 0, cur_byte = (uint8_t*)value->data.other; i < value->len;
-         i++, cur_byte++)
+    if (ctx->len + len > ASN_PRINT_BUF)
     {
-        PUT_OCT_SYM(hex_digits[(*cur_byte) >> 4  ]);
-        PUT_OCT_SYM(hex_digits[(*cur_byte) & 0x0f]);
-        PUT_OCT_SYM(' ');
+        asn_print_flush(ctx);
+        if (len > ASN_PRINT_BUF)
+        {
+            if (ctx->rc == 0)
+                ctx->rc = ctx->cb(text, len, ctx->opaque);
+            return;
+        }
     }
-    PUT_OCT_SYM('\'');
-    PUT_OCT_SYM('H');
 
-#undef PUT_OCT_SYM
-finish:
-    *pb = '\0';
-    return value->txt_len;
+    memcpy(ctx->buf + ctx->len, text, len);
+    ctx->len += len;
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value of complex type with
- * TAGGED syntax and put it into specified buffer.
- *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to be printed, should have INTEGER type.
- * @param indent        current indent
+ * Put NUL-terminated string to the output.
  *
- * @return number characters written to buffer or -1 if error occurred.
+ * @param ctx           printing context
+ * @param text          string to be put
  */
-static int
-asn_snprint_tagged(char *buffer, size_t buf_len, const asn_value *value,
-                   unsigned int indent)
+static inline void
+asn_print_str(asn_print_ctx *ctx, const char *text)
 {
-    unsigned int all_used = 0, used;
-
-    asn_value *v_el;
+    asn_print_put(ctx, text, strlen(text));
+}
 
-    /* codes of syntaxes which processed in this method
-     * may have arbitrary last two bits*/
-    if (value->syntax != TAGGED)
-        return -1;
+/**
+ * Put a number of spaces to the output.
+ *
+ * @param ctx           printing context
+ * @param indent        number of spaces
+ */
+static void
+asn_print_indent(asn_print_ctx *ctx, unsigned int indent)
+{
+    static const char spaces[] = "                                ";
+    unsigned int      len;
 
-    v_el = value->data.array[0];
-    if (v_el)
+    while (indent > 0)
     {
-        char t_class[4][30] = {"UNIVERSAL ","APPLICATION ","","PRIVATE "};
+        len = MIN(indent, sizeof(spaces) - 1);
+        asn_print_put(ctx, spaces, len);
+        indent -= len;
+    }
+}
+
+/**
+ * Put formatted text to the output. It is intended for short pieces
+ * like numbers and tags.
+ *
+ * @param ctx           printing context
+ * @param fmt           format string
+ * @param ...           format arguments
+ */
+static void
+asn_print_fmt(asn_print_ctx *ctx, const char *fmt, ...)
+{
+    char    text[64];
+    va_list ap;
+    int     len;
 
-        used = snprintf(buffer, buf_len, "[%s%d]",
-                        t_class[(int)value->tag.cl], value->tag.val);
-        if (used >= buf_len)
-            return used;
-        all_used += used; buffer += used;
+    va_start(ap, fmt);
+    len = vsnprintf(text, sizeof(text), fmt, ap);
+    va_end(ap);
 
-        used = asn_sprint_value(v_el, buffer, buf_len - all_used, indent);
-        all_used += used;
+    if (len < 0 || (size_t)len >= sizeof(text))
+    {
+        if (ctx->rc == 0)
+            ctx->rc = TE_ESMALLBUF;
+        return;
     }
 
-    return all_used;
+    asn_print_put(ctx, text, len);
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value of complex type with
- * CHOICE syntax and put it into specified buffer.
+ * Put decimal presentation of a number to the output. It is a lot
+ * cheaper than asn_print_fmt() which matters for big values.
  *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to be printed, should have INTEGER type.
- * @param indent        current indent
- *
- * @return number characters written to buffer or -1 if error occurred.
+ * @param ctx           printing context
+ * @param value         number to be printed
+ * @param is_signed     whether @p value should be treated as signed
  */
-static int
-asn_snprint_choice(char *buffer, size_t buf_len, const asn_value *value,
-                   unsigned int indent)
+static void
+asn_print_num(asn_print_ctx *ctx, int value, bool is_signed)
 {
-    int   used;
-    char *p = buffer,
-         *last = buffer + buf_len - 1,
-         *name_p;
+    char         text[12];
+    char        *p = text + sizeof(text);
+    bool         neg = is_signed && value < 0;
+    unsigned int n = neg ? -(unsigned int)value : (unsigned int)value;
 
-    asn_value *v_el;
+    do {
+        *--p = '0' + n % 10;
+        n /= 10;
+    } while (n != 0);
 
-    if (value->syntax != CHOICE)
-        return -1;
-
-    if ((v_el = value->data.array[0]) == NULL)
-        return -1;
+    if (neg)
+        *--p = '-';
 
+    asn_print_put(ctx, p, text + sizeof(text) - p);
+}
 
-    for (name_p = v_el->name;
-         (*name_p != '\0') && (p < last);
-         p++, name_p++)
-        *p = *name_p;
+static void asn_print_impl(asn_print_ctx *ctx, const asn_value *value,
+                           unsigned int indent);
 
-    if (p < last)
-        *p++ = ':';
+/**
+ * Print value of ENUMERATED syntax: label of the value if it is known,
+ * otherwise the number.
+ *
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
+ */
+static void
+asn_print_enum(asn_print_ctx *ctx, const asn_value *value)
+{
+    unsigned int i;
 
-    if (p == last)
+    for (i = 0; i < value->asn_type->len; i++)
     {
-        *p = '\0';
-        return asn_count_len_choice(value, indent);
+        if (value->data.integer == value->asn_type->sp.enum_entries[i].value)
+        {
+            asn_print_str(ctx, value->asn_type->sp.enum_entries[i].name);
+            return;
+        }
     }
-
-    used = p - buffer;
-    used += asn_sprint_value(v_el, p, buf_len - used, indent);
-
-    return used;
+    asn_print_num(ctx, value->data.integer, true);
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value of OID type and
- * put it into specified buffer.
+ * Print value of CHAR_STRING syntax with double quotes escaped.
  *
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param value         ASN.1 value to be printed, should have INTEGER type.
- *
- * @return number characters written to buffer or -1 if error occurred.
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
  */
-static int
-asn_snprint_objid(char *buffer, size_t buf_len, const asn_value *value)
+static void
+asn_print_charstring(asn_print_ctx *ctx, const asn_value *value)
 {
-    unsigned int i;
-    char *last = buffer + buf_len - 1;
-
-    unsigned int all_used = 0, used;
-    int *subid;
-
-    if (value->syntax != OID)
-        return -1;
-
+    const char *string = value->data.other;
+    const char *quote_place;
 
-    if (buf_len == 1)
-        goto error;
-    strcpy(buffer, "{");
+    asn_print_put(ctx, "\"", 1);
 
-    all_used++; buffer++; buf_len--;
-
-    subid = (int *)value->data.other;
-
-    for (i = 0; i < value->len; i++)
+    while (string != NULL &&
+           (quote_place = strchr(string, '"')) != NULL)
     {
-        used = snprintf(buffer, buf_len, "%d ", subid[i]);
-        if (used >= buf_len)
-            goto error;
-        all_used += used, buffer += used, buf_len -= used;
+        asn_print_put(ctx, string, quote_place - string);
+        asn_print_put(ctx, "\\\"", 2);
+        string = quote_place + 1;
     }
-    if (buffer == last)
-        goto error;
-    strcpy(buffer, "}");
-    all_used++;
+    if (string != NULL)
+        asn_print_str(ctx, string);
 
-    return all_used;
-
-error:
-    *last = '\0';
-    return asn_count_len_objid(value);
+    asn_print_put(ctx, "\"", 1);
 }
 
-
 /**
- * Prepare textual ASN.1 presentation of passed value of complex
- * type with many subvalues (i.e. 'SEQUENCE[_OF]' and 'SET[_OF]')
- * and put it into specified buffer.
- *
- * @param value         ASN.1 value to be printed, should have INTEGER type.
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
- * @param indent        current indent
+ * Print value of OCT_STRING syntax.
  *
- * @return number characters written to buffer or -1 if error occurred.
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
  */
-static int
-asn_snprint_array_fields(char *buffer, size_t buf_len, const asn_value *value,
-                         unsigned int indent)
+static void
+asn_print_octstring(asn_print_ctx *ctx, const asn_value *value)
 {
-    unsigned int i, j;
-    unsigned int all_used = 0, used;
-    int was_element = 0;
-
-    char *last = buffer + buf_len - 1;
+    static const char hex_digits[] = "0123456789ABCDEF";
+    const uint8_t    *cur_byte = value->data.other;
+    char              text[3 * 32];
+    size_t            used = 0;
+    unsigned int      i;
 
-    if ((value->syntax & ASN_SYN_ARRAY) == 0 ||
-        (value->syntax & COMPOUND) == 0)
-        return -1;
+    asn_print_put(ctx, "'", 1);
 
-#define PUT_OCT_SYM(_byte) \
-    do {                        \
-        if (buffer == last)     \
-            goto error;         \
-        *buffer++ = (_byte);    \
-        all_used++;             \
-    } while (0)
+    for (i = 0; i < value->len; i++, cur_byte++)
+    {
+        text[used++] = hex_digits[(*cur_byte) >> 4];
+        text[used++] = hex_digits[(*cur_byte) & 0x0f];
+        text[used++] = ' ';
+        if (used == sizeof(text))
+        {
+            asn_print_put(ctx, text, used);
+            used = 0;
+        }
+    }
+    asn_print_put(ctx, text, used);
 
-    PUT_OCT_SYM('{');
+    asn_print_put(ctx, "'H", 2);
+}
 
-    indent += 2;
+/**
+ * Print value of OID syntax.
+ *
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
+ */
+static void
+asn_print_objid(asn_print_ctx *ctx, const asn_value *value)
+{
+    const int   *subid = value->data.other;
+    unsigned int i;
 
+    asn_print_put(ctx, "{", 1);
     for (i = 0; i < value->len; i++)
     {
-        asn_value *v_el = value->data.array[i];
+        asn_print_num(ctx, subid[i], true);
+        asn_print_put(ctx, " ", 1);
+    }
+    asn_print_put(ctx, "}", 1);
+}
 
+/**
+ * Print value of complex type with many subvalues (i.e. 'SEQUENCE[_OF]'
+ * and 'SET[_OF]').
+ *
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
+ * @param indent        current indent
+ */
+static void
+asn_print_array_fields(asn_print_ctx *ctx, const asn_value *value,
+                       unsigned int indent)
+{
+    bool         was_element = false;
+    unsigned int i;
 
-        if (v_el)
-        {
-            if (was_element)
-                PUT_OCT_SYM(',');
+    asn_print_put(ctx, "{", 1);
 
-            PUT_OCT_SYM('\n');
+    for (i = 0; i < value->len && ctx->rc == 0; i++)
+    {
+        asn_value *v_el = value->data.array[i];
 
-            for (j = 0; j < indent; j++)
-                PUT_OCT_SYM(' ');
+        if (v_el == NULL)
+            continue;
 
-            /* Check if we have structure with named components. */
-            if (value->syntax & ASN_SYN_NAMED)
-            {
-                used = snprintf(buffer, buf_len - all_used, "%s ",
-                                v_el->name);
-                if (used >= buf_len - all_used)
-                    goto error;
-                all_used += used; buffer += used;
-            }
-
-            used = asn_sprint_value(v_el, buffer, buf_len - all_used,
-                                    indent);
-            if (used >= buf_len - all_used)
-                goto error;
-            all_used += used; buffer += used;
+        if (was_element)
+            asn_print_put(ctx, ",", 1);
+        asn_print_put(ctx, "\n", 1);
+        asn_print_indent(ctx, indent + 2);
 
-            was_element = 1;
+        if (value->syntax & ASN_SYN_NAMED)
+        {
+            asn_print_str(ctx, v_el->name);
+            asn_print_put(ctx, " ", 1);
         }
-    }
-    PUT_OCT_SYM('\n');
 
-    indent -= 2;
-    for (j = 0; j < indent; j++)
-        PUT_OCT_SYM(' ');
-
-    PUT_OCT_SYM('}');
-    *buffer = '\0';
-
-#undef PUT_OCT_SYM
+        asn_print_impl(ctx, v_el, indent + 2);
+        was_element = true;
+    }
 
-    return all_used;
-error:
-    *last = '\0';
-    return asn_count_txt_len(value, indent);
+    asn_print_put(ctx, "\n", 1);
+    asn_print_indent(ctx, indent);
+    asn_print_put(ctx, "}", 1);
 }
 
 /**
- * Prepare textual ASN.1 presentation of passed value and put it into
- * specified buffer.
+ * Print textual ASN.1 presentation of passed value.
  *
- * @param value         ASN.1 value to be printed.
- * @param buffer        buffer for ASN.1 text.
- * @param buf_len       length of buffer.
+ * @param ctx           printing context
+ * @param value         ASN.1 value to be printed
  * @param indent        current indent
- *
- * @return number characters written to buffer or -1 if error occurred.
  */
-int
-asn_sprint_value(const asn_value *value, char *buffer, size_t buf_len,
-                 unsigned int indent)
+static void
+asn_print_impl(asn_print_ctx *ctx, const asn_value *value,
+               unsigned int indent)
 {
-    if ((value == NULL) || (buffer == NULL) || (buf_len == 0))
-        return 0;
+    static const char *t_class[] = {"UNIVERSAL ", "APPLICATION ", "",
+                                    "PRIVATE "};
 
     switch (value->syntax)
     {
         case BOOL:
-            if (value->data.integer)
-                return snprintf(buffer, buf_len, "TRUE");
-            else
-                return snprintf(buffer, buf_len, "FALSE");
+            asn_print_str(ctx, value->data.integer ? "TRUE" : "FALSE");
+            break;
 
         case INTEGER:
-            return snprintf(buffer, buf_len, "%d", value->data.integer);
+            asn_print_num(ctx, value->data.integer, true);
+            break;
 
         case ENUMERATED:
-            return asn_snprint_enum(buffer, buf_len, value);
+            asn_print_enum(ctx, value);
+            break;
 
         case UINTEGER:
-            return snprintf(buffer, buf_len, "%u", value->data.integer);
+            asn_print_num(ctx, value->data.integer, false);
+            break;
 
         case CHAR_STRING:
-            return asn_snprint_charstring(buffer, buf_len, value);
+            asn_print_charstring(ctx, value);
+            break;
 
         case OCT_STRING:
-            return asn_snprint_octstring(buffer, buf_len, value);
+            asn_print_octstring(ctx, value);
+            break;
 
         case PR_ASN_NULL:
-            return snprintf(buffer, buf_len, "NULL");
+            asn_print_str(ctx, "NULL");
+            break;
 
-        case LONG_INT:
-        case BIT_STRING:
-        case REAL:
-            return 0; /* not implemented yet.*/
         case OID:
-            return asn_snprint_objid(buffer, buf_len, value);
+            asn_print_objid(ctx, value);
+            break;
+
         case CHOICE:
-            return asn_snprint_choice(buffer, buf_len, value, indent);
+            if (value->data.array[0] == NULL)
+            {
+                if (ctx->rc == 0)
+                    ctx->rc = TE_EASNINCOMPLVAL;
+                break;
+            }
+            asn_print_str(ctx, value->data.array[0]->name);
+            asn_print_put(ctx, ":", 1);
+            asn_print_impl(ctx, value->data.array[0], indent);
+            break;
 
         case TAGGED:
-            return asn_snprint_tagged(buffer, buf_len, value, indent);
+            if (value->data.array[0] == NULL)
+                break;
+            asn_print_fmt(ctx, "[%s%d]", t_class[(int)value->tag.cl],
+                          value->tag.val);
+            asn_print_impl(ctx, value->data.array[0], indent);
+            break;
 
         case SEQUENCE:
         case SEQUENCE_OF:
         case SET:
         case SET_OF:
-            return asn_snprint_array_fields(buffer, buf_len, value, indent);
+            asn_print_array_fields(ctx, value, indent);
+            break;
 
         default:
-            return 0; /* nothing to do. */
+            /* LONG_INT, BIT_STRING and REAL are not implemented yet */
+            break;
     }
 }
 
+/* See description in asn_usr.h */
+te_errno
+asn_print_value(const asn_value *value, unsigned int indent,
+                asn_print_cb *cb, void *opaque)
+{
+    char          buf[ASN_PRINT_BUF];
+    asn_print_ctx ctx = { .cb = cb, .opaque = opaque, .buf = buf };
+
+    if (value == NULL || cb == NULL)
+        return TE_EWRONGPTR;
+
+    asn_print_impl(&ctx, value, indent);
+    asn_print_flush(&ctx);
+
+    return ctx.rc;
+}
+
 /**
- * Count required length of string for textual presentation of
- * specified value.
+ * Callback for asn_print_value() which appends text to TE string.
  *
- * @param value         ASN.1 value.
- * @param indent        current indent
+ * @param text          piece of text
+ * @param len           length of the piece
+ * @param opaque        TE string
  *
- * @return length of required string.
+ * @return zero on success, otherwise error code.
  */
-size_t
-asn_count_txt_len(const asn_value *value, unsigned int indent)
+static te_errno
+asn_print_to_str(const char *text, size_t len, void *opaque)
 {
-    if (value == NULL)
-        return 0;
+    te_string_append_buf(opaque, text, len);
 
-    switch (value->syntax)
-    {
-        case BOOL:
-            if (value->data.integer)
-                return strlen("TRUE");
-            else
-                return strlen("FALSE");
+    return 0;
+}
 
-        case INTEGER:
-        case UINTEGER:
-            return value->txt_len;
+/* See description in asn_usr.h */
+te_errno
+asn_print_value_str(const asn_value *value, unsigned int indent,
+                    te_string *str)
+{
+    if (str == NULL)
+        return TE_EWRONGPTR;
 
-        case ENUMERATED:
-            return asn_count_len_enum(value);
+    return asn_print_value(value, indent, asn_print_to_str, str);
+}
 
-        case CHAR_STRING:
-            return value->txt_len;
+/** Buffer which asn_sprint_value() fills in like snprintf() */
+typedef struct asn_sprint_buf {
+    char   *ptr;    /**< Buffer for the text */
+    size_t  size;   /**< Size of the buffer */
+    size_t  len;    /**< Total length of the text printed so far */
+} asn_sprint_buf;
 
-        case OCT_STRING:
-            return value->txt_len;
+/**
+ * Callback for asn_print_value() which copies text to user buffer as far
+ * as it fits there, but counts all the text.
+ *
+ * @param text          piece of text
+ * @param len           length of the piece
+ * @param opaque        buffer to be filled in
+ *
+ * @return zero.
+ */
+static te_errno
+asn_print_to_buf(const char *text, size_t len, void *opaque)
+{
+    asn_sprint_buf *buf = opaque;
 
-        case PR_ASN_NULL:
-            return strlen("NULL");
+    /* One byte is always kept for terminating NUL */
+    if (buf->len + 1 < buf->size)
+        memcpy(buf->ptr + buf->len, text, MIN(len, buf->size - 1 - buf->len));
+    buf->len += len;
 
-        case LONG_INT:
-        case BIT_STRING:
-        case REAL:
-            return 0; /* not implemented yet.*/
+    return 0;
+}
 
-        case OID:
-            return asn_count_len_objid(value);
+/* See description in asn_usr.h */
+int
+asn_sprint_value(const asn_value *value, char *buffer, size_t buf_len,
+                 unsigned int indent)
+{
+    asn_sprint_buf buf = { .ptr = buffer, .size = buf_len, .len = 0 };
 
-        /* Due to some (not found) bugs in counting length, obtained value
-         * is a bit less then really need, so the following ugly hacks
-         * are made.
-         * TODO: found and fix bugs. */
-        case CHOICE:
-            return asn_count_len_choice(value, indent);
+    if ((value == NULL) || (buffer == NULL) || (buf_len == 0))
+        return 0;
 
-        case TAGGED:
-            return asn_count_len_tagged(value, indent);
+    if (asn_print_value(value, indent, asn_print_to_buf, &buf) != 0)
+    {
+        buffer[0] = '\0';
+        return -1;
+    }
 
-        case SEQUENCE:
-        case SEQUENCE_OF:
-        case SET:
-        case SET_OF:
-            return asn_count_len_array_fields(value, indent);
+    buffer[MIN(buf.len, buf_len - 1)] = '\0';
 
-        default:
-            return 0; /* nothing to do. */
-    }
+    return buf.len;
 }
 
 /**
- * Count required length of string for textual presentation
- * of specified value.
+ * Callback for asn_print_value() which writes text to a file.
  *
- * @param value         ASN.1 value.
- * @param indent        current indent
+ * @param text          piece of text
+ * @param len           length of the piece
+ * @param opaque        file stream
  *
- * @return length of required string.
+ * @return zero on success, otherwise error code.
  */
-size_t
-asn_count_len_array_fields(const asn_value *value, unsigned int indent)
+static te_errno
+asn_print_to_file(const char *text, size_t len, void *opaque)
 {
-    int *txt_len_p;
-
-    if (value == NULL)
-        return 0;
-    /* Explicit discards of 'const' qualifier, whereas field 'txt_len'
-     * should have 'mutable' semantic */
-    txt_len_p = (int *)&(value->txt_len);
-
-    if ((value->syntax & ASN_SYN_ARRAY) == 0 ||
-        (value->syntax & COMPOUND) == 0)
-        return -1;
-
-
-    if (value->txt_len < 0)
-    {
-        unsigned int i;
-
-        int all_used = 1; /* for "{" */
-        int elems = 0;
+    FILE *fp = opaque;
 
-        for (i = 0; i < value->len; i++)
-        {
-            asn_value *v_el = value->data.array[i];
+    if (fwrite(text, 1, len, fp) != len)
+        return te_rc_os2te(errno);
 
-            if (v_el)
-            {
-                if (value->syntax & ASN_SYN_NAMED)
-                {
-                    all_used += strlen(v_el->name) + 1;
-                }
-                all_used += asn_count_txt_len(v_el, indent + 2);
-                elems ++;
-            }
-        }
-        all_used +=   elems * (indent + 2) /* indents before subvalues */
-                    + elems + 1            /* new line symbols */
-                    + (elems ? (elems - 1) : 0)/* commas */
-                    + indent + 1;          /* closing brace wint indent */
-
-        *txt_len_p = all_used;
-    }
-
-    return value->txt_len;
+    return 0;
 }
 
 /**
@@ -1723,50 +1753,22 @@ asn_count_len_array_fields(const asn_value *value, unsigned int indent)
 te_errno
 asn_save_to_file(const asn_value *value, const char *filename)
 {
-    FILE *fp;
-    char *buffer;
-    int   len;
+    FILE     *fp;
+    te_errno  rc;
 
     if (value == NULL || filename == NULL)
         return TE_EWRONGPTR;
 
-    len = asn_count_txt_len(value, 0);
     fp = fopen(filename, "w+");
     if (fp == NULL)
-        return errno;
+        return te_rc_os2te(errno);
 
-    buffer = malloc(len + 11);
-    if (buffer == NULL)
-    {
-        /* We need to close files - this comment is for "konst" */
-        fclose(fp);
-        return TE_ENOMEM;
-    }
-    memset(buffer, 0, len + 11);
-
-    asn_sprint_value(value, buffer, len + 10, 0);
-    fwrite(buffer, strlen(buffer), 1, fp);
-
-    fclose(fp);
-
-    free(buffer);
-
-    return 0;
-}
-
-static te_errno
-file_len(const char *filename, size_t *len)
-{
-    struct stat fst;
-
-    if (len == NULL)
-        return TE_EWRONGPTR;
+    rc = asn_print_value(value, 0, asn_print_to_file, fp);
 
-    if (stat(filename, &fst) != 0)
-        return errno;
+    if (fclose(fp) != 0 && rc == 0)
+        rc = te_rc_os2te(errno);
 
-    *len = fst.st_size;
-    return 0;
+    return rc;
 }
 
 /**
@@ -1783,41 +1785,186 @@ te_errno
 asn_parse_dvalue_in_file(const char *filename, const asn_type *type,
                          asn_value **parsed_value, int *syms_parsed)
 {
-    size_t      flen = 0; /* Initialize to make GCC happy */
-    char       *buf;
-    int         fd;
-    ssize_t     read_sz;
+    asn_text_parser parser;
+    char            buf[PARSE_BUF];
+    size_t          total = 0;
+    size_t          used;
+    ssize_t         read_sz;
+    int             fd;
 
-    te_errno rc;
+    te_errno rc = 0;
 
     if (filename == NULL || type == NULL ||
         parsed_value == NULL || syms_parsed == NULL)
         return TE_EWRONGPTR;
 
-    if ((rc = file_len(filename, &flen)) != 0)
-        return rc;
-
-    buf = TE_ALLOC(flen + 1);
     fd = open(filename, O_RDONLY);
     if (fd < 0)
-        return errno;
+        return te_rc_os2te(errno);
 
-    read_sz = read(fd, buf, flen + 1);
-    close(fd);
+    asn_text_parser_init(&parser, type);
+    *parsed_value = NULL;
 
-    if (read_sz != (ssize_t)flen)
+    while ((read_sz = read(fd, buf, sizeof(buf))) > 0)
+    {
+        rc = asn_text_parser_feed(&parser, buf, read_sz, parsed_value,
+                                  &used);
+        total += used;
+        if (rc != 0 || *parsed_value != NULL)
+            break;
+    }
+
+    if (read_sz < 0)
     {
         ERROR("Cannot read everything from file: %s", strerror(errno));
-        return TE_EIO;
+        rc = TE_EIO;
+    }
+    else if (rc == 0 && *parsed_value != NULL)
+    {
+        *syms_parsed = total;
+    }
+    else if (rc == 0)
+    {
+        /* The value is not enclosed in braces, parse it at EOF */
+        rc = asn_text_parser_finish(&parser, parsed_value, syms_parsed);
     }
 
-    rc = asn_parse_value_text(buf, type, parsed_value, syms_parsed);
+    asn_text_parser_free(&parser);
+    close(fd);
+
+    return rc;
+}
 
-    free(buf);
+/* See description in asn_usr.h */
+void
+asn_text_parser_init(asn_text_parser *parser, const asn_type *type)
+{
+    parser->type = type;
+    parser->text = (te_string)TE_STRING_INIT;
+    parser->depth = 0;
+    parser->quote = '\0';
+    parser->escape = false;
+}
+
+/**
+ * Forget the text of the current value and scanning state.
+ *
+ * @param parser        incremental parser
+ */
+static void
+asn_text_parser_reset(asn_text_parser *parser)
+{
+    te_string_reset(&parser->text);
+    parser->depth = 0;
+    parser->quote = '\0';
+    parser->escape = false;
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_text_parser_feed(asn_text_parser *parser, const char *chunk, size_t len,
+                     asn_value **parsed_val, size_t *used)
+{
+    int      syms;
+    size_t   i;
+    te_errno rc;
+
+    if (parser == NULL || parser->type == NULL || parsed_val == NULL ||
+        used == NULL || (chunk == NULL && len > 0))
+        return TE_EWRONGPTR;
+
+    *parsed_val = NULL;
+
+    for (i = 0; i < len; i++)
+    {
+        char c = chunk[i];
+
+        if (parser->quote != '\0')
+        {
+            /*
+             * Only character strings may contain escaped symbols,
+             * see asn_impl_pt_charstring().
+             */
+            if (parser->escape)
+                parser->escape = false;
+            else if (c == '\\' && parser->quote == '"')
+                parser->escape = true;
+            else if (c == parser->quote)
+                parser->quote = '\0';
+        }
+        else if (c == '"' || c == '\'')
+        {
+            parser->quote = c;
+        }
+        else if (c == '{')
+        {
+            parser->depth++;
+        }
+        else if (c == '}')
+        {
+            if (parser->depth == 0)
+            {
+                *used = i;
+                return TE_EASNTXTPARSE;
+            }
+            if (--parser->depth == 0)
+                break;
+        }
+    }
+
+    if (i == len)
+    {
+        te_string_append_buf(&parser->text, chunk, len);
+        *used = len;
+        return 0;
+    }
+
+    *used = i + 1;
+    te_string_append_buf(&parser->text, chunk, *used);
+
+    rc = asn_parse_value_text(parser->text.ptr, parser->type,
+                              parsed_val, &syms);
+    asn_text_parser_reset(parser);
+
+    return rc;
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_text_parser_finish(asn_text_parser *parser, asn_value **parsed_val,
+                       int *parsed_syms)
+{
+    const char *text;
+    te_errno    rc;
+
+    if (parser == NULL || parser->type == NULL ||
+        parsed_val == NULL || parsed_syms == NULL)
+        return TE_EWRONGPTR;
+
+    text = te_string_value(&parser->text);
+    if (text[strspn(text, " \t\r\n\v\f")] == '\0')
+        rc = TE_ENODATA;
+    else if (parser->depth != 0 || parser->quote != '\0')
+        rc = TE_EASNTXTPARSE;
+    else
+        rc = asn_parse_value_text(text, parser->type, parsed_val,
+                                  parsed_syms);
+
+    asn_text_parser_reset(parser);
 
     return rc;
 }
 
+/* See description in asn_usr.h */
+void
+asn_text_parser_free(asn_text_parser *parser)
+{
+    if (parser == NULL)
+        return;
+
+    te_string_free(&parser->text);
+}
+
 bool
 asn_clean_count(asn_value *value)
 {
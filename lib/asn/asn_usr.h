@@ -17,6 +17,7 @@
 #include "te_stdint.h"
 #include "te_errno.h"
 #include "te_defs.h"
+#include "te_string.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -261,6 +262,17 @@ typedef struct asn_value asn_value;
 struct asn_child_desc;
 typedef struct asn_child_desc asn_child_desc_t;
 
+/**
+ * Arena of ASN.1 values, see asn_init_value_arena().
+ */
+typedef struct asn_arena asn_arena;
+
+/**
+ * Path to ASN.1 subvalue compiled for a certain type,
+ * see asn_path_compile().
+ */
+typedef struct asn_path asn_path;
+
 /**
  * Init empty ASN.1 value of specified type.
  *
@@ -291,6 +303,41 @@ extern asn_value *asn_init_value_tagged(const asn_type *type,
                                         asn_tag_class tc,
                                         asn_tag_value tag);
 
+/**
+ * Init empty ASN.1 value of specified type which owns an arena.
+ * Subvalues created in its tree by the library (e.g. when leafs are
+ * written by labels or compiled paths) and data of these subvalues are
+ * allocated from the arena. The arena is released at once when the value
+ * is freed with asn_free_value(), values created by asn_init_value()
+ * and put into the tree are freed as usual.
+ *
+ * Subvalues allocated from the arena must not be moved to other trees
+ * and used after the root value is freed.
+ *
+ * @param type       ASN.1 type to which value should belong
+ * @param size       Size of arena chunks, @c 0 to use the default one;
+ *                   the first chunk is allocated together with the value
+ *
+ * @return pointer to new asn_value instance or @c NULL if error occurred.
+ */
+extern asn_value *asn_init_value_arena(const asn_type *type, size_t size);
+
+/**
+ * Init empty ASN.1 value of specified type allocated from the arena
+ * of another value (see asn_init_value_arena()). The new value and
+ * subvalues created in its tree by the library are released together
+ * with the arena, so the value must be put into the tree of @p owner.
+ *
+ * @param type       ASN.1 type to which value should belong
+ * @param owner      Any value of a tree which arena should be used;
+ *                   if it is @c NULL or has no arena, the value is
+ *                   allocated on heap as by asn_init_value()
+ *
+ * @return pointer to new asn_value instance or @c NULL if error occurred.
+ */
+extern asn_value *asn_init_value_in(const asn_type *type,
+                                    const asn_value *owner);
+
 /**
  * Make a copy of ASN.1 value instance.
  *
@@ -366,7 +413,9 @@ extern te_errno asn_parse_value_text(const char *string,
                                      int *parsed_syms);
 
 /**
- * Read ASN.1 text file, parse DefinedValue of specified ASN.1 type
+ * Read ASN.1 text file, parse DefinedValue of specified ASN.1 type.
+ * The file is read in chunks, but the text of the value is accumulated
+ * in memory before it is parsed (see asn_text_parser_feed()).
  *
  * @param filename      name of file to be parsed
  * @param type          expected type of value
@@ -383,7 +432,7 @@ extern te_errno asn_parse_dvalue_in_file(const char *filename,
 
 /**
  * Prepare textual ASN.1 presentation of passed value and put it into
- * specified buffer.
+ * specified buffer. The text is printed by asn_print_value().
  * This method writes trailing zero to the text buffer, and checks that
  * there is space for it, but does not include it in amount of
  * printed symbols - exactly like standard snprintf().
@@ -417,6 +466,117 @@ extern int asn_sprint_value(const asn_value *value, char *buffer,
 extern te_errno asn_save_to_file(const asn_value *value,
                                  const char *filename);
 
+/**
+ * Callback which receives consecutive pieces of textual ASN.1 presentation
+ * of a value printed by asn_print_value().
+ *
+ * @param text          piece of text (not NUL-terminated)
+ * @param len           length of the piece
+ * @param opaque        opaque data passed to asn_print_value()
+ *
+ * @return zero on success, otherwise error code which stops printing.
+ */
+typedef te_errno (asn_print_cb)(const char *text, size_t len, void *opaque);
+
+/**
+ * Print textual ASN.1 presentation of passed value in one traversal of
+ * the value tree, passing the text to callback piece by piece.
+ * Neither length of the text is counted in advance nor a buffer for
+ * the whole text is required.
+ *
+ * @param value         ASN.1 value to be printed
+ * @param indent        current indent, usually zero
+ * @param cb            callback to be called for pieces of text
+ * @param opaque        opaque data for @p cb
+ *
+ * @return zero on success, otherwise error code (in particular, the
+ *         first error returned by @p cb).
+ */
+extern te_errno asn_print_value(const asn_value *value, unsigned int indent,
+                                asn_print_cb *cb, void *opaque);
+
+/**
+ * Append textual ASN.1 presentation of passed value to TE string in one
+ * traversal of the value tree.
+ *
+ * @param value         ASN.1 value to be printed
+ * @param indent        current indent, usually zero
+ * @param str           TE string to append to; on failure it may contain
+ *                      part of the text
+ *
+ * @return zero on success, otherwise error code.
+ */
+extern te_errno asn_print_value_str(const asn_value *value,
+                                    unsigned int indent, te_string *str);
+
+/**
+ * Incremental parser of ASN.1 text which consumes it in chunks of
+ * arbitrary size. Text of a value is accumulated until the value is
+ * complete, then it is parsed by asn_parse_value_text(), so memory for
+ * the text of one value is still required. Fields are internal and
+ * should not be accessed directly.
+ */
+typedef struct asn_text_parser {
+    const asn_type *type;       /**< Expected type of values */
+    te_string       text;       /**< Text of the current value */
+    unsigned int    depth;      /**< Nesting level of braces */
+    char            quote;      /**< Closing quote of the string which
+                                     is being scanned or @c '\0' */
+    bool            escape;     /**< Previous symbol in a character
+                                     string is a backslash */
+} asn_text_parser;
+
+/**
+ * Initialize incremental ASN.1 text parser.
+ *
+ * @param parser        parser to be initialized
+ * @param type          expected type of parsed values
+ */
+extern void asn_text_parser_init(asn_text_parser *parser,
+                                 const asn_type *type);
+
+/**
+ * Pass next chunk of ASN.1 text to the parser. The value is parsed as
+ * soon as its outermost braces are closed; the rest of the chunk is not
+ * consumed and may be passed to the parser again to get the next value.
+ * Values which are not enclosed in braces (e.g. plain integers or
+ * strings) are parsed by asn_text_parser_finish() only.
+ *
+ * @param parser        incremental parser
+ * @param chunk         chunk of text (need not be NUL-terminated)
+ * @param len           length of the chunk
+ * @param parsed_val    location for parsed value, @c NULL is put there
+ *                      if more text is required (OUT)
+ * @param used          number of consumed bytes of the chunk (OUT)
+ *
+ * @return zero on success, otherwise error code.
+ */
+extern te_errno asn_text_parser_feed(asn_text_parser *parser,
+                                     const char *chunk, size_t len,
+                                     asn_value **parsed_val, size_t *used);
+
+/**
+ * Parse the text accumulated by the parser when there is no more
+ * input, and reset the parser.
+ *
+ * @param parser        incremental parser
+ * @param parsed_val    parsed value (OUT)
+ * @param parsed_syms   number of parsed symbols of accumulated text (OUT)
+ *
+ * @return zero on success, otherwise error code (@c TE_ENODATA if no
+ *         value text is accumulated).
+ */
+extern te_errno asn_text_parser_finish(asn_text_parser *parser,
+                                       asn_value **parsed_val,
+                                       int *parsed_syms);
+
+/**
+ * Release resources allocated by incremental ASN.1 text parser.
+ *
+ * @param parser        incremental parser
+ */
+extern void asn_text_parser_free(asn_text_parser *parser);
+
 
 
 
@@ -986,6 +1146,141 @@ extern te_errno asn_write_uint32(asn_value *container,
 extern te_errno asn_read_uint32(const asn_value *container,
                                 uint32_t *value, const char *labels);
 
+/**
+ * Compile textual ASN.1 labels into a path which may be used to access
+ * subvalues of values of the specified type without parsing labels and
+ * looking up named entries on every access.
+ *
+ * Every level of the path should be labeled explicitly, including
+ * `CHOICE` (with or without leading '#'). Negative indexes of
+ * 'SEQUENCE OF' and 'SET OF' are counted from the end of array.
+ *
+ * @param type          ASN.1 type of root values
+ * @param labels        textual ASN.1 labels of subvalue; see
+ *                      asn_free_subvalue method for more description
+ * @param path          location for compiled path (OUT); it should be
+ *                      freed with asn_path_free()
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_compile(const asn_type *type, const char *labels,
+                                 asn_path **path);
+
+/**
+ * Free compiled path.
+ *
+ * @param path          compiled path (may be @c NULL)
+ */
+extern void asn_path_free(asn_path *path);
+
+/**
+ * Find subvalue in ASN.1 value tree by compiled path.
+ * Got subvalue should NOT be freed!
+ *
+ * @param value         root of ASN.1 value tree, it should be of
+ *                      the type the path is compiled for
+ * @param path          compiled path
+ * @param status        location of status of operation,
+ *                      always changed unless NULL (OUT)
+ *
+ * @return pointer to found subvalue or @c NULL.
+ */
+extern asn_value *asn_path_find(const asn_value *value,
+                                const asn_path *path, te_errno *status);
+
+/**
+ * Find subvalue in ASN.1 value tree by compiled path creating absent
+ * subvalues on the way, as asn_retrieve_descendant() does.
+ * Got subvalue should NOT be freed!
+ *
+ * @param value         root of ASN.1 value tree, it should be of
+ *                      the type the path is compiled for
+ * @param path          compiled path
+ * @param status        location of status of operation,
+ *                      always changed unless NULL (OUT)
+ *
+ * @return pointer to found subvalue or @c NULL.
+ */
+extern asn_value *asn_path_retrieve(asn_value *value,
+                                    const asn_path *path, te_errno *status);
+
+/**
+ * Write data into primitive syntax leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param data          data to be written, see asn_write_value_field()
+ * @param len           length of data
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_write_value(asn_value *container,
+                                     const asn_path *path,
+                                     const void *data, size_t len);
+
+/**
+ * Read data from primitive syntax leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param data          buffer for read data (OUT)
+ * @param len           length of available buffer / read data (IN/OUT)
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_read_value(const asn_value *container,
+                                    const asn_path *path,
+                                    void *data, size_t *len);
+
+/**
+ * Write 32-bit integer into leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param value         integer value to be written
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_write_int32(asn_value *container,
+                                     const asn_path *path, int32_t value);
+
+/**
+ * Read 32-bit integer from leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param value         place for integer value to be read (OUT)
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_read_int32(const asn_value *container,
+                                    const asn_path *path, int32_t *value);
+
+/**
+ * Write 32-bit unsigned integer into leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param value         value to be written
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_write_uint32(asn_value *container,
+                                      const asn_path *path, uint32_t value);
+
+/**
+ * Read 32-bit unsigned integer from leaf specified by compiled path.
+ *
+ * @param container     root of ASN.1 value tree
+ * @param path          compiled path of the leaf
+ * @param value         where to save read value (OUT)
+ *
+ * @return Status code.
+ */
+extern te_errno asn_path_read_uint32(const asn_value *container,
+                                     const asn_path *path,
+                                     uint32_t *value);
+
 /**
  * Write boolean into leaf in specified ASN.1 value.
  *
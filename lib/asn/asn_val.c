@@ -27,6 +27,9 @@
 
 #define AVOID_STRSEP 1
 
+/** Default size of ASN.1 values arena chunks */
+#define ASN_ARENA_DEF_SIZE 4096
+
 /* this function defined in asn_text.c */
 extern int number_of_digits(int value);
 extern int number_of_digits_unsigned(unsigned int value);
@@ -71,6 +74,123 @@ asn_strdup(const char* src)
     }
 }
 
+/**
+ * Allocate memory from ASN.1 values arena.
+ *
+ * @param arena     Arena.
+ * @param size      Size of memory.
+ *
+ * @return Pointer to allocated memory or @c NULL.
+ */
+static void *
+asn_arena_alloc(asn_arena *arena, size_t size)
+{
+    asn_arena_chunk *chunk = arena->chunks;
+    void            *ptr;
+
+    size = TE_ALIGN(size, sizeof(max_align_t));
+    if (chunk->size - chunk->used < size)
+    {
+        size_t chunk_size = MAX(arena->chunk_size, size);
+
+        chunk = malloc(sizeof(*chunk) + chunk_size);
+        if (chunk == NULL)
+            return NULL;
+
+        chunk->size = chunk_size;
+        chunk->used = 0;
+        chunk->next = arena->chunks;
+        arena->chunks = chunk;
+    }
+
+    ptr = (uint8_t *)chunk->data + chunk->used;
+    chunk->used += size;
+
+    return ptr;
+}
+
+/**
+ * Allocate memory for ASN.1 value or its data.
+ *
+ * @param arena     Arena of the value or @c NULL to allocate on heap.
+ * @param size      Size of memory.
+ *
+ * @return Pointer to allocated memory or @c NULL.
+ */
+static inline void *
+asn_impl_alloc(asn_arena *arena, size_t size)
+{
+    return arena == NULL ? malloc(size) : asn_arena_alloc(arena, size);
+}
+
+/**
+ * Change size of memory allocated by asn_impl_alloc(). Arena memory
+ * is never shrunk, it is moved to a new place when it grows.
+ *
+ * @param arena     Arena of the value or @c NULL if memory is on heap.
+ * @param ptr       Memory to be resized (may be @c NULL).
+ * @param old_size  Current size of memory.
+ * @param size      New size of memory.
+ *
+ * @return Pointer to resized memory or @c NULL.
+ */
+static void *
+asn_impl_realloc(asn_arena *arena, void *ptr, size_t old_size, size_t size)
+{
+    void *new_ptr;
+
+    if (arena == NULL)
+        return realloc(ptr, size);
+
+    if (size <= old_size)
+        return ptr;
+
+    new_ptr = asn_arena_alloc(arena, size);
+    if (new_ptr != NULL && old_size > 0)
+        memcpy(new_ptr, ptr, old_size);
+
+    return new_ptr;
+}
+
+/**
+ * Release memory allocated by asn_impl_alloc(). Arena memory is
+ * released together with the arena.
+ *
+ * @param arena     Arena of the value or @c NULL if memory is on heap.
+ * @param ptr       Memory to be released (may be @c NULL).
+ */
+static inline void
+asn_impl_free(asn_arena *arena, void *ptr)
+{
+    if (arena == NULL)
+        free(ptr);
+}
+
+/**
+ * Duplicate string into memory of ASN.1 value.
+ *
+ * @param arena     Arena of the value or @c NULL to allocate on heap.
+ * @param src       String to be duplicated (may be @c NULL).
+ *
+ * @return Duplicated string or @c NULL.
+ */
+static char *
+asn_impl_strdup(asn_arena *arena, const char *src)
+{
+    size_t  len;
+    char   *res;
+
+    if (arena == NULL || src == NULL)
+        return asn_strdup(src);
+
+    len = strlen(src) + 1;
+    res = asn_arena_alloc(arena, len);
+    if (res != NULL)
+        memcpy(res, src, len);
+
+    return res;
+}
+
 /**
  * Wrapper over asn_impl_find_subvalue, for find in writable container
  * and get writable subvalue. All parameters are same.
@@ -127,27 +247,22 @@ asn_tag_equal(asn_tag_t l, asn_tag_t r)
 }
 
 
-/**
- * Init empty ASN.1 value of specified type.
- *
- * @param type       ASN.1 type to which value should belong.
- *
- * @return pointer to new ASN_value instance or NULL if error occurred.
- */
+/* See description in asn_impl.h */
 asn_value *
-asn_init_value(const asn_type * type)
+asn_impl_init_value(const asn_type *type, asn_arena *arena)
 {
     asn_value *new_value;
     int arr_len;
 
     if (type == NULL) return NULL;
 
-    new_value = malloc(sizeof(asn_value));
+    new_value = asn_impl_alloc(arena, sizeof(asn_value));
     if (new_value == NULL)
         return NULL;
 
     memset(new_value, 0, sizeof(asn_value));
 
+    new_value->arena    = arena;
     new_value->asn_type = type;
     new_value->syntax   = type->syntax;
     new_value->tag      = type->tag;
@@ -166,7 +281,7 @@ asn_init_value(const asn_type * type)
         case SET:
             {
                 size_t  sz = arr_len * sizeof(asn_value *);
-                void   *ptr = malloc(sz);
+                void   *ptr = asn_impl_alloc(arena, sz);
 
                 new_value->len = arr_len;
                 new_value->data.array = ptr;
@@ -185,6 +300,73 @@ asn_init_value(const asn_type * type)
     return new_value;
 }
 
+/**
+ * Init empty ASN.1 value of specified type.
+ *
+ * @param type       ASN.1 type to which value should belong.
+ *
+ * @return pointer to new ASN_value instance or NULL if error occurred.
+ */
+asn_value *
+asn_init_value(const asn_type * type)
+{
+    return asn_impl_init_value(type, NULL);
+}
+
+/* See description in asn_usr.h */
+asn_value *
+asn_init_value_arena(const asn_type *type, size_t size)
+{
+    size_t           hdr_size = TE_ALIGN(sizeof(asn_arena),
+                                         sizeof(max_align_t));
+    asn_arena_chunk *chunk;
+    asn_arena       *arena;
+    asn_value       *value;
+
+    if (type == NULL)
+        return NULL;
+
+    if (size == 0)
+        size = ASN_ARENA_DEF_SIZE;
+    size = MAX(size, hdr_size);
+
+    /* The arena itself is placed at the beginning of its first chunk */
+    chunk = malloc(sizeof(*chunk) + size);
+    if (chunk == NULL)
+        return NULL;
+
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = hdr_size;
+
+    arena = (asn_arena *)chunk->data;
+    arena->chunk_size = size;
+    arena->chunks = chunk;
+
+    value = asn_impl_init_value(type, arena);
+    if (value == NULL)
+    {
+        asn_arena_chunk *next;
+
+        for (chunk = arena->chunks; chunk != NULL; chunk = next)
+        {
+            next = chunk->next;
+            free(chunk);
+        }
+        return NULL;
+    }
+    arena->root = value;
+
+    return value;
+}
+
+/* See description in asn_usr.h */
+asn_value *
+asn_init_value_in(const asn_type *type, const asn_value *owner)
+{
+    return asn_impl_init_value(type, owner == NULL ? NULL : owner->arena);
+}
+
 /**
  * Init empty ASN.1 value of specified type with certain ASN.1 tag.
  *
@@ -239,10 +421,11 @@ asn_assign_value(asn_value *dst, const asn_value *src)
         {
             for (i = 0; i < (int)dst->len; i++)
                  asn_free_value(dst->data.array[i]);
-            free(dst->data.array);
+            asn_impl_free(dst->arena, dst->data.array);
         }
 
-        arr = dst->data.array = malloc(len * sizeof(asn_value *));
+        arr = dst->data.array = asn_impl_alloc(dst->arena,
+                                               len * sizeof(asn_value *));
 
         if (arr==NULL)
         {
@@ -257,7 +440,7 @@ asn_assign_value(asn_value *dst, const asn_value *src)
             {
                 if ((*arr = asn_copy_value(src_elem))==NULL)
                 { /* ERROR! */
-                    free(dst->data.array);
+                    asn_impl_free(dst->arena, dst->data.array);
                     dst->data.array = NULL;
                     return ENOMEM;
                 }
@@ -274,7 +457,7 @@ asn_assign_value(asn_value *dst, const asn_value *src)
         if(src->syntax == BIT_STRING)
             len = (len + 7) >> 3;
 
-        free(dst->data.other);
+        asn_impl_free(dst->arena, dst->data.other);
 
         if ((src->data.other == NULL) || (len == 0))
         { /* data is not specified yet, value is incomplete.*/
@@ -291,7 +474,7 @@ asn_assign_value(asn_value *dst, const asn_value *src)
             return 0;
         }
 
-        if ((dst->data.other = malloc (len))==NULL)
+        if ((dst->data.other = asn_impl_alloc(dst->arena, len)) == NULL)
             return ENOMEM;
 
         memcpy (dst->data.other, src->data.other, len);
@@ -420,6 +603,37 @@ asn_copy_value(const asn_value *value)
 #endif
 }
 
+/**
+ * Free ASN.1 value allocated from arena: subvalues allocated on heap
+ * are freed, the arena is released if the value owns it.
+ *
+ * @param value       ASN.1 value to be destroyed.
+ */
+static void
+asn_arena_free_value(asn_value *value)
+{
+    asn_arena       *arena = value->arena;
+    asn_arena_chunk *chunk;
+    asn_arena_chunk *next;
+    unsigned int     i;
+
+    if (value->syntax & COMPOUND)
+    {
+        for (i = 0; i < value->len; i++)
+            asn_free_value(value->data.array[i]);
+    }
+
+    if (arena->root != value)
+        return;
+
+    /* The first chunk holding the arena itself is the last in the list */
+    for (chunk = arena->chunks; chunk != NULL; chunk = next)
+    {
+        next = chunk->next;
+        free(chunk);
+    }
+}
+
 /**
  * Free memory allocalted by ASN.1 value instance.
  *
@@ -432,6 +646,12 @@ asn_free_value(asn_value *value)
 {
     if (!value) return;
 
+    if (value->arena != NULL)
+    {
+        asn_arena_free_value(value);
+        return;
+    }
+
     if (value->syntax & COMPOUND)
     {
         unsigned int i;
@@ -803,6 +1023,8 @@ asn_child_named_index(const asn_type *type, const char *labels,
                     break;
                 }
             }
+            if (i == type->len)
+                return TE_EASNWRONGLABEL;
             break;
 
         case SEQUENCE_OF:
@@ -1022,7 +1244,7 @@ asn_retrieve_descendant(asn_value *value, te_errno *status,
             if (rc != 0)
                 break;
 
-            new_value = asn_init_value(new_type);
+            new_value = asn_impl_init_value(new_type, tmp_value->arena);
             rc = asn_put_child_by_index(tmp_value, new_value, subval_index);
         }
         tmp_value = new_value;
@@ -1199,8 +1421,10 @@ asn_put_child_by_index(asn_value *container, asn_value *new_value,
 
                 new_len = leaf_type_index + 1;
                 if ((container->data.array =
-                      realloc(container->data.array,
-                              new_len * sizeof(asn_value *)))
+                      asn_impl_realloc(container->arena,
+                                       container->data.array,
+                                       container->len * sizeof(asn_value *),
+                                       new_len * sizeof(asn_value *)))
                      == NULL)
                     return TE_ENOMEM;
 
@@ -1220,8 +1444,11 @@ asn_put_child_by_index(asn_value *container, asn_value *new_value,
                     container->data.array[i] = container->data.array[i+1];
 
                 container->data.array =
-                    realloc(container->data.array,
-                            container->len * sizeof(asn_value *));
+                    asn_impl_realloc(container->arena,
+                                     container->data.array,
+                                     (container->len + 1) *
+                                         sizeof(asn_value *),
+                                     container->len * sizeof(asn_value *));
 
                 return 0;
             }
@@ -1254,8 +1481,8 @@ asn_put_child_by_index(asn_value *container, asn_value *new_value,
         if (new_value->syntax & COMPOUND)
             new_value->txt_len = -1;
 
-        free(new_value->name);
-        new_value->name = asn_strdup(ne->name);
+        asn_impl_free(new_value->arena, new_value->name);
+        new_value->name = asn_impl_strdup(new_value->arena, ne->name);
         new_value->tag  = ne->tag;
     }
 
@@ -1386,7 +1613,7 @@ asn_put_descendent(asn_value *container, asn_value *subval,
                     else
                         new_type = par_value->asn_type->sp.subtype;
 
-                    tmp = asn_init_value(new_type);
+                    tmp = asn_impl_init_value(new_type, par_value->arena);
 
                     rc = asn_put_child_by_index(par_value, tmp, index);
                     par_value = tmp;
@@ -1609,7 +1836,7 @@ asn_write_primitive(asn_value *value, const void *data, size_t d_len)
         break;
 
     case CHAR_STRING:
-        free(value->data.other);
+        asn_impl_free(value->arena, value->data.other);
         if (d_len == 0 || data == NULL)
         {
             value->data.other = NULL;
@@ -1618,7 +1845,8 @@ asn_write_primitive(asn_value *value, const void *data, size_t d_len)
         }
         else
         {
-            char *str = value->data.other = malloc(d_len + 1);
+            char *str = value->data.other = asn_impl_alloc(value->arena,
+                                                           d_len + 1);
             strncpy(str, data, d_len);
             str[d_len] = '\0';
             value->len = d_len + 1; /* quantity of ALL used octets */
@@ -1648,7 +1876,7 @@ asn_write_primitive(asn_value *value, const void *data, size_t d_len)
         }
         else
         {
-            void * val = malloc(m_len);
+            void * val;
 
             if (value->asn_type->len > 0 &&
                 value->asn_type->len != d_len)
@@ -1656,8 +1884,11 @@ asn_write_primitive(asn_value *value, const void *data, size_t d_len)
                 return TE_EASNWRONGSIZE;
             }
 
-            if (value->data.other)
-                free (value->data.other);
+            val = asn_impl_alloc(value->arena, m_len);
+            if (val == NULL)
+                return TE_ENOMEM;
+
+            asn_impl_free(value->arena, value->data.other);
             value->data.other = val;
             memcpy(val,  data, m_len);
             value->len = d_len;
@@ -2107,6 +2338,233 @@ asn_read_bool(const asn_value *container, bool *value,
     return rc;
 }
 
+/*
+ * ===================== Compiled paths =====================
+ */
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_compile(const asn_type *type, const char *labels, asn_path **path)
+{
+    const asn_type *cur_type = type;
+    const char     *rest_labels = labels;
+    const char     *p;
+    unsigned int    max_len = 1;
+    asn_path       *res;
+    te_errno        rc;
+
+    if (type == NULL || labels == NULL || path == NULL)
+        return TE_EWRONGPTR;
+
+    for (p = labels; *p != '\0'; p++)
+    {
+        if (*p == '.')
+            max_len++;
+    }
+
+    res = malloc(sizeof(*res) + max_len * sizeof(res->steps[0]));
+    if (res == NULL)
+        return TE_ENOMEM;
+
+    res->type = type;
+    res->len = 0;
+
+    while (rest_labels != NULL && *rest_labels != '\0')
+    {
+        asn_path_step *step = &res->steps[res->len];
+
+        rc = asn_child_named_index(cur_type, rest_labels, &step->index,
+                                   &rest_labels);
+        if (rc != 0)
+        {
+            free(res);
+            return rc;
+        }
+
+        if (cur_type->syntax & ASN_SYN_NAMED)
+            step->type = cur_type->sp.named_entries[step->index].type;
+        else
+            step->type = cur_type->sp.subtype;
+
+        cur_type = step->type;
+        res->len++;
+    }
+
+    *path = res;
+    return 0;
+}
+
+/* See description in asn_usr.h */
+void
+asn_path_free(asn_path *path)
+{
+    free(path);
+}
+
+/**
+ * Get child of ASN.1 value by step of compiled path.
+ *
+ * @param container     ASN.1 value of the type the step is compiled for.
+ * @param step          Step of compiled path.
+ * @param child         Location for pointer to the child (OUT).
+ *
+ * @return Status code.
+ */
+static inline te_errno
+asn_path_get_child(const asn_value *container, const asn_path_step *step,
+                   asn_value **child)
+{
+    if (container->syntax != SEQUENCE)
+        return asn_get_child_by_index(container, child, step->index);
+
+    /* Children of SEQUENCE are always stored by their indexes. */
+    *child = container->data.array[step->index];
+
+    return *child == NULL ? TE_EASNINCOMPLVAL : 0;
+}
+
+/* See description in asn_usr.h */
+asn_value *
+asn_path_find(const asn_value *value, const asn_path *path,
+              te_errno *status)
+{
+    asn_value    *tmp_value = (asn_value *)value;
+    te_errno      rc = 0;
+    unsigned int  i;
+
+    if (value == NULL || path == NULL)
+        rc = TE_EWRONGPTR;
+    else if (value->asn_type != path->type)
+        rc = TE_EASNWRONGTYPE;
+
+    for (i = 0; rc == 0 && i < path->len; i++)
+    {
+        if (i > 0 && tmp_value->asn_type != path->steps[i - 1].type)
+            rc = TE_EASNWRONGTYPE;
+        else
+            rc = asn_path_get_child(tmp_value, &path->steps[i], &tmp_value);
+    }
+
+    if (status != NULL)
+        *status = rc;
+
+    return rc == 0 ? tmp_value : NULL;
+}
+
+/* See description in asn_usr.h */
+asn_value *
+asn_path_retrieve(asn_value *value, const asn_path *path, te_errno *status)
+{
+    asn_value    *tmp_value = value;
+    asn_value    *new_value;
+    te_errno      rc = 0;
+    unsigned int  i;
+
+    if (value == NULL || path == NULL)
+        rc = TE_EWRONGPTR;
+    else if (value->asn_type != path->type)
+        rc = TE_EASNWRONGTYPE;
+
+    for (i = 0; rc == 0 && i < path->len; i++)
+    {
+        const asn_path_step *step = &path->steps[i];
+
+        if (i > 0 && tmp_value->asn_type != path->steps[i - 1].type)
+        {
+            rc = TE_EASNWRONGTYPE;
+            break;
+        }
+
+        /* Textual presentation of all values on the path is changed */
+        tmp_value->txt_len = -1;
+
+        rc = asn_path_get_child(tmp_value, step, &new_value);
+        if (rc == TE_EASNINCOMPLVAL)
+        {
+            new_value = asn_impl_init_value(step->type, tmp_value->arena);
+            if (new_value == NULL)
+            {
+                rc = TE_ENOMEM;
+                break;
+            }
+
+            rc = asn_put_child_by_index(tmp_value, new_value, step->index);
+            if (rc != 0)
+                asn_free_value(new_value);
+        }
+        tmp_value = new_value;
+    }
+
+    if (status != NULL)
+        *status = rc;
+
+    return rc == 0 ? tmp_value : NULL;
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_write_value(asn_value *container, const asn_path *path,
+                     const void *data, size_t len)
+{
+    te_errno   rc;
+    asn_value *leaf = asn_path_retrieve(container, path, &rc);
+
+    if (leaf == NULL)
+        return rc;
+
+    return asn_write_primitive(leaf, data, len);
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_read_value(const asn_value *container, const asn_path *path,
+                    void *data, size_t *len)
+{
+    te_errno   rc;
+    asn_value *leaf = asn_path_find(container, path, &rc);
+
+    if (leaf == NULL)
+        return rc;
+
+    return asn_read_primitive(leaf, data, len);
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_write_int32(asn_value *container, const asn_path *path,
+                     int32_t value)
+{
+    return asn_path_write_value(container, path, &value, sizeof(value));
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_read_int32(const asn_value *container, const asn_path *path,
+                    int32_t *value)
+{
+    size_t len = sizeof(*value);
+
+    return asn_path_read_value(container, path, value, &len);
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_write_uint32(asn_value *container, const asn_path *path,
+                      uint32_t value)
+{
+    return asn_path_write_value(container, path, &value, sizeof(value));
+}
+
+/* See description in asn_usr.h */
+te_errno
+asn_path_read_uint32(const asn_value *container, const asn_path *path,
+                     uint32_t *value)
+{
+    size_t len = sizeof(*value);
+
+    return asn_path_read_value(container, path, value, &len);
+}
+
 /* see description in asn_usr.h */
 te_errno
 asn_write_string(asn_value *container, const char *value,
@@ -2657,7 +3115,8 @@ asn_insert_indexed(asn_value *container, asn_value *elem_value,
         return TE_EASNWRONGTYPE;
 
     {
-        asn_value **arr = malloc(new_len * sizeof(asn_value *));
+        asn_value **arr = asn_impl_alloc(value->arena,
+                                         new_len * sizeof(asn_value *));
 
         unsigned int i;
 
@@ -2672,8 +3131,7 @@ asn_insert_indexed(asn_value *container, asn_value *elem_value,
         for (; i < value->len; i++)
             arr[i+1] = value->data.array[i];
 
-        if (value->data.array)
-            free(value->data.array);
+        asn_impl_free(value->arena, value->data.array);
         value->data.array = arr;
         value->len = new_len;
     }
@@ -2721,7 +3179,8 @@ asn_remove_indexed(asn_value * container, int index, const char *subval_labels)
 
         if (value->len > 1)
         {
-            arr = malloc((value->len - 1) * sizeof(asn_value *));
+            arr = asn_impl_alloc(value->arena,
+                                 (value->len - 1) * sizeof(asn_value *));
             if (arr == NULL) return TE_ENOMEM;
         }
 
@@ -2735,7 +3194,7 @@ asn_remove_indexed(asn_value * container, int index, const char *subval_labels)
         for (; i < value->len; i++)
             arr[i] = value->data.array[i+1];
 
-        free(value->data.array);
+        asn_impl_free(value->arena, value->data.array);
         value->data.array = arr;
     }
 
@@ -3876,7 +4335,7 @@ asn_insert_value_extended_path(asn_value *root_node,
         {
             if (dst->data.array[i] != NULL)
             {
-                free(dst->data.array[i]);
+                asn_free_value(dst->data.array[i]);
             }
 #if 0
             RING("%s(): Copying item #%d (label=%s)", __FUNCTION__,
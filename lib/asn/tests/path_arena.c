@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * ASN.1 library
+ *
+ * self test and benchmark for compiled paths and arena allocated values
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+#include "te_config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "asn_usr.h"
+#include "test_types.h"
+
+/*
+Packet ::= SEQUENCE {
+    seq-no [0] INTEGER,
+    pdus   [1] SEQUENCE OF MySequence
+}
+*/
+asn_type at_complex_array = {
+    "ComplexArray",
+    {APPLICATION, 6},
+    SEQUENCE_OF,
+    0,
+    {.subtype = &my_complex}
+};
+
+asn_named_entry_t _at_packet_ne[] = {
+    { "seq-no", &asn_base_integer_s, {PRIVATE, 0} },
+    { "pdus", &at_complex_array, {PRIVATE, 1} }
+};
+
+asn_type at_packet = {
+    "Packet",
+    {APPLICATION, 7},
+    SEQUENCE,
+    sizeof(_at_packet_ne) / sizeof(asn_named_entry_t),
+    {_at_packet_ne}
+};
+
+#define BENCH_ITERS 100000
+
+static const char *labels[] = {
+    "seq-no",
+    "pdus.0.choice.#number",
+    "pdus.0.subseq.number",
+    "pdus.1.subseq.number",
+    "pdus.-1.subseq.string",
+};
+
+#define LABELS_NUM (sizeof(labels) / sizeof(labels[0]))
+
+int result = 0;
+
+char buf_labels[1000];
+char buf_paths[1000];
+
+static asn_path *paths[LABELS_NUM];
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static asn_value *
+build_labels(int32_t val)
+{
+    asn_value   *pkt = asn_init_value(&at_packet);
+    unsigned int i;
+
+    for (i = 0; i < LABELS_NUM - 1; i++)
+        asn_write_int32(pkt, val + i, labels[i]);
+    asn_write_string(pkt, "payload", labels[i]);
+
+    return pkt;
+}
+
+static asn_value *
+build_paths(int32_t val, bool arena)
+{
+    asn_value   *pkt = arena ? asn_init_value_arena(&at_packet, 0) :
+                               asn_init_value(&at_packet);
+    unsigned int i;
+    te_errno     rc;
+
+    for (i = 0; i < LABELS_NUM - 1; i++)
+    {
+        rc = asn_path_write_int32(pkt, paths[i], val + i);
+        if (rc != 0)
+        {
+            result = 1;
+            fprintf(stderr, "write by path '%s' failed 0x%X\n",
+                    labels[i], rc);
+        }
+    }
+    rc = asn_path_write_value(pkt, paths[i], "payload", strlen("payload"));
+    if (rc != 0)
+    {
+        result = 1;
+        fprintf(stderr, "write string by path failed 0x%X\n", rc);
+    }
+
+    return pkt;
+}
+
+static void
+check_tree(asn_value *pkt, int32_t val, const char *what)
+{
+    unsigned int i;
+    int32_t      got;
+    te_errno     rc;
+
+    for (i = 0; i < LABELS_NUM - 1; i++)
+    {
+        rc = asn_path_read_int32(pkt, paths[i], &got);
+        if (rc != 0 || got != val + (int32_t)i)
+        {
+            result = 1;
+            fprintf(stderr, "%s: read by path '%s' failed 0x%X, %d\n",
+                    what, labels[i], rc, got);
+        }
+        rc = asn_read_int32(pkt, &got, labels[i]);
+        if (rc != 0 || got != val + (int32_t)i)
+        {
+            result = 1;
+            fprintf(stderr, "%s: read by labels '%s' failed 0x%X, %d\n",
+                    what, labels[i], rc, got);
+        }
+    }
+
+    asn_sprint_value(pkt, buf_paths, sizeof(buf_paths), 0);
+    if (strcmp(buf_labels, buf_paths) != 0)
+    {
+        result = 1;
+        fprintf(stderr, "%s: text differs:\n%s\n%s\n",
+                what, buf_labels, buf_paths);
+    }
+}
+
+int
+main(void)
+{
+    asn_value   *pkt;
+    asn_value   *copy;
+    asn_path    *bad;
+    unsigned int i;
+    double       start;
+    double       labels_ns;
+    double       paths_ns;
+    double       arena_ns;
+    te_errno     rc;
+
+    for (i = 0; i < LABELS_NUM; i++)
+    {
+        rc = asn_path_compile(&at_packet, labels[i], &paths[i]);
+        if (rc != 0)
+        {
+            fprintf(stderr, "compile '%s' failed 0x%X\n", labels[i], rc);
+            return 1;
+        }
+    }
+
+    rc = asn_path_compile(&at_packet, "pdus.0.unknown", &bad);
+    if (rc != TE_EASNWRONGLABEL)
+    {
+        result = 1;
+        fprintf(stderr, "compile of wrong label returned 0x%X\n", rc);
+    }
+
+    pkt = build_labels(10);
+    asn_sprint_value(pkt, buf_labels, sizeof(buf_labels), 0);
+    printf("built by labels: \n%s\n", buf_labels);
+
+    rc = asn_get_indexed(pkt, &copy, 0, "pdus");
+    if (rc != 0 || asn_path_find(copy, paths[0], &rc) != NULL ||
+        rc != TE_EASNWRONGTYPE)
+    {
+        result = 1;
+        fprintf(stderr, "path is applied to wrong type, 0x%X\n", rc);
+    }
+    asn_free_value(pkt);
+
+    pkt = build_paths(10, false);
+    check_tree(pkt, 10, "heap");
+    asn_free_value(pkt);
+
+    pkt = build_paths(10, true);
+    check_tree(pkt, 10, "arena");
+
+    copy = asn_copy_value(pkt);
+    check_tree(copy, 10, "copy");
+    asn_free_value(copy);
+
+    /* Values allocated on heap may be put into arena tree */
+    copy = asn_init_value(&my_complex);
+    asn_write_int32(copy, 5, "subseq.number");
+    rc = asn_insert_indexed(pkt, copy, -1, "pdus");
+    if (rc != 0 || asn_read_int32(pkt, (int32_t *)&i,
+                                  "pdus.2.subseq.number") != 0 || i != 5)
+    {
+        result = 1;
+        fprintf(stderr, "insert heap value into arena tree failed 0x%X\n",
+                rc);
+    }
+
+    /* Values allocated from the arena of the tree they are put into */
+    copy = asn_init_value_in(&my_complex, pkt);
+    asn_write_int32(copy, 6, "subseq.number");
+    rc = asn_insert_indexed(pkt, copy, -1, "pdus");
+    if (rc != 0 || asn_read_int32(pkt, (int32_t *)&i,
+                                  "pdus.3.subseq.number") != 0 || i != 6)
+    {
+        result = 1;
+        fprintf(stderr, "insert arena value into its tree failed 0x%X\n",
+                rc);
+    }
+    asn_free_value(pkt);
+
+    start = now_ns();
+    for (i = 0; i < BENCH_ITERS; i++)
+        asn_free_value(build_labels(i));
+    labels_ns = (now_ns() - start) / BENCH_ITERS;
+
+    start = now_ns();
+    for (i = 0; i < BENCH_ITERS; i++)
+        asn_free_value(build_paths(i, false));
+    paths_ns = (now_ns() - start) / BENCH_ITERS;
+
+    start = now_ns();
+    for (i = 0; i < BENCH_ITERS; i++)
+        asn_free_value(build_paths(i, true));
+    arena_ns = (now_ns() - start) / BENCH_ITERS;
+
+    printf("build and free a tree: labels %.0f ns, compiled paths %.0f ns, "
+           "compiled paths and arena %.0f ns\n",
+           labels_ns, paths_ns, arena_ns);
+
+    for (i = 0; i < LABELS_NUM; i++)
+        asn_path_free(paths[i]);
+
+    return result;
+}
@@ -0,0 +1,311 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * ASN.1 library
+ *
+ * self test and benchmark for single pass printing and chunked parsing
+ * of ASN.1 text
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+#include "te_config.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "asn_usr.h"
+#include "te_string.h"
+#include "test_types.h"
+
+extern const asn_type asn_base_boolean_s;
+extern const asn_type asn_base_octstring_s;
+
+/*
+MyArray ::= SEQUENCE OF MySequence
+*/
+asn_type at_my_array = {
+    "MyArray",
+    {APPLICATION, 6},
+    SEQUENCE_OF,
+    0,
+    {.subtype = &my_complex}
+};
+
+/*
+Record ::= SEQUENCE {
+    name  [0] UniversalString,
+    data  [1] OCTET STRING,
+    kind  [2] OurNames,
+    flag  [3] BOOLEAN,
+    items [4] MyArray
+}
+*/
+asn_named_entry_t _at_record_ne[] = {
+    { "name", &asn_base_charstring_s, {PRIVATE, 0} },
+    { "data", &asn_base_octstring_s, {PRIVATE, 1} },
+    { "kind", &at_our_names, {PRIVATE, 2} },
+    { "flag", &asn_base_boolean_s, {PRIVATE, 3} },
+    { "items", &at_my_array, {PRIVATE, 4} }
+};
+
+asn_type at_record = {
+    "Record",
+    {APPLICATION, 7},
+    SEQUENCE,
+    sizeof(_at_record_ne) / sizeof(asn_named_entry_t),
+    {_at_record_ne}
+};
+
+#define BENCH_ITERS 2000
+
+int result = 0;
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static asn_value *
+build_record(unsigned int items, size_t name_len)
+{
+    asn_value   *rec = asn_init_value(&at_record);
+    char        *name = calloc(1, name_len + 1);
+    uint8_t      data[64];
+    char         label[64];
+    unsigned int i;
+
+    for (i = 0; i < name_len; i++)
+        name[i] = "ab\"{}' c"[i % 8];
+    asn_write_string(rec, name, "name");
+    free(name);
+
+    for (i = 0; i < sizeof(data); i++)
+        data[i] = i * 7;
+    asn_write_value_field(rec, data, sizeof(data), "data");
+    asn_write_int32(rec, 16, "kind");
+    asn_write_bool(rec, true, "flag");
+
+    for (i = 0; i < items; i++)
+    {
+        snprintf(label, sizeof(label), "items.%u.subseq.number", i);
+        asn_write_int32(rec, -(int)i, label);
+        snprintf(label, sizeof(label), "items.%u.subseq.string", i);
+        asn_write_string(rec, "item }{", label);
+        snprintf(label, sizeof(label), "items.%u.choice.#number", i);
+        asn_write_int32(rec, i, label);
+    }
+
+    return rec;
+}
+
+static char *
+sprint_record(const asn_value *rec)
+{
+    size_t len = asn_count_txt_len(rec, 0) + 1;
+    char  *buf = calloc(1, len);
+
+    asn_sprint_value(rec, buf, len, 0);
+    return buf;
+}
+
+static te_errno
+collect_cb(const char *text, size_t len, void *opaque)
+{
+    return te_string_append_buf(opaque, text, len);
+}
+
+static void
+check_print(const asn_value *rec, const char *what)
+{
+    char      *expected = sprint_record(rec);
+    te_string  str = TE_STRING_INIT;
+    te_errno   rc;
+
+    rc = asn_print_value_str(rec, 0, &str);
+    if (rc != 0 || strcmp(str.ptr, expected) != 0)
+    {
+        result = 1;
+        fprintf(stderr, "%s: asn_print_value_str() failed 0x%X:\n%s\n%s\n",
+                what, rc, expected, te_string_value(&str));
+    }
+
+    te_string_reset(&str);
+    rc = asn_print_value(rec, 0, collect_cb, &str);
+    if (rc != 0 || strcmp(str.ptr, expected) != 0)
+    {
+        result = 1;
+        fprintf(stderr, "%s: asn_print_value() failed 0x%X\n", what, rc);
+    }
+
+    te_string_free(&str);
+    free(expected);
+}
+
+static void
+check_truncate(const asn_value *rec, const char *what)
+{
+    char   *expected = sprint_record(rec);
+    size_t  len = strlen(expected);
+    char   *buf = malloc(len + 1);
+    size_t  size;
+    int     ret;
+
+    for (size = 1; size <= len + 1; size++)
+    {
+        memset(buf, '#', len + 1);
+        ret = asn_sprint_value(rec, buf, size, 0);
+        if (ret != (int)len || strlen(buf) != size - 1 ||
+            strncmp(buf, expected, size - 1) != 0)
+        {
+            result = 1;
+            fprintf(stderr, "%s: asn_sprint_value() to %u bytes returned "
+                    "%d instead of %u\n", what, (unsigned)size, ret,
+                    (unsigned)len);
+            break;
+        }
+    }
+
+    free(buf);
+    free(expected);
+}
+
+static void
+check_parse(const asn_value *rec, size_t chunk, const char *what)
+{
+    asn_text_parser parser;
+    te_string       text = TE_STRING_INIT;
+    asn_value      *parsed[2] = { NULL, NULL };
+    unsigned int    num = 0;
+    size_t          off = 0;
+    size_t          used;
+    int             syms;
+    te_errno        rc = 0;
+    char           *expected = sprint_record(rec);
+    char           *got;
+
+    /* Two values one after another and an unbraced value at the end */
+    asn_print_value_str(rec, 0, &text);
+    te_string_append(&text, "  ");
+    asn_print_value_str(rec, 0, &text);
+    te_string_append(&text, "\n  16 ");
+
+    asn_text_parser_init(&parser, &at_record);
+    while (off < text.len && rc == 0)
+    {
+        asn_value *val;
+
+        rc = asn_text_parser_feed(&parser, text.ptr + off,
+                                  MIN(chunk, text.len - off), &val, &used);
+        off += used;
+        if (val == NULL)
+            continue;
+
+        if (num < 2)
+            parsed[num] = val;
+        else
+            asn_free_value(val);
+        num++;
+        if (num == 2)
+            parser.type = &at_our_names;
+    }
+    if (rc != 0 || num != 2)
+    {
+        result = 1;
+        fprintf(stderr, "%s: chunk %u: feeding failed 0x%X, %u values\n",
+                what, (unsigned)chunk, rc, num);
+    }
+
+    for (num = 0; num < 2; num++)
+    {
+        if (parsed[num] == NULL)
+            continue;
+
+        got = sprint_record(parsed[num]);
+        if (strcmp(got, expected) != 0)
+        {
+            result = 1;
+            fprintf(stderr, "%s: chunk %u: value %u differs\n",
+                    what, (unsigned)chunk, num);
+        }
+        free(got);
+        asn_free_value(parsed[num]);
+    }
+
+    parsed[0] = NULL;
+    rc = asn_text_parser_finish(&parser, &parsed[0], &syms);
+    if (rc != 0 || parsed[0] == NULL ||
+        asn_read_int32(parsed[0], (int32_t *)&num, "") != 0 || num != 16)
+    {
+        result = 1;
+        fprintf(stderr, "%s: chunk %u: unbraced value failed 0x%X\n",
+                what, (unsigned)chunk, rc);
+    }
+    asn_free_value(parsed[0]);
+
+    if (asn_text_parser_finish(&parser, &parsed[0], &syms) != TE_ENODATA)
+    {
+        result = 1;
+        fprintf(stderr, "%s: finish without text is not ENODATA\n", what);
+    }
+
+    asn_text_parser_free(&parser);
+    te_string_free(&text);
+    free(expected);
+}
+
+int
+main(void)
+{
+    static const size_t chunks[] = { 1, 3, 64, 4096, 1 << 20 };
+    asn_value   *small = build_record(2, 20);
+    asn_value   *large = build_record(300, 10000);
+    te_string    str = TE_STRING_INIT;
+    char        *buf;
+    unsigned int i;
+    double       start;
+    double       twice_ns;
+    double       once_ns;
+
+    check_print(small, "small");
+    check_print(large, "large");
+    check_truncate(small, "small");
+
+    for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++)
+    {
+        check_parse(small, chunks[i], "small");
+        check_parse(large, chunks[i], "large");
+    }
+
+    buf = sprint_record(small);
+    printf("printed value:\n%s\n", buf);
+    free(buf);
+
+    start = now_ns();
+    for (i = 0; i < BENCH_ITERS; i++)
+    {
+        asn_clean_count(large);
+        free(sprint_record(large));
+    }
+    twice_ns = (now_ns() - start) / BENCH_ITERS;
+
+    start = now_ns();
+    for (i = 0; i < BENCH_ITERS; i++)
+    {
+        te_string_reset(&str);
+        asn_print_value_str(large, 0, &str);
+    }
+    once_ns = (now_ns() - start) / BENCH_ITERS;
+
+    printf("print %u bytes: count and sprint %.0f ns, single pass %.0f ns\n",
+           (unsigned)str.len, twice_ns, once_ns);
+
+    te_string_free(&str);
+    asn_free_value(small);
+    asn_free_value(large);
+
+    return result;
+}
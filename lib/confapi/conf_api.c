@@ -38,8 +38,13 @@
 #ifdef HAVE_ASSERT_H
 #include <assert.h>
 #endif
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#include <sys/mman.h>
 
 #include "te_alloc.h"
+#include "te_hash.h"
 #include "te_stdint.h"
 #include "te_errno.h"
 #include "te_defs.h"
@@ -130,6 +135,338 @@ static te_errno cfg_get_family_member(cfg_handle handle,
 static te_errno kill_all(cfg_handle handle, bool local);
 static te_errno kill(cfg_handle handle, bool local);
 
+/*
+ * Cache of Configurator replies.
+ *
+ * Configurator stamps replies with the generation of its database and
+ * publishes the current generation in shared memory. Cached replies
+ * are used while the published generation is not changed, i.e. while
+ * nobody has changed the database. Replies which must not be cached
+ * (e.g. values of volatile objects) have CFG_GEN_NONE generation.
+ *
+ * The cache is not used if TE_CONF_API_NO_CACHE environment variable
+ * is set or if the generation is not published by Configurator.
+ * The cache is protected by cfgl_lock.
+ */
+
+/** Number of entries in every cache table (must be a power of 2) */
+#define CFG_CACHE_SIZE  1024
+
+/** Cached OID and value of an object or instance */
+typedef struct cfg_cache_inst {
+    cfg_handle      handle;     /**< Handle (CFG_HANDLE_INVALID if
+                                     the entry is empty) */
+    char           *oid;        /**< OID or @c NULL if not cached */
+    bool            has_val;    /**< Is the value cached? */
+    cfg_val_type    val_type;   /**< Type of the value */
+    cfg_inst_val    val;        /**< Value */
+} cfg_cache_inst;
+
+/** Cached result of OID lookup */
+typedef struct cfg_cache_find {
+    char       *oid;            /**< OID or @c NULL if the entry
+                                     is empty */
+    cfg_handle  handle;         /**< Found handle */
+} cfg_cache_find;
+
+/** Is the cache initialized? */
+static bool cfgl_cache_init = false;
+
+/** Generation published by Configurator or @c NULL if no cache */
+static const uint32_t *cfgl_cache_gen_shm = NULL;
+
+/** Generation of the database all cached replies are valid for */
+static uint32_t cfgl_cache_gen = CFG_GEN_NONE;
+
+/** Cache of OIDs and values by handles */
+static cfg_cache_inst *cfgl_cache_insts = NULL;
+
+/** Cache of OID lookups */
+static cfg_cache_find *cfgl_cache_finds = NULL;
+
+/** Hash of an OID in the cache */
+static inline unsigned int
+cfg_cache_oid_hash(const char *oid)
+{
+    return te_hash_fnv32_str(TE_HASH_FNV32_INIT, oid) & (CFG_CACHE_SIZE - 1);
+}
+
+/** Hash of a handle */
+static inline unsigned int
+cfg_cache_handle_hash(cfg_handle handle)
+{
+    return (handle ^ (handle >> 32)) & (CFG_CACHE_SIZE - 1);
+}
+
+/** Drop all cached replies */
+static void
+cfg_cache_clear(void)
+{
+    unsigned int i;
+
+    if (cfgl_cache_insts == NULL)
+        return;
+
+    for (i = 0; i < CFG_CACHE_SIZE; i++)
+    {
+        cfg_cache_inst *entry = &cfgl_cache_insts[i];
+
+        free(entry->oid);
+        if (entry->has_val)
+            cfg_types[entry->val_type].free(entry->val);
+        memset(entry, 0, sizeof(*entry));
+        entry->handle = CFG_HANDLE_INVALID;
+
+        free(cfgl_cache_finds[i].oid);
+        cfgl_cache_finds[i].oid = NULL;
+    }
+}
+
+/** Release all resources of the cache */
+static void
+cfg_cache_fini(void)
+{
+    cfg_cache_clear();
+    free(cfgl_cache_insts);
+    cfgl_cache_insts = NULL;
+    free(cfgl_cache_finds);
+    cfgl_cache_finds = NULL;
+
+    if (cfgl_cache_gen_shm != NULL)
+    {
+        munmap((void *)cfgl_cache_gen_shm, sizeof(*cfgl_cache_gen_shm));
+        cfgl_cache_gen_shm = NULL;
+    }
+    cfgl_cache_init = false;
+}
+
+/**
+ * Check whether cached replies may be used. Drop them if the database
+ * generation is changed.
+ *
+ * @return @c true if the cache is in use.
+ */
+static bool
+cfg_cache_check(void)
+{
+    uint32_t gen;
+
+    if (!cfgl_cache_init)
+    {
+        void *ptr;
+        int   fd;
+
+        cfgl_cache_init = true;
+        if (getenv("TE_CONF_API_NO_CACHE") != NULL)
+            return false;
+
+        fd = shm_open(cs_gen_shm_name(), O_RDONLY, 0);
+        if (fd < 0)
+            return false;
+        ptr = mmap(NULL, sizeof(*cfgl_cache_gen_shm), PROT_READ,
+                   MAP_SHARED, fd, 0);
+        close(fd);
+        if (ptr == MAP_FAILED)
+            return false;
+
+        cfgl_cache_gen_shm = ptr;
+        cfgl_cache_insts = TE_ALLOC(CFG_CACHE_SIZE *
+                                    sizeof(*cfgl_cache_insts));
+        cfgl_cache_finds = TE_ALLOC(CFG_CACHE_SIZE *
+                                    sizeof(*cfgl_cache_finds));
+        cfgl_cache_gen = CFG_GEN_NONE;
+        cfg_cache_clear();
+    }
+
+    if (cfgl_cache_gen_shm == NULL)
+        return false;
+
+    gen = __atomic_load_n(cfgl_cache_gen_shm, __ATOMIC_ACQUIRE);
+    if (gen != cfgl_cache_gen)
+    {
+        cfg_cache_clear();
+        cfgl_cache_gen = gen;
+    }
+
+    return true;
+}
+
+/**
+ * Check whether a reply may be cached.
+ *
+ * @param gen       generation of the database in the reply
+ *
+ * @return @c true if the reply should be put in the cache.
+ */
+static bool
+cfg_cache_accept(uint32_t gen)
+{
+    if (cfgl_cache_gen_shm == NULL || gen == CFG_GEN_NONE)
+        return false;
+
+    /* The database is changed after the last check */
+    if (gen != cfgl_cache_gen)
+    {
+        cfg_cache_clear();
+        cfgl_cache_gen = gen;
+    }
+
+    return true;
+}
+
+/**
+ * Get the cache entry of a handle.
+ *
+ * @param handle    object or instance handle
+ * @param create    reset the entry if it belongs to another handle
+ *
+ * @return Cache entry or @c NULL.
+ */
+static cfg_cache_inst *
+cfg_cache_inst_get(cfg_handle handle, bool create)
+{
+    cfg_cache_inst *entry = &cfgl_cache_insts[cfg_cache_handle_hash(handle)];
+
+    if (entry->handle != handle)
+    {
+        if (!create)
+            return NULL;
+
+        free(entry->oid);
+        if (entry->has_val)
+            cfg_types[entry->val_type].free(entry->val);
+        memset(entry, 0, sizeof(*entry));
+        entry->handle = handle;
+    }
+
+    return entry;
+}
+
+/**
+ * Look up an OID in the cache.
+ *
+ * @param oid       OID in string representation
+ * @param handle    location for the handle
+ *
+ * @return @c true if the OID is found.
+ */
+static bool
+cfg_cache_find_lookup(const char *oid, cfg_handle *handle)
+{
+    cfg_cache_find *entry;
+
+    if (!cfg_cache_check())
+        return false;
+
+    entry = &cfgl_cache_finds[cfg_cache_oid_hash(oid)];
+    if (entry->oid == NULL || strcmp(entry->oid, oid) != 0)
+        return false;
+
+    *handle = entry->handle;
+    return true;
+}
+
+/** Put result of OID lookup in the cache */
+static void
+cfg_cache_find_put(const char *oid, cfg_handle handle, uint32_t gen)
+{
+    cfg_cache_find *entry;
+
+    if (!cfg_cache_accept(gen))
+        return;
+
+    entry = &cfgl_cache_finds[cfg_cache_oid_hash(oid)];
+    if (entry->oid == NULL || strcmp(entry->oid, oid) != 0)
+    {
+        free(entry->oid);
+        entry->oid = TE_STRDUP(oid);
+    }
+    entry->handle = handle;
+}
+
+/**
+ * Look up OID of a handle in the cache.
+ *
+ * @param handle    object or instance handle
+ *
+ * @return OID (owned by the cache) or @c NULL.
+ */
+static const char *
+cfg_cache_oid_lookup(cfg_handle handle)
+{
+    cfg_cache_inst *entry;
+
+    if (!cfg_cache_check())
+        return NULL;
+
+    entry = cfg_cache_inst_get(handle, false);
+    return entry == NULL ? NULL : entry->oid;
+}
+
+/** Put OID of a handle in the cache */
+static void
+cfg_cache_oid_put(cfg_handle handle, const char *oid, uint32_t gen)
+{
+    cfg_cache_inst *entry;
+
+    if (!cfg_cache_accept(gen))
+        return;
+
+    entry = cfg_cache_inst_get(handle, true);
+    free(entry->oid);
+    entry->oid = TE_STRDUP(oid);
+}
+
+/**
+ * Look up value of an instance in the cache.
+ *
+ * @param handle    instance handle
+ * @param val_type  location for the value type
+ * @param val       location for a copy of the value
+ *
+ * @return @c true if the value is found.
+ */
+static bool
+cfg_cache_val_lookup(cfg_handle handle, cfg_val_type *val_type,
+                     cfg_inst_val *val)
+{
+    cfg_cache_inst *entry;
+
+    if (!cfg_cache_check())
+        return false;
+
+    entry = cfg_cache_inst_get(handle, false);
+    if (entry == NULL || !entry->has_val ||
+        cfg_types[entry->val_type].copy(entry->val, val) != 0)
+        return false;
+
+    *val_type = entry->val_type;
+    return true;
+}
+
+/** Put value of an instance in the cache */
+static void
+cfg_cache_val_put(cfg_handle handle, cfg_val_type val_type,
+                  cfg_inst_val val, uint32_t gen)
+{
+    cfg_cache_inst *entry;
+
+    if (!cfg_cache_accept(gen))
+        return;
+
+    entry = cfg_cache_inst_get(handle, true);
+    if (entry->has_val)
+    {
+        cfg_types[entry->val_type].free(entry->val);
+        entry->has_val = false;
+    }
+    if (cfg_types[val_type].copy(val, &entry->val) == 0)
+    {
+        entry->val_type = val_type;
+        entry->has_val = true;
+    }
+}
+
 
 /* See description in conf_api.h */
 te_errno
@@ -324,6 +661,8 @@ cfg_get_oid_str(cfg_handle handle, char **oid)
 
     char *str;
 
+    const char *cached;
+
     *oid = NULL;
 
     if (handle == CFG_HANDLE_INVALID)
@@ -343,6 +682,16 @@ cfg_get_oid_str(cfg_handle handle, char **oid)
         return TE_RC(TE_CONF_API, TE_EIPC);
     }
 
+    cached = cfg_cache_oid_lookup(handle);
+    if (cached != NULL)
+    {
+        *oid = TE_STRDUP(cached);
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_unlock(&cfgl_lock);
+#endif
+        return 0;
+    }
+
     memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
     msg = (cfg_get_oid_msg *)cfgl_msg_buf;
 
@@ -360,6 +709,7 @@ cfg_get_oid_str(cfg_handle handle, char **oid)
         str = TE_ALLOC(len);
         memcpy((void *)str, (void *)(msg->oid), len);
         *oid = str;
+        cfg_cache_oid_put(handle, str, msg->gen);
     }
 
 #ifdef HAVE_PTHREAD_H
@@ -565,6 +915,7 @@ cfg_find_str(const char *oid, cfg_handle *handle)
 
     size_t      len;
     te_errno    ret_val = 0;
+    cfg_handle  found;
 
     if (oid == NULL)
     {
@@ -583,22 +934,36 @@ cfg_find_str(const char *oid, cfg_handle *handle)
         return TE_RC(TE_CONF_API, TE_EIPC);
     }
 
-    memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
-    msg = (cfg_find_msg *)cfgl_msg_buf;
-    len = strlen(oid) + 1;
+    if (cfg_cache_find_lookup(oid, &found))
+    {
+        if (handle != NULL)
+            *handle = found;
+    }
+    else
+    {
+        memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
+        msg = (cfg_find_msg *)cfgl_msg_buf;
 
-    ret_val = cfg_ipc_mk_find_str(msg, CFG_MSG_MAX, oid);
-    if (ret_val != 0)
-        return ret_val;
+        ret_val = cfg_ipc_mk_find_str(msg, CFG_MSG_MAX, oid);
+        if (ret_val != 0)
+        {
+#ifdef HAVE_PTHREAD_H
+            pthread_mutex_unlock(&cfgl_lock);
+#endif
+            return ret_val;
+        }
 
-    len = CFG_MSG_MAX;
+        len = CFG_MSG_MAX;
 
-    ret_val = ipc_send_message_with_answer(cfgl_ipc_client,
-                                           CONFIGURATOR_SERVER,
-                                           msg, msg->len, msg, &len);
-    if ((ret_val == 0) && ((ret_val = msg->rc) == 0) && (handle != NULL))
-    {
-        *handle = msg->handle;
+        ret_val = ipc_send_message_with_answer(cfgl_ipc_client,
+                                               CONFIGURATOR_SERVER,
+                                               msg, msg->len, msg, &len);
+        if ((ret_val == 0) && ((ret_val = msg->rc) == 0))
+        {
+            if (handle != NULL)
+                *handle = msg->handle;
+            cfg_cache_find_put(oid, msg->handle, msg->gen);
+        }
     }
 #ifdef HAVE_PTHREAD_H
     pthread_mutex_unlock(&cfgl_lock);
@@ -941,6 +1306,62 @@ cfg_get_father(cfg_handle handle, cfg_handle *father)
     return TE_RC(TE_CONF_API, ret_val);
 }
 
+/**
+ * Get a value of the specified type from the list of arguments.
+ *
+ * @param type      value type
+ * @param list      list of arguments with the value;
+ *                    for integer values: int
+ *                    for strings: char *
+ *                    for addresses: struct sockaddr *
+ *
+ * @return The value.
+ */
+static cfg_inst_val
+cfg_inst_val_from_list(cfg_val_type type, va_list list)
+{
+    cfg_inst_val value = {};
+
+#define CASE_INTEGER_TYPE(variant_, cvt_type_, type_, type_for_varg_) \
+        case cvt_type_:                                                        \
+            value.val_ ## variant_ = (type_)va_arg(list, type_for_varg_);      \
+            break;
+
+    switch (type)
+    {
+        CASE_INTEGER_TYPE(bool, CVT_BOOL, bool, unsigned int);
+        CASE_INTEGER_TYPE(int8, CVT_INT8, int8_t, int);
+        CASE_INTEGER_TYPE(uint8, CVT_UINT8, uint8_t, unsigned int);
+        CASE_INTEGER_TYPE(int16, CVT_INT16, int16_t, int);
+        CASE_INTEGER_TYPE(uint16, CVT_UINT16, uint16_t, unsigned int);
+        CASE_INTEGER_TYPE(int32, CVT_INT32, int32_t, int);
+        CASE_INTEGER_TYPE(uint32, CVT_UINT32, uint32_t, unsigned int);
+        CASE_INTEGER_TYPE(int64, CVT_INT64, int64_t, int64_t);
+        CASE_INTEGER_TYPE(uint64, CVT_UINT64, uint64_t, uint64_t);
+
+        case CVT_DOUBLE:
+            value.val_double = va_arg(list, double);
+            break;
+
+        case CVT_STRING:
+            value.val_str = va_arg(list, char *);
+            break;
+
+        case CVT_ADDRESS:
+            value.val_addr = va_arg(list, struct sockaddr *);
+            break;
+
+        case CVT_NONE:
+            break;
+
+        case CVT_UNSPECIFIED:
+            assert(false);
+    }
+#undef CASE_INTEGER_TYPE
+
+    return value;
+}
+
 /**
  * Create object instance locally or on the agent.
  *
@@ -989,42 +1410,7 @@ cfg_add_instance_gen(const char *oid, cfg_handle *handle, bool local,
     msg->local = local;
     msg->val_type = type;
 
-#define CASE_INTEGER_TYPE(variant_, cvt_type_, type_, type_for_varg_) \
-        case cvt_type_:                                                        \
-            value.val_ ## variant_ = (type_)va_arg(list, type_for_varg_);      \
-            break;
-
-    switch (type)
-    {
-        CASE_INTEGER_TYPE(bool, CVT_BOOL, bool, unsigned int);
-        CASE_INTEGER_TYPE(int8, CVT_INT8, int8_t, int);
-        CASE_INTEGER_TYPE(uint8, CVT_UINT8, uint8_t, unsigned int);
-        CASE_INTEGER_TYPE(int16, CVT_INT16, int16_t, int);
-        CASE_INTEGER_TYPE(uint16, CVT_UINT16, uint16_t, unsigned int);
-        CASE_INTEGER_TYPE(int32, CVT_INT32, int32_t, int);
-        CASE_INTEGER_TYPE(uint32, CVT_UINT32, uint32_t, unsigned int);
-        CASE_INTEGER_TYPE(int64, CVT_INT64, int64_t, int64_t);
-        CASE_INTEGER_TYPE(uint64, CVT_UINT64, uint64_t, uint64_t);
-
-        case CVT_DOUBLE:
-            value.val_double = va_arg(list, double);
-            break;
-
-        case CVT_STRING:
-            value.val_str = va_arg(list, char *);
-            break;
-
-        case CVT_ADDRESS:
-            value.val_addr = va_arg(list, struct sockaddr *);
-            break;
-
-        case CVT_NONE:
-            break;
-
-        case CVT_UNSPECIFIED:
-            assert(false);
-    }
-#undef CASE_INTEGER_TYPE
+    value = cfg_inst_val_from_list(type, list);
 
     cfg_types[type].put_to_msg(value, (cfg_msg *)msg);
 
@@ -1442,42 +1828,7 @@ cfg_set_instance_gen(cfg_handle handle, bool local, cfg_val_type type,
         return TE_RC(TE_CONF_API, TE_EIPC);
     }
 
-#define CASE_INTEGER_TYPE(variant_, cvt_type_, type_, type_for_varg_) \
-        case cvt_type_:                                                        \
-            value.val_ ## variant_ = (type_)va_arg(list, type_for_varg_);      \
-            break
-
-    switch (type)
-    {
-        CASE_INTEGER_TYPE(bool, CVT_BOOL, bool, unsigned int);
-        CASE_INTEGER_TYPE(int8, CVT_INT8, int8_t, int);
-        CASE_INTEGER_TYPE(uint8, CVT_UINT8, uint8_t, unsigned int);
-        CASE_INTEGER_TYPE(int16, CVT_INT16, int16_t, int);
-        CASE_INTEGER_TYPE(uint16, CVT_UINT16, uint16_t, unsigned int);
-        CASE_INTEGER_TYPE(int32, CVT_INT32, int32_t, int);
-        CASE_INTEGER_TYPE(uint32, CVT_UINT32, uint32_t, unsigned int);
-        CASE_INTEGER_TYPE(int64, CVT_INT64, int64_t, int64_t);
-        CASE_INTEGER_TYPE(uint64, CVT_UINT64, uint64_t, uint64_t);
-
-        case CVT_DOUBLE:
-            value.val_double = va_arg(list, double);
-            break;
-
-        case CVT_STRING:
-            value.val_str = va_arg(list, char *);
-            break;
-
-        case CVT_ADDRESS:
-            value.val_addr = va_arg(list, struct sockaddr *);
-            break;
-
-        case CVT_NONE:
-            break;
-
-        case CVT_UNSPECIFIED:
-             assert(0);
-    }
-#undef CASE_INTEGER_TYPE
+    value = cfg_inst_val_from_list(type, list);
 
     memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
     msg = (cfg_set_msg *)cfgl_msg_buf;
@@ -1628,6 +1979,227 @@ cfg_commit_fmt(const char *oid_fmt, ...)
     return cfg_commit(oid);
 }
 
+/**
+ * Append an operation record to the batch.
+ *
+ * @param batch     batch of changes
+ * @param msg       CFG_ADD, CFG_SET or CFG_DEL message
+ * @param oid       OID of the instance to set or delete or @c NULL
+ *
+ * @return Status code.
+ */
+static te_errno
+cfg_batch_append(cfg_batch *batch, const cfg_msg *msg, const char *oid)
+{
+    cfg_batch_op op;
+    size_t       oid_len = (oid == NULL) ? 1 : strlen(oid) + 1;
+    size_t       offset;
+
+    if (batch->msg.len == 0)
+        te_dbuf_append(&batch->msg, NULL, sizeof(cfg_batch_msg));
+
+    op.oid_offset = sizeof(op) + msg->len;
+    op.len = TE_ALIGN(op.oid_offset + oid_len, CFG_BATCH_ALIGN);
+
+    offset = batch->msg.len;
+    te_dbuf_append(&batch->msg, &op, sizeof(op));
+    te_dbuf_append(&batch->msg, msg, msg->len);
+    te_dbuf_append(&batch->msg, oid == NULL ? "" : oid, oid_len);
+    te_dbuf_append(&batch->msg, NULL, op.len - op.oid_offset - oid_len);
+
+    TE_VEC_APPEND(&batch->offsets, offset);
+
+    return 0;
+}
+
+/**
+ * Add creation or change of an object instance to the batch.
+ *
+ * @param batch     batch of changes
+ * @param msg_type  CFG_ADD or CFG_SET
+ * @param oid       instance OID
+ * @param type      value type
+ * @param ...       value (see cfg_inst_val_from_list())
+ *
+ * @return Status code.
+ */
+static te_errno
+cfg_batch_add_val(cfg_batch *batch, uint8_t msg_type, const char *oid,
+                  cfg_val_type type, ...)
+{
+    char          buf[CFG_MSG_MAX] = {};
+    cfg_add_msg  *msg = (cfg_add_msg *)buf;
+    cfg_inst_val  value;
+    size_t        value_size = 0;
+    te_errno      rc;
+    va_list       list;
+
+    va_start(list, type);
+    value = cfg_inst_val_from_list(type, list);
+    va_end(list);
+
+    if (msg_type == CFG_SET)
+    {
+        rc = cfg_ipc_mk_set((cfg_set_msg *)buf, sizeof(buf),
+                            CFG_HANDLE_INVALID, false, type, value);
+        if (rc != 0)
+            return rc;
+
+        return cfg_batch_append(batch, (cfg_msg *)buf, oid);
+    }
+
+    if (type == CVT_STRING || type == CVT_ADDRESS)
+        value_size = cfg_types[type].value_size(value);
+
+    if (sizeof(*msg) + value_size + strlen(oid) + 1 > sizeof(buf))
+        return TE_RC(TE_CONF_API, TE_ESMALLBUF);
+
+    msg->type = CFG_ADD;
+    msg->local = false;
+    msg->val_type = type;
+    cfg_types[type].put_to_msg(value, (cfg_msg *)msg);
+
+    msg->oid_offset = msg->len;
+    msg->len += strlen(oid) + 1;
+    strcpy(buf + msg->oid_offset, oid);
+
+    return cfg_batch_append(batch, (cfg_msg *)msg, NULL);
+}
+
+/* See description in conf_api.h */
+te_errno
+cfg_batch_add_fmt(cfg_batch *batch, cfg_val_type type, const void *val,
+                  const char *oid_fmt, ...)
+{
+    va_list ap;
+    char    oid[CFG_OID_MAX];
+
+    va_start(ap, oid_fmt);
+    vsnprintf(oid, sizeof(oid), oid_fmt, ap);
+    va_end(ap);
+
+    return cfg_batch_add_val(batch, CFG_ADD, oid, type, val);
+}
+
+/* See description in conf_api.h */
+te_errno
+cfg_batch_set_fmt(cfg_batch *batch, cfg_val_type type, const void *val,
+                  const char *oid_fmt, ...)
+{
+    va_list ap;
+    char    oid[CFG_OID_MAX];
+
+    va_start(ap, oid_fmt);
+    vsnprintf(oid, sizeof(oid), oid_fmt, ap);
+    va_end(ap);
+
+    return cfg_batch_add_val(batch, CFG_SET, oid, type, val);
+}
+
+/* See description in conf_api.h */
+te_errno
+cfg_batch_del_fmt(cfg_batch *batch, const char *oid_fmt, ...)
+{
+    cfg_del_msg msg;
+    va_list     ap;
+    char        oid[CFG_OID_MAX];
+    te_errno    rc;
+
+    va_start(ap, oid_fmt);
+    vsnprintf(oid, sizeof(oid), oid_fmt, ap);
+    va_end(ap);
+
+    rc = cfg_ipc_mk_del(&msg, sizeof(msg), CFG_HANDLE_INVALID, false);
+    if (rc != 0)
+        return rc;
+
+    return cfg_batch_append(batch, (cfg_msg *)&msg, oid);
+}
+
+/* See description in conf_api.h */
+te_errno
+cfg_batch_commit(cfg_batch *batch)
+{
+    cfg_batch_msg *msg;
+    size_t         len;
+    int            ret_val = 0;
+
+    if (te_vec_size(&batch->offsets) == 0)
+        return 0;
+
+    msg = (cfg_batch_msg *)batch->msg.ptr;
+    msg->type = CFG_BATCH;
+    msg->len = batch->msg.len;
+    msg->rc = 0;
+    msg->n_ops = te_vec_size(&batch->offsets);
+
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_lock(&cfgl_lock);
+#endif
+    INIT_IPC;
+    if (cfgl_ipc_client == NULL)
+    {
+#ifdef HAVE_PTHREAD_H
+        pthread_mutex_unlock(&cfgl_lock);
+#endif
+        return TE_RC(TE_CONF_API, TE_EIPC);
+    }
+
+    len = batch->msg.len;
+
+    if ((ret_val = ipc_send_message_with_answer(cfgl_ipc_client,
+                                                CONFIGURATOR_SERVER,
+                                                msg, msg->len,
+                                                msg, &len)) == 0)
+    {
+        ret_val = msg->rc;
+        if (ret_val == 0)
+            RING("Applied batch of %u configuration changes", msg->n_ops);
+    }
+
+#ifdef HAVE_PTHREAD_H
+    pthread_mutex_unlock(&cfgl_lock);
+#endif
+
+    if (ret_val != 0)
+        te_log_stack_push("Failed to apply batch of %u configuration "
+                          "changes: rc=%s-%s", msg->n_ops,
+                          te_rc_mod2str(ret_val), te_rc_err2str(ret_val));
+
+    return TE_RC(TE_CONF_API, ret_val);
+}
+
+/* See description in conf_api.h */
+te_errno
+cfg_batch_status(const cfg_batch *batch, unsigned int i, cfg_handle *handle)
+{
+    const cfg_batch_op *op;
+    const cfg_msg      *msg;
+
+    if (i >= te_vec_size(&batch->offsets))
+        return TE_RC(TE_CONF_API, TE_EINVAL);
+
+    op = (const cfg_batch_op *)(batch->msg.ptr +
+                                TE_VEC_GET(size_t, &batch->offsets, i));
+    msg = CFG_BATCH_OP_MSG(op);
+
+    if (handle != NULL)
+    {
+        *handle = (msg->type == CFG_ADD && msg->rc == 0) ?
+                  ((const cfg_add_msg *)msg)->handle : CFG_HANDLE_INVALID;
+    }
+
+    return TE_RC(TE_CONF_API, msg->rc);
+}
+
+/* See description in conf_api.h */
+void
+cfg_batch_free(cfg_batch *batch)
+{
+    te_dbuf_free(&batch->msg);
+    te_vec_free(&batch->offsets);
+}
+
 /* See description in conf_api.h */
 te_errno
 cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
@@ -1635,6 +2207,7 @@ cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
     cfg_get_msg    *msg;
     va_list         list;
     cfg_inst_val    value;
+    cfg_val_type    val_type;
     size_t          len;
     te_errno        rc = 0;
 
@@ -1655,29 +2228,41 @@ cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
         return TE_RC(TE_CONF_API, TE_EIPC);
     }
 
-    memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
-    msg = (cfg_get_msg *)cfgl_msg_buf;
-    rc = cfg_ipc_mk_get(msg, CFG_MSG_MAX, handle, false);
-    if (rc != 0)
-        return rc;
+    if (!cfg_cache_val_lookup(handle, &val_type, &value))
+    {
+        memset(cfgl_msg_buf, 0, sizeof(cfgl_msg_buf));
+        msg = (cfg_get_msg *)cfgl_msg_buf;
+        rc = cfg_ipc_mk_get(msg, CFG_MSG_MAX, handle, false);
+        if (rc != 0)
+        {
+#ifdef HAVE_PTHREAD_H
+            pthread_mutex_unlock(&cfgl_lock);
+#endif
+            return rc;
+        }
 
-    len = CFG_MSG_MAX;
+        len = CFG_MSG_MAX;
 
-    rc = ipc_send_message_with_answer(cfgl_ipc_client,
-                                      CONFIGURATOR_SERVER,
-                                      msg, msg->len, msg, &len);
-    if ((rc != 0) || ((rc = msg->rc) != 0) ||
-        ((rc = cfg_types[msg->val_type].get_from_msg((cfg_msg *)msg,
-                                                     &value)) != 0))
-    {
+        rc = ipc_send_message_with_answer(cfgl_ipc_client,
+                                          CONFIGURATOR_SERVER,
+                                          msg, msg->len, msg, &len);
+        if ((rc != 0) || ((rc = msg->rc) != 0) ||
+            ((rc = cfg_types[msg->val_type].get_from_msg((cfg_msg *)msg,
+                                                         &value)) != 0))
+        {
 #ifdef HAVE_PTHREAD_H
-        pthread_mutex_unlock(&cfgl_lock);
+            pthread_mutex_unlock(&cfgl_lock);
 #endif
-        return TE_RC(TE_CONF_API, rc);
+            return TE_RC(TE_CONF_API, rc);
+        }
+
+        val_type = msg->val_type;
+        cfg_cache_val_put(handle, val_type, value, msg->gen);
     }
 
-    if (type != NULL && *type != CVT_UNSPECIFIED && *type != msg->val_type)
+    if (type != NULL && *type != CVT_UNSPECIFIED && *type != val_type)
     {
+        cfg_types[val_type].free(value);
 #ifdef HAVE_PTHREAD_H
         pthread_mutex_unlock(&cfgl_lock);
 #endif
@@ -1696,7 +2281,7 @@ cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
             break;                                                         \
         }
 
-    switch (msg->val_type)
+    switch (val_type)
     {
         CASE_INTEGER_TYPE(bool, CVT_BOOL, bool);
         CASE_INTEGER_TYPE(int8, CVT_INT8, int8_t);
@@ -1741,7 +2326,7 @@ cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
         default:
         {
             ERROR("Get Configurator instance of unknown type %u",
-                  msg->val_type);
+                  val_type);
             rc = TE_RC(TE_CONF_API, TE_EINVAL);
             break;
         }
@@ -1751,7 +2336,7 @@ cfg_get_instance(cfg_handle handle, cfg_val_type *type, ...)
 
     if ((type != NULL) && (*type == CVT_UNSPECIFIED))
     {
-        *type = msg->val_type;
+        *type = val_type;
     }
 
 #ifdef HAVE_PTHREAD_H
@@ -2563,6 +3148,8 @@ cfg_api_cleanup(void)
 {
     int rc = ipc_close_client(cfgl_ipc_client);
 
+    cfg_cache_fini();
+
     if (rc != 0)
     {
         ERROR("%s(): ipc_close_client() failed with rc=%d",
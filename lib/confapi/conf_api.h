@@ -8,8 +8,14 @@
  * - @cmd{Add} new object instances;
  * - @cmd{Delete} existing object instances;
  * - change the value of an object instance;
- * - @cmd{Get} the value of an object instance.
+ * - @cmd{Get} the value of an object instance;
+ * - apply a batch of changes with a single request.
  * .
+ *
+ * Results of lookups by OID, OIDs of handles and values of
+ * non-volatile instances are cached in the process while the
+ * Configurator database is not changed by anybody. Set
+ * @c TE_CONF_API_NO_CACHE environment variable to disable it.
  */
 
 /**
@@ -46,6 +52,7 @@
 #include "cs_common.h"
 #include "conf_oid.h"
 #include "te_kvpair.h"
+#include "te_vector.h"
 #include "rcf_api.h"
 
 #ifdef __cplusplus
@@ -845,6 +852,127 @@ extern te_errno cfg_get_addr_sync(struct sockaddr **val,
 
 /**@}*/
 
+/** @defgroup confapi_base_batch Batches of configuration changes
+ * @ingroup confapi_base
+ *
+ * Operations added to a batch are sent to Configurator in a single
+ * request and applied in order with one commit on every Test Agent
+ * involved. Configurator synchronizes touched instances with Test Agents
+ * after the commits. If an operation, a commit or a synchronization
+ * fails, all the batch is rolled back.
+ *
+ * @code
+ * cfg_batch batch = CFG_BATCH_INIT;
+ *
+ * rc = cfg_batch_add_fmt(&batch, CFG_VAL(NONE, NULL),
+ *                        "/agent:%s/foo:bar", ta);
+ * if (rc == 0)
+ *     rc = cfg_batch_set_fmt(&batch, CFG_VAL(INT32, 1),
+ *                            "/agent:%s/foo:bar/baz:", ta);
+ * if (rc == 0)
+ *     rc = cfg_batch_commit(&batch);
+ * cfg_batch_free(&batch);
+ * @endcode
+ * @{
+ */
+
+/** Batch of configuration changes */
+typedef struct cfg_batch {
+    te_dbuf msg;        /**< Request with operation records */
+    te_vec  offsets;    /**< Offsets of operation records in @p msg */
+} cfg_batch;
+
+/** On-stack batch initializer */
+#define CFG_BATCH_INIT { \
+    .msg = TE_DBUF_INIT(0),             \
+    .offsets = TE_VEC_INIT(size_t),     \
+}
+
+/**
+ * Add creation of an object instance to the batch.
+ *
+ * Use macro CFG_VAL() to make the second and the third arguments pair.
+ *
+ * @param batch     batch of changes
+ * @param type      value type
+ * @param val       value to be assigned to the new instance
+ * @param oid_fmt   format string for the instance OID
+ * @param ...       format string arguments
+ *
+ * @return Status code (see te_errno.h)
+ */
+extern te_errno cfg_batch_add_fmt(cfg_batch *batch, cfg_val_type type,
+                                  const void *val, const char *oid_fmt, ...)
+                                  TE_LIKE_PRINTF(4, 5);
+
+/**
+ * Add change of an object instance value to the batch.
+ *
+ * The instance is looked up when the operation is applied, so it may
+ * be added by one of the previous operations of the batch.
+ *
+ * @param batch     batch of changes
+ * @param type      value type
+ * @param val       new value of the instance
+ * @param oid_fmt   format string for the instance OID
+ * @param ...       format string arguments
+ *
+ * @return Status code (see te_errno.h)
+ */
+extern te_errno cfg_batch_set_fmt(cfg_batch *batch, cfg_val_type type,
+                                  const void *val, const char *oid_fmt, ...)
+                                  TE_LIKE_PRINTF(4, 5);
+
+/**
+ * Add deletion of an object instance to the batch. Children of the
+ * instance are not deleted, so they should be deleted by previous
+ * operations of the batch.
+ *
+ * The instance is looked up when the operation is applied, so it may
+ * be added by one of the previous operations of the batch.
+ *
+ * @param batch     batch of changes
+ * @param oid_fmt   format string for the instance OID
+ * @param ...       format string arguments
+ *
+ * @return Status code (see te_errno.h)
+ */
+extern te_errno cfg_batch_del_fmt(cfg_batch *batch, const char *oid_fmt, ...)
+                                  TE_LIKE_PRINTF(2, 3);
+
+/**
+ * Apply all operations of the batch. Status of every operation
+ * may be obtained with cfg_batch_status() afterwards.
+ *
+ * @param batch     batch of changes
+ *
+ * @return Status code (see te_errno.h): status of the first failed
+ *         operation or commit if the batch is rolled back.
+ */
+extern te_errno cfg_batch_commit(cfg_batch *batch);
+
+/**
+ * Get status of an operation of the applied batch. Operations following
+ * the failed one are not applied and have @c TE_ECANCELED status.
+ *
+ * @param batch     batch of changes
+ * @param i         index of the operation in order of addition
+ * @param handle    location for handle of the added instance or @c NULL
+ *
+ * @return Status of the operation.
+ */
+extern te_errno cfg_batch_status(const cfg_batch *batch, unsigned int i,
+                                 cfg_handle *handle);
+
+/**
+ * Free resources of the batch. It may be filled again afterwards.
+ *
+ * @param batch     batch of changes
+ */
+extern void cfg_batch_free(cfg_batch *batch);
+
+/**@}*/
+
 /** @defgroup confapi_base_sync Synchronization configuration tree with Test Agent
  * @ingroup confapi_base
  * @{
@@ -98,7 +98,7 @@ te_errno
 cfg_ipc_mk_del(cfg_del_msg *msg, size_t msg_buf_size,
                cfg_handle handle, bool local)
 {
-    if (msg_buf_size < sizeof(cfg_get_msg))
+    if (msg_buf_size < sizeof(cfg_del_msg))
         return TE_RC(TE_CONF_API, TE_ESMALLBUF);
 
     memset(msg, 0, sizeof(cfg_del_msg));
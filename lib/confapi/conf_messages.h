@@ -32,6 +32,27 @@ cs_server_name(void)
 /** Configurator's server name */
 #define CONFIGURATOR_SERVER     cs_server_name()
 
+/**
+ * Name of the shared memory object where Configurator publishes
+ * the current generation of its database (@c uint32_t).
+ */
+static inline const char *
+cs_gen_shm_name(void)
+{
+    static char name[256];
+
+    if (name[0] == '\0')
+        snprintf(name, sizeof(name), "/%s_gen", cs_server_name());
+
+    return name;
+}
+
+/**
+ * Generation in replies which must not be cached (e.g. values of
+ * volatile objects). Valid generations are never equal to it.
+ */
+#define CFG_GEN_NONE            0
+
 /** Type of IPC used by Configurator */
 #define CONFIGURATOR_IPC        (true) /* Connection-oriented IPC */
 
@@ -71,6 +92,8 @@ enum {
     CFG_TREE_PRINT,/**< Print a tree of obj|ins from a prefix */
     CFG_PROCESS_HISTORY,/**< Process history configuration file
                              IN: file name, key-value pairs to substitute */
+    CFG_BATCH,     /**< Apply a batch of add, delete and set requests:
+                        IN: operations; OUT: status of every operation */
 };
 
 /* Set of generic fields of the Configurator message */
@@ -78,6 +101,8 @@ enum {
     uint8_t     type;    /**< Message type */                       \
     uint32_t    len;     /**< Length of the whole message */        \
     int         rc;      /**< OUT: errno defined in te_errno.h */   \
+    uint32_t    gen;     /**< OUT: generation of the database the   \
+                              reply is valid for or CFG_GEN_NONE */ \
 
 /** Generic Configurator message structure */
 typedef struct cfg_msg {
@@ -330,6 +355,38 @@ typedef struct cfg_process_history_msg {
     char    filename[0]; /**< IN: file name */
 } cfg_process_history_msg;
 
+/**
+ * Operation of CFG_BATCH message. It is followed by CFG_ADD, CFG_DEL
+ * or CFG_SET message and NUL-terminated OID of the instance to delete
+ * or to set which is used if the handle in the message is
+ * @c CFG_HANDLE_INVALID (empty string otherwise). Status of the
+ * operation and handle of the added instance are returned in the
+ * message.
+ */
+typedef struct cfg_batch_op {
+    uint32_t    len;        /**< Length of the operation record
+                                 (multiple of @ref CFG_BATCH_ALIGN) */
+    uint32_t    oid_offset; /**< Offset to OID from the record start */
+} cfg_batch_op;
+
+/** Alignment of operation records in CFG_BATCH message */
+#define CFG_BATCH_ALIGN     8
+
+/** Get the message of CFG_BATCH operation */
+#define CFG_BATCH_OP_MSG(_op) \
+    ((cfg_msg *)((uint8_t *)(_op) + sizeof(cfg_batch_op)))
+
+/** Get the OID of CFG_BATCH operation */
+#define CFG_BATCH_OP_OID(_op) \
+    ((char *)(_op) + (_op)->oid_offset)
+
+/** CFG_BATCH message content */
+typedef struct cfg_batch_msg {
+    CFG_MSG_FIELDS
+    uint32_t    n_ops;      /**< IN: number of operations */
+    uint64_t    ops[0];     /**< IN/OUT: operation records */
+} cfg_batch_msg;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
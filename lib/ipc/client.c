@@ -29,6 +29,9 @@
 #if HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif
+#if HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 #if HAVE_TIME_H
 #include <time.h>
 #endif
@@ -564,7 +567,6 @@ write_socket(int socket, const char *buffer, size_t len)
     return 0;
 }
 
-
 /* See description in ipc_client.h */
 int
 ipc_init_client(const char *name, bool conn,
@@ -1358,22 +1360,11 @@ ipc_stream_send_message(struct ipc_client *ipcc, const char *server_name,
 
     if (msg_len + 8 > IPC_TCP_CLIENT_BUFFER_SIZE)
     {
-        /* Message is too long to fit into the internal buffer */
-        size_t len = msg_len;
-
-        if (write_socket(server->stream.socket,
-                         (char *)&len, sizeof(len)) != 0)
-        {
-            /*
-             * Encountering EPIPE is part of normal operation
-             * for some TE components
-             */
-            if (errno != EPIPE)
-                perror("ipc_send_message(): write_socket()");
-            return TE_OS_RC(TE_IPC, errno);
-        }
-
-        return write_socket(server->stream.socket, msg, msg_len);
+        /*
+         * Message is too long to fit into the internal buffer,
+         * send it together with its length without copying.
+         */
+        return ipc_write_socket_msg(server->stream.socket, msg, msg_len, -1);
     }
     else
     {
@@ -10,13 +10,30 @@
 
 #include "te_config.h"
 
+#include <stdio.h>
 #if HAVE_STDLIB_H
 #include <stdlib.h>
 #endif
+#if HAVE_STRING_H
+#include <string.h>
+#endif
+#if HAVE_ERRNO_H
+#include <errno.h>
+#endif
 #if HAVE_ASSERT_H
 #include <assert.h>
 #endif
+#if HAVE_SYS_SOCKET_H
+#include <sys/socket.h>
+#endif
+#if HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
+#if HAVE_SYS_POLL_H
+#include <sys/poll.h>
+#endif
 
+#include "te_defs.h"
 #include "te_errno.h"
 
 #include "ipc_internal.h"
@@ -49,3 +66,71 @@ ipc_remember_datagram(struct ipc_datagrams *p_pool, void *data, size_t len,
 
     return 0;
 }
+
+/* See description in ipc_internal.h */
+int
+ipc_write_socket_msg(int socket, const void *msg, size_t msg_len,
+                     int timeout)
+{
+    size_t          len = msg_len;
+    struct iovec    iov[2];
+    struct msghdr   hdr;
+    struct iovec   *cur = iov;
+    size_t          n_iov = TE_ARRAY_LEN(iov);
+    int             flags = (timeout < 0) ? 0 : MSG_DONTWAIT;
+
+    iov[0].iov_base = &len;
+    iov[0].iov_len = sizeof(len);
+    iov[1].iov_base = (void *)msg;
+    iov[1].iov_len = msg_len;
+
+    while (n_iov > 0)
+    {
+        ssize_t r;
+
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.msg_iov = cur;
+        hdr.msg_iovlen = n_iov;
+
+        r = sendmsg(socket, &hdr, flags);
+        if (r < 0)
+        {
+            struct pollfd   pfd = { socket, POLLOUT, 0 };
+
+            if (errno == EINTR)
+                continue;
+
+            if (errno != EAGAIN || timeout < 0)
+            {
+                if (errno != EPIPE)
+                    perror("ipc_write_socket_msg(): sendmsg() error");
+                return TE_OS_RC(TE_IPC, errno);
+            }
+
+            r = poll(&pfd, 1, timeout);
+            if (r == 0)
+            {
+                /* Too long block - give up */
+                return TE_RC(TE_IPC, TE_ETIMEDOUT);
+            }
+            if (r < 0 && errno != EINTR)
+                return TE_OS_RC(TE_IPC, errno);
+            continue;
+        }
+
+        /* Skip completely sent parts and adjust partially sent one */
+        while (n_iov > 0 && (size_t)r >= cur->iov_len)
+        {
+            r -= cur->iov_len;
+            cur++;
+            n_iov--;
+        }
+        if (n_iov > 0)
+        {
+            cur->iov_base = (char *)cur->iov_base + r;
+            cur->iov_len -= r;
+        }
+    }
+
+    return 0;
+}
@@ -118,6 +118,25 @@ extern int ipc_remember_datagram(struct ipc_datagrams *p_pool,
                                  size_t addr_len);
 
 
+/**
+ * Write message length followed by the message to the connection
+ * with as few system calls as possible (not copying the message).
+ * Partial writes and interrupted system calls are resumed.
+ *
+ * @param socket    - connection socket
+ * @param msg       - message to send
+ * @param msg_len   - message length
+ * @param timeout   - maximum time to wait for the socket to become
+ *                    writable in milliseconds or negative to block
+ *
+ * @return Status code.
+ * @retval 0        - success
+ * @retval TE_ETIMEDOUT - the socket has not become writable in time
+ */
+extern int ipc_write_socket_msg(int socket, const void *msg,
+                                size_t msg_len, int timeout);
+
+
 /** @name
  * Sizes of the internal server/client buffers. It is used to avoid
  * duplicate writing to the TCP channel to increase performance. In the
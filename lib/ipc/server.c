@@ -35,6 +35,9 @@
 #if HAVE_SYS_SOCKET_H
 #include <sys/socket.h>
 #endif
+#if HAVE_SYS_UIO_H
+#include <sys/uio.h>
+#endif
 #if HAVE_SYS_POLL_H
 #include <sys/poll.h>
 #endif
@@ -964,14 +967,12 @@ ipc_stream_send_answer(struct ipc_server *ipcs,
 
     if ((msg_len + sizeof(len)) > IPC_TCP_SERVER_BUFFER_SIZE)
     {
-        /* Message is too long to fit into the internal buffer */
-
-        if (write_socket(ipcsc->stream.socket, &len, sizeof(len)) != 0)
-        {
-            return TE_OS_RC(TE_IPC, errno);
-        }
-
-        return write_socket(ipcsc->stream.socket, msg, msg_len);
+        /*
+         * Message is too long to fit into the internal buffer,
+         * send it together with its length without copying.
+         */
+        return ipc_write_socket_msg(ipcsc->stream.socket, msg, msg_len,
+                                    TE_SEC2MS(2));
     }
     else
     {
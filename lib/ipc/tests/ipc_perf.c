@@ -0,0 +1,224 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Test for IPC library.
+ *
+ * Measure request/answer latency and one-way throughput of
+ * connectionless (segmented datagrams) and connection-oriented
+ * (length-framed stream) IPC for messages of different sizes.
+ *
+ * Usage: ipc_perf [number of messages]
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+#include "te_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#include "te_defs.h"
+#include "te_errno.h"
+#include "te_sleep.h"
+#include "ipc_client.h"
+#include "ipc_server.h"
+
+/** Default number of messages sent in every measurement */
+#define IPC_PERF_N_MSGS     20000
+
+/** Maximum size of a message */
+#define IPC_PERF_MAX_SIZE   0x10000
+
+/** Message requesting an answer */
+#define IPC_PERF_REQ        'R'
+/** Message not requiring an answer */
+#define IPC_PERF_DATA       'D'
+/** Message stopping the server */
+#define IPC_PERF_QUIT       'Q'
+
+/** Sizes of messages to measure */
+static const size_t sizes[] = { 64, 512, 2000, 8192, IPC_PERF_MAX_SIZE };
+
+/* Serve requests until quit message is received */
+static int
+run_server(const char *name, bool conn)
+{
+    struct ipc_server *srv = NULL;
+    static char buf[IPC_PERF_MAX_SIZE];
+    int rc;
+
+    rc = ipc_register_server(name, conn, &srv);
+    if (rc != 0)
+    {
+        printf("Failed to register server '%s': %x\n", name, rc);
+        return 1;
+    }
+
+    while (true)
+    {
+        struct ipc_server_client *client = NULL;
+        size_t len = sizeof(buf);
+
+        rc = ipc_receive_message(srv, buf, &len, &client);
+        while (rc == TE_RC(TE_IPC, TE_ESMALLBUF))
+        {
+            /* Messages are not larger than the buffer, but be safe */
+            len = sizeof(buf);
+            rc = ipc_receive_message(srv, buf, &len, &client);
+        }
+        if (rc != 0)
+        {
+            printf("Failed to receive message: %x\n", rc);
+            break;
+        }
+
+        if (buf[0] == IPC_PERF_QUIT)
+            break;
+
+        if (buf[0] == IPC_PERF_REQ)
+        {
+            rc = ipc_send_answer(srv, client, buf, 1);
+            if (rc != 0)
+            {
+                printf("Failed to send answer: %x\n", rc);
+                break;
+            }
+        }
+    }
+
+    ipc_close_server(srv);
+
+    return rc == 0 ? 0 : 1;
+}
+
+/* Send a message requesting an answer and wait for the answer */
+static int
+request(struct ipc_client *client, const char *name, char *msg, size_t len)
+{
+    char answer[1];
+    size_t answer_len = sizeof(answer);
+
+    msg[0] = IPC_PERF_REQ;
+
+    return ipc_send_message_with_answer(client, name, msg, len,
+                                        answer, &answer_len);
+}
+
+/* Measure latency and throughput for one type of IPC */
+static int
+measure(const char *mode, bool conn, unsigned int n_msgs)
+{
+    static char msg[IPC_PERF_MAX_SIZE];
+    struct ipc_client *client = NULL;
+    char name[64];
+    struct timeval tv_start;
+    struct timeval tv_end;
+    pid_t pid;
+    int status;
+    unsigned int i;
+    unsigned int j;
+    int rc;
+
+    snprintf(name, sizeof(name), "ipc_perf_%s_%u", mode,
+             (unsigned int)getpid());
+    memset(msg, 'x', sizeof(msg));
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+        return -1;
+    if (pid == 0)
+        _exit(run_server(name, conn));
+
+    rc = ipc_init_client("ipc_perf_client", conn, &client);
+    if (rc != 0)
+    {
+        printf("Failed to initialize client: %x\n", rc);
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        return -1;
+    }
+
+    /* Make sure that the server is ready */
+    while (request(client, name, msg, 1) != 0)
+        te_msleep(10);
+
+    for (i = 0; i < TE_ARRAY_LEN(sizes) && rc == 0; i++)
+    {
+        size_t size = sizes[i];
+        double latency;
+        double throughput;
+
+        gettimeofday(&tv_start, NULL);
+        for (j = 0; j < n_msgs && rc == 0; j++)
+            rc = request(client, name, msg, size);
+        gettimeofday(&tv_end, NULL);
+        latency = (double)TIMEVAL_SUB(tv_end, tv_start) / n_msgs;
+
+        gettimeofday(&tv_start, NULL);
+        msg[0] = IPC_PERF_DATA;
+        for (j = 0; j < n_msgs && rc == 0; j++)
+            rc = ipc_send_message(client, name, msg, size);
+        /* Wait until the server gets all messages */
+        if (rc == 0)
+            rc = request(client, name, msg, 1);
+        gettimeofday(&tv_end, NULL);
+        throughput = (double)size * n_msgs /
+                     TIMEVAL_SUB(tv_end, tv_start);
+
+        if (rc != 0)
+        {
+            printf("Failed to exchange messages of %u bytes: %x\n",
+                   (unsigned int)size, rc);
+            break;
+        }
+
+        printf("%-10s %6u bytes: latency %7.1f us, "
+               "throughput %8.1f MB/s\n",
+               mode, (unsigned int)size, latency, throughput);
+    }
+
+    msg[0] = IPC_PERF_QUIT;
+    if (ipc_send_message(client, name, msg, 1) != 0)
+        kill(pid, SIGKILL);
+    ipc_close_client(client);
+
+    if (waitpid(pid, &status, 0) < 0 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+
+    return rc == 0 ? 0 : -1;
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned int n_msgs = IPC_PERF_N_MSGS;
+    int result = 0;
+
+    if (argc > 1)
+        n_msgs = strtoul(argv[1], NULL, 0);
+    if (n_msgs == 0)
+    {
+        printf("Wrong number of messages\n");
+        return 1;
+    }
+
+    if (ipc_init() != 0)
+    {
+        printf("Failed to initialize IPC\n");
+        return 1;
+    }
+
+    printf("IPC performance, %u messages of every size\n", n_msgs);
+    if (measure("datagram", false, n_msgs) != 0 ||
+        measure("stream", true, n_msgs) != 0)
+        result = 1;
+
+    ipc_kill();
+
+    return result;
+}
@@ -763,3 +763,20 @@ ta_log_get(uint32_t buf_length, uint8_t *transfer_buf)
 ret:
     return log_length;
 }
+
+/* See the description in logger_ta.h */
+te_errno
+ta_log_get_status(uint32_t *last_seqno, bool *pending)
+{
+    ta_log_lock_key key;
+
+    if (ta_log_lock(&key) != 0)
+        return TE_EAGAIN;
+
+    *last_seqno = log_sequence;
+    *pending = (LGR_RB_UNUSED(&log_buffer) != LGR_TOTAL_RB_EL);
+
+    (void)ta_log_unlock(&key);
+
+    return 0;
+}
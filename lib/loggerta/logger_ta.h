@@ -83,6 +83,22 @@ extern void ta_log_dynamic_user_ts(te_log_ts_sec sec, te_log_ts_usec usec,
  */
 extern uint32_t ta_log_get(uint32_t buf_length, uint8_t *transfer_buf);
 
+/**
+ * Get the status of the Test Agent local log buffer.
+ *
+ * The sequence number may be used by the log consumer as a barrier:
+ * all messages registered before the call have sequence numbers less
+ * than or equal to it.
+ *
+ * @param[out] last_seqno   Sequence number of the last registered message.
+ * @param[out] pending      Whether the log buffer has messages which
+ *                          have not been got yet.
+ *
+ * @return Status code (if the log buffer cannot be locked, the status
+ *         is unknown and the output parameters are not changed).
+ */
+extern te_errno ta_log_get_status(uint32_t *last_seqno, bool *pending);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif /* __cplusplus */
@@ -64,6 +64,16 @@ static pthread_mutex_t  lgr_lock = PTHREAD_MUTEX_INITIALIZER;
  */
 static struct ipc_client *lgr_client = NULL;
 
+/**
+ * Process which owns the Logger IPC client connection.
+ *
+ * A child process must not share the connection with its parent
+ * since their messages may interleave in the stream.
+ *
+ * @note It should be used under lgr_lock only.
+ */
+static pid_t lgr_client_pid = -1;
+
 /**
  * Logging output interface.
  *
@@ -106,6 +116,16 @@ ten_log_message(const char *file, unsigned int line,
     pthread_mutex_lock(&lgr_lock);
 #endif
 
+    if (lgr_client != NULL && lgr_client_pid != getpid())
+    {
+        /*
+         * The client is inherited from the parent process: close
+         * the copy of the connection and establish own one.
+         */
+        ipc_close_client(lgr_client);
+        lgr_client = NULL;
+    }
+
     if (lgr_client == NULL)
     {
         int  rc;
@@ -125,14 +145,19 @@ ten_log_message(const char *file, unsigned int line,
             return;
         }
         assert(lgr_client != NULL);
-        te_log_message_tx = log_message_ipc;
-        atexit(log_client_close);
-
-        /* Initialize backend */
-        lgr_out.common = te_log_msg_out_raw;
-        lgr_out.buf = lgr_out.end = NULL;
-        lgr_out.args_max = 0;
-        lgr_out.args = NULL;
+
+        if (lgr_client_pid == -1)
+        {
+            te_log_message_tx = log_message_ipc;
+            atexit(log_client_close);
+
+            /* Initialize backend */
+            lgr_out.common = te_log_msg_out_raw;
+            lgr_out.buf = lgr_out.end = NULL;
+            lgr_out.args_max = 0;
+            lgr_out.args = NULL;
+        }
+        lgr_client_pid = getpid();
     }
 
     log_message_va(&lgr_out, file, line, sec, usec, level, entity, user,
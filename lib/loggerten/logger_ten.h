@@ -49,7 +49,7 @@ logger_server_name(void)
 #define LGR_SRV_NAME            (logger_server_name())
 
 /** Type of IPC used for Logger TEN API <-> Logger server */
-#define LOGGER_IPC              (false) /* Connectionless IPC */
+#define LOGGER_IPC              (true) /* Connection-oriented IPC */
 
 
 /** Discover name of the Logger client for TA */
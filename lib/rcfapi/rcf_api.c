@@ -1228,6 +1228,110 @@ rcf_ta_cfg_get(const char *ta_name, int session, const char *oid,
     return 0;
 }
 
+/**
+ * Read a field of a configuration tree record.
+ *
+ * @param pos           location of the current position in records
+ * @param end           end of records
+ * @param str           location for the field (allocated)
+ *
+ * @return Status code.
+ */
+static te_errno
+cfg_tree_read_field(const uint8_t **pos, const uint8_t *end, char **str)
+{
+    uint32_t len;
+
+    if (end - *pos < (ptrdiff_t)sizeof(len))
+        return TE_RC(TE_RCF_API, TE_EFMT);
+
+    memcpy(&len, *pos, sizeof(len));
+    len = ntohl(len);
+    *pos += sizeof(len);
+
+    if (len == RCF_CFG_TREE_NO_VALUE)
+    {
+        *str = NULL;
+        return 0;
+    }
+    if ((size_t)(end - *pos) < len)
+        return TE_RC(TE_RCF_API, TE_EFMT);
+
+    *str = TE_ALLOC(len + 1);
+    memcpy(*str, *pos, len);
+    *pos += len;
+
+    return 0;
+}
+
+/* See description in rcf_api.h */
+te_errno
+rcf_ta_cfg_get_tree(const char *ta_name, int session, const char *oid,
+                    rcf_ta_cfg_tree_cb *cb, void *opaque)
+{
+    rcf_msg     msg;
+    rcf_msg    *ans;
+    size_t      anslen;
+    int         next = 0;
+    te_errno    rc;
+
+    RCF_API_INIT;
+
+    if (oid == NULL || cb == NULL || strlen(oid) >= RCF_MAX_ID || BAD_TA)
+        return TE_RC(TE_RCF_API, TE_EINVAL);
+
+    do {
+        const uint8_t *pos;
+        const uint8_t *end;
+
+        memset(&msg, 0, sizeof(msg));
+        te_strlcpy(msg.id, oid, sizeof(msg.id));
+        te_strlcpy(msg.ta, ta_name, sizeof(msg.ta));
+        msg.opcode = RCFOP_CONFGET_TREE;
+        msg.sid = session;
+        msg.intparm = next;
+
+        ans = NULL;
+        anslen = sizeof(msg);
+        rc = send_recv_rcf_ipc_message(ctx_handle, &msg, sizeof(msg),
+                                       &msg, &anslen, &ans);
+        if (rc != 0)
+            return rc;
+
+        if (ans == NULL)
+            ans = &msg;
+
+        if ((rc = ans->error) == 0)
+        {
+            next = atoi(ans->value);
+
+            pos = (const uint8_t *)ans->data;
+            end = pos + ans->data_len;
+            while (rc == 0 && pos < end)
+            {
+                char *inst_oid = NULL;
+                char *value = NULL;
+
+                rc = cfg_tree_read_field(&pos, end, &inst_oid);
+                if (rc == 0 && inst_oid == NULL)
+                    rc = TE_RC(TE_RCF_API, TE_EFMT);
+                if (rc == 0)
+                    rc = cfg_tree_read_field(&pos, end, &value);
+                if (rc == 0)
+                    rc = cb(inst_oid, value, opaque);
+
+                free(inst_oid);
+                free(value);
+            }
+        }
+
+        if (ans != &msg)
+            free(ans);
+    } while (rc == 0 && next > 0);
+
+    return rc;
+}
+
 /**
  * Implementation of rcf_ta_cfg_set and rcf_ta_cfg_add functionality -
  * see description of these functions for details.
@@ -1367,22 +1471,27 @@ rcf_ta_cfg_group(const char *ta_name, int session, bool is_start)
 /* See description in rcf_api.h */
 te_errno
 rcf_get_sniffer_dump(const char *ta_name, const char *snif_id,
-                     char *fname, unsigned long long *offset)
+                     char *fname, unsigned long long *offset,
+                     bool compress, bool *compressed)
 {
     rcf_msg     msg;
     te_errno    rc;
     size_t      anslen = sizeof(msg);
+    char       *end;
 
     RCF_API_INIT;
 
     if (BAD_TA || fname == NULL || strlen(fname) == 0 ||
-        snif_id == NULL || strlen(snif_id) >= RCF_MAX_VAL)
+        snif_id == NULL || strlen(snif_id) >= RCF_MAX_VAL ||
+        compressed == NULL)
         return TE_RC(TE_RCF_API, TE_EINVAL);
 
     memset(&msg, 0, sizeof(msg));
 
     te_strlcpy(msg.ta, ta_name, sizeof(msg.ta));
-    te_strlcpy(msg.id, snif_id, sizeof(msg.id));
+    if (te_snprintf(msg.id, sizeof(msg.id), "%s%s", snif_id,
+                    compress ? " gzip" : "") != 0)
+        return TE_RC(TE_RCF_API, TE_EINVAL);
 
     msg.opcode = RCFOP_GET_SNIF_DUMP;
     msg.sid = RCF_TA_GET_LOG_SID;
@@ -1396,7 +1505,10 @@ rcf_get_sniffer_dump(const char *ta_name, const char *snif_id,
         te_strlcpy(fname, msg.file, RCF_MAX_PATH);
         if (strlen(msg.value) == 0)
             return TE_RC(TE_RCF_API, TE_ENODATA);
-        *offset = strtoll(msg.value, NULL, 10);
+        *offset = strtoull(msg.value, &end, 10);
+        while (*end == ' ')
+            end++;
+        *compressed = (strcmp(end, "gzip") == 0);
     }
     return rc;
 }
@@ -1483,6 +1595,88 @@ rcf_ta_get_log(const char *ta_name, char *log_file)
     return rc;
 }
 
+/**
+ * Parse the Test Agent log buffer status reported in the answer
+ * to RCFOP_GET_LOG command.
+ *
+ * @param str       status string ("<last seqno> <pending>")
+ * @param status    location for the parsed status
+ */
+static void
+parse_ta_log_status(const char *str, rcf_ta_log_status *status)
+{
+    char          *end;
+    unsigned long  seqno;
+    unsigned long  pending;
+
+    memset(status, 0, sizeof(*status));
+
+    seqno = strtoul(str, &end, 10);
+    if (end == str || *end != ' ')
+        return;
+
+    str = end;
+    pending = strtoul(str, &end, 10);
+    if (end == str)
+        return;
+
+    status->valid = true;
+    status->last_seqno = seqno;
+    status->pending = (pending != 0);
+}
+
+/* See description in rcf_api.h */
+te_errno
+rcf_ta_get_log_data(const char *ta_name, uint8_t **buf, size_t *len,
+                    rcf_ta_log_status *status)
+{
+    rcf_msg     msg;
+    rcf_msg    *ans = NULL;
+    size_t      anslen = sizeof(msg);
+    te_errno    rc;
+
+    RCF_API_INIT;
+
+    if (BAD_TA)
+        return TE_RC(TE_RCF_API, TE_EINVAL);
+
+    if (buf == NULL || len == NULL)
+        return TE_RC(TE_RCF_API, TE_EWRONGPTR);
+
+    memset(&msg, 0, sizeof(msg));
+    te_strlcpy(msg.ta, ta_name, sizeof(msg.ta));
+    msg.opcode = RCFOP_GET_LOG;
+    msg.sid = RCF_TA_GET_LOG_SID;
+    msg.intparm = RCF_GET_LOG_INLINE;
+
+    rc = send_recv_rcf_ipc_message(ctx_handle, &msg, sizeof(msg),
+                                   &msg, &anslen, &ans);
+    if (rc != 0)
+        return rc;
+
+    if (ans == NULL)
+    {
+        /* Log bulk is always larger than the message itself */
+        if ((rc = msg.error) == 0)
+            rc = TE_RC(TE_RCF_API, TE_ENOENT);
+        return rc;
+    }
+
+    if ((rc = ans->error) == 0)
+    {
+        *buf = TE_ALLOC(ans->data_len);
+        memcpy(*buf, ans->data, ans->data_len);
+        *len = ans->data_len;
+
+        if (status != NULL)
+            parse_ta_log_status(ans->value, status);
+    }
+
+    free(ans);
+
+    return rc;
+}
+
 /* See description in rcf_api.h */
 te_errno
 rcf_ta_get_var(const char *ta_name, int session, const char *var_name,
@@ -2046,6 +2240,8 @@ rcf_ta_trrecv_start(const char *ta_name, int session,
 
     msg.intparm |= (mode & RCF_TRRECV_SEQ_MATCH) ? TR_SEQ_MATCH : 0;
     msg.intparm |= (mode & RCF_TRRECV_MISMATCH) ? TR_MISMATCH : 0;
+    if (msg.intparm & TR_RESULTS)
+        msg.intparm |= (mode & RCF_TRRECV_BINARY) ? TR_BINARY : 0;
     msg.sid = session;
     msg.num = num;
     msg.timeout = timeout;
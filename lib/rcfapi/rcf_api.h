@@ -65,6 +65,9 @@ typedef enum rcf_trrecv_mode {
     RCF_TRRECV_SEQ_MATCH = 0x04,   /**< Pattern sequence matching */
     RCF_TRRECV_MISMATCH = 0x08,    /**< Store mismatch packets
                                         to get from test later */
+    RCF_TRRECV_BINARY = 0x10,      /**< Report stored packets as binary
+                                        records (see tad_bin_pkt_hdr)
+                                        instead of ASN.1 text */
 } rcf_trrecv_mode;
 
 /**
@@ -317,6 +320,48 @@ extern te_errno rcf_ta_cfg_get(const char *ta_name, int session,
                                const char *oid,
                                char *val_buf, size_t len);
 
+/**
+ * Callback for object instances got by rcf_ta_cfg_get_tree().
+ *
+ * @param oid           object instance identifier
+ * @param value         object instance value or @c NULL if the object
+ *                      has no value on the Test Agent
+ * @param opaque        opaque data passed to rcf_ta_cfg_get_tree()
+ *
+ * @return Status code (non-zero stops processing)
+ */
+typedef te_errno rcf_ta_cfg_tree_cb(const char *oid, const char *value,
+                                    void *opaque);
+
+/**
+ * This function is used to obtain all object instances matching
+ * a wildcard identifier together with their values using as few
+ * round trips to the Test Agent as possible (large trees are got
+ * in chunks). The function may be called by Configurator only.
+ *
+ * @param ta_name       Test Agent name
+ * @param session       TA session or 0
+ * @param oid           wildcard object instance identifier
+ *                      (e.g. "/agent:Agt_A/...")
+ * @param cb            callback to be called for every instance
+ * @param opaque        opaque data to be passed to @p cb
+ *
+ * @return error code
+ *
+ * @retval 0                success
+ * @retval TE_EINVAL        name of non-running TN Test Agent or
+ *                          non-existent session identifier is provided
+ *                          or OID string is too long
+ * @retval TE_EIPC          cannot interact with RCF
+ * @retval TE_EFMT          the Test Agent does not support the command
+ * @retval TE_ETAREBOOTED   Test Agent is rebooted
+ * @retval other            error returned by command handler on the TA
+ *                          or by @p cb
+ */
+extern te_errno rcf_ta_cfg_get_tree(const char *ta_name, int session,
+                                    const char *oid,
+                                    rcf_ta_cfg_tree_cb *cb, void *opaque);
+
 /**
  * This function is used to change value of object instance.
  * The function may be called by Configurator only.
@@ -411,6 +456,13 @@ extern te_errno rcf_ta_cfg_group(const char *ta_name, int session,
  * @param snif_id       The sniffer ID
  * @param fname         File name for the capture logs (IN/OUT)
  * @param offset        The absolute offset of the received part of capture.
+ * @param compress      Ask the Test Agent to compress the capture data
+ *                      with gzip
+ * @param compressed    Location for the flag whether the received data
+ *                      are compressed (agents which do not support
+ *                      compression ignore the request)
+ *
+ * Only the data captured since the previous call are passed.
  *
  * @return Status code
  *
@@ -424,7 +476,8 @@ extern te_errno rcf_ta_cfg_group(const char *ta_name, int session,
  */
 extern te_errno rcf_get_sniffer_dump(const char *ta_name,
                                      const char *snif_id, char *fname,
-                                     unsigned long long *offset);
+                                     unsigned long long *offset,
+                                     bool compress, bool *compressed);
 
 /**
  * This function is used to get list of sniffers from the Test Agent.
@@ -478,6 +531,42 @@ extern te_errno rcf_ta_get_sniffers(const char *ta_name,
  */
 extern te_errno rcf_ta_get_log(const char *ta_name, char *log_file);
 
+/** Status of the Test Agent log buffer reported along with log bulk */
+typedef struct rcf_ta_log_status {
+    bool        valid;          /**< Whether the status is reported
+                                     by the Test Agent (old agents do
+                                     not report it) */
+    uint32_t    last_seqno;     /**< Sequence number of the last message
+                                     registered on the Test Agent */
+    bool        pending;        /**< Whether some messages are left in
+                                     the Test Agent log buffer */
+} rcf_ta_log_status;
+
+/**
+ * This function is used to get bulk of log from the Test Agent
+ * directly into memory, without an intermediate local file.
+ * The function may be called by Logger only.
+ *
+ * @param ta_name       Test Agent name
+ * @param buf           location for the log bulk (allocated by the
+ *                      function, the caller is responsible to free it)
+ * @param len           location for the log bulk length
+ * @param status        location for the Test Agent log buffer status
+ *                      (may be @c NULL)
+ *
+ * @return error code
+ *
+ * @retval 0                success
+ * @retval TE_EINVAL        name of non-running TN Test Agent is provided
+ * @retval TE_EIPC          cannot interact with RCF
+ * @retval TE_ETAREBOOTED   Test Agent is rebooted
+ * @retval TE_ENOENT        no log messages
+ * @retval other            error returned by command handler on the TA
+ */
+extern te_errno rcf_ta_get_log_data(const char *ta_name, uint8_t **buf,
+                                    size_t *len,
+                                    rcf_ta_log_status *status);
+
 /**
  * This function is used to obtain value of the variable from the Test Agent
  * or NUT served by it.
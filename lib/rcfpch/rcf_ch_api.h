@@ -191,6 +191,9 @@ typedef enum {
     RCF_CH_CFG_DEL,
     RCF_CH_CFG_GRP_START,
     RCF_CH_CFG_GRP_END,
+    RCF_CH_CFG_GET_TREE,    /**< Get values of all instances matching
+                                 wildcard OID, value is the number
+                                 of instances to skip */
 } rcf_ch_cfg_op_t;
 
 /**
@@ -485,6 +488,9 @@ typedef enum rcf_ch_trrecv_flags {
                                               matching */
     RCF_CH_TRRECV_MISMATCH = 8,          /**< Store mismatch packets
                                               to get from test later */
+    RCF_CH_TRRECV_PACKETS_BINARY = 16,   /**< Report packets as binary
+                                              records (see
+                                              tad_bin_pkt_hdr) */
 } rcf_ch_trrecv_flags;
 
 /**
@@ -345,6 +345,8 @@ get_opcode(char **ptr, rcf_op_t *opcode)
 
     TRY_CMD(SHUTDOWN);
     TRY_CMD(REBOOT);
+    /* Must go before CONFGET since it is a prefix */
+    TRY_CMD(CONFGET_TREE);
     TRY_CMD(CONFGET);
     TRY_CMD(CONFSET);
     TRY_CMD(CONFADD);
@@ -383,6 +385,13 @@ get_opcode(char **ptr, rcf_op_t *opcode)
 /**
  * Transmit log to the Test Engine.
  *
+ * The answer carries the sequence number of the last registered
+ * message and the flag whether some messages are still pending in
+ * the local log buffer, so that Logger may drain the buffer without
+ * waiting for the next polling period and use the sequence number
+ * as a flush barrier. The status is not reported if there are no
+ * messages or the log buffer cannot be locked to get it.
+ *
  * @param cbuf          command buffer
  * @param conn          connection handle
  * @param answer_plen   number of bytes to be copied from the command
@@ -397,13 +406,28 @@ transmit_log(struct rcf_comm_connection *conn, char *cbuf,
     size_t      len;
     te_errno    rc;
     int         ret;
+    uint32_t    last_seqno;
+    bool        pending;
 
     len = ta_log_get(sizeof(log_data), log_data);
 
-    ret = snprintf(cbuf + answer_plen, buflen - answer_plen,
-                   (len == 0) ? "%u" : "0 attach %u",
-                   (len == 0) ? (unsigned)TE_RC(TE_RCF_PCH, TE_ENOENT) :
-                                (unsigned)len);
+    if (len == 0)
+    {
+        ret = snprintf(cbuf + answer_plen, buflen - answer_plen, "%u",
+                       (unsigned)TE_RC(TE_RCF_PCH, TE_ENOENT));
+    }
+    else if (ta_log_get_status(&last_seqno, &pending) != 0)
+    {
+        /* Status is unknown, Logger polls again and gets it */
+        ret = snprintf(cbuf + answer_plen, buflen - answer_plen,
+                       "0 attach %u", (unsigned)len);
+    }
+    else
+    {
+        ret = snprintf(cbuf + answer_plen, buflen - answer_plen,
+                       "0 %u %u attach %u", (unsigned)last_seqno,
+                       pending ? 1 : 0, (unsigned)len);
+    }
     if ((size_t)ret >= (buflen - answer_plen))
     {
         ERROR("Command buffer too small");
@@ -656,6 +680,30 @@ rcf_pch_run(const char *confstr, const char *info)
                 break;
             }
 
+            case RCFOP_CONFGET_TREE:
+            {
+                char *oid;
+                char *skip;
+
+                if (*ptr == 0 || ba != NULL ||
+                    transform_str(&ptr, &oid) != 0 ||
+                    transform_str(&ptr, &skip) != 0 || *ptr != 0)
+                    goto bad_protocol;
+
+                rc = rcf_ch_configure(conn, cmd, cmd_buf_len, answer_plen,
+                                      ba, len, RCF_CH_CFG_GET_TREE,
+                                      oid, skip);
+
+                if (rc < 0)
+                    rc = rcf_pch_configure(conn, cmd, cmd_buf_len,
+                                           answer_plen, ba, len,
+                                           RCF_CH_CFG_GET_TREE, oid, skip);
+
+                if (rc != 0)
+                    goto communication_problem;
+                break;
+            }
+
             case RCFOP_CONFGET:
             case RCFOP_CONFSET:
             case RCFOP_CONFADD:
@@ -1069,6 +1117,12 @@ rcf_pch_run(const char *confstr, const char *info)
                         ptr += strlen("no-payload");
                         SKIP_SPACES(ptr);
                     }
+                    if (strncmp(ptr, "binary", strlen("binary")) == 0)
+                    {
+                        mode |= RCF_CH_TRRECV_PACKETS_BINARY;
+                        ptr += strlen("binary");
+                        SKIP_SPACES(ptr);
+                    }
                 }
 
                 if (strncmp(ptr, "seq-match", strlen("seq-match")) == 0)
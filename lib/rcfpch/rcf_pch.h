@@ -151,6 +151,19 @@ extern int rcf_pch_configure(struct rcf_comm_connection *conn,
 extern te_errno rcf_pch_agent_list(unsigned int gid, const char *oid,
                                    const char *sub_id, char **list);
 
+/**
+ * Get identifier of the current configuration snapshot.
+ *
+ * A snapshot lasts while a subtree or wildcard get request is processed
+ * or, inside a configuration group, between changes. Accessors may
+ * cache system state obtained within one snapshot and reuse it until
+ * the identifier changes.
+ *
+ * @return Snapshot identifier or @c 0 if nothing should be cached
+ *         (out of groups or while a change is being made).
+ */
+extern unsigned int rcf_pch_cfg_snapshot(void);
+
 /**
  * Default file processing handler.
  *
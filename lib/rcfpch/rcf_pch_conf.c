@@ -74,8 +74,10 @@
 
 /** Structure for temporary storing of instances/objects identifiers */
 typedef struct olist {
-    struct olist *next;             /**< Pointer to the next element */
-    char          oid[CFG_OID_MAX]; /**< Element OID */
+    struct olist       *next;             /**< Pointer to the next
+                                               element */
+    rcf_pch_cfg_object *obj;              /**< Object of the element */
+    char                oid[CFG_OID_MAX]; /**< Element OID */
 } olist;
 
 /** Postponed configuration commit operation */
@@ -91,10 +93,32 @@ static TAILQ_HEAD(rcf_pch_commit_head_t, rcf_pch_commit_op_t)   commits;
 static bool is_group = false;       /**< Is group started? */
 static unsigned int gid;                    /**< Group identifier */
 
+static unsigned int snapshot = 0;       /**< Current snapshot or 0 */
+static unsigned int snapshot_seq = 0;   /**< Last started snapshot */
+
 
 /** Test Agent root node */
 RCF_PCH_CFG_NODE_AGENT(node_agent);
 
+/**
+ * Start a new configuration snapshot making everything cached by
+ * accessors in the previous one obsolete.
+ */
+static void
+snapshot_start(void)
+{
+    if (++snapshot_seq == 0)
+        snapshot_seq++;
+    snapshot = snapshot_seq;
+}
+
+/* See description in rcf_pch.h */
+unsigned int
+rcf_pch_cfg_snapshot(void)
+{
+    return snapshot;
+}
+
 /**
  * Get root of the tree of supported objects.
  *
@@ -371,6 +395,7 @@ create_wildcard_inst_list(rcf_pch_cfg_object *obj, char *parsed, char *oid,
                 new_entry = TE_ALLOC(sizeof(olist));
 
                 strcpy(new_entry->oid, tmp_parsed);
+                new_entry->obj = obj;
 
                 new_entry->next = *list;
                 *list = new_entry;
@@ -468,6 +493,7 @@ create_wildcard_obj_list(rcf_pch_cfg_object *obj, char *parsed, char *oid,
             new_entry = TE_ALLOC(sizeof(olist));
 
             strcpy(new_entry->oid, tmp_parsed);
+            new_entry->obj = obj;
             new_entry->next = *list;
             *list = new_entry;
         }
@@ -943,6 +969,300 @@ out:
     return rc;
 }
 
+/**
+ * Append a big-endian 32-bit length of a configuration tree record
+ * field.
+ *
+ * @param buf       buffer with records
+ * @param len       length to append
+ */
+static void
+append_tree_len(te_string *buf, uint32_t len)
+{
+    const char bytes[] = { (char)(len >> 24), (char)(len >> 16),
+                           (char)(len >> 8), (char)len };
+
+    te_string_append_buf(buf, bytes, sizeof(bytes));
+}
+
+/**
+ * Get the value of an object instance for a configuration tree request
+ * applying substitutions if any.
+ *
+ * @param obj       object of the instance
+ * @param oid       object instance identifier
+ * @param value     location for the value (RCF_MAX_VAL bytes)
+ *
+ * @return Status code
+ */
+static te_errno
+get_tree_value(rcf_pch_cfg_object *obj, const char *oid, char *value)
+{
+    char *inst_names[RCF_MAX_PARAMS] = {NULL,};
+    cfg_oid *p_oid;
+    cfg_inst_subid *p_ids;
+    unsigned int i;
+    te_errno rc;
+
+    p_oid = cfg_convert_oid_str(oid);
+    if (p_oid == NULL)
+        return TE_EFMT;
+
+    /* Skip empty root and agent name as rcf_pch_configure() does */
+    p_ids = (cfg_inst_subid *)(p_oid->ids);
+    for (i = 2; i < p_oid->len && i - 2 < RCF_MAX_PARAMS; i++)
+        inst_names[i - 2] = p_ids[i].name;
+
+    value[0] = '\0';
+    rc = (obj->get)(gid, oid, value, inst_names[0], inst_names[1],
+                    inst_names[2], inst_names[3], inst_names[4],
+                    inst_names[5], inst_names[6], inst_names[7],
+                    inst_names[8], inst_names[9]);
+    if (rc == 0 && obj->subst != NULL && p_oid->len >= 3)
+        rc = do_substitutions(obj, value, inst_names[p_oid->len - 3], p_ids);
+
+    cfg_free_oid(p_oid);
+    return rc;
+}
+
+/**
+ * State of configure get tree request which is answered in chunks.
+ * All the records are collected when the first chunk is requested,
+ * so that the tree is listed and read once and the chunks are
+ * consistent with each other.
+ */
+typedef struct get_tree_cursor {
+    char        oid[CFG_OID_MAX];   /**< Wildcard OID of the request or
+                                         empty string if there is no
+                                         request in progress */
+    te_string   records;            /**< All the records */
+    size_t      pos;                /**< Offset of the next chunk */
+    unsigned long next;             /**< Number of records before the
+                                         next chunk */
+} get_tree_cursor;
+
+/** The configure get tree request in progress */
+static get_tree_cursor tree_cursor = { .records = TE_STRING_INIT };
+
+/** Forget the configure get tree request in progress */
+static void
+get_tree_cursor_reset(void)
+{
+    tree_cursor.oid[0] = '\0';
+    te_string_free(&tree_cursor.records);
+    tree_cursor.pos = 0;
+    tree_cursor.next = 0;
+}
+
+/**
+ * Get a big-endian 32-bit length of a configuration tree record field.
+ *
+ * @param pos       position of the length in records
+ *
+ * @return The length.
+ */
+static uint32_t
+get_tree_len(const char *pos)
+{
+    const uint8_t *bytes = (const uint8_t *)pos;
+
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) |
+           ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+/**
+ * Start configure get tree request: list all object instances matching
+ * a wildcard identifier and collect records with their values.
+ *
+ * @param oid       wildcard instance identifier
+ *
+ * @return Status code
+ */
+static te_errno
+get_tree_cursor_start(const char *oid)
+{
+    char       copy[CFG_OID_MAX];
+    char       value[RCF_MAX_VAL];
+    olist     *list = NULL;
+    olist     *tmp;
+    te_errno   rc;
+
+    get_tree_cursor_reset();
+
+    strcpy(copy, oid);
+    rc = create_wildcard_inst_list(rcf_pch_conf_root(), NULL, copy, oid,
+                                   &list);
+    if (rc != 0)
+        return rc;
+
+    for (tmp = list; tmp != NULL; tmp = tmp->next)
+    {
+        bool has_value = (tmp->obj->get != NULL);
+
+        if (has_value)
+        {
+            rc = get_tree_value(tmp->obj, tmp->oid, value);
+            /* Instance may disappear after listing */
+            if (TE_RC_GET_ERROR(rc) == TE_ENOENT)
+            {
+                rc = 0;
+                continue;
+            }
+            if (rc != 0)
+            {
+                ERROR("Failed to get value for '%s' rc=%r", tmp->oid, rc);
+                break;
+            }
+        }
+
+        append_tree_len(&tree_cursor.records, strlen(tmp->oid));
+        te_string_append_buf(&tree_cursor.records, tmp->oid,
+                             strlen(tmp->oid));
+        if (has_value)
+        {
+            append_tree_len(&tree_cursor.records, strlen(value));
+            te_string_append_buf(&tree_cursor.records, value,
+                                 strlen(value));
+        }
+        else
+        {
+            append_tree_len(&tree_cursor.records, RCF_CFG_TREE_NO_VALUE);
+        }
+    }
+    free_list(list);
+
+    if (rc != 0)
+    {
+        get_tree_cursor_reset();
+        return rc;
+    }
+
+    strcpy(tree_cursor.oid, oid);
+
+    return 0;
+}
+
+/**
+ * Process configure get tree request: get all object instances
+ * matching a wildcard identifier together with their values.
+ * Instances are reported in chunks of at most RCF_CFG_TREE_CHUNK
+ * records, see rcf_internal.h for the format. The records are
+ * collected on the first request and the following chunks are
+ * taken from them. The answer contains the number of records
+ * returned so far to get the next chunk or zero if there are no
+ * more instances.
+ *
+ * @param conn            connection handle
+ * @param cbuf            command buffer
+ * @param buflen          length of the command buffer
+ * @param answer_plen     number of bytes in the command buffer
+ *                        to be copied to the answer
+ * @param oid             wildcard instance identifier
+ * @param skip_str        position returned in the answer to the
+ *                        previous chunk request or zero to start
+ *
+ * @return 0 or error returned by communication library
+ */
+static te_errno
+process_get_tree(struct rcf_comm_connection *conn, char *cbuf,
+                 size_t buflen, size_t answer_plen, const char *oid,
+                 const char *skip_str)
+{
+    const char    *chunk;
+    size_t         chunk_len;
+    size_t         end_pos;
+    unsigned int   n_records;
+    unsigned long  skip;
+    unsigned long  next;
+    char          *end;
+    te_errno       rc;
+
+    ENTRY("OID='%s' skip=%s", oid, skip_str);
+
+    skip = strtoul(skip_str, &end, 10);
+    if (*skip_str == '\0' || *end != '\0' || strchr(oid, ':') == NULL ||
+        strlen(oid) >= sizeof(tree_cursor.oid))
+    {
+        ERROR("Invalid configure get tree request: '%s' '%s'",
+              oid, skip_str);
+        SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, TE_EINVAL));
+    }
+
+    if (skip == 0)
+    {
+        if (!is_group)
+            ++gid;
+
+        rc = get_tree_cursor_start(oid);
+        if (rc != 0)
+            SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, rc));
+    }
+    else if (skip != tree_cursor.next || strcmp(oid, tree_cursor.oid) != 0)
+    {
+        ERROR("Configure get tree request '%s' at %lu does not continue "
+              "the request in progress", oid, skip);
+        SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, TE_ESTALE));
+    }
+
+    end_pos = tree_cursor.pos;
+    for (n_records = 0;
+         n_records < RCF_CFG_TREE_CHUNK &&
+         end_pos < tree_cursor.records.len;
+         n_records++)
+    {
+        uint32_t len;
+
+        /* OID and value (if any) with their lengths */
+        end_pos += sizeof(len) + get_tree_len(tree_cursor.records.ptr +
+                                               end_pos);
+        len = get_tree_len(tree_cursor.records.ptr + end_pos);
+        end_pos += sizeof(len);
+        if (len != RCF_CFG_TREE_NO_VALUE)
+            end_pos += len;
+    }
+    chunk_len = end_pos - tree_cursor.pos;
+
+    if (chunk_len == 0)
+    {
+        get_tree_cursor_reset();
+        SEND_ANSWER("0 0");
+    }
+    chunk = tree_cursor.records.ptr + tree_cursor.pos;
+
+    if (end_pos < tree_cursor.records.len)
+    {
+        tree_cursor.pos = end_pos;
+        tree_cursor.next += n_records;
+        next = tree_cursor.next;
+    }
+    else
+    {
+        next = 0;
+    }
+
+    if ((size_t)snprintf(cbuf + answer_plen, buflen - answer_plen,
+                         "0 %lu attach %u", next,
+                         (unsigned int)chunk_len) >=
+            (buflen - answer_plen))
+    {
+        get_tree_cursor_reset();
+        ERROR("Command buffer too small for reply");
+        SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, TE_E2BIG));
+    }
+
+    RCF_CH_LOCK;
+    rc = rcf_comm_agent_reply(conn, cbuf, strlen(cbuf) + 1);
+    if (rc == 0)
+        rc = rcf_comm_agent_reply(conn, chunk, chunk_len);
+    RCF_CH_UNLOCK;
+
+    if (next == 0 || rc != 0)
+        get_tree_cursor_reset();
+
+    EXIT("%r", rc);
+    return rc;
+}
+
 /* See description in rcf_pch.h */
 int
 rcf_pch_configure(struct rcf_comm_connection *conn,
@@ -974,6 +1294,25 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
                                         (val == NULL) ? "NULL" : val);
     VERB("Default configuration handler is executed");
 
+    if (op == RCF_CH_CFG_GET_TREE)
+    {
+        if (!is_group)
+            snapshot_start();
+        rc = process_get_tree(conn, cbuf, buflen, answer_plen, oid, val);
+        if (!is_group)
+            snapshot = 0;
+        EXIT("%r", rc);
+        return rc;
+    }
+
+    /*
+     * Accessors must see the actual state while changes are made,
+     * the next snapshot of a group is started when the change is done.
+     */
+    if (op == RCF_CH_CFG_SET || op == RCF_CH_CFG_ADD ||
+        op == RCF_CH_CFG_DEL)
+        snapshot = 0;
+
     if (oid != 0)
     {
         /* Now parse the oid and look for the object */
@@ -985,7 +1324,11 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
                 SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, TE_EINVAL));
             }
 
+            if (!is_group)
+                snapshot_start();
             rc = process_wildcard(conn, cbuf, buflen, answer_plen, oid);
+            if (!is_group)
+                snapshot = 0;
 
             EXIT("%r", rc);
 
@@ -1069,12 +1412,14 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
         case RCF_CH_CFG_GRP_START:
             VERB("Configuration group %u start", gid);
             is_group = true;
+            snapshot_start();
             SEND_ANSWER("0");
             break;
 
         case RCF_CH_CFG_GRP_END:
             VERB("Configuration group %u end", gid);
             is_group = false;
+            snapshot = 0;
             SEND_ANSWER("%d", commit_all_postponed());
             break;
 
@@ -1120,6 +1465,8 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
             {
                 rc = commit(commit_obj, &p_oid);
             }
+            if (is_group)
+                snapshot_start();
             cfg_free_oid(p_oid);
             SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, rc));
             break;
@@ -1131,6 +1478,8 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
             {
                 rc = commit(commit_obj, &p_oid);
             }
+            if (is_group)
+                snapshot_start();
             cfg_free_oid(p_oid);
             SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, rc));
             break;
@@ -1142,6 +1491,8 @@ rcf_pch_configure(struct rcf_comm_connection *conn,
             {
                 rc = commit(commit_obj, &p_oid);
             }
+            if (is_group)
+                snapshot_start();
             cfg_free_oid(p_oid);
             SEND_ANSWER("%d", TE_RC(TE_RCF_PCH, rc));
             break;
@@ -200,6 +200,33 @@ job_receive_many(unsigned int n_filters, unsigned int *filters, int timeout_ms,
     return rc;
 }
 
+/* Receive all pending messages once there are enough of them. */
+static te_errno
+job_receive_batch(unsigned int n_filters, unsigned int *filters,
+                  int timeout_ms, unsigned int min_count, size_t min_bytes,
+                  tarpc_job_buffer **buffers, unsigned int *count)
+{
+    te_errno rc;
+    ta_job_buffer_t *ta_bufs = NULL;
+    unsigned int i;
+
+    INIT_MANAGER_IF_NEEDED(manager);
+
+    rc = ta_job_receive_batch(manager, n_filters, filters, timeout_ms,
+                              min_count, min_bytes, &ta_bufs, count);
+    if (rc == 0)
+    {
+        *buffers = TE_ALLOC((*count) * sizeof(**buffers));
+
+        for (i = 0; i < *count; i++)
+            ta_job_buffer2tarpc_job_buffer(&ta_bufs[i], &((*buffers)[i]));
+    }
+
+    free(ta_bufs);
+
+    return rc;
+}
+
 static te_errno
 job_clear(unsigned int n_filters, unsigned int *filters)
 {
@@ -521,6 +548,21 @@ TARPC_FUNC_STATIC(job_receive_many, {},
     out->buffers.buffers_len = bufs_count;
 })
 
+TARPC_FUNC_STATIC(job_receive_batch, {},
+{
+    tarpc_job_buffer *bufs = NULL;
+    unsigned int bufs_count = in->count;
+
+    MAKE_CALL(out->retval = func(in->filters.filters_len,
+                                 in->filters.filters_val,
+                                 in->timeout_ms, in->min_count,
+                                 in->min_bytes, &bufs, &bufs_count));
+    out->common.errno_changed = false;
+
+    out->buffers.buffers_val = bufs;
+    out->buffers.buffers_len = bufs_count;
+})
+
 TARPC_FUNC_STATIC(job_clear, {},
 {
     MAKE_CALL(out->retval = func(in->filters.filters_len,
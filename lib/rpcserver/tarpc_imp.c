@@ -7991,15 +7991,51 @@ tarpc_fill_buff_with_sequence(char *buf, int size, tarpc_pat_gen_arg *arg)
     return 0;
 }
 
+/**
+ * Number of independent lanes used by tarpc_fill_buff_with_sequence_lcg().
+ */
+#define TARPC_LCG_LANES 8
+
+#ifdef __GNUC__
+/** Vector of LCG lanes processed by a single SIMD instruction */
+typedef uint32_t tarpc_lcg_vec __attribute__((vector_size(16)));
+
+/** Number of vectors covering all LCG lanes */
+#define TARPC_LCG_VECS \
+    (TARPC_LCG_LANES * sizeof(uint32_t) / sizeof(tarpc_lcg_vec))
+
+/**
+ * Convert all elements of a vector to network byte order.
+ *
+ * @param v     Vector in host byte order
+ *
+ * @return Vector in network byte order.
+ */
+static inline tarpc_lcg_vec
+tarpc_lcg_vec_hton(tarpc_lcg_vec v)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) |
+           (v << 24);
+#else
+    return v;
+#endif
+}
+#endif
+
 /* See description in rpc_server.h */
 te_errno
 tarpc_fill_buff_with_sequence_lcg(char *buf, int size,
                                   tarpc_pat_gen_arg *arg)
 {
     int i;
+    int j;
     uint32_t x0 = arg->coef1;
     uint32_t a = arg->coef2;
     uint32_t c = arg->coef3;
+    uint32_t a_jump = 1;
+    uint32_t c_jump = 0;
+    uint32_t lane[TARPC_LCG_LANES];
     uint32_t *p32buf = (uint32_t *)buf;
     int word_size = (size + arg->offset + 3) / 4;
 
@@ -8007,15 +8043,62 @@ tarpc_fill_buff_with_sequence_lcg(char *buf, int size,
         return 0;
 
     arg->offset = (size + arg->offset) % 4;
-    p32buf[0] = htonl(x0);
 
-    for (i = 1; i < word_size; ++i)
+    /*
+     * The first TARPC_LCG_LANES elements are computed one by one.
+     * After that every lane jumps TARPC_LCG_LANES elements ahead:
+     * X[n + L] = a^L * X[n] + c * (a^(L-1) + ... + a + 1).
+     * There is no dependency between lanes, so they are computed
+     * with SIMD instructions where it is possible.
+     */
+    for (j = 0; j < TARPC_LCG_LANES; j++)
+    {
+        lane[j] = x0;
+        x0 = a * x0 + c;
+        a_jump *= a;
+        c_jump = a * c_jump + c;
+    }
+
+    for (i = 0; i < word_size && i < TARPC_LCG_LANES; i++)
+        p32buf[i] = htonl(lane[i]);
+
+#ifdef __GNUC__
+    if (i + TARPC_LCG_LANES <= word_size)
+    {
+        tarpc_lcg_vec vec[TARPC_LCG_VECS];
+        tarpc_lcg_vec tmp;
+
+        memcpy(vec, lane, sizeof(vec));
+        for (; i + TARPC_LCG_LANES <= word_size; i += TARPC_LCG_LANES)
+        {
+            for (j = 0; j < (int)TARPC_LCG_VECS; j++)
+            {
+                vec[j] = a_jump * vec[j] + c_jump;
+                tmp = tarpc_lcg_vec_hton(vec[j]);
+                memcpy(p32buf + i + j * sizeof(tmp) / sizeof(uint32_t),
+                       &tmp, sizeof(tmp));
+            }
+        }
+        memcpy(lane, vec, sizeof(vec));
+    }
+#else
+    for (; i + TARPC_LCG_LANES <= word_size; i += TARPC_LCG_LANES)
+    {
+        for (j = 0; j < TARPC_LCG_LANES; j++)
+        {
+            lane[j] = a_jump * lane[j] + c_jump;
+            p32buf[i + j] = htonl(lane[j]);
+        }
+    }
+#endif
+
+    for (j = 0; i < word_size; i++, j++)
     {
-        uint32_t curr_elem = a * x0 + c;
-        p32buf[i] = htonl(curr_elem);
-        x0 = curr_elem;
+        lane[j] = a_jump * lane[j] + c_jump;
+        p32buf[i] = htonl(lane[j]);
     }
 
+    x0 = ntohl(p32buf[word_size - 1]);
     arg->coef1 = arg->offset ? x0 : (a * x0 + c);
     return 0;
 }
@@ -8063,6 +8146,8 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
      */
     int bytes_rest = 0;
     int send_flags = iomux == FUNC_NO_IOMUX ? 0 : MSG_DONTWAIT;
+    /* Number of send calls which may be made without iomux wait */
+    unsigned int batch_left = 0;
 
     int                     iomux_timeout;
     iomux_state             iomux_st;
@@ -8075,6 +8160,9 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
     tarpc_pat_gen_arg prev_gen_arg = in->gen_arg;
     out->gen_arg = in->gen_arg;
     out->bytes = 0;
+    out->calls = 0;
+    out->waits = 0;
+    out->duration_us = 0;
 
     RING("%s() started", __FUNCTION__);
 
@@ -8219,6 +8307,7 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
         int len = 0;
         /* The offset within generated sequence to send data from. */
         uint32_t offset = 0;
+        bool no_wait = false;
 
         if (!in->size_rnd_once && bytes_rest == 0)
             size = rand_range(in->size_min, in->size_max);
@@ -8241,76 +8330,98 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
         if (TE_US2MS(delay) > (int)TE_SEC2MS(in->time2run) - MSEC_DIFF)
             break;
 
-        usleep(delay);
-        gettimeofday(&tv_now, NULL);
-
-        /* Wait for writability until time2run expires. */
-        iomux_timeout = (int)TE_SEC2MS(in->time2run) - MSEC_DIFF;
-        if (iomux_timeout <= 0)
-            break;
-
-        /*
-         * However if time2wait is positive, wait no more than
-         * time2wait before terminating.
-         */
-        if (in->time2wait > 0)
-            iomux_timeout = MIN((unsigned int)iomux_timeout, in->time2wait);
-
-        rc = iomux_wait(iomux, &iomux_f, &iomux_st, &iomux_ret,
-                        iomux_timeout);
-
-        if (rc < 0)
+        if (delay > 0)
         {
-            if (errno == EINTR)
-                continue;
-
-            te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
-                             "%s wait failed: %r",
-                             iomux2str(iomux), te_rc_os2te(errno));
-            PTRN_SEND_ERROR;
+            usleep(delay);
+            gettimeofday(&tv_now, NULL);
         }
-        else if (rc > 1)
+
+        if (batch_left > 0)
         {
-            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
-                             "%s wait returned more then one fd",
-                             iomux2str(iomux));
-            PTRN_SEND_ERROR;
+            /*
+             * The socket was writable after the last wait, try to
+             * send without waiting again; EAGAIN returns us to iomux.
+             */
+            batch_left--;
+            no_wait = true;
         }
-        else if (rc == 0  && iomux != FUNC_NO_IOMUX)
+        else
         {
-            break;
-        }
+            /* Wait for writability until time2run expires. */
+            iomux_timeout = (int)TE_SEC2MS(in->time2run) - MSEC_DIFF;
+            if (iomux_timeout <= 0)
+                break;
 
-        itr = IOMUX_RETURN_ITERATOR_START;
-        itr = iomux_return_iterate(iomux, &iomux_st, &iomux_ret,
-                                   itr, &fd, &events);
-        if (fd != in->s && iomux != FUNC_NO_IOMUX)
-        {
-            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
-                             "%s wait returned incorrect fd %d "
-                             "instead of %d",
-                             iomux2str(iomux), fd, in->s);
-            PTRN_SEND_ERROR;
-        }
+            /*
+             * However if time2wait is positive, wait no more than
+             * time2wait before terminating.
+             */
+            if (in->time2wait > 0)
+            {
+                iomux_timeout = MIN((unsigned int)iomux_timeout,
+                                    in->time2wait);
+            }
+
+            rc = iomux_wait(iomux, &iomux_f, &iomux_st, &iomux_ret,
+                            iomux_timeout);
+            out->waits++;
 
-        if ((events & POLLERR) && pollerr_handler != NULL)
-        {
-            rc = pollerr_handler(pollerr_handler_data,
-                                 in->s);
             if (rc < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+
+                te_rpc_error_set(TE_OS_RC(TE_TA_UNIX, errno),
+                                 "%s wait failed: %r",
+                                 iomux2str(iomux), te_rc_os2te(errno));
                 PTRN_SEND_ERROR;
+            }
+            else if (rc > 1)
+            {
+                te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
+                                 "%s wait returned more then one fd",
+                                 iomux2str(iomux));
+                PTRN_SEND_ERROR;
+            }
+            else if (rc == 0  && iomux != FUNC_NO_IOMUX)
+            {
+                break;
+            }
 
-            if (!(events & POLLOUT))
-                continue;
-        }
+            itr = IOMUX_RETURN_ITERATOR_START;
+            itr = iomux_return_iterate(iomux, &iomux_st, &iomux_ret,
+                                       itr, &fd, &events);
+            if (fd != in->s && iomux != FUNC_NO_IOMUX)
+            {
+                te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
+                                 "%s wait returned incorrect fd %d "
+                                 "instead of %d",
+                                 iomux2str(iomux), fd, in->s);
+                PTRN_SEND_ERROR;
+            }
 
-        if (!(events & POLLOUT) && iomux != FUNC_NO_IOMUX)
-        {
-            te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
-                             "%s wait succeeded but returned events "
-                             "%s instead of POLLOUT", iomux2str(iomux),
-                             poll_event_rpc2str(poll_event_h2rpc(events)));
-            PTRN_SEND_ERROR;
+            if ((events & POLLERR) && pollerr_handler != NULL)
+            {
+                rc = pollerr_handler(pollerr_handler_data,
+                                     in->s);
+                if (rc < 0)
+                    PTRN_SEND_ERROR;
+
+                if (!(events & POLLOUT))
+                    continue;
+            }
+
+            if (!(events & POLLOUT) && iomux != FUNC_NO_IOMUX)
+            {
+                te_rpc_error_set(TE_RC(TE_TA_UNIX, TE_EFAIL),
+                                 "%s wait succeeded but returned events "
+                                 "%s instead of POLLOUT", iomux2str(iomux),
+                                 poll_event_rpc2str(poll_event_h2rpc(events)));
+                PTRN_SEND_ERROR;
+            }
+
+            if (in->batch > 1 && iomux != FUNC_NO_IOMUX)
+                batch_left = in->batch - 1;
         }
 
         /*
@@ -8357,8 +8468,17 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
             len = send_func(in->s, send_ptr, send_size, send_flags);
         }
 
+        out->calls++;
+
         if (len < 0)
         {
+            if (no_wait && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                batch_left = 0;
+                errno = 0;
+                continue;
+            }
+
             if (!in->ignore_err)
             {
                 ERROR("send() failed in pattern_sender(): errno %s (%x)",
@@ -8374,12 +8494,20 @@ pattern_sender(tarpc_pattern_sender_in *in, tarpc_pattern_sender_out *out)
         }
         bytes_rest -= len;
         out->bytes += len;
+
+        /* Send buffer is full, there is no point in trying again */
+        if ((size_t)len < send_size)
+            batch_left = 0;
     }
 #undef PTRN_SEND_ERROR
 #undef MSEC_DIFF
 
-    RING("pattern_sender() stopped, sent %llu bytes",
-         out->bytes);
+    gettimeofday(&tv_now, NULL);
+    out->duration_us = TE_SEC2US(tv_now.tv_sec - tv_start.tv_sec) +
+                       tv_now.tv_usec - tv_start.tv_usec;
+
+    RING("pattern_sender() stopped, sent %llu bytes in %llu calls "
+         "(%llu waits)", out->bytes, out->calls, out->waits);
 
     if (bytes_rest != 0)
     {
@@ -8432,6 +8560,8 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
     int events = 0;
     int rc = 0;
     int recv_flags = iomux == FUNC_NO_IOMUX ? 0 : MSG_DONTWAIT;
+    /* Number of receive calls which may be made without iomux wait */
+    unsigned int batch_left = 0;
 
     int                     iomux_timeout;
     iomux_state             iomux_st;
@@ -8444,6 +8574,9 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
 
     out->gen_arg = in->gen_arg;
     out->bytes = 0;
+    out->calls = 0;
+    out->waits = 0;
+    out->duration_us = 0;
 
     RING("%s() started", __FUNCTION__);
 
@@ -8530,6 +8663,7 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
     {
         int len = 0;
         uint32_t offset = in->gen_arg.offset;
+        bool no_wait = false;
 
         /* Wait for readability until time2run expires. */
         iomux_timeout = (int)TE_SEC2MS(in->time2run) - MSEC_DIFF;
@@ -8543,7 +8677,16 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
         if (in->time2wait > 0)
             iomux_timeout = MIN((unsigned int)iomux_timeout, in->time2wait);
 
-        if (iomux == FUNC_NO_IOMUX)
+        if (batch_left > 0)
+        {
+            /*
+             * The socket was readable after the last wait, try to
+             * receive without waiting again; EAGAIN returns us to iomux.
+             */
+            batch_left--;
+            no_wait = true;
+        }
+        else if (iomux == FUNC_NO_IOMUX)
         {
             SET_RECV_TIMEOUT(TE_MS2US(iomux_timeout));
             if (rc != 0)
@@ -8559,6 +8702,7 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
         {
             rc = iomux_wait(iomux, &iomux_f, &iomux_st, &iomux_ret,
                             iomux_timeout);
+            out->waits++;
             if (rc < 0)
             {
                 if (errno == EINTR)
@@ -8614,13 +8758,25 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
 
                 PTRN_RECV_ERROR;
             }
+
+            if (in->batch > 1)
+                batch_left = in->batch - 1;
         }
 
         len = recv_func(in->s, buf, MAX_PKT, recv_flags);
+        out->calls++;
         if (len < 0)
         {
             int recv_errno = errno;
 
+            if (no_wait &&
+                (recv_errno == EAGAIN || recv_errno == EWOULDBLOCK))
+            {
+                batch_left = 0;
+                errno = 0;
+                continue;
+            }
+
             if (iomux == FUNC_NO_IOMUX &&
                 (recv_errno == EAGAIN || recv_errno == EWOULDBLOCK))
                 continue;
@@ -8672,8 +8828,12 @@ pattern_receiver(tarpc_pattern_receiver_in *in,
 #undef MSEC_DIFF
 #undef MAX_OFFSET
 
-    RING("pattern_receiver() stopped, received %llu bytes",
-         out->bytes);
+    gettimeofday(&tv_now, NULL);
+    out->duration_us = TE_SEC2US(tv_now.tv_sec - tv_start.tv_sec) +
+                       tv_now.tv_usec - tv_start.tv_usec;
+
+    RING("pattern_receiver() stopped, received %llu bytes in %llu calls "
+         "(%llu waits)", out->bytes, out->calls, out->waits);
 
     out->gen_arg = in->gen_arg;
 
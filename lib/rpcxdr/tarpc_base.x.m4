@@ -4561,6 +4561,11 @@ struct tarpc_pattern_sender_in {
     tarpc_ptr   pollerr_handler_data;   /**< Data to pass to @c POLLERR
                                              handler */
 
+    uint32_t    batch;          /**< Maximum number of send calls made
+                                     after a single iomux wakeup (@c 0 or
+                                     @c 1 means waiting before every
+                                     call) */
+
     tarpc_pat_gen_arg gen_arg;  /**< Pattern generator function
                                      arguments */
 };
@@ -4574,6 +4579,12 @@ struct tarpc_pattern_sender_out {
     tarpc_bool  func_failed;    /**< @c true if it was data transmitting
                                      function who failed */
 
+    uint64_t    calls;          /**< Number of data transmitting
+                                     function calls */
+    uint64_t    waits;          /**< Number of iomux waits */
+    uint64_t    duration_us;    /**< Time spent in the function
+                                     (in microseconds) */
+
     tarpc_pat_gen_arg gen_arg;  /**< Pattern generator function
                                      arguments */
 };
@@ -4599,6 +4610,10 @@ struct tarpc_pattern_receiver_in {
     tarpc_bool  ignore_pollerr; /**< If @c true, @c POLLERR event should be
                                      ignored if it arrives instead of
                                      @c POLLIN */
+    uint32_t    batch;          /**< Maximum number of receive calls
+                                     made after a single iomux wakeup
+                                     (@c 0 or @c 1 means waiting before
+                                     every call) */
 
     tarpc_pat_gen_arg gen_arg;  /**< Pattern generator function
                                      arguments */
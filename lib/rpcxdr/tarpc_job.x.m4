@@ -183,6 +183,19 @@ struct tarpc_job_receive_many_out {
     tarpc_int retval;
 };
 
+/* job_receive_batch */
+struct tarpc_job_receive_batch_in {
+    struct tarpc_in_arg common;
+
+    tarpc_uint filters<>;
+    tarpc_int timeout_ms;
+    tarpc_uint min_count;
+    tarpc_size_t min_bytes;
+    tarpc_uint count;
+};
+
+typedef struct tarpc_job_receive_many_out tarpc_job_receive_batch_out;
+
 /* job_clear */
 struct tarpc_job_clear_in {
     struct tarpc_in_arg common;
@@ -409,6 +422,7 @@ program job
         RPC_DEF(job_receive)
         RPC_DEF(job_receive_last)
         RPC_DEF(job_receive_many)
+        RPC_DEF(job_receive_batch)
         RPC_DEF(job_clear)
         RPC_DEF(job_send)
         RPC_DEF(job_poll)
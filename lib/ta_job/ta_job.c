@@ -37,6 +37,7 @@
 #if HAVE_SIGNAL_H
 #include <signal.h>
 #endif
+#include <sys/epoll.h>
 
 /* The maximum size of log user entry (in bytes) for filter logging. */
 #define MAX_LOG_USER_SIZE 128
@@ -60,10 +61,14 @@
 #define MAX_JOBS UINT_MAX
 
 #define MAX_QUEUE_SIZE (16 * 1024 * 1024)
-#define MAX_MESSAGE_DATA_SIZE 8192
+/*
+ * Default pipe capacity, so that all data available on a channel
+ * is usually read and passed to filters at once.
+ */
+#define MAX_MESSAGE_DATA_SIZE 65536
 
-#define CTRL_PIPE_INITIALIZER {-1, -1}
-#define CTRL_MESSAGE ("c\n")
+/* Maximum number of events processed after a single epoll_wait() */
+#define MAX_EPOLL_EVENTS 64
 
 typedef struct message_t {
     TAILQ_ENTRY(message_t) entry;
@@ -82,6 +87,10 @@ typedef struct message_queue_t {
     message_list messages;
     size_t dropped;
     size_t size;
+    /* Number of messages in the queue */
+    unsigned int n_msgs;
+    /* Total size of data of messages in the queue */
+    size_t data_size;
 } message_queue_t;
 
 typedef enum queue_action_t {
@@ -193,10 +202,8 @@ struct ta_job_manager_t {
 
     pthread_mutex_t channels_lock;
     pthread_cond_t data_cond;
-    int ctrl_pipe[2];
-
-    int abandoned_descriptors[FD_SETSIZE];
-    size_t n_abandoned_descriptors;
+    /* Descriptors of started channels */
+    int epoll_fd;
 
     bool thread_is_running;
     pthread_t service_thread;
@@ -209,7 +216,7 @@ static const ta_job_manager_t ta_job_manager_initializer = {
     .all_filters = LIST_HEAD_INITIALIZER(all_filters),
     .channels_lock = PTHREAD_MUTEX_INITIALIZER,
     .data_cond = PTHREAD_COND_INITIALIZER,
-    .ctrl_pipe = CTRL_PIPE_INITIALIZER,
+    .epoll_fd = -1,
     .thread_is_running = false,
 };
 
@@ -364,95 +371,52 @@ out:
     return rc;
 }
 
+/*
+ * Start or continue monitoring of a descriptor by the service thread.
+ * Events carry an id rather than a pointer, so an event which is
+ * received for a destroyed channel is simply dropped.
+ *
+ * Readiness of an input channel is reported once, monitoring should
+ * be continued after the data is written.
+ */
 static te_errno
-abandoned_descriptors_add(ta_job_manager_t *manager, size_t count, int *fds)
-{
-    size_t i;
-    size_t *n_ab_descr = &manager->n_abandoned_descriptors;
-    int *ab_descr = manager->abandoned_descriptors;
-
-    if (*n_ab_descr + count > FD_SETSIZE)
-    {
-        ERROR("Failed to add abandoned descriptors: not enough space");
-        return TE_ENOBUFS;
-    }
-
-    for (i = 0; i < count; i++)
-        ab_descr[(*n_ab_descr)++] = fds[i];
-
-    return 0;
-}
-
-static void
-abandoned_descriptors_close(ta_job_manager_t *manager)
+epoll_watch(ta_job_manager_t *manager, int op, int fd, unsigned int id,
+            bool is_input)
 {
-    size_t i;
-    size_t *n_ab_descr = &manager->n_abandoned_descriptors;
-    int *ab_descr = manager->abandoned_descriptors;
+    struct epoll_event event;
 
-    for (i = 0; i < *n_ab_descr; i++)
-        close(ab_descr[i]);
+    memset(&event, 0, sizeof(event));
+    event.events = is_input ? (EPOLLOUT | EPOLLONESHOT) : EPOLLIN;
+    event.data.u32 = id;
 
-    *n_ab_descr = 0;
-}
-
-static te_errno
-ctrl_pipe_create(ta_job_manager_t *manager)
-{
-    int rc;
-
-    if (manager->ctrl_pipe[0] > -1 || manager->ctrl_pipe[1] > -1)
+    if (epoll_ctl(manager->epoll_fd, op, fd, &event) != 0)
     {
-        WARN("Control pipe already created");
-        return 0;
-    }
+        te_errno rc = te_rc_os2te(errno);
 
-    if ((rc = pipe2(manager->ctrl_pipe, O_CLOEXEC)) != 0)
-    {
-        ERROR("Control pipe creation failure");
-        return te_rc_os2te(rc);
+        ERROR("Failed to watch descriptor %d: %r", fd, rc);
+        return rc;
     }
 
     return 0;
 }
 
 static void
-ctrl_pipe_destroy(ta_job_manager_t *manager)
+epoll_unwatch(ta_job_manager_t *manager, int fd)
 {
-    if (manager->ctrl_pipe[0] > -1)
-        close(manager->ctrl_pipe[0]);
-    if (manager->ctrl_pipe[1] > -1)
-        close(manager->ctrl_pipe[1]);
-
-    manager->ctrl_pipe[0] = -1;
-    manager->ctrl_pipe[1] = -1;
-}
-
-static int
-ctrl_pipe_get_read_fd(ta_job_manager_t *manager)
-{
-    return manager->ctrl_pipe[0];
+    if (manager->epoll_fd > -1 && fd > -1)
+        (void)epoll_ctl(manager->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
 }
 
-static te_errno
-ctrl_pipe_send(ta_job_manager_t *manager)
+/* Stop monitoring of a channel descriptor and close it */
+static void
+channel_close_fd(ta_job_manager_t *manager, channel_t *channel)
 {
-    ssize_t write_rc;
-
-    write_rc = write(manager->ctrl_pipe[1], CTRL_MESSAGE, sizeof(CTRL_MESSAGE));
-    if (write_rc < 0)
+    if (channel->fd > -1)
     {
-        ERROR("Control pipe write failed");
-        return te_rc_os2te(errno);
+        epoll_unwatch(manager, channel->fd);
+        close(channel->fd);
+        channel->fd = -1;
     }
-
-    if (write_rc == 0)
-    {
-        ERROR("Control pipe write sent 0 bytes");
-        return TE_EIO;
-    }
-
-    return 0;
 }
 
 static te_errno
@@ -460,6 +424,8 @@ init_message_queue(message_queue_t *queue)
 {
     queue->size = 0;
     queue->dropped = 0;
+    queue->n_msgs = 0;
+    queue->data_size = 0;
     TAILQ_INIT(&queue->messages);
 
     return 0;
@@ -475,6 +441,8 @@ queue_drop_oldest(message_queue_t *queue)
         TAILQ_REMOVE(&queue->messages, msg, entry);
 
         queue->size -= (msg->size + sizeof(*msg));
+        queue->n_msgs--;
+        queue->data_size -= msg->size;
         free(msg->data);
         free(msg);
 
@@ -526,6 +494,8 @@ queue_put(const char *buf, size_t size, bool eos, unsigned int channel_id,
     TAILQ_INSERT_TAIL(&queue->messages, msg, entry);
 
     queue->size += needed_space;
+    queue->n_msgs++;
+    queue->data_size += size;
 
     return 0;
 }
@@ -546,6 +516,9 @@ queue_extract_first_msg(message_queue_t *queue)
         msg->dropped = queue->dropped;
         queue->dropped = 0;
         TAILQ_REMOVE(&queue->messages, msg, entry);
+        queue->size -= (msg->size + sizeof(*msg));
+        queue->n_msgs--;
+        queue->data_size -= msg->size;
     }
 
     return msg;
@@ -1188,16 +1161,21 @@ filter_exec(ta_job_manager_t *manager, filter_t *filter,
 }
 
 static te_errno
-channel_read(ta_job_manager_t *manager, channel_t *channel)
+channel_read(ta_job_manager_t *manager, channel_t *channel, char *buf)
 {
-    char buf[MAX_MESSAGE_DATA_SIZE] = {0};
     ssize_t read_c;
     size_t i;
     te_errno rc;
 
-    read_c = read(channel->fd, buf, sizeof(buf));
+    read_c = read(channel->fd, buf, MAX_MESSAGE_DATA_SIZE);
     if (read_c < 0)
+    {
+        /* The event may be received before the descriptor was replaced */
+        if (errno == EAGAIN || errno == EINTR)
+            return 0;
+
         return te_rc_os2te(errno);
+    }
 
     for (i = 0; i < channel->n_filters; i++)
     {
@@ -1207,71 +1185,58 @@ channel_read(ta_job_manager_t *manager, channel_t *channel)
     }
 
     if (read_c == 0)
+    {
         channel->closed = true;
+        epoll_unwatch(manager, channel->fd);
+    }
 
     return 0;
 }
 
 static void
-thread_destroy_unused_channels(channel_list *channels)
+thread_destroy_unused_channels(ta_job_manager_t *manager)
 {
     channel_t *channel;
     channel_t *channel_tmp;
 
-    LIST_FOREACH_SAFE(channel, channels, next, channel_tmp)
+    LIST_FOREACH_SAFE(channel, &manager->all_channels, next, channel_tmp)
     {
         if (channel->job == NULL)
         {
-            if (channel->fd > -1)
-                close(channel->fd);
+            channel_close_fd(manager, channel);
             channel_destroy(channel);
         }
     }
 }
 
 static void
-thread_read_selected(ta_job_manager_t *manager, fd_set *rfds,
-                     channel_list *channels)
+thread_process_event(ta_job_manager_t *manager, struct epoll_event *event,
+                     char *buf)
 {
-    channel_t *active_channel = NULL;
     channel_t *channel;
     te_errno rc;
 
-    LIST_FOREACH(channel, channels, next)
+    LIST_FOREACH(channel, &manager->all_channels, next)
     {
-        if (FD_ISSET(channel->fd, rfds))
-        {
-            active_channel = channel;
+        if (channel->id == event->data.u32)
             break;
-        }
     }
 
-    if (active_channel == NULL)
+    if (channel == NULL || channel->closed || channel->fd < 0)
     {
-        INFO("Drop data on destroyed channel\n");
+        INFO("Drop event on destroyed channel\n");
         return;
     }
 
-    if ((rc = channel_read(manager, active_channel)) != 0)
+    if (channel->is_input_channel)
     {
-        WARN("Channel read failure '%r', continuing", rc);
+        channel->input_ready = true;
+        if (channel->signal_on_data)
+            pthread_cond_signal(&manager->data_cond);
     }
-}
-
-static void
-thread_mark_selected_ready(ta_job_manager_t *manager, fd_set *wfds,
-                           channel_list *channels)
-{
-    channel_t *channel;
-
-    LIST_FOREACH(channel, channels, next)
+    else if ((rc = channel_read(manager, channel, buf)) != 0)
     {
-        if (FD_ISSET(channel->fd, wfds))
-        {
-            channel->input_ready = true;
-            if (channel->signal_on_data)
-                pthread_cond_signal(&manager->data_cond);
-        }
+        WARN("Channel read failure '%r', continuing", rc);
     }
 }
 
@@ -1280,91 +1245,34 @@ thread_work_loop(void *arg)
 {
     ta_job_manager_t *manager = arg;
 
-    fd_set rfds;
-    fd_set wfds;
-    int select_rc;
-
-    UNUSED(arg);
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    char buf[MAX_MESSAGE_DATA_SIZE];
+    int n_events;
+    int i;
 
     logfork_register_user("JOB CONTROL");
     logfork_set_id_logging(false);
 
     while (1)
     {
-        int ctrl_fd = ctrl_pipe_get_read_fd(manager);
-        int max_fd = ctrl_fd;
-        channel_t *channel;
-
-        FD_ZERO(&rfds);
-        FD_ZERO(&wfds);
-        FD_SET(ctrl_fd, &rfds);
-
-        pthread_mutex_lock(&manager->channels_lock);
-
-        LIST_FOREACH(channel, &manager->all_channels, next)
-        {
-            if (!channel->closed && channel->fd > -1)
-            {
-                if (channel->is_input_channel)
-                {
-                    if (!channel->input_ready)
-                        FD_SET(channel->fd, &wfds);
-                }
-                else
-                {
-                    FD_SET(channel->fd, &rfds);
-                }
-
-                if (channel->fd > max_fd)
-                    max_fd = channel->fd;
-            }
-        }
-
-        pthread_mutex_unlock(&manager->channels_lock);
-
-        select_rc = select(max_fd + 1, &rfds, &wfds, NULL, NULL);
-
-        if (select_rc < 0)
+        n_events = epoll_wait(manager->epoll_fd, events,
+                              TE_ARRAY_LEN(events), -1);
+        if (n_events < 0)
         {
-            switch (errno)
-            {
-                case EINTR:
-                    /* A failure due to signal is ignored */
-                    break;
-                default:
-                    ERROR("select() failed, %s", strerror(errno));
-                    break;
-            }
+            /* A failure due to signal is ignored */
+            if (errno != EINTR)
+                ERROR("epoll_wait() failed, %s", strerror(errno));
+            continue;
         }
-        else if (select_rc)
-        {
-            bool channel_process_needed = true;
-
-            pthread_mutex_lock(&manager->channels_lock);
-
-            if (FD_ISSET(ctrl_fd, &rfds))
-            {
-                char buf[sizeof(CTRL_MESSAGE)] = {0};
-                ssize_t read_c = read(ctrl_fd, buf, sizeof(buf));
-
-                if (read_c <= 0)
-                    WARN("Control pipe read failed, continuing");
 
-                channel_process_needed = false;
-            }
+        pthread_mutex_lock(&manager->channels_lock);
 
-            thread_destroy_unused_channels(&manager->all_channels);
-            abandoned_descriptors_close(manager);
+        thread_destroy_unused_channels(manager);
 
-            if (channel_process_needed)
-            {
-                thread_read_selected(manager, &rfds, &manager->all_channels);
-                thread_mark_selected_ready(manager, &wfds,
-                                           &manager->all_channels);
-            }
+        for (i = 0; i < n_events; i++)
+            thread_process_event(manager, &events[i], buf);
 
-            pthread_mutex_unlock(&manager->channels_lock);
-        }
+        pthread_mutex_unlock(&manager->channels_lock);
     }
 
     return NULL;
@@ -1374,24 +1282,24 @@ static te_errno
 thread_start(ta_job_manager_t *manager)
 {
     te_errno rc;
+    int ret;
 
-    if ((rc = ctrl_pipe_create(manager)) != 0)
-        return rc;
-
-    /* Check read end of the pipe for descriptor limit */
-    if (ctrl_pipe_get_read_fd(manager) >= FD_SETSIZE)
+    manager->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (manager->epoll_fd < 0)
     {
-        ERROR("Failed to create control pipe, file descriptor limit exceeded");
-        ctrl_pipe_destroy(manager);
-        return TE_EMFILE;
+        rc = te_rc_os2te(errno);
+        ERROR("Failed to create epoll instance: %r", rc);
+        return rc;
     }
 
-    if (pthread_create(&manager->service_thread, NULL,
-                       thread_work_loop, manager) != 0)
+    ret = pthread_create(&manager->service_thread, NULL,
+                         thread_work_loop, manager);
+    if (ret != 0)
     {
         ERROR("Thread create failure");
-        ctrl_pipe_destroy(manager);
-        return te_rc_os2te(errno);
+        close(manager->epoll_fd);
+        manager->epoll_fd = -1;
+        return te_rc_os2te(ret);
     }
 
     return 0;
@@ -1404,6 +1312,15 @@ close_valid(int fd)
         close(fd);
 }
 
+static te_errno
+set_nonblock(int fd)
+{
+    if (fd >= 0 && fcntl(fd, F_SETFL, O_NONBLOCK | fcntl(fd, F_GETFL)) != 0)
+        return te_rc_os2te(errno);
+
+    return 0;
+}
+
 static te_errno
 ta_job_build_tool_and_args(char **tool, te_vec *args, ta_job_t *job)
 {
@@ -1472,9 +1389,6 @@ ta_job_start(ta_job_manager_t *manager, unsigned int id)
     int *stdout_fd_p = &stdout_fd;
     int *stderr_fd_p = &stderr_fd;
     int *stdin_fd_p = &stdin_fd;
-    int descrs_to_abandon[MAX_OUTPUT_CHANNELS_PER_JOB +
-                          MAX_INPUT_CHANNELS_PER_JOB];
-    size_t n_descrs_to_abandon = 0;
     size_t i;
     char *tool = NULL;
     te_vec args = TE_VEC_INIT(char *);
@@ -1523,54 +1437,25 @@ ta_job_start(ta_job_manager_t *manager, unsigned int id)
         return te_rc_os2te(errno);
     }
 
-    if (stdout_fd >= FD_SETSIZE || stderr_fd >= FD_SETSIZE ||
-        stdin_fd >= FD_SETSIZE)
+    /* Data is read when it is available, reading must not block */
+    if ((rc = set_nonblock(stdout_fd)) != 0 ||
+        (rc = set_nonblock(stderr_fd)) != 0)
     {
-        ERROR("Failed to start a job, file descriptor limit exceeded");
+        ERROR("Failed to make job output non-blocking: %r", rc);
         close_valid(stdout_fd);
         close_valid(stderr_fd);
         close_valid(stdin_fd);
         proc_kill(pid, SIGTERM, -1);
-        return TE_EMFILE;
+        return rc;
     }
 
     pthread_mutex_lock(&manager->channels_lock);
 
-    if ((rc = ctrl_pipe_send(manager)) != 0)
-    {
-        pthread_mutex_unlock(&manager->channels_lock);
-        close_valid(stdout_fd);
-        close_valid(stderr_fd);
-        close_valid(stdin_fd);
-        proc_kill(pid, SIGTERM, -1);
-        return rc;
-    }
-
+    /* Descriptors of the previous run are not needed anymore */
     for (i = 0; i < job->n_out_channels; i++)
-    {
-        if (job->out_channels[i]->fd > -1)
-            descrs_to_abandon[n_descrs_to_abandon++] = job->out_channels[i]->fd;
-    }
+        channel_close_fd(manager, job->out_channels[i]);
     for (i = 0; i < job->n_in_channels; i++)
-    {
-        if (job->in_channels[i]->fd > -1)
-            descrs_to_abandon[n_descrs_to_abandon++] = job->in_channels[i]->fd;
-    }
-
-    if (n_descrs_to_abandon > 0)
-    {
-        rc = abandoned_descriptors_add(manager, n_descrs_to_abandon,
-                                       descrs_to_abandon);
-        if (rc != 0)
-        {
-            pthread_mutex_unlock(&manager->channels_lock);
-            close_valid(stdout_fd);
-            close_valid(stderr_fd);
-            close_valid(stdin_fd);
-            proc_kill(pid, SIGTERM, -1);
-            return rc;
-        }
-    }
+        channel_close_fd(manager, job->in_channels[i]);
 
     if (job->n_out_channels > 0)
     {
@@ -1588,6 +1473,33 @@ ta_job_start(ta_job_manager_t *manager, unsigned int id)
         job->in_channels[0]->closed = false;
     }
 
+    for (i = 0; i < job->n_out_channels + job->n_in_channels; i++)
+    {
+        channel_t *channel = i < job->n_out_channels ?
+                             job->out_channels[i] :
+                             job->in_channels[i - job->n_out_channels];
+
+        if (channel->fd > -1)
+        {
+            rc = epoll_watch(manager, EPOLL_CTL_ADD, channel->fd,
+                             channel->id, channel->is_input_channel);
+            if (rc != 0)
+                break;
+        }
+    }
+
+    if (rc != 0)
+    {
+        for (i = 0; i < job->n_out_channels; i++)
+            channel_close_fd(manager, job->out_channels[i]);
+        for (i = 0; i < job->n_in_channels; i++)
+            channel_close_fd(manager, job->in_channels[i]);
+
+        pthread_mutex_unlock(&manager->channels_lock);
+        proc_kill(pid, SIGTERM, -1);
+        return rc;
+    }
+
     pthread_mutex_unlock(&manager->channels_lock);
 
     job->has_started = true;
@@ -1723,8 +1635,7 @@ ta_job_deallocate_channels(ta_job_manager_t *manager, unsigned int n_channels,
         if (channel == NULL)
             continue;
 
-        if (channel->fd > -1)
-            close(channel->fd);
+        channel_close_fd(manager, channel);
 
         /*
          * We do not rely on thread_destroy_unused_channels() to do the job
@@ -2282,6 +2193,152 @@ ta_job_receive_many(ta_job_manager_t *manager, unsigned int n_filters,
     return rc;
 }
 
+/*
+ * Check whether the filters have enough messages to be received by
+ * ta_job_receive_batch(). End of stream is enough since no more data
+ * may come from the channel.
+ */
+static bool
+batch_ready(ta_job_manager_t *manager, unsigned int n_filters,
+            unsigned int *filters, unsigned int min_count, size_t min_bytes)
+{
+    unsigned int n_msgs = 0;
+    size_t data_size = 0;
+    unsigned int i;
+
+    for (i = 0; i < n_filters; i++)
+    {
+        message_queue_t *queue = &get_filter(manager, filters[i])->queue;
+        message_t *last = TAILQ_LAST(&queue->messages, message_list);
+
+        if (last != NULL && last->eos)
+            return true;
+
+        n_msgs += queue->n_msgs;
+        data_size += queue->data_size;
+    }
+
+    if (n_msgs == 0)
+        return false;
+
+    if (min_count == 0 && min_bytes == 0)
+        return true;
+
+    return (min_count != 0 && n_msgs >= min_count) ||
+           (min_bytes != 0 && data_size >= min_bytes);
+}
+
+/* See description in ta_job.h */
+te_errno
+ta_job_receive_batch(ta_job_manager_t *manager, unsigned int n_filters,
+                     unsigned int *filters, int timeout_ms,
+                     unsigned int min_count, size_t min_bytes,
+                     ta_job_buffer_t **buffers, unsigned int *count)
+{
+    te_vec bufs = TE_VEC_INIT(ta_job_buffer_t);
+    struct timeval now;
+    struct timespec timeout;
+    uint64_t nanoseconds;
+    unsigned int max_count = *count;
+    unsigned int i;
+    te_errno rc = 0;
+
+    *buffers = NULL;
+    *count = 0;
+
+    if (n_filters == 0)
+    {
+        ERROR("Number of filters to receive from must be greater than zero");
+        return TE_EINVAL;
+    }
+
+    if (timeout_ms >= 0)
+    {
+        gettimeofday(&now, NULL);
+
+        nanoseconds = TE_SEC2NS(now.tv_sec);
+        nanoseconds += TE_US2NS(now.tv_usec);
+        nanoseconds += TE_MS2NS(timeout_ms);
+
+        TE_NS2TS(nanoseconds, &timeout);
+    }
+
+    pthread_mutex_lock(&manager->channels_lock);
+
+    /* After this loop all filter ids are checked to be valid */
+    for (i = 0; i < n_filters; i++)
+    {
+        bool ready;
+
+        if ((rc = channel_or_filter_ready(manager, filters[i], true,
+                                          &ready)) != 0)
+        {
+            pthread_mutex_unlock(&manager->channels_lock);
+            ERROR("Job receive batch failed, %r", rc);
+            return rc;
+        }
+    }
+
+    for (i = 0; i < n_filters; i++)
+        switch_signal_on_data(manager, filters[i], true);
+
+    /* Every new message is signalled, wait until there are enough */
+    while (!batch_ready(manager, n_filters, filters, min_count, min_bytes))
+    {
+        int wait_rc;
+
+        if (timeout_ms >= 0)
+        {
+            wait_rc = pthread_cond_timedwait(&manager->data_cond,
+                                             &manager->channels_lock,
+                                             &timeout);
+        }
+        else
+        {
+            wait_rc = pthread_cond_wait(&manager->data_cond,
+                                        &manager->channels_lock);
+        }
+
+        if (wait_rc != 0)
+        {
+            if (wait_rc != ETIMEDOUT)
+                WARN("pthread_cond_(timed)wait failed");
+            rc = te_rc_os2te(wait_rc);
+            break;
+        }
+    }
+
+    for (i = 0; i < n_filters; i++)
+        switch_signal_on_data(manager, filters[i], false);
+
+    /* Return whatever is available, even if the thresholds are not met */
+    for (i = 0; i < n_filters; i++)
+    {
+        message_queue_t *queue = &get_filter(manager, filters[i])->queue;
+        message_t *msg;
+
+        while ((max_count == 0 || te_vec_size(&bufs) < max_count) &&
+               (msg = queue_extract_first_msg(queue)) != NULL)
+        {
+            ta_job_buffer_t buf;
+
+            move_or_copy_message_to_buffer(msg, &buf, true);
+            free(msg);
+            TE_VEC_APPEND(&bufs, buf);
+        }
+    }
+
+    pthread_mutex_unlock(&manager->channels_lock);
+
+    if (te_vec_size(&bufs) > 0)
+        rc = 0;
+
+    *buffers = (ta_job_buffer_t *)(bufs.data.ptr);
+    *count = te_vec_size(&bufs);
+
+    return rc;
+}
+
 /* See description in ta_job.h */
 te_errno
 ta_job_clear(ta_job_manager_t *manager, unsigned int n_filters,
@@ -2361,8 +2418,9 @@ ta_job_send_unsafe(ta_job_manager_t *manager, unsigned int channel_id,
         return TE_EIO;
     }
 
-    /* Wake up the service thread to continue monitoring the descriptor */
-    if ((rc = ctrl_pipe_send(manager)) != 0)
+    /* Continue monitoring of the descriptor by the service thread */
+    if ((rc = epoll_watch(manager, EPOLL_CTL_MOD, channel->fd, channel->id,
+                          true)) != 0)
         return rc;
 
     return 0;
@@ -337,6 +337,43 @@ extern te_errno ta_job_receive_many(ta_job_manager_t *manager,
                                     ta_job_buffer_t **buffers,
                                     unsigned int *count);
 
+/**
+ * Receive all pending messages from the specified filters at once
+ * waiting until enough messages are accumulated.
+ *
+ * The function waits until the filters together have at least
+ * @p min_count messages or at least @p min_bytes bytes of data, or until
+ * end of stream is queued on some filter. If both thresholds are zero,
+ * a single message is enough. When the timeout expires, the messages
+ * available at that moment are returned.
+ *
+ * @param[in]    manager       Job manager handle
+ * @param[in]    n_filters     Number of filters to receive from
+ * @param[in]    filters       ID of filters to receive from
+ * @param[in]    timeout_ms    Time to wait for the thresholds to be reached
+ *                             (negative means infinite)
+ * @param[in]    min_count     Threshold on the number of messages
+ *                             (zero to ignore)
+ * @param[in]    min_bytes     Threshold on the size of data in messages
+ *                             (zero to ignore)
+ * @param[out]   buffers       Where to save pointer to array of buffers with
+ *                             messages
+ * @param[in,out] count        On input, maximum number of messages to retrieve.
+ *                             If zero, all available messages will be
+ *                             retrieved. On output - number of actually
+ *                             retrieved messages.
+ *
+ * @return       Status code
+ * @retval TE_ETIMEDOUT        No messages are available within the timeout
+ */
+extern te_errno ta_job_receive_batch(ta_job_manager_t *manager,
+                                     unsigned int n_filters,
+                                     unsigned int *filters, int timeout_ms,
+                                     unsigned int min_count,
+                                     size_t min_bytes,
+                                     ta_job_buffer_t **buffers,
+                                     unsigned int *count);
+
 /**
  * Remove all messages from the filters' message queues
  *
@@ -316,7 +316,9 @@ tad_arp_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_arp_header)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_arp_header)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_arp_header);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
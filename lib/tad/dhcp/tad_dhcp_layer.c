@@ -551,7 +551,9 @@ tad_dhcp_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_dhcpv4_message)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_dhcpv4_message)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_dhcpv4_message);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
@@ -1026,7 +1028,9 @@ tad_dhcp6_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_dhcpv6_message)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_dhcpv6_message)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_dhcpv6_message);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
@@ -485,7 +485,8 @@ tad_geneve_match_post_cb(csap_p              csap,
     if ((proto_data == NULL) || (pkt == NULL) || (pkt_data == NULL))
         return TE_RC(TE_TAD_CSAP, TE_EINVAL);
 
-    meta_pkt_layer_nds = asn_init_value(ndn_geneve_header);
+    meta_pkt_layer_nds = tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                                     ndn_geneve_header);
     if (meta_pkt_layer_nds == NULL)
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
 
@@ -494,7 +495,7 @@ tad_geneve_match_post_cb(csap_p              csap,
     if ((rc != 0) || (pkt_data->nb_options == 0))
         goto out;
 
-    options_nds = asn_init_value(ndn_geneve_options);
+    options_nds = asn_init_value_in(ndn_geneve_options, meta_pkt_layer_nds);
     if (options_nds == NULL)
     {
         rc = TE_ENOMEM;
@@ -514,7 +515,7 @@ tad_geneve_match_post_cb(csap_p              csap,
         asn_value    *option_nds;
         unsigned int  option_data_nb_bits;
 
-        option_nds = asn_init_value(ndn_geneve_option);
+        option_nds = asn_init_value_in(ndn_geneve_option, options_nds);
         if (option_nds == NULL)
         {
             rc = TE_ENOMEM;
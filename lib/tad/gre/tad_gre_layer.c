@@ -490,7 +490,8 @@ tad_gre_match_post_cb(csap_p              csap,
     if ((proto_data == NULL) || (pkt == NULL) || (pkt_data == NULL))
         return TE_RC(TE_TAD_CSAP, TE_EINVAL);
 
-    meta_pkt_layer_nds = asn_init_value(ndn_gre_header);
+    meta_pkt_layer_nds = tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                                     ndn_gre_header);
     if (meta_pkt_layer_nds == NULL)
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
 
@@ -503,7 +504,8 @@ tad_gre_match_post_cb(csap_p              csap,
     {
         asn_value *opt_cksum_nds;
 
-        opt_cksum_nds = asn_init_value(ndn_gre_header_opt_cksum);
+        opt_cksum_nds = asn_init_value_in(ndn_gre_header_opt_cksum,
+                                          meta_pkt_layer_nds);
         if (opt_cksum_nds == NULL)
         {
             rc = TE_ENOMEM;
@@ -529,7 +531,8 @@ tad_gre_match_post_cb(csap_p              csap,
         asn_value *opt_key_nds;
         asn_value *opt_key_nvgre_nds;
 
-        opt_key_nds = asn_init_value(ndn_gre_header_opt_key);
+        opt_key_nds = asn_init_value_in(ndn_gre_header_opt_key,
+                                        meta_pkt_layer_nds);
         if (opt_key_nds == NULL)
         {
             rc = TE_ENOMEM;
@@ -544,7 +547,8 @@ tad_gre_match_post_cb(csap_p              csap,
             goto out;
         }
 
-        opt_key_nvgre_nds = asn_init_value(ndn_gre_header_opt_key_nvgre);
+        opt_key_nvgre_nds = asn_init_value_in(ndn_gre_header_opt_key_nvgre,
+                                              meta_pkt_layer_nds);
         if (opt_key_nvgre_nds == NULL)
         {
             rc = TE_ENOMEM;
@@ -569,7 +573,8 @@ tad_gre_match_post_cb(csap_p              csap,
     {
         asn_value *opt_seqn_nds;
 
-        opt_seqn_nds = asn_init_value(ndn_gre_header_opt_seqn);
+        opt_seqn_nds = asn_init_value_in(ndn_gre_header_opt_seqn,
+                                         meta_pkt_layer_nds);
         if (opt_seqn_nds == NULL)
         {
             rc = TE_ENOMEM;
@@ -1219,7 +1219,9 @@ tad_icmp6_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_icmp6_message)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_icmp6_message)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_icmp6_message);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
@@ -923,7 +923,9 @@ tad_ip4_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_ip4_header)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_ip4_header)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_ip4_header);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
@@ -61,7 +61,9 @@ tad_rte_mbuf_match_post_cb(csap_p              csap,
     if (~csap->state & CSAP_STATE_RESULTS)
         return 0;
 
-    if ((meta_pkt_layer->nds = asn_init_value(ndn_rte_mbuf_pdu)) == NULL)
+    if ((meta_pkt_layer->nds =
+             tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                         ndn_rte_mbuf_pdu)) == NULL)
     {
         ERROR_ASN_INIT_VALUE(ndn_rte_mbuf_pdu);
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
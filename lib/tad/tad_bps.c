@@ -51,6 +51,8 @@ tad_bps_pkt_frag_init(const tad_bps_pkt_frag *descr,
 
     bps->fields = fields;
     bps->descr = descr;
+    bps->rx_type = NULL;
+    bps->rx_paths = NULL;
 
     bps->tx_def = TE_ALLOC(fields * sizeof(bps->tx_def[0]));
     bps->rx_def = TE_ALLOC(fields * sizeof(bps->rx_def[0]));
@@ -131,6 +133,56 @@ tad_bps_pkt_frag_init(const tad_bps_pkt_frag *descr,
     return 0;
 }
 
+/**
+ * Free compiled paths to fragment fields in received packets NDS.
+ *
+ * @param bps       BPS internal data
+ */
+static void
+tad_bps_rx_paths_free(tad_bps_pkt_frag_def *bps)
+{
+    unsigned int    i;
+
+    if (bps->rx_paths == NULL)
+        return;
+
+    for (i = 0; i < bps->fields; ++i)
+        asn_path_free(bps->rx_paths[i]);
+    free(bps->rx_paths);
+    bps->rx_paths = NULL;
+    bps->rx_type = NULL;
+}
+
+/**
+ * Compile paths to fragment fields in received packets NDS of
+ * the specified type, if they are not compiled yet. Fields which
+ * paths cannot be compiled for are written by labels.
+ *
+ * @param bps       BPS internal data
+ * @param type      Type of received packets NDS
+ */
+static void
+tad_bps_rx_paths_compile(tad_bps_pkt_frag_def *bps, const asn_type *type)
+{
+    unsigned int    i;
+    char            tmp[64];
+
+    if (bps->rx_paths != NULL && bps->rx_type == type)
+        return;
+
+    tad_bps_rx_paths_free(bps);
+
+    bps->rx_paths = TE_ALLOC(bps->fields * sizeof(bps->rx_paths[0]));
+    bps->rx_type = type;
+
+    for (i = 0; i < bps->fields; ++i)
+    {
+        snprintf(tmp, sizeof(tmp), "%s.#plain", bps->descr[i].name);
+        if (asn_path_compile(type, tmp, bps->rx_paths + i) != 0)
+            bps->rx_paths[i] = NULL;
+    }
+}
+
 /* See description in tad_bps.h */
 void
 tad_bps_pkt_frag_free(tad_bps_pkt_frag_def *bps)
@@ -147,6 +199,7 @@ tad_bps_pkt_frag_free(tad_bps_pkt_frag_def *bps)
     }
     free(bps->tx_def);
     free(bps->rx_def);
+    tad_bps_rx_paths_free(bps);
 }
 
 /* See description in tad_bps.h */
@@ -650,9 +703,48 @@ tad_data_unit_to_nds(asn_value *nds, const char *name,
     return rc;
 }
 
+/**
+ * Write data unit of a fragment field to received packet NDS using
+ * compiled path to the field if it is available.
+ *
+ * @param def       Binary packet fragment definition
+ * @param i         Index of the field
+ * @param nds       Received packet NDS
+ * @param du        Data unit
+ *
+ * @return Status code.
+ */
+static te_errno
+tad_bps_data_unit_to_nds(const tad_bps_pkt_frag_def *def, unsigned int i,
+                         asn_value *nds, tad_data_unit_t *du)
+{
+    const asn_path *path = def->rx_paths[i];
+    te_errno        rc;
+
+    switch (path == NULL ? TAD_DU_UNDEF : du->du_type)
+    {
+        case TAD_DU_I32:
+            rc = asn_path_write_int32(nds, path, du->val_i32);
+            break;
+        case TAD_DU_OCTS:
+            rc = asn_path_write_value(nds, path, du->val_data.oct_str,
+                                      du->val_data.len);
+            break;
+        default:
+            return tad_data_unit_to_nds(nds, def->descr[i].name, du);
+    }
+
+    if (rc != 0)
+    {
+        WARN("data_unit_to_nds() rc %r, name '%s.#plain'",
+             rc, def->descr[i].name);
+    }
+    return rc;
+}
+
 /* See description in tad_bps.h */
 te_errno
-tad_bps_pkt_frag_match_post(const tad_bps_pkt_frag_def *def,
+tad_bps_pkt_frag_match_post(tad_bps_pkt_frag_def *def,
                             tad_bps_pkt_frag_data *pkt_data,
                             const tad_pkt *pkt, unsigned int *bitoff,
                             asn_value *nds)
@@ -670,6 +762,8 @@ tad_bps_pkt_frag_match_post(const tad_bps_pkt_frag_def *def,
         return TE_RC(TE_TAD_BPS, TE_EWRONGPTR);
     }
 
+    tad_bps_rx_paths_compile(def, asn_get_type(nds));
+
     for (i = 0; (rc == 0) && (i < def->fields); ++i, *bitoff += len)
     {
         if (def->descr[i].len > 0)
@@ -690,7 +784,7 @@ tad_bps_pkt_frag_match_post(const tad_bps_pkt_frag_def *def,
         if (len > 0)
             tad_bin_to_data_unit(pkt, *bitoff, len, pkt_data->dus + i);
 
-        rc = tad_data_unit_to_nds(nds, def->descr[i].name, pkt_data->dus + i);
+        rc = tad_bps_data_unit_to_nds(def, i, nds, pkt_data->dus + i);
         if (rc != 0)
         {
             WARN("bps_frag_match: rc %r, field idx %d, name '%s'",
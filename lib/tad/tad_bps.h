@@ -62,6 +62,13 @@ typedef struct tad_bps_pkt_frag_def {
                                          fragment fields Tx defaults */
     tad_data_unit_t        *rx_def; /**< Array of TAD data units for
                                          fragment fields Rx defaults */
+
+    const asn_type         *rx_type;  /**< Type of received packets NDS
+                                           @a rx_paths are compiled for */
+    asn_path              **rx_paths; /**< Compiled paths to fragment
+                                           fields in received packets NDS
+                                           (@c NULL for fields which are
+                                           written by labels) */
 } tad_bps_pkt_frag_def;
 
 /**
@@ -177,7 +184,7 @@ extern te_errno tad_bps_pkt_frag_match_do(
                     const tad_pkt *pkt, unsigned int *bitoff);
 
 extern te_errno tad_bps_pkt_frag_match_post(
-                    const tad_bps_pkt_frag_def *def,
+                    tad_bps_pkt_frag_def *def,
                     tad_bps_pkt_frag_data *pkt_data,
                     const tad_pkt *pkt, unsigned int *bitoff,
                     asn_value *nds);
@@ -142,6 +142,8 @@ enum {
                                          end of processing */
     CSAP_STATE_STOP       = 0x08000, /**< User request to stop */
     CSAP_STATE_DESTROY    = 0x10000, /**< CSAP is being destroyed */
+    CSAP_STATE_PACKETS_BINARY = 0x20000, /**< Report received packets
+                                              in binary records */
 };
 /*@}*/
 
@@ -32,10 +32,47 @@
 #include "tad_recv.h"
 
 #include "te_alloc.h"
+#include "te_dbuf.h"
 
 #define ANS_BUF 100
 #define RBUF 0x4000
 
+/** Compiled paths to fields of received packets NDS */
+static struct {
+    asn_path *match_unit;   /**< "match-unit" */
+    asn_path *ts_sec;       /**< "received.seconds" */
+    asn_path *ts_usec;      /**< "received.micro-seconds" */
+    asn_path *payload;      /**< "payload.#bytes" */
+} tad_recv_paths;
+
+/** Control of compilation of received packets NDS paths */
+static pthread_once_t tad_recv_paths_once = PTHREAD_ONCE_INIT;
+/** Status of compilation of received packets NDS paths */
+static te_errno tad_recv_paths_rc = 0;
+
+/**
+ * Compile paths to fields of received packets NDS, which are filled in
+ * for every received packet. The status is saved in tad_recv_paths_rc.
+ */
+static void
+tad_recv_paths_compile(void)
+{
+    te_errno rc;
+
+    if ((rc = asn_path_compile(ndn_raw_packet, "match-unit",
+                               &tad_recv_paths.match_unit)) != 0 ||
+        (rc = asn_path_compile(ndn_raw_packet, "received.seconds",
+                               &tad_recv_paths.ts_sec)) != 0 ||
+        (rc = asn_path_compile(ndn_raw_packet, "received.micro-seconds",
+                               &tad_recv_paths.ts_usec)) != 0 ||
+        (rc = asn_path_compile(ndn_raw_packet, "payload.#bytes",
+                               &tad_recv_paths.payload)) != 0)
+    {
+        ERROR("Failed to compile paths of received packets NDS: %r", rc);
+        tad_recv_paths_rc = TE_RC(TE_TAD_CH, rc);
+    }
+}
+
 /**
  * Preprocess traffic pattern sequence of PDUs using protocol-specific
  * callbacks.
@@ -629,6 +666,10 @@ tad_recv_start_prepare(csap_p csap, const char *ptrn_str,
         (flags & RCF_CH_TRRECV_PACKETS_NO_PAYLOAD))
         csap->state |= CSAP_STATE_PACKETS_NO_PAYLOAD;
 
+    if ((csap->state & CSAP_STATE_RESULTS) &&
+        (flags & RCF_CH_TRRECV_PACKETS_BINARY))
+        csap->state |= CSAP_STATE_PACKETS_BINARY;
+
     csap->first_pkt = csap->last_pkt = tad_tv_zero;
 
     CSAP_UNLOCK(csap);
@@ -1278,6 +1319,7 @@ tad_recv_do(csap_p csap)
         /* Read one packet from media */
         rc = read_cb(csap, timeout, pkt, &read_len);
         gettimeofday(&meta_pkt->ts, NULL);
+        meta_pkt->raw_len = read_len;
         F_VERB(CSAP_LOG_FMT "read callback returned len=%u: %r",
                CSAP_LOG_ARGS(csap), (unsigned)read_len, rc);
 
@@ -1471,6 +1513,100 @@ tad_recv_get_packet(csap_p csap, bool wait, tad_recv_pkt **pkt)
     return rc;
 }
 
+/**
+ * Append a binary record of a received packet to the buffer.
+ *
+ * @param csap          CSAP instance
+ * @param pkt           Received packet
+ * @param buf           Buffer with records
+ */
+static void
+tad_recv_pkt_bin_append(csap_p csap, const tad_recv_pkt *pkt, te_dbuf *buf)
+{
+    const tad_pkt      *raw = tad_pkts_first_pkt(&pkt->raw);
+    tad_bin_pkt_hdr     hdr;
+    size_t              frame_len;
+    size_t              pld_len;
+    size_t              off;
+
+    frame_len = MIN(pkt->raw_len, tad_pkt_len(raw));
+    if (csap->state & CSAP_STATE_PACKETS_NO_PAYLOAD)
+    {
+        /* Payload is the tail of the frame */
+        pld_len = tad_pkt_len(&pkt->payload);
+        frame_len = (pld_len < frame_len) ? frame_len - pld_len : 0;
+    }
+
+    hdr.len = htonl(frame_len);
+    hdr.ts_sec = htonl(pkt->ts.tv_sec);
+    hdr.ts_usec = htonl(pkt->ts.tv_usec);
+    hdr.match_unit = htonl(pkt->match_unit);
+    te_dbuf_append(buf, &hdr, sizeof(hdr));
+
+    off = buf->len;
+    te_dbuf_append(buf, NULL, frame_len);
+    if (frame_len > 0)
+        tad_pkt_read_bits(raw, 0, frame_len << 3, buf->ptr + off);
+}
+
+/**
+ * Report received packets in binary records. Records are sent in
+ * attachments of about TAD_BIN_REPLY_LEN bytes.
+ *
+ * @param csap          CSAP instance
+ * @param reply_ctx     TAD async reply context
+ * @param wait          Wait for more packets or end of processing
+ * @param got           Location for the number of got packets
+ *
+ * @return Status code.
+ */
+static te_errno
+tad_recv_get_packets_bin(csap_p csap, tad_reply_context *reply_ctx,
+                         bool wait, unsigned int *got)
+{
+/** Length of records to be accumulated before they are sent */
+#define TAD_BIN_REPLY_LEN   (64 << 10)
+
+    te_dbuf         buf = TE_DBUF_INIT(TE_DBUF_DEFAULT_GROW_FACTOR);
+    tad_recv_pkt   *pkt = NULL;
+    te_errno        rc;
+    te_errno        rc_reply = 0;
+
+    while ((rc = tad_recv_get_packet(csap, wait, &pkt)) == 0)
+    {
+        /* See tad_recv_get_packets() */
+        if (pkt->match_unit != -1)
+            (*got)++;
+
+        tad_recv_pkt_bin_append(csap, pkt, &buf);
+        tad_recv_pkt_free(csap, pkt);
+
+        if (buf.len >= TAD_BIN_REPLY_LEN)
+        {
+            TE_RC_UPDATE(rc_reply, tad_reply_bin(reply_ctx, buf.ptr,
+                                                 buf.len));
+            te_dbuf_reset(&buf);
+        }
+    }
+
+    if (buf.len > 0)
+        TE_RC_UPDATE(rc_reply, tad_reply_bin(reply_ctx, buf.ptr, buf.len));
+    te_dbuf_free(&buf);
+
+    if (rc_reply != 0)
+    {
+        ERROR(CSAP_LOG_FMT "Failed to report received packets: %r",
+              CSAP_LOG_ARGS(csap), rc_reply);
+    }
+
+    if (TE_RC_GET_ERROR(rc) == TE_ENOENT)
+        rc = 0;
+
+    return rc;
+
+#undef TAD_BIN_REPLY_LEN
+}
+
 /* See description in tad_api.h */
 te_errno
 tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
@@ -1487,14 +1623,37 @@ tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
     ENTRY(CSAP_LOG_FMT "wait=%u got=%p(%u)", CSAP_LOG_ARGS(csap),
           (unsigned)wait, got, (got == NULL) ? 0 : (int)*got);
 
-    while ((rc = tad_recv_get_packet(csap, wait, &pkt)) == 0)
+    if (csap->state & CSAP_STATE_PACKETS_BINARY)
+    {
+        rc = tad_recv_get_packets_bin(csap, reply_ctx, wait, got);
+        EXIT(CSAP_LOG_FMT "%r", CSAP_LOG_ARGS(csap), rc);
+        return rc;
+    }
+
+    pthread_once(&tad_recv_paths_once, tad_recv_paths_compile);
+    if (tad_recv_paths_rc != 0)
     {
+        EXIT(CSAP_LOG_FMT "%r", CSAP_LOG_ARGS(csap), tad_recv_paths_rc);
+        return tad_recv_paths_rc;
+    }
 
-        /* Process packet */
-        pkt->nds = asn_init_value(ndn_raw_packet);
-        /* FIXME: Check pkt->nds */
+    while ((rc = tad_recv_get_packet(csap, wait, &pkt)) == 0)
+    {
 
-        asn_write_int32(pkt->nds, pkt->match_unit, "match-unit");
+        /*
+         * Process packet: the NDS lives only until the packet is
+         * reported, so build it (including layers NDS created by
+         * match_post_cb callbacks) in an arena to free it at once.
+         */
+        pkt->nds = asn_init_value_arena(ndn_raw_packet, 0);
+        if (pkt->nds == NULL)
+        {
+            ERROR(CSAP_LOG_FMT "Failed to create received packet NDS",
+                  CSAP_LOG_ARGS(csap));
+            tad_recv_pkt_free(csap, pkt);
+            rc = TE_RC(TE_TAD_CH, TE_ENOMEM);
+            break;
+        }
 
         /*
          * Number of match packets must be reported here for backward
@@ -1505,14 +1664,22 @@ tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
         if (pkt->match_unit != -1)
             (*got)++;
 
-        asn_write_int32(pkt->nds, pkt->ts.tv_sec,
-                        "received.seconds");
-        asn_write_int32(pkt->nds, pkt->ts.tv_usec,
-                        "received.micro-seconds");
-        pdus = asn_init_value(ndn_generic_pdu_sequence);
-        if (asn_put_child_value(pkt->nds, pdus, PRIVATE, NDN_PKT_PDUS) != 0)
+        if ((rc = asn_path_write_int32(pkt->nds, tad_recv_paths.match_unit,
+                                       pkt->match_unit)) != 0 ||
+            (rc = asn_path_write_int32(pkt->nds, tad_recv_paths.ts_sec,
+                                       pkt->ts.tv_sec)) != 0 ||
+            (rc = asn_path_write_int32(pkt->nds, tad_recv_paths.ts_usec,
+                                       pkt->ts.tv_usec)) != 0)
+        {
+            ERROR(CSAP_LOG_FMT "Failed to fill in received packet NDS: %r",
+                  CSAP_LOG_ARGS(csap), rc);
+        }
+
+        pdus = asn_init_value_in(ndn_generic_pdu_sequence, pkt->nds);
+        if (pdus == NULL ||
+            asn_put_child_value(pkt->nds, pdus, PRIVATE, NDN_PKT_PDUS) != 0)
             ERROR("ERROR: %s:%u", __FILE__, __LINE__);
-        for (layer = 0; layer < csap->depth; ++layer)
+        for (layer = 0; pdus != NULL && layer < csap->depth; ++layer)
         {
             /*
              * Handle mismatch packet: silently skip layer if match packet
@@ -1521,6 +1688,7 @@ tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
             if (tad_pkt_len(tad_pkts_first_pkt(&pkt->layers[layer].pkts)) == 0)
                 continue;
 
+            pkt->layers[layer].pkt_nds = pkt->nds;
             if (csap_get_proto_support(csap, layer)->match_post_cb != NULL)
             {
                 rc = csap_get_proto_support(csap, layer)->match_post_cb(
@@ -1530,7 +1698,12 @@ tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
                             csap->id, layer, rc);
             }
 
-            pdu = asn_init_value(ndn_generic_pdu);
+            pdu = asn_init_value_in(ndn_generic_pdu, pkt->nds);
+            if (pdu == NULL)
+            {
+                ERROR("ERROR: %s:%u", __FILE__, __LINE__);
+                continue;
+            }
             if (asn_put_child_value(pdu, pkt->layers[layer].nds, PRIVATE,
                                     csap->layers[layer].proto_tag) != 0)
                 ERROR("ERROR: %s:%u", __FILE__, __LINE__);
@@ -1550,8 +1723,8 @@ tad_recv_get_packets(csap_p csap, tad_reply_context *reply_ctx, bool wait,
             }
             else
             {
-                rc = asn_write_value_field(pkt->nds, payload, payload_len,
-                                           "payload.#bytes");
+                rc = asn_path_write_value(pkt->nds, tad_recv_paths.payload,
+                                          payload, payload_len);
                 if (rc != 0)
                 {
                     ERROR("ASN error in add rest payload %r", rc);
@@ -30,6 +30,9 @@ typedef struct tad_recv_pkt_layer {
     asn_value  *nds;    /**< ASN.1 representation of the layer */
     tad_pkts    pkts;   /**< Packets */
     void       *opaque; /**< Opaque data to help matching */
+    asn_value  *pkt_nds; /**< ASN.1 representation of the whole packet
+                              the layer representation is put into
+                              (@c NULL if it is not created yet) */
 } tad_recv_pkt_layer;
 
 /**
@@ -46,6 +49,8 @@ typedef struct tad_recv_pkt {
     tad_pkt             payload;    /**< Payload of the packet */
 
     tad_pkts            raw;        /**< Raw packets */
+    size_t              raw_len;    /**< Length of received data in
+                                         the first raw packet */
 
     struct timeval      ts;         /**< Timestamp of the whole packet
                                          (timestamp of the last fragment
@@ -68,6 +73,23 @@ extern tad_recv_pkt *tad_recv_pkt_alloc(csap_p csap);
 extern void tad_recv_pkt_cleanup_upper(csap_p csap, tad_recv_pkt *pkt);
 extern void tad_recv_pkt_cleanup(csap_p csap, tad_recv_pkt *pkt);
 
+/**
+ * Create an empty ASN.1 representation of a received packet layer.
+ * If the representation of the whole packet is already created, the
+ * value is allocated from its arena and must be put into it.
+ *
+ * @param layer     Received packet layer data
+ * @param type      ASN.1 type of the layer representation
+ *
+ * @return Created value or @c NULL on failure.
+ */
+static inline asn_value *
+tad_recv_pkt_layer_init_nds(const tad_recv_pkt_layer *layer,
+                            const asn_type *type)
+{
+    return asn_init_value_in(type, layer->pkt_nds);
+}
+
 
 #ifdef __cplusplus
 } /* extern "C" */
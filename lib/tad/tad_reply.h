@@ -36,6 +36,9 @@ typedef te_errno (tad_reply_op_pkts)(void *, te_errno, unsigned int);
 /** Report received packet */
 typedef te_errno (tad_reply_op_pkt)(void *, const asn_value *);
 
+/** Report received packets in binary records */
+typedef te_errno (tad_reply_op_bin)(void *, const void *, size_t);
+
 /** TAD async reply backend specification */
 typedef struct tad_reply_spec {
     size_t                  opaque_size;
@@ -43,6 +46,7 @@ typedef struct tad_reply_spec {
     tad_reply_op_poll      *poll;
     tad_reply_op_pkts      *pkts;
     tad_reply_op_pkt       *pkt;
+    tad_reply_op_bin       *bin;
 } tad_reply_spec;
 
 
@@ -133,6 +137,21 @@ tad_reply_pkt(tad_reply_context *ctx, const asn_value *pkt)
                 ctx->spec->pkt(ctx->opaque, pkt) : 0;
 }
 
+/**
+ * Async report received packets in binary records.
+ *
+ * @param ctx           TAD async reply context
+ * @param buf           Records (see tad_bin_pkt_hdr)
+ * @param len           Length of records
+ */
+static inline te_errno
+tad_reply_bin(tad_reply_context *ctx, const void *buf, size_t len)
+{
+    return (ctx != NULL && ctx->spec != NULL && ctx->spec->bin != NULL) ?
+                ctx->spec->bin(ctx->opaque, buf, len) :
+                TE_RC(TE_TAD_CH, TE_EOPNOTSUPP);
+}
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
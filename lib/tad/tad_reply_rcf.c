@@ -29,6 +29,7 @@
 #include "logger_api.h"
 #include "comm_agent.h"
 #include "rcf_ch_api.h"
+#include "te_string.h"
 #include "asn_usr.h"
 #include "tad_reply_rcf.h"
 
@@ -124,62 +125,129 @@ tad_reply_rcf_pkts(void *opaque, te_errno rc, unsigned int num)
     return tad_reply_rfc_fmt(opaque, "%u %u", (unsigned int)rc, num);
 }
 
-static tad_reply_op_pkt tad_reply_rcf_pkt;
-static te_errno
-tad_reply_rcf_pkt(void *opaque, const asn_value *pkt)
-{
 /*
  * It is an upper estimation for "attach" and decimal presentation
  * of attach length.
  */
 #define EXTRA_BUF_SPACE     20
 
+/**
+ * Allocate a buffer for an answer with attachment and put the answer
+ * prefix followed by "attach" to it.
+ *
+ * @param ctx           RCF reply context
+ * @param attach_len    Length of the attachment
+ * @param buffer        Location for the allocated buffer
+ * @param cmd_len       Location for the offset of attachment in it
+ *
+ * @return Status code.
+ */
+static te_errno
+tad_reply_rcf_attach_alloc(const tad_reply_rcf_ctx *ctx, size_t attach_len,
+                           char **buffer, size_t *cmd_len)
+{
+    char   *buf;
+    int     ret;
+
+    buf = TE_ALLOC(ctx->prefix_len + EXTRA_BUF_SPACE + attach_len);
+
+    memcpy(buf, ctx->answer_buf, ctx->prefix_len);
+    ret = snprintf(buf + ctx->prefix_len, EXTRA_BUF_SPACE, " attach %u",
+                   (unsigned)attach_len);
+    if (ret >= EXTRA_BUF_SPACE)
+    {
+        ERROR("%s(): Upper estimation on required buffer space is wrong",
+              __FUNCTION__);
+        free(buf);
+        return TE_ESMALLBUF;
+    }
+
+    *buffer = buf;
+    *cmd_len = strlen(buf) + 1;
+
+    return 0;
+}
+
+static tad_reply_op_pkt tad_reply_rcf_pkt;
+static te_errno
+tad_reply_rcf_pkt(void *opaque, const asn_value *pkt)
+{
     tad_reply_rcf_ctx  *ctx = opaque;
-    te_errno            rc;
-    int                 ret;
+    te_string           str = TE_STRING_INIT;
+    size_t              head = ctx->prefix_len + EXTRA_BUF_SPACE;
+    char                attach[EXTRA_BUF_SPACE];
     size_t              attach_len;
-    int                 attach_rlen;
-    char               *buffer;
     size_t              cmd_len;
+    char               *cmd;
+    te_errno            rc;
+    int                 ret;
 
     assert(pkt != NULL);
 
-    attach_len = asn_count_txt_len(pkt, 0) + 1;
-    VERB("%s(): attach len %u", __FUNCTION__, (unsigned)attach_len);
+    /*
+     * Print the packet in one pass after the room reserved for the
+     * command, since the length of the attachment is not known yet.
+     */
+    te_string_append_buf(&str, NULL, head);
+    rc = asn_print_value_str(pkt, 0, &str);
+    if (rc != 0)
+    {
+        ERROR("%s(): asn_print_value_str() failed: %r", __FUNCTION__, rc);
+        te_string_free(&str);
+        return rc;
+    }
 
-    buffer = TE_ALLOC(ctx->prefix_len + EXTRA_BUF_SPACE + attach_len);
+    /* Attachment includes the terminating NUL */
+    attach_len = str.len - head + 1;
+    VERB("%s(): attach len %u", __FUNCTION__, (unsigned)attach_len);
 
-    memcpy(buffer, ctx->answer_buf, ctx->prefix_len);
-    ret = snprintf(buffer + ctx->prefix_len, EXTRA_BUF_SPACE, " attach %u",
+    ret = snprintf(attach, sizeof(attach), " attach %u",
                    (unsigned)attach_len);
-    if (ret >= EXTRA_BUF_SPACE)
+    if (ret >= (int)sizeof(attach))
     {
         ERROR("%s(): Upper estimation on required buffer space is wrong",
               __FUNCTION__);
-        free(buffer);
+        te_string_free(&str);
         return TE_ESMALLBUF;
     }
-    cmd_len = strlen(buffer) + 1;
 
-    if ((attach_rlen =
-         asn_sprint_value(pkt, buffer + cmd_len, attach_len, 0))
-        != (int)(attach_len - 1))
-    {
-        ERROR("%s(): asn_sprint_value() returns unexpected number: "
-              "expected %u, got %d",
-              __FUNCTION__, (unsigned)(attach_len - 1), attach_rlen);
-        free(buffer);
-        return TE_EFAULT;
-    }
+    /* Put the command just before the attachment */
+    cmd_len = ctx->prefix_len + ret + 1;
+    cmd = str.ptr + head - cmd_len;
+    memcpy(cmd, ctx->answer_buf, ctx->prefix_len);
+    memcpy(cmd + ctx->prefix_len, attach, ret + 1);
 
     RCF_CH_SAFE_LOCK;
-    rc = rcf_comm_agent_reply(ctx->rcfc, buffer, cmd_len + attach_len);
+    rc = rcf_comm_agent_reply(ctx->rcfc, cmd, cmd_len + attach_len);
     RCF_CH_SAFE_UNLOCK;
-    free(buffer);
+    te_string_free(&str);
 
     return rc;
+}
+
+static tad_reply_op_bin tad_reply_rcf_bin;
+static te_errno
+tad_reply_rcf_bin(void *opaque, const void *buf, size_t len)
+{
+    tad_reply_rcf_ctx  *ctx = opaque;
+    te_errno            rc;
+    char               *buffer;
+    size_t              cmd_len;
+
+    VERB("%s(): attach len %u", __FUNCTION__, (unsigned)len);
 
-#undef EXTRA_BUF_SPACE
+    rc = tad_reply_rcf_attach_alloc(ctx, len, &buffer, &cmd_len);
+    if (rc != 0)
+        return rc;
+
+    memcpy(buffer + cmd_len, buf, len);
+
+    RCF_CH_SAFE_LOCK;
+    rc = rcf_comm_agent_reply(ctx->rcfc, buffer, cmd_len + len);
+    RCF_CH_SAFE_UNLOCK;
+    free(buffer);
+
+    return rc;
 }
 
 /** Reply to RCF backend specification */
@@ -189,6 +257,7 @@ static const tad_reply_spec tad_reply_rfc = {
     .poll           = tad_reply_rcf_poll,
     .pkts           = tad_reply_rcf_pkts,
     .pkt            = tad_reply_rcf_pkt,
+    .bin            = tad_reply_rcf_bin,
 };
 
 
@@ -280,7 +280,8 @@ tad_vxlan_match_post_cb(csap_p              csap,
     if ((proto_data == NULL) || (pkt == NULL) || (pkt_data == NULL))
         return TE_RC(TE_TAD_CSAP, TE_EINVAL);
 
-    meta_pkt_layer_nds = asn_init_value(ndn_vxlan_header);
+    meta_pkt_layer_nds = tad_recv_pkt_layer_init_nds(meta_pkt_layer,
+                                                     ndn_vxlan_header);
     if (meta_pkt_layer_nds == NULL)
         return TE_RC(TE_TAD_CSAP, TE_ENOMEM);
 
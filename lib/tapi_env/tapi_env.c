@@ -28,6 +28,15 @@
 #if HAVE_PTHREAD_H
 #include <pthread.h>
 #endif
+#if HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
 
 #include "tapi_env.h"
 
@@ -42,6 +51,9 @@
 #include "tapi_rpc.h"
 #include "tapi_sockaddr.h"
 #include "te_alloc.h"
+#include "te_file.h"
+#include "te_string.h"
+#include "te_hash.h"
 
 /**
  * Function provided by FLEX.
@@ -54,15 +66,27 @@
 extern int env_cfg_parse(tapi_env *e, const char *cfg);
 
 
-/** Entry of the list with network node indexes */
-typedef struct node_index {
-    SLIST_ENTRY(node_index) links;  /**< Links */
-    unsigned int            net;    /**< Net index */
-    unsigned int            node;   /**< Node in the net index */
-} node_index;
+/** Name of the file in TE_TMP where bindings of environments are cached */
+#define TAPI_ENV_BIND_CACHE_FILE    "tapi_env_bind_cache"
 
-/** List of the network node indexes */
-typedef SLIST_HEAD(node_indexes, node_index) node_indexes;
+/**
+ * Network model prepared for binding of environment. Properties of
+ * nodes which require Configurator requests are got once before
+ * binding.
+ */
+typedef struct bind_ctx {
+    cfg_nets_t         *cfg_nets;   /**< Network model */
+    unsigned int       *first_node; /**< Index of the first node of
+                                         every net in per-node arrays */
+    char              **node_ta;    /**< Test Agent of every node
+                                         (@c NULL if it is unknown) */
+    enum net_node_type *ta_type;    /**< Type of Test Agent of every
+                                         node */
+    bool               *used;       /**< Whether node is already bound */
+} bind_ctx;
+
+/** Get index of node @p _j of net @p _i in per-node arrays */
+#define BIND_NODE(_ctx, _i, _j) ((_ctx)->first_node[_i] + (_j))
 
 static te_errno prepare_nets(tapi_env_nets *nets,
                              cfg_nets_t    *cfg_nets);
@@ -79,31 +103,27 @@ static te_errno add_address(tapi_env_addr         *env_addr,
                             cfg_nets_t            *cfg_nets,
                             const struct sockaddr *addr);
 
+static te_errno bind_env(tapi_env *env, const char *cfg);
 static te_errno bind_env_to_cfg_nets(tapi_env_ifs *ifs,
-                                     cfg_nets_t   *cfg_nets);
+                                     bind_ctx     *ctx);
 static bool bind_host_if(tapi_env_if  *iface,
                             tapi_env_ifs *ifs,
-                            cfg_nets_t   *cfg_nets,
-                            node_indexes *used_nodes);
-
-static int cmp_agent_names(cfg_handle node1, cfg_handle node2);
+                            bind_ctx     *ctx);
 
 static te_errno node_value_get_ith_inst_name(cfg_handle     node,
                                              unsigned int   i,
                                              char         **p_str);
 
-static void node_mark_used(node_indexes *used_nodes,
-                           unsigned int net, unsigned int node);
-static void node_unmark_used(node_indexes *used_nodes,
-                             unsigned int net, unsigned int node);
-static bool node_is_used(node_indexes *used_nodes,
-                            unsigned int net, unsigned int node);
+static char *get_node_ta(cfg_handle node);
+static enum net_node_type get_ta_type(const bind_ctx *ctx,
+                                      unsigned int i_net,
+                                      unsigned int i_node);
 
 static bool check_net_type_cfg_vs_env(cfg_net_t *net,
                                          tapi_env_type net_type);
 
-static bool check_node_type_vs_pcos(cfg_nets_t         *cfg_nets,
-                                       cfg_net_node_t     *node,
+static bool check_node_type_vs_pcos(bind_ctx           *ctx,
+                                       unsigned int        node,
                                        tapi_env_processes *processes);
 
 /* Resolve object name. If it's an alias name - return the actual object
@@ -220,7 +240,7 @@ tapi_env_get_rpcs_only(const char *cfg, tapi_env *env)
         return rc;
     }
 
-    rc = bind_env_to_cfg_nets(&env->ifs, &env->cfg_nets);
+    rc = bind_env(env, cfg);
     if (rc != 0)
         return rc;
 
@@ -285,7 +305,7 @@ tapi_env_get(const char *cfg, tapi_env *env)
         return TE_EENV;
     }
 
-    rc = bind_env_to_cfg_nets(&env->ifs, &env->cfg_nets);
+    rc = bind_env(env, cfg);
     if (rc != 0)
     {
         /* ERROR is logged in bind_env_to_cfg_nets function */
@@ -2147,32 +2167,171 @@ prepare_pcos(tapi_env_hosts *hosts)
 }
 
 
+/**
+ * Get properties of network model nodes required for binding.
+ *
+ * @param ctx           binding context to initialize
+ * @param cfg_nets      network model configuration
+ */
+static void
+bind_ctx_init(bind_ctx *ctx, cfg_nets_t *cfg_nets)
+{
+    unsigned int n_nodes = 0;
+    unsigned int i;
+    unsigned int j;
+
+    ctx->cfg_nets = cfg_nets;
+    ctx->first_node = TE_ALLOC((cfg_nets->n_nets + 1) *
+                               sizeof(*ctx->first_node));
+    for (i = 0; i < cfg_nets->n_nets; ++i)
+    {
+        ctx->first_node[i] = n_nodes;
+        n_nodes += cfg_nets->nets[i].n_nodes;
+    }
+    ctx->first_node[i] = n_nodes;
+
+    ctx->node_ta = TE_ALLOC((n_nodes + 1) * sizeof(*ctx->node_ta));
+    ctx->ta_type = TE_ALLOC((n_nodes + 1) * sizeof(*ctx->ta_type));
+    ctx->used = TE_ALLOC((n_nodes + 1) * sizeof(*ctx->used));
+
+    /*
+     * Test Agent of a node is resolved with a few Configurator
+     * requests; matcher compares them for every candidate node,
+     * so get them once.
+     */
+    for (i = 0; i < cfg_nets->n_nets; ++i)
+    {
+        for (j = 0; j < cfg_nets->nets[i].n_nodes; ++j)
+        {
+            ctx->node_ta[BIND_NODE(ctx, i, j)] =
+                get_node_ta(cfg_nets->nets[i].nodes[j].handle);
+        }
+    }
+
+    for (i = 0; i < cfg_nets->n_nets; ++i)
+    {
+        for (j = 0; j < cfg_nets->nets[i].n_nodes; ++j)
+            ctx->ta_type[BIND_NODE(ctx, i, j)] = get_ta_type(ctx, i, j);
+    }
+}
+
+/**
+ * Release memory allocated for binding context.
+ *
+ * @param ctx           binding context
+ */
+static void
+bind_ctx_fini(bind_ctx *ctx)
+{
+    unsigned int i;
+
+    for (i = 0; i < ctx->first_node[ctx->cfg_nets->n_nets]; ++i)
+        free(ctx->node_ta[i]);
+
+    free(ctx->node_ta);
+    free(ctx->ta_type);
+    free(ctx->used);
+    free(ctx->first_node);
+}
+
+/**
+ * Check whether two network model nodes belong to the same Test Agent.
+ *
+ * @param ctx           binding context
+ * @param node1         index of the first node
+ * @param node2         index of the second node
+ *
+ * @return @c true if Test Agents are known and equal.
+ */
+static bool
+bind_same_ta(const bind_ctx *ctx, unsigned int node1, unsigned int node2)
+{
+    return ctx->node_ta[node1] != NULL && ctx->node_ta[node2] != NULL &&
+           strcmp(ctx->node_ta[node1], ctx->node_ta[node2]) == 0;
+}
+
+/**
+ * Check whether host interface may be bound to the network model node
+ * taking into account interfaces bound before it.
+ *
+ * @param iface         host interface to be bound
+ * @param ifs           list with all hosts/interfaces
+ * @param ctx           binding context
+ * @param i             index of the net
+ * @param j             index of the node in the net
+ *
+ * @return @c true if the node suits the interface.
+ */
+static bool
+bind_if_node_suits(tapi_env_if *iface, tapi_env_ifs *ifs, bind_ctx *ctx,
+                   unsigned int i, unsigned int j)
+{
+    tapi_env_if *p;
+
+    if (ctx->used[BIND_NODE(ctx, i, j)])
+    {
+        VERB("Node (%u,%u) is already used", i, j);
+        return false;
+    }
+
+    if (!check_node_type_vs_pcos(ctx, BIND_NODE(ctx, i, j),
+                                 &iface->host->processes))
+    {
+        VERB("Node (%u,%u) type=%u is not suitable for the host",
+             i, j, ctx->cfg_nets->nets[i].nodes[j].type);
+        return false;
+    }
+    VERB("Node (%u,%u) match PCOs type", i, j);
+
+    /* Check that there is no conflicts with already bound nodes */
+    p = iface;
+    while ((p = p->links.cqe_prev) != (void *)ifs)
+    {
+        bool one_host;
+        bool one_ta;
+
+        one_host = (iface->host == p->host);
+        one_ta = bind_same_ta(ctx, BIND_NODE(ctx, i, j),
+                              BIND_NODE(ctx, p->net->i_net, p->i_node));
+        /*
+         * If host is the same, it implies that names are
+         * specified. If both names are not specified, allow
+         * any binding.
+         */
+        if ((one_host != one_ta) &&
+            ((iface->host->name != NULL) || (p->host->name != NULL)))
+        {
+            VERB("Hosts with %s names ('%s/%s' vs '%s/%s') "
+                 "can't be bound to nodes %s",
+                 one_host ? "the same" : "different",
+                 iface->host->name, iface->name,
+                 p->host->name, p->name,
+                 one_ta ? "with the same test agent" :
+                          "on different agents");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static te_errno
-bind_env_to_cfg_nets(tapi_env_ifs *ifs, cfg_nets_t *cfg_nets)
+bind_env_to_cfg_nets(tapi_env_ifs *ifs, bind_ctx *ctx)
 {
-    te_errno        rc = 0;
-    node_indexes    used_nodes;
-    node_index     *p;
+    tapi_env_if    *iface;
 
-    /* Initialize empty list with used nodes */
-    SLIST_INIT(&used_nodes);
+    CIRCLEQ_FOREACH(iface, ifs, links)
+        iface->net->i_net = iface->i_node = UINT_MAX;
 
     /* Recursively bind all hosts */
-    if (!bind_host_if(ifs->cqh_first, ifs, cfg_nets, &used_nodes))
+    if (!bind_host_if(ifs->cqh_first, ifs, ctx))
     {
         ERROR("Failed to bind requested environment configuration to "
               "available network configuration");
-        rc = TE_EENV;
-    }
-
-    /* Free list of used indexes */
-    while ((p = SLIST_FIRST(&used_nodes)) != NULL)
-    {
-        SLIST_REMOVE(&used_nodes, p, node_index, links);
-        free(p);
+        return TE_EENV;
     }
 
-    return rc;
+    return 0;
 }
 
 
@@ -2181,18 +2340,19 @@ bind_env_to_cfg_nets(tapi_env_ifs *ifs, cfg_nets_t *cfg_nets)
  *
  * @param iface         host interface to be bound
  * @param ifs           list with all hosts/interfaces
- * @param cfg_nets      network model configuration
- * @param used_nodes    list with used (net, node) indexes
+ * @param ctx           binding context
  *
  * @retval @c true      success
  * @retval @c false     failure
  */
 static bool
-bind_host_if(tapi_env_if *iface, tapi_env_ifs *ifs,
-             cfg_nets_t *cfg_nets, node_indexes *used_nodes)
+bind_host_if(tapi_env_if *iface, tapi_env_ifs *ifs, bind_ctx *ctx)
 {
+    cfg_nets_t     *cfg_nets = ctx->cfg_nets;
     unsigned int    i, j;
-    tapi_env_if    *p;
+    unsigned int    net_min = 0;
+    unsigned int    net_max = cfg_nets->n_nets;
+    bool            net_bound;
 
     if (iface == (void *)ifs)
         return true;
@@ -2204,103 +2364,357 @@ bind_host_if(tapi_env_if *iface, tapi_env_ifs *ifs,
     VERB("Try to bind host '%s' interface '%s'",
          iface->host->name, iface->name);
 
-    for (i = 0; i < cfg_nets->n_nets; ++i)
+    /*
+     * If some interface in the same net is already bound, only nodes
+     * of its net may be tried.
+     */
+    net_bound = (iface->net->i_net != UINT_MAX);
+    if (net_bound)
+    {
+        net_min = iface->net->i_net;
+        net_max = net_min + 1;
+    }
+
+    for (i = net_min; i < net_max; ++i)
     {
+        if (!check_net_type_cfg_vs_env(cfg_nets->nets + i,
+                                       iface->net->type))
+        {
+            VERB("Net %u is not suitable for the host in the net with "
+                 "type=%u", i, iface->net->type);
+            continue;
+        }
+
         for (j = 0; j < cfg_nets->nets[i].n_nodes; ++j)
         {
-            if (node_is_used(used_nodes, i, j))
-            {
-                VERB("Node (%u,%u) is already used", i, j);
+            if (!bind_if_node_suits(iface, ifs, ctx, i, j))
                 continue;
-            }
 
-            if (!check_net_type_cfg_vs_env(cfg_nets->nets + i,
-                                           iface->net->type))
+            /* No conflicts discovered */
+            iface->net->i_net = i;
+            iface->i_node = j;
+            ctx->used[BIND_NODE(ctx, i, j)] = true;
+            VERB("Mark (%u,%u) as used by '%s/%s'", i, j,
+                 iface->host->name, iface->name);
+            /* Try to bind the next host/interface */
+            if (bind_host_if(iface->links.cqe_next, ifs, ctx))
             {
-                VERB("Node (%u,%u) type=%u is not suitable for the host "
-                     "in the net with type=%u", i, j,
-                     cfg_nets->nets[i].nodes[j].type, iface->net->type);
-                continue;
+                return true;
             }
+            VERB("Failed to bind host '%s/%s', unmark (%u,%u)",
+                 iface->host->name, iface->name, i, j);
+            /* Failed to bind the host */
+            ctx->used[BIND_NODE(ctx, i, j)] = false;
+            iface->i_node = UINT_MAX;
+            if (!net_bound)
+                iface->net->i_net = UINT_MAX;
+        }
+    }
+
+    VERB("Failed to bind host '%s/%s'", iface->host->name, iface->name);
+
+    return false;
+}
+
+/**
+ * Make a key of environment binding in the cache. It consists of
+ * a hash of the network model (including values of nodes which refer
+ * to Test Agent resources) and environment configuration string
+ * without spaces.
+ *
+ * @param cfg           environment configuration string
+ * @param cfg_nets      network model configuration
+ * @param key           where to put the key
+ *
+ * @return Status code.
+ */
+static te_errno
+bind_cache_key(const char *cfg, cfg_nets_t *cfg_nets, te_string *key)
+{
+    uint64_t        hash = TE_HASH_FNV64_INIT;
+    unsigned int    i;
+    unsigned int    j;
+    te_errno        rc;
+
+    for (i = 0; i < cfg_nets->n_nets; ++i)
+    {
+        cfg_net_t *net = cfg_nets->nets + i;
+
+        hash = te_hash_fnv64_buf(hash, net->name, strlen(net->name) + 1);
+        hash = te_hash_fnv64_buf(hash, &net->handle, sizeof(net->handle));
+        hash = te_hash_fnv64_buf(hash, &net->n_nodes, sizeof(net->n_nodes));
+
+        for (j = 0; j < net->n_nodes; ++j)
+        {
+            cfg_net_node_t *node = net->nodes + j;
+            cfg_val_type    val_type = CVT_STRING;
+            char           *value;
+
+            rc = cfg_get_instance(node->handle, &val_type, &value);
+            if (rc != 0)
+                return rc;
+
+            hash = te_hash_fnv64_buf(hash, &node->handle, sizeof(node->handle));
+            hash = te_hash_fnv64_buf(hash, &node->type, sizeof(node->type));
+            hash = te_hash_fnv64_buf(hash, &node->rsrc_type,
+                                   sizeof(node->rsrc_type));
+            hash = te_hash_fnv64_buf(hash, value, strlen(value) + 1);
+            free(value);
+        }
+    }
+
+    te_string_append(key, "%016" PRIx64 " ", hash);
+    for (; *cfg != '\0'; cfg++)
+    {
+        if (!isspace((unsigned char)*cfg))
+            te_string_append(key, "%c", *cfg);
+    }
+
+    return 0;
+}
+
+/**
+ * Check whether a cache line holds binding with a given key.
+ *
+ * @param line          line of the cache file
+ * @param key           key of the binding
+ *
+ * @return @c true if the line matches the key.
+ */
+static bool
+bind_cache_line_match(const char *line, const char *key)
+{
+    size_t key_len = strlen(key);
+
+    return strncmp(line, key, key_len) == 0 && line[key_len] == ' ';
+}
+
+/**
+ * Look up environment binding in the cache and apply it.
+ * The cached binding is checked against the environment in the same
+ * way as the full search does, so that a stale entry is not applied.
+ *
+ * @param ifs           list with all hosts/interfaces
+ * @param ctx           binding context
+ * @param path          path to the cache file
+ * @param key           key of the binding
+ *
+ * @return @c true if binding was found and applied.
+ */
+static bool
+bind_cache_lookup(tapi_env_ifs *ifs, bind_ctx *ctx,
+                  const char *path, const char *key)
+{
+    cfg_nets_t     *cfg_nets = ctx->cfg_nets;
+    te_string       cache = TE_STRING_INIT;
+    const char     *line;
+    const char     *s;
+    tapi_env_if    *iface;
+    unsigned int    i;
+    bool            found = false;
+
+    /* Cache file does not exist before the first binding in a run */
+    if (access(path, F_OK) != 0 ||
+        te_file_read_string(&cache, false, 0, "%s", path) != 0)
+    {
+        te_string_free(&cache);
+        return false;
+    }
 
-            if (!check_node_type_vs_pcos(cfg_nets,
-                                         cfg_nets->nets[i].nodes + j,
-                                         &iface->host->processes))
+    for (line = cache.ptr; line != NULL && *line != '\0';
+         line = strchr(line, '\n'), line = (line == NULL ? NULL : line + 1))
+    {
+        if (bind_cache_line_match(line, key))
+        {
+            found = true;
+            break;
+        }
+    }
+
+    if (found)
+    {
+        CIRCLEQ_FOREACH(iface, ifs, links)
+            iface->net->i_net = iface->i_node = UINT_MAX;
+
+        s = line + strlen(key) + 1;
+        CIRCLEQ_FOREACH(iface, ifs, links)
+        {
+            unsigned int i_net;
+            unsigned int i_node;
+            int n = 0;
+
+            if (sscanf(s, "%u:%u%n", &i_net, &i_node, &n) != 2 ||
+                i_net >= cfg_nets->n_nets ||
+                i_node >= cfg_nets->nets[i_net].n_nodes ||
+                (iface->net->i_net != UINT_MAX &&
+                 iface->net->i_net != i_net) ||
+                !check_net_type_cfg_vs_env(cfg_nets->nets + i_net,
+                                           iface->net->type) ||
+                !bind_if_node_suits(iface, ifs, ctx, i_net, i_node))
             {
-                VERB("Node (%u,%u) type=%u is not suitable for the host",
-                     i, j, cfg_nets->nets[i].nodes[j].type);
-                continue;
+                WARN("Cached binding of host '%s/%s' does not suit "
+                     "the environment, bind it from scratch",
+                     iface->host->name, iface->name);
+                found = false;
+                break;
             }
-            VERB("Node (%u,%u) match PCOs type", i, j);
 
-            /* Check that there is no conflicts with already bound nodes */
-            p = iface;
-            while ((p = p->links.cqe_prev) != (void *)ifs)
-            {
-                bool one_host;
-                bool one_ta;
+            iface->net->i_net = i_net;
+            iface->i_node = i_node;
+            ctx->used[BIND_NODE(ctx, i_net, i_node)] = true;
+            s += n;
+            if (*s == ',')
+                s++;
+        }
+    }
 
-                if (iface->net == p->net)
-                {
-                    if (i != p->net->i_net)
-                    {
-                        VERB("Hosts '%s/%s'(0x%x) and '%s/%s'(0x%x) "
-                             "must be in one net", iface->host->name,
-                             iface->name, iface, p->host->name,
-                             p->name, p);
-                        break;
-                    }
-                }
-                one_host = (iface->host == p->host);
-                one_ta = (cmp_agent_names(
-                              cfg_nets->nets[i].nodes[j].handle,
-                              cfg_nets->nets[p->net->i_net].
-                                  nodes[p->i_node].handle) == 0);
-                /*
-                 * If host is the same, it implies that names are
-                 * specified. If both names are not specified, allow
-                 * any binding.
-                 */
-                if ((one_host != one_ta) &&
-                    ((iface->host->name != NULL) ||
-                     (p->host->name != NULL)))
-                {
-                    VERB("Hosts with %s names ('%s/%s' vs '%s/%s') "
-                         "can't be bound to nodes %s",
-                         one_host ? "the same" : "different",
-                         iface->host->name, iface->name,
-                         p->host->name, p->name,
-                         one_ta ? "with the same test agent" :
-                                  "on different agents");
-                    break;
-                }
+    if (!found)
+    {
+        CIRCLEQ_FOREACH(iface, ifs, links)
+            iface->net->i_net = iface->i_node = UINT_MAX;
+        for (i = 0; i < ctx->first_node[cfg_nets->n_nets]; ++i)
+            ctx->used[i] = false;
+    }
+
+    te_string_free(&cache);
+
+    return found;
+}
+
+/**
+ * Store environment binding in the cache replacing the entry with
+ * the same key if any.
+ *
+ * @param ifs           list with all bound hosts/interfaces
+ * @param path          path to the cache file
+ * @param key           key of the binding
+ */
+static void
+bind_cache_store(tapi_env_ifs *ifs, const char *path, const char *key)
+{
+    te_string       old = TE_STRING_INIT;
+    te_string       cache = TE_STRING_INIT;
+    const char     *line;
+    const char     *end;
+    char           *tmp_path = NULL;
+    tapi_env_if    *iface;
+    int             fd;
+
+    /* Keep bindings with other keys */
+    if (access(path, F_OK) == 0 &&
+        te_file_read_string(&old, false, 0, "%s", path) == 0)
+    {
+        for (line = old.ptr; line != NULL && *line != '\0';
+             line = (end == NULL ? NULL : end + 1))
+        {
+            end = strchr(line, '\n');
+            if (!bind_cache_line_match(line, key))
+            {
+                te_string_append(&cache, "%.*s\n",
+                                 (int)(end == NULL ? strlen(line) :
+                                                     (size_t)(end - line)),
+                                 line);
             }
-            if (p == (void *)ifs)
+        }
+    }
+
+    te_string_append(&cache, "%s ", key);
+    CIRCLEQ_FOREACH(iface, ifs, links)
+    {
+        te_string_append(&cache, "%s%u:%u",
+                         iface == ifs->cqh_first ? "" : ",",
+                         iface->net->i_net, iface->i_node);
+    }
+    te_string_append(&cache, "\n");
+
+    /*
+     * Tests may run simultaneously, so the new cache is written to
+     * a temporary file which atomically replaces the old one. A binding
+     * stored concurrently may be lost, it is just found again.
+     */
+    fd = te_file_create_unique_fd(&tmp_path, "%s.", NULL, path);
+    if (fd < 0)
+    {
+        WARN("Failed to create temporary file for environment binding "
+             "cache '%s'", path);
+    }
+    else
+    {
+        if (write(fd, cache.ptr, cache.len) != (ssize_t)cache.len)
+        {
+            WARN("Failed to write environment binding cache '%s'",
+                 tmp_path);
+            close(fd);
+            unlink(tmp_path);
+        }
+        else
+        {
+            close(fd);
+            if (rename(tmp_path, path) != 0)
             {
-                /* No conflicts discovered */
-                iface->net->i_net = i;
-                iface->i_node = j;
-                node_mark_used(used_nodes, i, j);
-                VERB("Mark (%u,%u) as used by '%s/%s'", i, j,
-                     iface->host->name, iface->name);
-                /* Try to bind the next host/interface */
-                if (bind_host_if(iface->links.cqe_next, ifs, cfg_nets,
-                                 used_nodes))
-                {
-                    return true;
-                }
-                VERB("Failed to bind host '%s/%s', unmark (%u,%u)",
-                     iface->host->name, iface->name, i, j);
-                /* Failed to bind the host */
-                node_unmark_used(used_nodes, i, j);
-                iface->net->i_net = iface->i_node = UINT_MAX;
+                WARN("Failed to replace environment binding cache '%s': %s",
+                     path, strerror(errno));
+                unlink(tmp_path);
             }
         }
+        free(tmp_path);
     }
 
-    VERB("Failed to bind host '%s/%s'", iface->host->name, iface->name);
+    te_string_free(&cache);
+    te_string_free(&old);
+}
 
-    return false;
+/**
+ * Bind environment to the network model. The result is cached in
+ * TE_TMP, so that tests of the same run with the same environment
+ * and unchanged network model do not repeat binding.
+ * The cache is not used if TE_ENV_NO_BIND_CACHE is set.
+ *
+ * @param env           environment
+ * @param cfg           environment configuration string
+ *
+ * @return Status code.
+ */
+static te_errno
+bind_env(tapi_env *env, const char *cfg)
+{
+    const char *te_tmp = getenv("TE_TMP");
+    te_string   path = TE_STRING_INIT;
+    te_string   key = TE_STRING_INIT;
+    bind_ctx    ctx;
+    bool        use_cache;
+    te_errno    rc;
+
+    bind_ctx_init(&ctx, &env->cfg_nets);
+
+    use_cache = (te_tmp != NULL && getenv("TE_ENV_NO_BIND_CACHE") == NULL);
+    if (use_cache)
+    {
+        te_string_append(&path, "%s/%s", te_tmp, TAPI_ENV_BIND_CACHE_FILE);
+        rc = bind_cache_key(cfg, &env->cfg_nets, &key);
+        if (rc != 0)
+        {
+            WARN("Failed to make environment binding cache key: %r", rc);
+            use_cache = false;
+        }
+        else if (bind_cache_lookup(&env->ifs, &ctx, path.ptr, key.ptr))
+        {
+            VERB("Environment binding is taken from cache");
+            rc = 0;
+            goto out;
+        }
+    }
+
+    rc = bind_env_to_cfg_nets(&env->ifs, &ctx);
+    if (rc == 0 && use_cache)
+        bind_cache_store(&env->ifs, path.ptr, key.ptr);
+
+out:
+    bind_ctx_fini(&ctx);
+    te_string_free(&key);
+    te_string_free(&path);
+
+    return rc;
 }
 
 static te_errno
@@ -2391,105 +2805,6 @@ get_node_ta(cfg_handle node)
     return ta;
 }
 
-/**
- * Compare names of the test agents in OID stored in network
- * configuration nodes.
- *
- * @param node1         handle of the first node
- * @param node1         handle of the second node
- *
- * @retval 0            equal
- * @retval != 0         not equal
- */
-static int
-cmp_agent_names(cfg_handle node1, cfg_handle node2)
-{
-    int         retval;
-    char       *agt1;
-    char       *agt2;
-
-    agt1 = get_node_ta(node1);
-    if (agt1 == NULL)
-        return -1;
-    agt2 = get_node_ta(node2);
-    if (agt2 == NULL)
-    {
-        free(agt1);
-        return -1;
-    }
-
-    retval = strcmp(agt1, agt2);
-
-    free(agt1);
-    free(agt2);
-
-    return retval;
-}
-
-
-/**
- * Mark node with indexes (net, node) as used.
- *
- * @param used_nodes    list of used indes pairs
- * @param net           net-index
- * @param node          node-index
- */
-static void
-node_mark_used(node_indexes *used_nodes, unsigned int net, unsigned int node)
-{
-    node_index *p = TE_ALLOC(sizeof(*p));
-
-    p->net = net;
-    p->node = node;
-
-    SLIST_INSERT_HEAD(used_nodes, p, links);
-}
-
-/**
- * Unmark node with indexes (net, node) as used.
- *
- * @param used_nodes    list of used indes pairs
- * @param net           net-index
- * @param node          node-index
- */
-static void
-node_unmark_used(node_indexes *used_nodes, unsigned int net, unsigned int node)
-{
-    node_index *p;
-
-    for (p = SLIST_FIRST(used_nodes);
-         (p != NULL) && ((net != p->net) || (node != p->node));
-         p = SLIST_NEXT(p, links));
-
-    if (p != NULL)
-    {
-        SLIST_REMOVE(used_nodes, p, node_index, links);
-        free(p);
-    }
-}
-
-/**
- * Is node with indexes (net, node) marked as used.
- *
- * @param used_nodes    list of used indes pairs
- * @param net           net-index
- * @param node          node-index
- *
- * @retval @c true      marked as used
- * @retval @c false     not marked as used
- */
-static bool
-node_is_used(node_indexes *used_nodes, unsigned int net, unsigned int node)
-{
-    node_index *p;
-
-    for (p = SLIST_FIRST(used_nodes);
-         (p != NULL) && ((net != p->net) || (node != p->node));
-         p = SLIST_NEXT(p, links));
-
-    return (p != NULL);
-}
-
 /**
  * Get type of PCOs.
  *
@@ -2545,15 +2860,18 @@ get_pcos_type(tapi_env_processes *procs)
 /**
  * Get TA type associated with specified configuration network node.
  *
- * @param cfg_nets      All information about configuration networks
- * @param node          Configuration network node
+ * @param ctx           binding context with Test Agents of nodes
+ * @param i_net         index of the net
+ * @param i_node        index of the node in the net
  *
  * @return Configuration network node type.
  */
 static enum net_node_type
-get_ta_type(cfg_nets_t *cfg_nets, cfg_net_node_t *node)
+get_ta_type(const bind_ctx *ctx, unsigned int i_net, unsigned int i_node)
 {
-    enum net_node_type  type = node->type;
+    const cfg_nets_t   *cfg_nets = ctx->cfg_nets;
+    unsigned int        node = BIND_NODE(ctx, i_net, i_node);
+    enum net_node_type  type = cfg_nets->nets[i_net].nodes[i_node].type;
     unsigned int        i;
     unsigned int        j;
 
@@ -2561,9 +2879,8 @@ get_ta_type(cfg_nets_t *cfg_nets, cfg_net_node_t *node)
     {
         for (j = 0; j < cfg_nets->nets[i].n_nodes; ++j)
         {
-            if ((node->handle != cfg_nets->nets[i].nodes[j].handle) &&
-                cmp_agent_names(node->handle,
-                    cfg_nets->nets[i].nodes[j].handle) == 0 &&
+            if (BIND_NODE(ctx, i, j) != node &&
+                bind_same_ta(ctx, node, BIND_NODE(ctx, i, j)) &&
                 cfg_nets->nets[i].nodes[j].type != NET_NODE_TYPE_AGENT)
             {
                 if (type == NET_NODE_TYPE_AGENT)
@@ -2608,15 +2925,15 @@ tapi_get_addr_type(tapi_env *env, const char *name)
 /**
  * Check that network node type matches type of requested PCOs.
  *
- * @param cfg_nets      All information about configuration networks
- * @param node          Configuration network node
+ * @param ctx           Binding context
+ * @param node          Index of configuration network node in @p ctx
  * @param processes     Processes with PCOs on the host to be bound
  *
  * @return Whether types match?
  */
 static bool
-check_node_type_vs_pcos(cfg_nets_t         *cfg_nets,
-                        cfg_net_node_t     *node,
+check_node_type_vs_pcos(bind_ctx           *ctx,
+                        unsigned int        node,
                         tapi_env_processes *processes)
 {
     tapi_env_type type = get_pcos_type(processes);
@@ -2626,9 +2943,9 @@ check_node_type_vs_pcos(cfg_nets_t         *cfg_nets,
         case TAPI_ENV_INVALID:
             return false;
         case TAPI_ENV_IUT:
-            return get_ta_type(cfg_nets, node) == NET_NODE_TYPE_NUT;
+            return ctx->ta_type[node] == NET_NODE_TYPE_NUT;
         case TAPI_ENV_IUT_PEER:
-            return get_ta_type(cfg_nets, node) == NET_NODE_TYPE_NUT_PEER;
+            return ctx->ta_type[node] == NET_NODE_TYPE_NUT_PEER;
         case TAPI_ENV_TESTER:
             return true;
         default:
@@ -567,6 +567,12 @@ extern te_errno tapi_env_init(tapi_env *env);
 /**
  * Get Socket API test suite environment for the test.
  *
+ * Result of binding the environment to configured networks is cached
+ * in @c TE_TMP directory, so that the next test with the same
+ * environment and the same networks configuration does not repeat
+ * the search. Set @c TE_ENV_NO_BIND_CACHE environment variable to
+ * disable the cache.
+ *
  * @param cfg       Environment configuration string
  * @param env       Location for environment
  *
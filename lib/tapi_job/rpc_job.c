@@ -522,6 +522,49 @@ rpc_job_receive_many(rcf_rpc_server *rpcs, unsigned int n_filters,
     RETVAL_TE_ERRNO(job_receive_many, out.retval);
 }
 
+te_errno
+rpc_job_receive_batch(rcf_rpc_server *rpcs, unsigned int n_filters,
+                      unsigned int *filters, int timeout_ms,
+                      unsigned int min_count, size_t min_bytes,
+                      tarpc_job_buffer **buffers, unsigned int *count)
+{
+    tarpc_job_receive_batch_in in;
+    tarpc_job_receive_batch_out out;
+    te_log_buf *tlbp_filters;
+
+    memset(&in, 0, sizeof(in));
+    memset(&out, 0, sizeof(out));
+
+    in.filters.filters_val = filters;
+    in.filters.filters_len = n_filters;
+    in.timeout_ms = timeout_ms;
+    in.min_count = min_count;
+    in.min_bytes = min_bytes;
+    in.count = *count;
+
+    rpc_job_set_rpcs_timeout(rpcs, timeout_ms, TAPI_RPC_JOB_BIG_TIMEOUT_MS);
+    rcf_rpc_call(rpcs, "job_receive_batch", &in, &out);
+    CHECK_RPC_ERRNO_UNCHANGED(job_receive_batch, out.retval);
+
+    tlbp_filters = te_log_buf_alloc();
+    TAPI_RPC_LOG(rpcs, job_receive_batch, "%u, {%s}, %d ms, %u, %zu, %u",
+                 "%r count=%u",
+                 in.filters.filters_len,
+                 tarpc_uint_array2log_buf(tlbp_filters,
+                                          in.filters.filters_len,
+                                          in.filters.filters_val),
+                 in.timeout_ms, in.min_count, (size_t)in.min_bytes, in.count,
+                 out.retval, out.buffers.buffers_len);
+    te_log_buf_free(tlbp_filters);
+
+    *buffers = out.buffers.buffers_val;
+    *count = out.buffers.buffers_len;
+    out.buffers.buffers_val = NULL;
+    out.buffers.buffers_len = 0;
+
+    RETVAL_TE_ERRNO(job_receive_batch, out.retval);
+}
+
 void
 tarpc_job_buffers_free(tarpc_job_buffer *buffers, unsigned int count)
 {
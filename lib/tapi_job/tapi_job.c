@@ -1301,9 +1301,14 @@ tapi_job_receive_last(const tapi_job_channel_set_t filters, int timeout_ms,
     return receive_common(filters, timeout_ms, buffer, rpc_job_receive_last);
 }
 
-te_errno
-tapi_job_receive_many(const tapi_job_channel_set_t filters, int timeout_ms,
-                      tapi_job_buffer_t **buffers, unsigned int *count)
+/*
+ * Receive multiple messages with rpc_job_receive_many() or, if
+ * @p batch is @c true, with rpc_job_receive_batch().
+ */
+static te_errno
+receive_many_common(const tapi_job_channel_set_t filters, int timeout_ms,
+                    bool batch, unsigned int min_count, size_t min_bytes,
+                    tapi_job_buffer_t **buffers, unsigned int *count)
 {
     unsigned int *channel_ids = NULL;
     unsigned int n_channels;
@@ -1327,8 +1332,16 @@ tapi_job_receive_many(const tapi_job_channel_set_t filters, int timeout_ms,
 
     silent_pass = rpcs->silent_pass;
     rpcs->silent_pass = filters[0]->silent_pass;
-    rc = rpc_job_receive_many(rpcs, n_channels, channel_ids, timeout_ms,
-                              &bufs, &bufs_count);
+    if (batch)
+    {
+        rc = rpc_job_receive_batch(rpcs, n_channels, channel_ids, timeout_ms,
+                                   min_count, min_bytes, &bufs, &bufs_count);
+    }
+    else
+    {
+        rc = rpc_job_receive_many(rpcs, n_channels, channel_ids, timeout_ms,
+                                  &bufs, &bufs_count);
+    }
     rpcs->silent_pass = silent_pass;
 
     free(channel_ids);
@@ -1352,6 +1365,23 @@ tapi_job_receive_many(const tapi_job_channel_set_t filters, int timeout_ms,
     return rc;
 }
 
+te_errno
+tapi_job_receive_many(const tapi_job_channel_set_t filters, int timeout_ms,
+                      tapi_job_buffer_t **buffers, unsigned int *count)
+{
+    return receive_many_common(filters, timeout_ms, false, 0, 0,
+                               buffers, count);
+}
+
+te_errno
+tapi_job_receive_batch(const tapi_job_channel_set_t filters, int timeout_ms,
+                       unsigned int min_count, size_t min_bytes,
+                       tapi_job_buffer_t **buffers, unsigned int *count)
+{
+    return receive_many_common(filters, timeout_ms, true, min_count,
+                               min_bytes, buffers, count);
+}
+
 void
 tapi_job_buffers_free(tapi_job_buffer_t *buffers, unsigned int count)
 {
@@ -650,6 +650,39 @@ extern te_errno tapi_job_receive_many(const tapi_job_channel_set_t filters,
                                       tapi_job_buffer_t **buffers,
                                       unsigned int *count);
 
+/**
+ * Obtain all pending messages from the specified filters at once,
+ * waiting until the filters together have at least @p min_count messages
+ * or at least @p min_bytes bytes of data, or until end of stream.
+ * If both thresholds are zero, a single message is enough. When
+ * the timeout expires, the messages available at that moment are
+ * returned.
+ *
+ * This allows to collect output of a job producing a lot of messages
+ * with few RPC calls instead of polling and receiving every message.
+ *
+ * @param filters     Set of filters to read from
+ * @param timeout_ms  Timeout to wait (negative means tapi_job_get_timeout())
+ *                    until the thresholds are reached
+ * @param min_count   Threshold on the number of messages (zero to ignore)
+ * @param min_bytes   Threshold on the size of data (zero to ignore)
+ * @param buffers     Where to save pointer to array of buffers with
+ *                    messages (should be released by caller with
+ *                    tapi_job_buffers_free())
+ * @param count       On input, maximum number of messages to retrieve.
+ *                    If zero, all available messages will be retrieved.
+ *                    On output - number of actually retrieved messages
+ *
+ * @return Status code.
+ * @retval TE_ETIMEDOUT     if there are no messages within @p timeout_ms
+ */
+extern te_errno tapi_job_receive_batch(const tapi_job_channel_set_t filters,
+                                       int timeout_ms,
+                                       unsigned int min_count,
+                                       size_t min_bytes,
+                                       tapi_job_buffer_t **buffers,
+                                       unsigned int *count);
+
 /**
  * Release array of message buffers.
  *
@@ -280,6 +280,35 @@ extern te_errno rpc_job_receive_many(rcf_rpc_server *rpcs,
                                      tarpc_job_buffer **buffers,
                                      unsigned int *count);
 
+/**
+ * Receive all pending messages from the specified filters at once,
+ * waiting until the filters have at least @p min_count messages or at
+ * least @p min_bytes bytes of data (see ta_job_receive_batch()).
+ *
+ * @param rpcs        RPC server
+ * @param n_filters   Number of filters
+ * @param filters     Set of filters to read from
+ * @param timeout_ms  Timeout to wait (negative means
+ *                    #TAPI_RPC_JOB_BIG_TIMEOUT_MS)
+ * @param min_count   Threshold on the number of messages (zero to ignore)
+ * @param min_bytes   Threshold on the size of data (zero to ignore)
+ * @param buffers     Where to save pointer to array of message buffers.
+ *                    It should be released by the caller with
+ *                    tarpc_job_buffers_free()
+ * @param count       On input, maximum number of messages to retrieve.
+ *                    If zero, all available messages will be retrieved.
+ *                    On output - number of actually retrieved messages
+ *
+ * @return Status code.
+ */
+extern te_errno rpc_job_receive_batch(rcf_rpc_server *rpcs,
+                                      unsigned int n_filters,
+                                      unsigned int *filters, int timeout_ms,
+                                      unsigned int min_count,
+                                      size_t min_bytes,
+                                      tarpc_job_buffer **buffers,
+                                      unsigned int *count);
+
 /**
  * Release array of message buffers.
  *
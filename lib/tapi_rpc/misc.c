@@ -717,6 +717,7 @@ rpc_pattern_sender(rcf_rpc_server *rpcs, int s,
     in.time2wait = args->time2wait;
     in.time2run = args->duration_sec;
     in.ignore_err = args->ignore_err;
+    in.batch = args->batch;
 
     if (rpcs->timeout == RCF_RPC_UNSPEC_TIMEOUT)
         rpcs->timeout = TE_SEC2MS(args->duration_sec +
@@ -738,6 +739,9 @@ rpc_pattern_sender(rcf_rpc_server *rpcs, int s,
         *(args->sent_ptr) = out.bytes;
     if (args->send_failed_ptr != NULL)
         *(args->send_failed_ptr) = out.func_failed;
+    args->stats.calls = out.calls;
+    args->stats.waits = out.waits;
+    args->stats.duration_us = out.duration_us;
 
     CHECK_RETVAL_VAR_IS_ZERO_OR_MINUS_ONE(pattern_sender, out.retval);
 
@@ -748,8 +752,10 @@ rpc_pattern_sender(rcf_rpc_server *rpcs, int s,
                  "delay_min=%d, delay_max=%d, delay_once=%d, "
                  "time2wait=%u, duration_sec=%d, "
                  "total_size=%" TE_PRINTF_64 "u, ignore_err=%d "
-                 "pollerr_handler=%s pollerr_handler_data=" RPC_PTR_FMT,
-                 "%d sent=%" TE_PRINTF_64 "u",
+                 "pollerr_handler=%s pollerr_handler_data=" RPC_PTR_FMT
+                 " batch=%u",
+                 "%d sent=%" TE_PRINTF_64 "u calls=%" TE_PRINTF_64 "u "
+                 "waits=%" TE_PRINTF_64 "u duration=%" TE_PRINTF_64 "uus",
                  s, args->gen_func, TARPC_PAT_GEN_ARG_VAL(in.gen_arg),
                  args->snd_wrapper, RPC_PTR_VAL(args->snd_wrapper_ctx),
                  iomux2str(args->iomux),
@@ -760,8 +766,9 @@ rpc_pattern_sender(rcf_rpc_server *rpcs, int s,
                  (args->pollerr_handler == NULL ?
                     "(none)" :
                     args->pollerr_handler),
-                 RPC_PTR_VAL(args->pollerr_handler_data),
-                 out.retval, out.bytes);
+                 RPC_PTR_VAL(args->pollerr_handler_data), args->batch,
+                 out.retval, out.bytes, out.calls, out.waits,
+                 out.duration_us);
     RETVAL_INT(pattern_sender, out.retval);
 }
 
@@ -827,6 +834,7 @@ rpc_pattern_receiver(rcf_rpc_server *rpcs, int s,
                                   TAPI_RPC_TIMEOUT_EXTRA_SEC);
 
     in.ignore_pollerr = args->ignore_pollerr;
+    in.batch = args->batch;
 
     rcf_rpc_call(rpcs, "pattern_receiver", &in, &out);
 
@@ -843,6 +851,9 @@ rpc_pattern_receiver(rcf_rpc_server *rpcs, int s,
 
     if (args->recv_failed_ptr != NULL)
         *(args->recv_failed_ptr) = out.func_failed;
+    args->stats.calls = out.calls;
+    args->stats.waits = out.waits;
+    args->stats.duration_us = out.duration_us;
 
     CHECK_RETVAL_VAR_ERR_COND(pattern_receiver, out.retval,
                               !(out.retval <= 0 && out.retval >= -2), -1,
@@ -850,13 +861,16 @@ rpc_pattern_receiver(rcf_rpc_server *rpcs, int s,
 
     TAPI_RPC_LOG(rpcs, pattern_receiver, "fd=%d, gen_func='%s', "
                  "gen_arg=[" TARPC_PAT_GEN_ARG_FMT "], iomux='%s', "
-                 "time2wait=%u, duration_sec=%d, ignore_pollerr=%s",
-                 "%d received=%" TE_PRINTF_64 "u",
+                 "time2wait=%u, duration_sec=%d, ignore_pollerr=%s, "
+                 "batch=%u",
+                 "%d received=%" TE_PRINTF_64 "u calls=%" TE_PRINTF_64 "u "
+                 "waits=%" TE_PRINTF_64 "u duration=%" TE_PRINTF_64 "uus",
                  s, args->gen_func, TARPC_PAT_GEN_ARG_VAL(in.gen_arg),
                  iomux2str(args->iomux), args->time2wait,
                  args->duration_sec,
-                 (args->ignore_pollerr ? "TRUE" : "FALSE"),
-                 out.retval, out.bytes);
+                 (args->ignore_pollerr ? "TRUE" : "FALSE"), args->batch,
+                 out.retval, out.bytes, out.calls, out.waits,
+                 out.duration_us);
     RETVAL_INT(pattern_receiver, out.retval);
 }
 
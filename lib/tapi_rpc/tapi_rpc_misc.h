@@ -86,6 +86,17 @@ tapi_rand_gen_set(tapi_rand_gen *arg,
     arg->once = once;
 }
 
+/**
+ * Statistics of pattern sender or receiver run
+ */
+typedef struct tapi_pat_stats {
+    uint64_t    calls;          /**< Number of calls of data
+                                     transmitting function */
+    uint64_t    waits;          /**< Number of iomux waits */
+    uint64_t    duration_us;    /**< Duration of the run
+                                     (in microseconds) */
+} tapi_pat_stats;
+
 /**
  * Pattern sender settings
  */
@@ -133,11 +144,18 @@ typedef struct tapi_pat_sender {
                                                      argument (as the
                                                      second argument
                                                      socket FD is passed) */
+    unsigned int        batch;            /**< Maximum number of @b send()
+                                               calls made after a single
+                                               iomux wakeup until the
+                                               socket is not writable
+                                               (@c 0 or @c 1 means waiting
+                                               before every call) */
 
     /* out */
     uint64_t            sent;             /**< Number of sent bytes */
     bool send_failed;      /**< @c true if @b send() call
                                                failed */
+    tapi_pat_stats      stats;            /**< Statistics of the run */
 
     /*
      * These fields are alternative to fields without "_ptr". After
@@ -185,6 +203,12 @@ typedef struct tapi_pat_receiver {
                                                if it arrives instead of
                                                @c POLLIN, and continue
                                                polling */
+    unsigned int        batch;          /**< Maximum number of @b recv()
+                                             calls made after a single
+                                             iomux wakeup until there is
+                                             no more data (@c 0 or @c 1
+                                             means waiting before every
+                                             call) */
 
     /* out */
     uint64_t            exp_received;   /**< Number of bytes expected to
@@ -195,6 +219,7 @@ typedef struct tapi_pat_receiver {
     uint64_t            received;       /**< Number of received bytes */
     bool recv_failed;    /**< @c true if @b recv() call
                                              was failed */
+    tapi_pat_stats      stats;          /**< Statistics of the run */
 
     /*
      * These fields are alternative to fields without "_ptr". After
@@ -22,10 +22,15 @@
 #ifdef HAVE_SYS_TIME_H
 #include <sys/time.h>
 #endif
+#ifdef HAVE_ARPA_INET_H
+#include <arpa/inet.h>
+#endif
 
 #include "te_defs.h"
 #include "te_errno.h"
 #include "te_str.h"
+#include "te_string.h"
+#include "te_file.h"
 #include "tad_common.h"
 
 #include "logger_api.h"
@@ -257,6 +262,7 @@ tapi_tad_csap_create(const char *ta_name, int session,
     if ((rc = te_make_tmp_file(tmp_name)) != 0)
         return TE_RC(TE_TAPI, rc);
 
+    /* RCF sends the file to the agent as an attachment */
     rc = asn_save_to_file(csap_spec, tmp_name);
     if (rc != 0)
     {
@@ -326,6 +332,7 @@ tapi_tad_trsend_start(const char *ta_name, int session,
     if ((rc = te_make_tmp_file(tmp_name)) != 0)
         return TE_RC(TE_TAPI, rc);
 
+    /* RCF sends the file to the agent as an attachment */
     rc = asn_save_to_file(templ, tmp_name);
     if (rc != 0)
     {
@@ -387,6 +394,132 @@ tapi_tad_trrecv_start(const char *ta_name, int session,
 }
 
 
+/** Packet received in binary mode */
+struct tapi_tad_bin_pkt {
+    struct timeval  ts;         /**< Timestamp */
+    int             match_unit; /**< Index of matched pattern unit */
+    const uint8_t  *frame;      /**< Raw frame */
+    size_t          len;        /**< Length of the frame */
+    asn_value      *nds;        /**< ASN.1 representation made on demand
+                                     or @c NULL */
+};
+
+/* See the description in tapi_tad.h */
+void
+tapi_tad_bin_pkt_ts(const tapi_tad_bin_pkt *pkt, struct timeval *ts)
+{
+    *ts = pkt->ts;
+}
+
+/* See the description in tapi_tad.h */
+int
+tapi_tad_bin_pkt_match_unit(const tapi_tad_bin_pkt *pkt)
+{
+    return pkt->match_unit;
+}
+
+/* See the description in tapi_tad.h */
+const uint8_t *
+tapi_tad_bin_pkt_frame(const tapi_tad_bin_pkt *pkt, size_t *len)
+{
+    *len = pkt->len;
+    return pkt->frame;
+}
+
+/* See the description in tapi_tad.h */
+te_errno
+tapi_tad_bin_pkt_get_nds(tapi_tad_bin_pkt *pkt, const asn_value **nds)
+{
+    asn_value  *val;
+    te_errno    rc;
+
+    if (pkt->nds == NULL)
+    {
+        val = asn_init_value(ndn_raw_packet);
+        if (val == NULL)
+            return TE_RC(TE_TAPI, TE_ENOMEM);
+
+        rc = asn_write_int32(val, pkt->match_unit, "match-unit");
+        if (rc == 0)
+            rc = asn_write_int32(val, pkt->ts.tv_sec, "received.seconds");
+        if (rc == 0)
+        {
+            rc = asn_write_int32(val, pkt->ts.tv_usec,
+                                 "received.micro-seconds");
+        }
+        if (rc == 0)
+        {
+            rc = asn_write_value_field(val, pkt->frame, pkt->len,
+                                       "payload.#bytes");
+        }
+        if (rc != 0)
+        {
+            ERROR("%s(): failed to make ASN.1 value of a packet: %r",
+                  __FUNCTION__, rc);
+            asn_free_value(val);
+            return rc;
+        }
+
+        pkt->nds = val;
+    }
+
+    *nds = pkt->nds;
+    return 0;
+}
+
+/**
+ * Parse binary records of received packets (see tad_bin_pkt_hdr)
+ * from file and pass them one by one to user callback.
+ *
+ * @param filename      Name of the file with received packets
+ * @param cb_data       Callback data
+ */
+static void
+tapi_tad_trrecv_bin_handler(const char *filename,
+                            tapi_tad_trrecv_cb_data *cb_data)
+{
+    te_string           buf = TE_STRING_INIT;
+    tad_bin_pkt_hdr     hdr;
+    tapi_tad_bin_pkt    pkt;
+    size_t              off;
+    te_errno            rc;
+
+    rc = te_file_read_string(&buf, true, 0, "%s", filename);
+    if (rc != 0)
+    {
+        ERROR("Failed to read received packets from '%s': %r",
+              filename, rc);
+        return;
+    }
+
+    for (off = 0; off < buf.len; off += sizeof(hdr) + pkt.len)
+    {
+        if (buf.len - off < sizeof(hdr))
+        {
+            ERROR("Truncated header of received packet record");
+            break;
+        }
+        memcpy(&hdr, buf.ptr + off, sizeof(hdr));
+
+        memset(&pkt, 0, sizeof(pkt));
+        pkt.len = ntohl(hdr.len);
+        if (buf.len - off - sizeof(hdr) < pkt.len)
+        {
+            ERROR("Truncated frame of received packet record");
+            break;
+        }
+        pkt.ts.tv_sec = ntohl(hdr.ts_sec);
+        pkt.ts.tv_usec = ntohl(hdr.ts_usec);
+        pkt.match_unit = (int32_t)ntohl(hdr.match_unit);
+        pkt.frame = (const uint8_t *)buf.ptr + off + sizeof(hdr);
+
+        cb_data->bin_callback(&pkt, cb_data->user_data);
+        asn_free_value(pkt.nds);
+    }
+
+    te_string_free(&buf);
+}
+
 /**
  * Packet handler which parse received packet from file into ASN value
  * and pass it together with user data to user callback.
@@ -406,6 +539,11 @@ tapi_tad_trrecv_pkt_handler(const char *filename, void *my_data)
     tapi_tad_trrecv_cb_data *cb_data =
         (tapi_tad_trrecv_cb_data *)my_data;
 
+    if (cb_data != NULL && cb_data->bin_callback != NULL)
+    {
+        tapi_tad_trrecv_bin_handler(filename, cb_data);
+        return;
+    }
 
     /* Parse file in any case to check that it is OK */
     rc = asn_parse_dvalue_in_file(filename, ndn_raw_packet,
@@ -442,6 +580,20 @@ tapi_tad_trrecv_make_cb_data(tapi_tad_trrecv_cb  callback,
     return res;
 }
 
+/* See the description in tapi_tad.h */
+tapi_tad_trrecv_cb_data *
+tapi_tad_trrecv_make_bin_cb_data(tapi_tad_trrecv_bin_cb  bin_callback,
+                                 void                   *user_data)
+{
+    tapi_tad_trrecv_cb_data *res;
+
+    res = TE_ALLOC(sizeof(*res));
+    res->bin_callback = bin_callback;
+    res->user_data = user_data;
+
+    return res;
+}
+
 
 /* See description in tapi_tad.h */
 te_errno
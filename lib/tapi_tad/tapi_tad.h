@@ -182,7 +182,10 @@ extern int tapi_tad_trsend_start(const char *ta_name, int session,
  * @param mode          The flags allows to specify the receive mode.
  *                      Count received packets only, store packets
  *                      to get to the test side later or use pattern sequence
- *                      matching.
+ *                      matching. If @c RCF_TRRECV_BINARY is set, stored
+ *                      packets are reported as raw frames and should be
+ *                      got with callback data made by
+ *                      tapi_tad_trrecv_make_bin_cb_data().
  *
  * @return Zero on success or error code
  */
@@ -207,12 +210,33 @@ extern te_errno tapi_tad_trrecv_start(const char      *ta_name,
 typedef void (*tapi_tad_trrecv_cb)(asn_value *packet,
                                    void      *user_data);
 
+/**
+ * Packet received in binary mode (see @c RCF_TRRECV_BINARY).
+ * It is valid only inside a callback it is passed to.
+ */
+typedef struct tapi_tad_bin_pkt tapi_tad_bin_pkt;
+
+/**
+ * Type for callback which will receive packets caught in binary mode.
+ *
+ * @param pkt           Received packet
+ * @param user_data     Pointer to opaque data, specified by user for his
+ *                      callback
+ */
+typedef void (*tapi_tad_trrecv_bin_cb)(tapi_tad_bin_pkt *pkt,
+                                       void             *user_data);
+
 /**
  * Structure for with parameters for receiving packets
  */
 typedef struct tapi_tad_trrecv_cb_data {
-    tapi_tad_trrecv_cb  callback;   /**< Callback */
-    void               *user_data;  /**< Pointer to user data for it */
+    tapi_tad_trrecv_cb      callback;       /**< Callback */
+    void                   *user_data;      /**< Pointer to user data
+                                                 for it */
+    tapi_tad_trrecv_bin_cb  bin_callback;   /**< Callback for packets
+                                                 received in binary mode;
+                                                 if it is set, @p callback
+                                                 is not used */
 } tapi_tad_trrecv_cb_data;
 
 /**
@@ -227,6 +251,65 @@ extern tapi_tad_trrecv_cb_data *tapi_tad_trrecv_make_cb_data(
                                     tapi_tad_trrecv_cb  callback,
                                     void               *user_data);
 
+/**
+ * Make struct with parameters for receiving packets in binary mode.
+ *
+ * @param bin_callback  User callback
+ * @param user_data     Pointer to user data for it
+ *
+ * @return pointer to new instance of structure.
+ */
+extern tapi_tad_trrecv_cb_data *tapi_tad_trrecv_make_bin_cb_data(
+                                    tapi_tad_trrecv_bin_cb  bin_callback,
+                                    void                   *user_data);
+
+/**
+ * Get timestamp of a packet received in binary mode.
+ *
+ * @param pkt           Received packet
+ * @param ts            Location for the timestamp
+ */
+extern void tapi_tad_bin_pkt_ts(const tapi_tad_bin_pkt *pkt,
+                                struct timeval *ts);
+
+/**
+ * Get index of the pattern unit matched by a packet received in
+ * binary mode.
+ *
+ * @param pkt           Received packet
+ *
+ * @return Index of the pattern unit or @c -1 for a mismatch packet.
+ */
+extern int tapi_tad_bin_pkt_match_unit(const tapi_tad_bin_pkt *pkt);
+
+/**
+ * Get raw frame of a packet received in binary mode.
+ *
+ * If receiving was started without payload, the frame is truncated
+ * to headers.
+ *
+ * @param pkt           Received packet
+ * @param len           Location for the frame length
+ *
+ * @return Frame data (valid as long as the packet).
+ */
+extern const uint8_t *tapi_tad_bin_pkt_frame(const tapi_tad_bin_pkt *pkt,
+                                             size_t *len);
+
+/**
+ * Get ASN.1 representation of a packet received in binary mode.
+ * The value of @c ndn_raw_packet type is made on the first call:
+ * it has timestamp, matched unit and the frame as payload, but no
+ * PDUs since layers are decoded on the agent side only.
+ *
+ * @param pkt           Received packet
+ * @param nds           Location for the value (owned by the packet)
+ *
+ * @return Status code.
+ */
+extern te_errno tapi_tad_bin_pkt_get_nds(tapi_tad_bin_pkt *pkt,
+                                         const asn_value **nds);
+
 /**
  * Continue already started receiving process on CSAP.
  * Blocks until reception is finished.
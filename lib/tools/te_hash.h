@@ -0,0 +1,130 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* Copyright (C) 2026 OKTET Labs Ltd. All rights reserved. */
+/** @file
+ * @brief Non-cryptographic hash functions
+ *
+ * @defgroup te_tools_te_hash Non-cryptographic hash functions
+ * @ingroup te_tools
+ * @{
+ *
+ * FNV-1a hash functions to be used in hash tables and caches.
+ * A hash may be calculated over several pieces of data by passing
+ * the result of the previous call to the next one, the first call
+ * should be passed the offset basis (@c TE_HASH_FNV32_INIT or
+ * @c TE_HASH_FNV64_INIT).
+ */
+
+#ifndef __TE_HASH_H__
+#define __TE_HASH_H__
+
+#include "te_config.h"
+
+#include "te_defs.h"
+#include "te_stdint.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** 32-bit FNV-1a offset basis */
+#define TE_HASH_FNV32_INIT      UINT32_C(2166136261)
+
+/** 32-bit FNV-1a prime */
+#define TE_HASH_FNV32_PRIME     UINT32_C(16777619)
+
+/** 64-bit FNV-1a offset basis */
+#define TE_HASH_FNV64_INIT      UINT64_C(14695981039346656037)
+
+/** 64-bit FNV-1a prime */
+#define TE_HASH_FNV64_PRIME     UINT64_C(1099511628211)
+
+/**
+ * Add a byte to 32-bit FNV-1a hash.
+ *
+ * @param hash          Hash of preceding data
+ * @param byte          Byte to add
+ *
+ * @return Updated hash.
+ */
+static inline uint32_t
+te_hash_fnv32_byte(uint32_t hash, uint8_t byte)
+{
+    return (hash ^ byte) * TE_HASH_FNV32_PRIME;
+}
+
+/**
+ * Add a buffer to 32-bit FNV-1a hash.
+ *
+ * @param hash          Hash of preceding data
+ * @param data          Data to add
+ * @param len           Length of @p data
+ *
+ * @return Updated hash.
+ */
+static inline uint32_t
+te_hash_fnv32_buf(uint32_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+
+    while (len-- > 0)
+        hash = te_hash_fnv32_byte(hash, *p++);
+
+    return hash;
+}
+
+/**
+ * Add a string (without terminating @c NUL) to 32-bit FNV-1a hash.
+ *
+ * @param hash          Hash of preceding data
+ * @param str           String to add
+ *
+ * @return Updated hash.
+ */
+static inline uint32_t
+te_hash_fnv32_str(uint32_t hash, const char *str)
+{
+    for (; *str != '\0'; str++)
+        hash = te_hash_fnv32_byte(hash, (uint8_t)*str);
+
+    return hash;
+}
+
+/**
+ * Add a byte to 64-bit FNV-1a hash.
+ *
+ * @param hash          Hash of preceding data
+ * @param byte          Byte to add
+ *
+ * @return Updated hash.
+ */
+static inline uint64_t
+te_hash_fnv64_byte(uint64_t hash, uint8_t byte)
+{
+    return (hash ^ byte) * TE_HASH_FNV64_PRIME;
+}
+
+/**
+ * Add a buffer to 64-bit FNV-1a hash.
+ *
+ * @param hash          Hash of preceding data
+ * @param data          Data to add
+ * @param len           Length of @p data
+ *
+ * @return Updated hash.
+ */
+static inline uint64_t
+te_hash_fnv64_buf(uint64_t hash, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+
+    while (len-- > 0)
+        hash = te_hash_fnv64_byte(hash, *p++);
+
+    return hash;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif /* !__TE_HASH_H__ */
+/**@} <!-- END te_tools_te_hash --> */
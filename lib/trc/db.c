@@ -265,6 +265,7 @@ trc_free_test_iters(trc_test_iters *iters)
         trc_free_test_iter(p);
         free(p);
     }
+    trc_test_iters_changed(iters);
 }
 
 /* See description in trc_db.h */
@@ -502,6 +503,7 @@ trc_db_test_delete_wilds(trc_test *test)
             trc_free_test_iter(p);
         }
     }
+    trc_test_iters_changed(&test->iters);
 }
 
 /* See the description in trc_db.h */
@@ -533,6 +535,7 @@ trc_db_new_test_iter(trc_test *test, unsigned int n_args,
         TAILQ_INSERT_TAIL(&test->iters.head, p, links);
     else
         TAILQ_INSERT_BEFORE(insert_before, p, links);
+    trc_test_iters_changed(&test->iters);
 
     return p;
 }
@@ -23,6 +23,7 @@
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <libxml/xinclude.h>
+#include <libxml/xmlreader.h>
 
 #include "logger_api.h"
 #include "te_alloc.h"
@@ -780,16 +781,16 @@ get_expected_results(xmlNodePtr *node, trc_exp_results *results)
 }
 
 /**
- * Allocate and get test iteration.
+ * Allocate test iteration and get its properties.
  *
  * @param node          XML node
- * @param db            TRC database
  * @param test          Parent test
+ * @param iter          Location for the new iteration
  *
  * @return Status code.
  */
 static te_errno
-alloc_and_get_test_iter(xmlNodePtr node, te_trc_db *db, trc_test *test)
+alloc_test_iter(xmlNodePtr node, trc_test *test, trc_test_iter **iter)
 {
     te_errno        rc;
     trc_test_iter  *p;
@@ -840,10 +841,34 @@ alloc_and_get_test_iter(xmlNodePtr node, te_trc_db *db, trc_test *test)
 
     p->args.node = node;
 
+    *iter = p;
+    return 0;
+}
+
+/**
+ * Allocate and get test iteration.
+ *
+ * @param node          XML node
+ * @param db            TRC database
+ * @param test          Parent test
+ *
+ * @return Status code.
+ */
+static te_errno
+alloc_and_get_test_iter(xmlNodePtr node, te_trc_db *db, trc_test *test)
+{
+    te_errno        rc;
+    trc_test_iter  *p;
+
+    rc = alloc_test_iter(node, test, &p);
+    if (rc != 0)
+        return rc;
+
     node = xmlNodeChildren(node);
 
     /* Get arguments of the iteration */
     rc = get_test_args(&node, &p->args);
+    trc_test_iters_changed(&test->iters);
     if (rc != 0)
         return rc;
 
@@ -1056,18 +1081,18 @@ update_boolean_prop(xmlNodePtr node, const char *property, bool value)
 }
 
 /**
- * Get expected result of the test.
+ * Allocate test and get its properties.
  *
  * @param node          XML node
- * @param db            TRC database
  * @param tests         List of tests to add the new test
  * @param parent        Parent iteration
+ * @param test          Location for the new test
  *
  * @return Status code.
  */
 static te_errno
-alloc_and_get_test(xmlNodePtr node, te_trc_db *db, trc_tests *tests,
-                   trc_test_iter *parent)
+alloc_test(xmlNodePtr node, trc_tests *tests, trc_test_iter *parent,
+           trc_test **test)
 {
     te_errno    rc;
     trc_test   *p;
@@ -1142,6 +1167,31 @@ alloc_and_get_test(xmlNodePtr node, te_trc_db *db, trc_tests *tests,
 
     INFO("Parsing test '%s' type=%d aux=%d", p->name, p->type, p->aux);
 
+    *test = p;
+    return 0;
+}
+
+/**
+ * Get expected result of the test.
+ *
+ * @param node          XML node
+ * @param db            TRC database
+ * @param tests         List of tests to add the new test
+ * @param parent        Parent iteration
+ *
+ * @return Status code.
+ */
+static te_errno
+alloc_and_get_test(xmlNodePtr node, te_trc_db *db, trc_tests *tests,
+                   trc_test_iter *parent)
+{
+    te_errno    rc;
+    trc_test   *p;
+
+    rc = alloc_test(node, tests, parent, &p);
+    if (rc != 0)
+        return rc;
+
     node = xmlNodeChildren(node);
 
     rc = get_node_with_text_content(&node, "objective", &p->objective);
@@ -1514,6 +1564,584 @@ trc_xinclude_process(xmlDocPtr doc, const char *location)
     return trc_xinclude_process_do(doc, root, trc_dir);
 }
 
+/**
+ * Get properties of TRC database from its root XML element.
+ *
+ * @param node      Root XML element
+ * @param db        TRC database
+ *
+ * @return Status code.
+ */
+static te_errno
+get_db_props(xmlNodePtr node, te_trc_db *db)
+{
+    char       *unknown_exp_status;
+    te_errno    rc;
+
+    rc = get_boolean_prop(node, "last_match", &db->last_match);
+    if (rc != 0)
+        return rc;
+
+    rc = get_boolean_prop(node, "merged", &db->merged);
+    if (rc != 0)
+        return rc;
+
+    db->version = XML2CHAR(xmlGetProp(node, CONST_CHAR2XML("version")));
+    if (db->version == NULL)
+    {
+        INFO("Version of the TRC DB is missing");
+    }
+
+    unknown_exp_status = XML2CHAR(xmlGetProp(node,
+                                CONST_CHAR2XML("unknown_exp_status")));
+    if (unknown_exp_status != NULL)
+    {
+        if (strcmp(unknown_exp_status, "passed_ok") == 0)
+            db->unknown_exp_status = TRC_UNKNOWN_EXP_STATUS_PASSED_OK;
+        else if (strcmp(unknown_exp_status, "passed_unknown") == 0)
+            db->unknown_exp_status = TRC_UNKNOWN_EXP_STATUS_PASSED_UNKNOWN;
+        free(unknown_exp_status);
+    }
+    else
+    {
+        db->unknown_exp_status = TRC_UNKNOWN_EXP_STATUS_PASSED_UNKNOWN;
+    }
+
+    return 0;
+}
+
+/*
+ * Streaming load of TRC database.
+ *
+ * XML files are read with xmlTextReader and in-memory database is
+ * built on the fly, so XML document of the whole database is never
+ * kept in memory. Only small leaf elements (arguments, expected
+ * results, notes, globals) are expanded into XML trees which are
+ * processed by the same functions as in the case of DOM-based load
+ * and freed by the reader as soon as it moves further. XInclude
+ * elements are followed when they are met.
+ */
+
+/** Context of streaming load of TRC database */
+typedef struct trc_stream_ctx {
+    te_trc_db  *db;     /**< TRC database being loaded */
+    const char *dir;    /**< Directory of the file being read */
+} trc_stream_ctx;
+
+/**
+ * Callback processing an element of TRC database during streaming
+ * load. It is called when the reader is positioned on the start of
+ * the element and it should leave the reader either on the same node
+ * or on the end of the element.
+ *
+ * @param ctx       Streaming load context
+ * @param reader    XML reader
+ * @param data      Data of the parent element
+ *
+ * @return Status code.
+ */
+typedef te_errno (*trc_stream_elem_cb)(trc_stream_ctx *ctx,
+                                       xmlTextReaderPtr reader,
+                                       void *data);
+
+/** Data of a test element processed by streaming load */
+typedef struct trc_stream_test {
+    trc_test   *test;       /**< Test */
+    int         stage;      /**< The last processed kind of children */
+} trc_stream_test;
+
+/** Data of an iteration element processed by streaming load */
+typedef struct trc_stream_iter {
+    trc_test_iter  *iter;   /**< Iteration */
+    int             stage;  /**< The last processed kind of children */
+} trc_stream_iter;
+
+/** Data of a list of tests processed by streaming load */
+typedef struct trc_stream_tests {
+    trc_tests      *tests;  /**< List of tests */
+    trc_test_iter  *parent; /**< Parent iteration */
+} trc_stream_tests;
+
+static te_errno trc_stream_file(trc_stream_ctx *ctx, const char *path,
+                                trc_stream_elem_cb cb, void *data);
+
+/**
+ * Report errors and warnings of XML reader.
+ */
+static void
+trc_stream_error(void *arg, const char *msg, xmlParserSeverities severity,
+                 xmlTextReaderLocatorPtr locator)
+{
+    const char *path = arg;
+    int         line = xmlTextReaderLocatorLineNumber(locator);
+
+    if (severity == XML_PARSER_SEVERITY_VALIDITY_WARNING ||
+        severity == XML_PARSER_SEVERITY_WARNING)
+        WARN("%s:%d: %s", path, line, msg);
+    else
+        ERROR("Error occurred during parsing TRC database file:\n"
+              "    %s:%d\n    %s", path, line, msg);
+}
+
+/**
+ * Expand the current element of XML reader into XML tree.
+ *
+ * @param reader    XML reader
+ *
+ * @return XML element or @c NULL in the case of failure.
+ */
+static xmlNodePtr
+trc_stream_expand(xmlTextReaderPtr reader)
+{
+    xmlNodePtr node = xmlTextReaderExpand(reader);
+
+    if (node == NULL)
+        ERROR("Failed to expand element '%s' of TRC database",
+              xmlTextReaderConstName(reader));
+
+    return node;
+}
+
+/**
+ * Process XInclude element: read the included file and process its
+ * root element as if it was met instead of XInclude element.
+ *
+ * @param ctx       Streaming load context
+ * @param reader    XML reader positioned on XInclude element
+ * @param cb        Callback processing elements of the parent
+ * @param data      Data of the parent element
+ *
+ * @return Status code.
+ */
+static te_errno
+trc_stream_include(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                   trc_stream_elem_cb cb, void *data)
+{
+    te_string   path = TE_STRING_INIT;
+    trc_file   *file;
+    char       *href;
+    te_errno    rc;
+
+    href = XML2CHAR(xmlTextReaderGetAttribute(reader,
+                                              CONST_CHAR2XML("href")));
+    if (href == NULL)
+    {
+        ERROR("Failed to obtain href property value of xi:include");
+        return TE_RC(TE_TRC, TE_EINVAL);
+    }
+
+    if (href[0] == '/')
+        te_string_append(&path, "%s", href);
+    else
+        te_string_append(&path, "%s/%s", ctx->dir, href);
+
+    INFO("%s(): including '%s'", __FUNCTION__, path.ptr);
+
+    /* Included files are tracked by href like in the case of DOM */
+    file = TE_ALLOC(sizeof(*file));
+    file->filename = href;
+    TAILQ_INSERT_TAIL(inc_files, file, links);
+
+    rc = trc_stream_file(ctx, path.ptr, cb, data);
+
+    TAILQ_REMOVE(inc_files, file, links);
+    free(file->filename);
+    free(file);
+    te_string_free(&path);
+
+    return rc;
+}
+
+/**
+ * Process all children elements of the current element.
+ *
+ * @param ctx       Streaming load context
+ * @param reader    XML reader positioned on the parent element,
+ *                  it is left on the end of the element
+ * @param cb        Callback to process each child element
+ * @param data      Data of the parent element
+ *
+ * @return Status code.
+ */
+static te_errno
+trc_stream_children(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                    trc_stream_elem_cb cb, void *data)
+{
+    int         depth = xmlTextReaderDepth(reader);
+    te_errno    rc;
+    int         ret;
+
+    if (xmlTextReaderIsEmptyElement(reader))
+        return 0;
+
+    ret = xmlTextReaderRead(reader);
+    while (ret == 1)
+    {
+        switch (xmlTextReaderNodeType(reader))
+        {
+            case XML_READER_TYPE_END_ELEMENT:
+                if (xmlTextReaderDepth(reader) == depth)
+                    return 0;
+                break;
+
+            case XML_READER_TYPE_ELEMENT:
+                if (xmlStrcmp(xmlTextReaderConstLocalName(reader),
+                              CONST_CHAR2XML("include")) == 0)
+                    rc = trc_stream_include(ctx, reader, cb, data);
+                else
+                    rc = cb(ctx, reader, data);
+                if (rc != 0)
+                    return rc;
+
+                /* Skip the rest of the element */
+                ret = xmlTextReaderNext(reader);
+                continue;
+
+            default:
+                /* Comments and text between elements are ignored */
+                break;
+        }
+        ret = xmlTextReaderRead(reader);
+    }
+
+    ERROR("Unexpected end of TRC database file in the element '%s'",
+          xmlTextReaderConstName(reader));
+    return TE_RC(TE_TRC, TE_EFMT);
+}
+
+static te_errno trc_stream_test_elem(trc_stream_ctx *ctx,
+                                     xmlTextReaderPtr reader, void *data);
+
+/**
+ * Process an element in the list of tests.
+ */
+static te_errno
+trc_stream_tests_elem(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                      void *data)
+{
+    trc_stream_tests   *tests = data;
+    trc_stream_test     test_data = { NULL, 0 };
+    const xmlChar      *name = xmlTextReaderConstLocalName(reader);
+    te_errno            rc;
+
+    if (xmlStrcmp(name, CONST_CHAR2XML("command")) == 0)
+        return 0;
+
+    if (xmlStrcmp(name, CONST_CHAR2XML("test")) != 0)
+    {
+        ERROR("%s: Unexpected element '%s'", __FUNCTION__, name);
+        return TE_RC(TE_TRC, TE_EFMT);
+    }
+
+    rc = alloc_test(xmlTextReaderCurrentNode(reader), tests->tests,
+                    tests->parent, &test_data.test);
+    if (rc != 0)
+        return rc;
+
+    /* XML node is freed by the reader */
+    test_data.test->node = test_data.test->iters.node = NULL;
+
+    rc = trc_stream_children(ctx, reader, trc_stream_test_elem, &test_data);
+    if (rc == 0 && test_data.stage == 0)
+    {
+        ERROR("Objective of the test '%s' is missing",
+              test_data.test->name);
+        rc = TE_RC(TE_TRC, TE_EFMT);
+    }
+
+    return rc;
+}
+
+/**
+ * Process an element of a test iteration.
+ */
+static te_errno
+trc_stream_iter_elem(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                     void *data)
+{
+    trc_stream_iter    *iter_data = data;
+    trc_test_iter      *iter = iter_data->iter;
+    const xmlChar      *name = xmlTextReaderConstLocalName(reader);
+    trc_stream_tests    tests = { &iter->tests, iter };
+    trc_exp_result     *result;
+    xmlNodePtr          node;
+    te_errno            rc;
+
+    /* Order of elements: arguments, notes, results, tests */
+    if (xmlStrcmp(name, CONST_CHAR2XML("arg")) == 0 &&
+        iter_data->stage <= 1)
+    {
+        iter_data->stage = 1;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        return alloc_and_get_test_arg(node, &iter->args);
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("notes")) == 0 &&
+             iter_data->stage <= 1)
+    {
+        iter_data->stage = 2;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        rc = get_text_content(node, "notes", &iter->notes);
+        if (rc != 0)
+            ERROR("Failed to get notes for the test iteration");
+        return rc;
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("results")) == 0 &&
+             iter_data->stage <= 3)
+    {
+        iter_data->stage = 3;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        result = TE_ALLOC(sizeof(*result));
+        TAILQ_INIT(&result->results);
+        STAILQ_INSERT_TAIL(&iter->exp_results, result, links);
+        get_expected_result(node, result);
+        return 0;
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("test")) == 0 ||
+             xmlStrcmp(name, CONST_CHAR2XML("command")) == 0)
+    {
+        iter_data->stage = 4;
+        return trc_stream_tests_elem(ctx, reader, &tests);
+    }
+
+    ERROR("Unexpected element '%s' in test iteration", name);
+    return TE_RC(TE_TRC, TE_EFMT);
+}
+
+/**
+ * Process an element of a test.
+ */
+static te_errno
+trc_stream_test_elem(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                     void *data)
+{
+    trc_stream_test    *test_data = data;
+    trc_test           *test = test_data->test;
+    const xmlChar      *name = xmlTextReaderConstLocalName(reader);
+    trc_stream_iter     iter_data = { NULL, 0 };
+    trc_test_iter_arg  *arg;
+    xmlNodePtr          node;
+    te_errno            rc;
+
+    /* Order of elements: objective, notes, globals, iterations */
+    if (xmlStrcmp(name, CONST_CHAR2XML("objective")) == 0 &&
+        test_data->stage == 0)
+    {
+        test_data->stage = 1;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        rc = get_text_content(node, "objective", &test->objective);
+        if (rc != 0)
+        {
+            ERROR("Failed to get objective of the test '%s': %r",
+                  test->name, rc);
+        }
+        return rc;
+    }
+    else if (test_data->stage == 0)
+    {
+        ERROR("Failed to get objective of the test '%s': "
+              "unexpected element '%s'", test->name, name);
+        return TE_RC(TE_TRC, TE_EFMT);
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("notes")) == 0 &&
+             test_data->stage == 1)
+    {
+        test_data->stage = 2;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        rc = get_text_content(node, "notes", &test->notes);
+        if (rc != 0)
+            ERROR("Failed to get notes of the test '%s'", test->name);
+        return rc;
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("globals")) == 0 &&
+             test_data->stage <= 2)
+    {
+        test_data->stage = 3;
+        node = trc_stream_expand(reader);
+        if (node == NULL)
+            return TE_RC(TE_TRC, TE_EFMT);
+
+        rc = get_globals(node, ctx->db, test);
+        if (rc != 0)
+        {
+            ERROR("%s: failed to update globals with test '%s': %r",
+                  __FUNCTION__, test->name, rc);
+        }
+        return rc;
+    }
+    else if (xmlStrcmp(name, CONST_CHAR2XML("iter")) == 0)
+    {
+        test_data->stage = 4;
+        rc = alloc_test_iter(xmlTextReaderCurrentNode(reader), test,
+                             &iter_data.iter);
+        if (rc != 0)
+            return rc;
+
+        /* XML nodes are freed by the reader */
+        iter_data.iter->node = NULL;
+        iter_data.iter->tests.node = NULL;
+        iter_data.iter->args.node = NULL;
+
+        rc = trc_stream_children(ctx, reader, trc_stream_iter_elem,
+                                 &iter_data);
+        TAILQ_FOREACH(arg, &iter_data.iter->args.head, links)
+            arg->node = NULL;
+        trc_test_iters_changed(&test->iters);
+        if (rc != 0)
+            ERROR("Failed to get iterations of the test '%s'", test->name);
+        return rc;
+    }
+
+    ERROR("Unexpected element '%s' in test entry", name);
+    return TE_RC(TE_TRC, TE_EFMT);
+}
+
+/**
+ * Process the root element of TRC database.
+ */
+static te_errno
+trc_stream_db_elem(trc_stream_ctx *ctx, xmlTextReaderPtr reader,
+                   void *data)
+{
+    trc_stream_tests    tests = { &ctx->db->tests, NULL };
+    te_errno            rc;
+
+    UNUSED(data);
+
+    if (xmlStrcmp(xmlTextReaderConstLocalName(reader),
+                  CONST_CHAR2XML("trc_db")) != 0)
+    {
+        ERROR("Unexpected root element of the DB XML file");
+        return TE_RC(TE_TRC, TE_EFMT);
+    }
+
+    rc = get_db_props(xmlTextReaderCurrentNode(reader), ctx->db);
+    if (rc != 0)
+        return rc;
+
+    return trc_stream_children(ctx, reader, trc_stream_tests_elem, &tests);
+}
+
+/**
+ * Read TRC database file and process its root element.
+ *
+ * @param ctx       Streaming load context
+ * @param path      Path to the file
+ * @param cb        Callback to process the root element
+ * @param data      Data passed to the callback
+ *
+ * @return Status code.
+ */
+static te_errno
+trc_stream_file(trc_stream_ctx *ctx, const char *path,
+                trc_stream_elem_cb cb, void *data)
+{
+    const char         *saved_dir = ctx->dir;
+    xmlTextReaderPtr    reader;
+    char               *dir;
+    char               *p;
+    te_errno            rc = 0;
+    int                 ret;
+
+    reader = xmlReaderForFile(path, NULL,
+                              XML_PARSE_NOBLANKS | XML_PARSE_NONET);
+    if (reader == NULL)
+    {
+        ERROR("Failed to open TRC database file '%s'", path);
+        return TE_RC(TE_TRC, TE_ENOENT);
+    }
+    xmlTextReaderSetErrorHandler(reader, trc_stream_error, (void *)path);
+
+    while ((ret = xmlTextReaderRead(reader)) == 1 &&
+           xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT);
+
+    if (ret != 1)
+    {
+        ERROR("Empty XML document '%s' of the DB with expected testing "
+              "results", path);
+        rc = TE_RC(TE_TRC, TE_EFMT);
+    }
+    else
+    {
+        dir = strdup(path);
+        p = strrchr(dir, '/');
+        if (p != NULL)
+            *p = '\0';
+        ctx->dir = (p != NULL) ? dir : ".";
+
+        rc = cb(ctx, reader, data);
+        ctx->dir = saved_dir;
+        free(dir);
+
+        /* Make sure the rest of the document is well-formed */
+        while (rc == 0 && (ret = xmlTextReaderNext(reader)) == 1);
+        if (rc == 0 && ret < 0)
+            rc = TE_RC(TE_TRC, TE_EFMT);
+    }
+
+    xmlFreeTextReader(reader);
+
+    return rc;
+}
+
+/**
+ * Load TRC database without keeping its XML document in memory.
+ *
+ * @param db        TRC database with file name set
+ *
+ * @return Status code.
+ */
+static te_errno
+trc_db_stream_load(te_trc_db *db)
+{
+    trc_stream_ctx  ctx = { db, "." };
+    trc_file       *file;
+    te_errno        rc;
+
+    inc_files = TE_ALLOC(sizeof(*inc_files));
+    TAILQ_INIT(inc_files);
+
+    file = TE_ALLOC(sizeof(*file));
+    file->filename = strdup(db->filename);
+    if (file->filename == NULL)
+    {
+        ERROR("Out of memory");
+        free(file);
+        return TE_ENOMEM;
+    }
+    TAILQ_INSERT_TAIL(inc_files, file, links);
+
+    rc = trc_stream_file(&ctx, db->filename, trc_stream_db_elem, NULL);
+    trc_files_free(inc_files);
+
+    if (rc != 0)
+    {
+        ERROR("Preprocessing of DB with expected testing results in "
+              "file '%s' failed", db->filename);
+    }
+    else
+    {
+        INFO("DB with expected testing results in file '%s' "
+             "parsed successfully", db->filename);
+    }
+
+    return rc;
+}
+
 /* See description in te_trc.h */
 te_errno
 trc_db_open_ext(const char *location, te_trc_db **db, int flags)
@@ -1538,6 +2166,9 @@ trc_db_open_ext(const char *location, te_trc_db **db, int flags)
     if ((*db)->filename == NULL)
         return TE_ENOMEM;
 
+    if ((flags & (TRC_OPEN_KEEP_DOM | TRC_OPEN_FIX_XINCLUDE)) == 0)
+        return trc_db_stream_load(*db);
+
     rc = trc_read_doc((*db)->filename, &(*db)->xml_doc);
     if (rc != 0)
         return rc;
@@ -1581,41 +2212,10 @@ trc_db_open_ext(const char *location, te_trc_db **db, int flags)
     }
     else
     {
-        const char *unknown_exp_status;
-
-        rc = get_boolean_prop(node, "last_match", &(*db)->last_match);
-        if (rc != 0)
-            return rc;
-
-        rc = get_boolean_prop(node, "merged", &(*db)->merged);
+        rc = get_db_props(node, *db);
         if (rc != 0)
             return rc;
 
-        (*db)->version = XML2CHAR(xmlGetProp(node,
-                                          CONST_CHAR2XML("version")));
-        if ((*db)->version == NULL)
-        {
-            INFO("Version of the TRC DB is missing");
-        }
-
-        unknown_exp_status = XML2CHAR(xmlGetProp(node,
-                                    CONST_CHAR2XML("unknown_exp_status")));
-        if (unknown_exp_status != NULL)
-        {
-            if (strcmp(unknown_exp_status, "passed_ok") == 0)
-                (*db)->unknown_exp_status =
-                    TRC_UNKNOWN_EXP_STATUS_PASSED_OK;
-            else if (strcmp(unknown_exp_status, "passed_unknown") == 0)
-                (*db)->unknown_exp_status =
-                    TRC_UNKNOWN_EXP_STATUS_PASSED_UNKNOWN;
-        }
-        else
-        {
-            (*db)->unknown_exp_status =
-                TRC_UNKNOWN_EXP_STATUS_PASSED_UNKNOWN;
-        }
-
-
         node = xmlNodeChildren(node);
         (*db)->tests.node = node;
 
@@ -1894,6 +2494,7 @@ insert_iter_after(trc_test_iters *iters, trc_test_iter *tgt,
         TAILQ_INSERT_HEAD(&iters->head, iter, links);
     else
         TAILQ_INSERT_AFTER(&iters->head, tgt, iter, links);
+    trc_test_iters_changed(iters);
 }
 
 static void fix_merged_tests(trc_tests *tests);
@@ -3323,6 +3924,7 @@ iters_filter_by_tags(trc_test_iters *iters, const tqh_strings *tags,
         else if (flags & TRC_FILTER_DEL_NO_RES)
         {
             TAILQ_REMOVE(&iters->head, iter, links);
+            trc_test_iters_changed(iters);
 
             if (iter->node != NULL)
             {
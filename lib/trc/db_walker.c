@@ -18,6 +18,7 @@
 
 #include "te_errno.h"
 #include "te_alloc.h"
+#include "te_hash.h"
 #include "logger_api.h"
 
 #include "te_trc.h"
@@ -571,6 +572,321 @@ trc_report_argument_compare (const void *arg1, const void *arg2)
                   ((trc_report_argument *)arg2)->name);
 }
 
+/** Entry of the index of test iterations */
+typedef struct trc_iter_index_entry {
+    struct trc_iter_index_entry *next;  /**< Next entry in the bucket */
+    uint64_t                     hash;  /**< Hash of arguments */
+    bool                         wild;  /**< Whether the iteration has
+                                             wildcard arguments */
+    trc_test_iter               *iter;  /**< Test iteration */
+} trc_iter_index_entry;
+
+/**
+ * Index of test iterations by arguments. Iterations having no
+ * wildcard arguments are placed in the hash table, other iterations
+ * are kept in a separate list and are always checked. Both buckets
+ * and the list of wildcards preserve the order of iterations.
+ */
+typedef struct trc_test_iters_index {
+    trc_iter_index_entry   *entries;    /**< Entries in the order of
+                                             iterations */
+    trc_iter_index_entry  **buckets;    /**< Hash table buckets */
+    unsigned int            mask;       /**< Number of buckets minus 1 */
+    trc_iter_index_entry  **wilds;      /**< Wildcard iterations */
+    unsigned int            n_wilds;    /**< Number of wildcard
+                                             iterations */
+} trc_test_iters_index;
+
+/**
+ * Add a string to the hash of test arguments.
+ *
+ * @param hash      Hash value to update
+ * @param str       String to add
+ * @param normspace Whether spaces should be processed in the same way
+ *                  as trc_db_strcmp_normspace() does
+ *
+ * @return Updated hash value.
+ */
+static uint64_t
+trc_args_hash_add(uint64_t hash, const char *str, bool normspace)
+{
+    bool started = false;
+    bool space = false;
+
+    for (; *str != '\0'; str++)
+    {
+        if (normspace && isspace(*str))
+        {
+            space = started;
+            continue;
+        }
+        if (space)
+        {
+            hash = te_hash_fnv64_byte(hash, ' ');
+            space = false;
+        }
+        hash = te_hash_fnv64_byte(hash, (uint8_t)*str);
+        started = true;
+    }
+
+    /* Add terminating zero to separate strings */
+    return te_hash_fnv64_byte(hash, '\0');
+}
+
+/**
+ * Calculate hash of arguments of a test iteration from TRC database.
+ *
+ * @param args      Arguments of the iteration
+ * @param hash      Where to save the hash value
+ *
+ * @return @c false if the iteration has wildcard arguments.
+ */
+static bool
+trc_iter_args_hash(const trc_test_iter_args *args, uint64_t *hash)
+{
+    const trc_test_iter_arg *arg;
+    uint64_t                 h = TE_HASH_FNV64_INIT;
+
+    TAILQ_FOREACH(arg, &args->head, links)
+    {
+        if (*arg->value == '\0')
+            return false;
+
+        h = trc_args_hash_add(h, arg->name, false);
+        h = trc_args_hash_add(h, arg->value, true);
+    }
+
+    *hash = h;
+    return true;
+}
+
+/**
+ * Calculate hash of sorted arguments of a test iteration from log
+ * in the same way as trc_iter_args_hash() does.
+ *
+ * @param n_args    Number of arguments
+ * @param args      Arguments sorted by name
+ * @param hash      Where to save the hash value
+ *
+ * @return @c false if the index cannot be used to match the arguments.
+ */
+static bool
+trc_report_args_hash(unsigned int n_args, const trc_report_argument *args,
+                     uint64_t *hash)
+{
+    uint64_t     h = TE_HASH_FNV64_INIT;
+    unsigned int i;
+
+    for (i = 0; i < n_args; i++)
+    {
+        if (args[i].variable)
+            continue;
+
+        /* Values of global variables are compared in a special way */
+        if (strncmp(args[i].value, TEST_ARG_VAR_PREFIX,
+                    strlen(TEST_ARG_VAR_PREFIX)) == 0)
+            return false;
+
+        h = trc_args_hash_add(h, args[i].name, false);
+        h = trc_args_hash_add(h, args[i].value, true);
+    }
+
+    *hash = h;
+    return true;
+}
+
+/* See the description in trc_db.h */
+void
+trc_test_iters_changed(trc_test_iters *iters)
+{
+    trc_test_iters_index *index = iters->index;
+
+    if (index == NULL)
+        return;
+
+    free(index->entries);
+    free(index->buckets);
+    free(index->wilds);
+    free(index);
+    iters->index = NULL;
+}
+
+/**
+ * Build the index of test iterations by arguments.
+ *
+ * @param iters     Queue of test iterations
+ *
+ * @return Index of iterations.
+ */
+static trc_test_iters_index *
+trc_test_iters_index_build(trc_test_iters *iters)
+{
+    trc_test_iters_index *index;
+    trc_test_iter        *iter;
+    trc_iter_index_entry *entry;
+    unsigned int          n_iters = 0;
+    unsigned int          n_buckets = 1;
+    unsigned int          i;
+
+    TAILQ_FOREACH(iter, &iters->head, links)
+        n_iters++;
+
+    while (n_buckets < n_iters)
+        n_buckets <<= 1;
+
+    index = TE_ALLOC(sizeof(*index));
+    index->entries = TE_ALLOC(n_iters * sizeof(*index->entries));
+    index->buckets = TE_ALLOC(n_buckets * sizeof(*index->buckets));
+    index->wilds = TE_ALLOC(n_iters * sizeof(*index->wilds));
+    index->mask = n_buckets - 1;
+
+    entry = index->entries;
+    TAILQ_FOREACH(iter, &iters->head, links)
+    {
+        entry->iter = iter;
+        entry->wild = !trc_iter_args_hash(&iter->args, &entry->hash);
+        if (entry->wild)
+            index->wilds[index->n_wilds++] = entry;
+        entry++;
+    }
+
+    /* Go backwards to keep the order of iterations in buckets */
+    for (i = n_iters; i-- > 0; )
+    {
+        entry = &index->entries[i];
+        if (!entry->wild)
+        {
+            entry->next = index->buckets[entry->hash & index->mask];
+            index->buckets[entry->hash & index->mask] = entry;
+        }
+    }
+
+    return index;
+}
+
+/** Iterations of a test matching arguments from log */
+typedef struct trc_iter_matches {
+    trc_test_iter  *last;       /**< The last matching iteration */
+    trc_test_iter  *old_exact;  /**< The last exact match from TRC
+                                     database */
+    trc_test_iter  *new_exact;  /**< The last exact match added by
+                                     TRC Update */
+    trc_test_iter  *wild;       /**< The last wildcard match */
+    bool            dup;        /**< Whether duplicates are detected */
+} trc_iter_matches;
+
+/**
+ * Take into account a matching test iteration.
+ *
+ * @param matches       Matches found so far
+ * @param iter          Matching iteration
+ * @param match_result  Result of matching (@c ITER_EXACT_MATCH or
+ *                      @c ITER_WILD_MATCH)
+ */
+static void
+trc_iter_matches_add(trc_iter_matches *matches, trc_test_iter *iter,
+                     int match_result)
+{
+    matches->last = iter;
+
+    if (match_result == ITER_WILD_MATCH)
+    {
+        /*
+         * TRC Update tool does not create
+         * wildcards iterations to be matched
+         * during log processing - so no need
+         * in new_ or old_ prefix.
+         */
+        if (matches->wild != NULL || matches->old_exact != NULL)
+            matches->dup = true;
+        matches->wild = iter;
+    }
+    else if (iter->log_found)
+    {
+        if (matches->new_exact != NULL)
+        {
+            matches->dup = true;
+            ERROR("TRC Update generates duplicates!");
+        }
+        matches->new_exact = iter;
+    }
+    else
+    {
+        if (matches->old_exact != NULL || matches->wild != NULL)
+            matches->dup = true;
+        matches->old_exact = iter;
+    }
+}
+
+/**
+ * Find iterations matching arguments from log using the index of
+ * test iterations. Matches are the same as found by checking every
+ * iteration with test_iter_args_match() in strict mode.
+ *
+ * @param walker        TRC database walker positioned on a test
+ * @param n_args        Number of arguments
+ * @param args          Arguments sorted by name
+ * @param matches       Where to save matches
+ *
+ * @return @c false if the index cannot be used for these arguments.
+ */
+static bool
+trc_iter_matches_lookup(te_trc_db_walker *walker, unsigned int n_args,
+                        trc_report_argument *args,
+                        trc_iter_matches *matches)
+{
+    trc_test_iters       *iters = &walker->test->iters;
+    trc_iter_index_entry *entry;
+    trc_iter_index_entry *last_exact = NULL;
+    trc_iter_index_entry *last_wild = NULL;
+    uint64_t              hash;
+    unsigned int          i;
+    int                   match_result;
+
+    /* Hashing is consistent only with the default comparison */
+    if (trc_db_compare_values != trc_db_strcmp_normspace ||
+        TAILQ_EMPTY(&iters->head) ||
+        !trc_report_args_hash(n_args, args, &hash))
+        return false;
+
+    if (iters->index == NULL)
+        iters->index = trc_test_iters_index_build(iters);
+
+    for (entry = iters->index->buckets[hash & iters->index->mask];
+         entry != NULL;
+         entry = entry->next)
+    {
+        if (entry->hash != hash)
+            continue;
+
+        match_result = test_iter_args_match(walker->db, &entry->iter->args,
+                                            n_args, args, true);
+        if (match_result != ITER_NO_MATCH)
+        {
+            trc_iter_matches_add(matches, entry->iter, match_result);
+            last_exact = entry;
+        }
+    }
+
+    for (i = 0; i < iters->index->n_wilds; i++)
+    {
+        entry = iters->index->wilds[i];
+        match_result = test_iter_args_match(walker->db, &entry->iter->args,
+                                            n_args, args, true);
+        if (match_result != ITER_NO_MATCH)
+        {
+            trc_iter_matches_add(matches, entry->iter, match_result);
+            last_wild = entry;
+        }
+    }
+
+    /* The last match is the one which is closer to the end of queue */
+    if (last_exact != NULL && (last_wild == NULL || last_exact > last_wild))
+        matches->last = last_exact->iter;
+
+    return true;
+}
+
 /* See the description in te_trc.h */
 bool
 trc_db_walker_step_iter(te_trc_db_walker *walker, unsigned int n_args,
@@ -590,15 +906,10 @@ trc_db_walker_step_iter(te_trc_db_walker *walker, unsigned int n_args,
     }
     else
     {
-        int found = 0;
         int match_result = 0;
 
-        trc_test_iter *iter = NULL;
-        trc_test_iter *old_exact_iter = NULL;
-        trc_test_iter *new_exact_iter = NULL;
-        trc_test_iter *wild_iter = NULL;
+        trc_iter_matches matches = { NULL, NULL, NULL, NULL, false };
         trc_test_iter *iter_to_copy = NULL;
-        bool dup_detected = false;
 
         bool user_match = false;
         const char *arg_names[n_args];
@@ -612,72 +923,50 @@ trc_db_walker_step_iter(te_trc_db_walker *walker, unsigned int n_args,
             arg_names[i] = args[i].name;
 
         qsort(args, n_args, sizeof(*args), trc_report_argument_compare);
-        for (walker->iter = TAILQ_FIRST(&walker->test->iters.head);
-             walker->iter != NULL;
-             walker->iter = TAILQ_NEXT(walker->iter, links))
-        {
-            if (func_args_match == NULL || walker->iter->log_found)
-            {
-                match_result = test_iter_args_match(walker->db,
-                                                    &walker->iter->args,
-                                                    n_args, args, true);
-            }
-            else
-            {
-                match_result = func_args_match(walker->iter,
-                                               n_args, args, false);
-                user_match = true;
-            }
 
-            if (match_result != ITER_NO_MATCH)
+        /*
+         * User-defined matching cannot be indexed, check all
+         * iterations in this case.
+         */
+        if (func_args_match != NULL ||
+            !trc_iter_matches_lookup(walker, n_args, args, &matches))
+        {
+            for (walker->iter = TAILQ_FIRST(&walker->test->iters.head);
+                 walker->iter != NULL;
+                 walker->iter = TAILQ_NEXT(walker->iter, links))
             {
-                iter = walker->iter;
-                found++;
-
-                if (match_result == ITER_WILD_MATCH)
+                if (func_args_match == NULL || walker->iter->log_found)
                 {
-                    /*
-                     * TRC Update tool does not create
-                     * wildcards iterations to be matched
-                     * during log processing - so no need
-                     * in new_ or old_ prefix.
-                     */
-                    if (wild_iter != NULL ||
-                        old_exact_iter != NULL)
-                        dup_detected = true;
-                    wild_iter = walker->iter;
-                }
-                else if (iter->log_found)
-                {
-                    if (new_exact_iter != NULL)
-                    {
-                        dup_detected = true;
-                        ERROR("TRC Update generates duplicates!");
-                    }
-                    new_exact_iter = walker->iter;
+                    match_result = test_iter_args_match(walker->db,
+                                                        &walker->iter->args,
+                                                        n_args, args, true);
                 }
                 else
                 {
-                    if (old_exact_iter != NULL ||
-                        wild_iter != NULL)
-                        dup_detected = true;
-                    old_exact_iter = walker->iter;
+                    match_result = func_args_match(walker->iter,
+                                                   n_args, args, false);
+                    user_match = true;
                 }
+
+                if (match_result != ITER_NO_MATCH)
+                    trc_iter_matches_add(&matches, walker->iter,
+                                         match_result);
             }
         }
 
+        walker->iter = NULL;
         if ((flags & STEP_ITER_MATCH_FLAGS) == 0)
-            walker->iter = iter;
+            walker->iter = matches.last;
         if (walker->iter == NULL &&
             !(flags & STEP_ITER_NO_MATCH_OLD))
-            walker->iter = old_exact_iter;
+            walker->iter = matches.old_exact;
         if (walker->iter == NULL &&
             !(flags & STEP_ITER_NO_MATCH_NEW))
-            walker->iter = new_exact_iter;
+            walker->iter = matches.new_exact;
         if (walker->iter == NULL &&
             !(flags &
               (STEP_ITER_NO_MATCH_WILD | STEP_ITER_NO_MATCH_OLD)))
-            walker->iter = wild_iter;
+            walker->iter = matches.wild;
 
         /* nothing found */
         if (walker->iter == NULL)
@@ -700,10 +989,10 @@ trc_db_walker_step_iter(te_trc_db_walker *walker, unsigned int n_args,
                  * can try to minimize unnecessary rearrangements.
                  */
 
-                if (wild_iter != NULL)
-                    iter_to_copy = wild_iter;
-                else if (old_exact_iter != NULL)
-                    iter_to_copy = old_exact_iter;
+                if (matches.wild != NULL)
+                    iter_to_copy = matches.wild;
+                else if (matches.old_exact != NULL)
+                    iter_to_copy = matches.old_exact;
 
                 VERB("Step iteration - force to create");
                 walker->iter = trc_db_new_test_iter(walker->test,
@@ -771,7 +1060,7 @@ trc_db_walker_step_iter(te_trc_db_walker *walker, unsigned int n_args,
          * For temporary merged database multiple matching entries
          * are fine.
          */
-        if (dup_detected && !walker->db->merged)
+        if (matches.dup && !walker->db->merged)
         {
             char *hash = trc_db_test_params_hash(n_args, args);
             ERROR("TEST='%s || %s'\n"
@@ -0,0 +1,196 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Test for TRC library.
+ *
+ * Generate a large TRC database split into files with XInclude,
+ * load it in streaming mode and with XML document kept in memory
+ * and print load time and peak RSS for both modes.
+ *
+ * Usage: db_load_perf [number of files [iterations per file]]
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+#include "te_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "te_defs.h"
+#include "te_sleep.h"
+#include "te_trc.h"
+#include "trc_db.h"
+
+/** Default number of included files */
+#define DB_LOAD_PERF_N_FILES 20
+
+/** Default number of iterations in every included file */
+#define DB_LOAD_PERF_N_ITERS 20000
+
+/* Write a file with a test having a lot of iterations */
+static int
+write_test_file(const char *dir, unsigned int n, unsigned int n_iters)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    unsigned int i;
+
+    snprintf(path, sizeof(path), "%s/test%u.xml", dir, n);
+    f = fopen(path, "w");
+    if (f == NULL)
+        return -1;
+
+    fprintf(f, "<?xml version=\"1.0\"?>\n"
+               "<test name=\"test%u\" type=\"script\">\n"
+               "  <objective>Test %u</objective>\n"
+               "  <notes/>\n", n, n);
+    for (i = 0; i < n_iters; i++)
+    {
+        fprintf(f, "  <iter result=\"PASSED\">\n"
+                   "    <arg name=\"a\">%u</arg>\n"
+                   "    <arg name=\"b\">value %u</arg>\n"
+                   "    <arg name=\"c\"/>\n"
+                   "    <notes/>\n"
+                   "    <results tags=\"linux\">\n"
+                   "      <result value=\"FAILED\">\n"
+                   "        <verdict>Verdict %u</verdict>\n"
+                   "      </result>\n"
+                   "    </results>\n"
+                   "  </iter>\n", i % 100, i, i % 7);
+    }
+    fprintf(f, "</test>\n");
+
+    return fclose(f);
+}
+
+/* Write the main file of the database including all test files */
+static int
+write_db(const char *dir, unsigned int n_files, unsigned int n_iters)
+{
+    char path[PATH_MAX];
+    FILE *f;
+    unsigned int i;
+
+    for (i = 0; i < n_files; i++)
+    {
+        if (write_test_file(dir, i, n_iters) != 0)
+            return -1;
+    }
+
+    snprintf(path, sizeof(path), "%s/trc.xml", dir);
+    f = fopen(path, "w");
+    if (f == NULL)
+        return -1;
+
+    fprintf(f, "<?xml version=\"1.0\"?>\n"
+               "<trc_db>\n"
+               "  <test name=\"suite\" type=\"package\">\n"
+               "    <objective>Suite</objective>\n"
+               "    <notes/>\n"
+               "    <iter result=\"PASSED\">\n"
+               "      <notes/>\n");
+    for (i = 0; i < n_files; i++)
+    {
+        fprintf(f, "      <xi:include "
+                   "xmlns:xi=\"http://www.w3.org/2003/XInclude\" "
+                   "href=\"test%u.xml\" parse=\"xml\"/>\n", i);
+    }
+    fprintf(f, "    </iter>\n"
+               "  </test>\n"
+               "</trc_db>\n");
+
+    return fclose(f);
+}
+
+/* Load the database in a child process and print statistics */
+static int
+measure_load(const char *dir, const char *mode, int flags)
+{
+    char path[PATH_MAX];
+    pid_t pid;
+    int status;
+
+    snprintf(path, sizeof(path), "%s/trc.xml", dir);
+
+    fflush(stdout);
+    pid = fork();
+    if (pid < 0)
+        return -1;
+
+    if (pid == 0)
+    {
+        struct timeval tv_start;
+        struct timeval tv_end;
+        struct rusage usage;
+        te_trc_db *db;
+        te_errno rc;
+
+        gettimeofday(&tv_start, NULL);
+        rc = trc_db_open_ext(path, &db, flags);
+        gettimeofday(&tv_end, NULL);
+        if (rc != 0)
+        {
+            printf("Failed to load TRC database: %x\n", rc);
+            fflush(stdout);
+            _exit(1);
+        }
+
+        getrusage(RUSAGE_SELF, &usage);
+        printf("%-10s load time %8.3f s, peak RSS %8ld KiB\n", mode,
+               (double)TIMEVAL_SUB(tv_end, tv_start) / 1000000,
+               usage.ru_maxrss);
+        fflush(stdout);
+        _exit(0);
+    }
+
+    if (waitpid(pid, &status, 0) < 0 ||
+        !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return -1;
+
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned int n_files = DB_LOAD_PERF_N_FILES;
+    unsigned int n_iters = DB_LOAD_PERF_N_ITERS;
+    char dir[] = "/tmp/te_trc_db_load_perf_XXXXXX";
+    char cmd[PATH_MAX];
+    int result = 0;
+
+    if (argc > 1)
+        n_files = strtoul(argv[1], NULL, 0);
+    if (argc > 2)
+        n_iters = strtoul(argv[2], NULL, 0);
+
+    if (mkdtemp(dir) == NULL)
+    {
+        printf("Failed to create temporary directory\n");
+        return 1;
+    }
+
+    if (write_db(dir, n_files, n_iters) != 0)
+    {
+        printf("Failed to write TRC database\n");
+        result = 1;
+    }
+    else
+    {
+        printf("TRC database: %u files, %u iterations in each\n",
+               n_files, n_iters);
+        if (measure_load(dir, "streaming", 0) != 0 ||
+            measure_load(dir, "DOM", TRC_OPEN_KEEP_DOM) != 0)
+            result = 1;
+    }
+
+    snprintf(cmd, sizeof(cmd), "rm -rf %s", dir);
+    if (system(cmd) != 0)
+        printf("Failed to remove %s\n", dir);
+
+    return result;
+}
@@ -0,0 +1,186 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/**
+ * Test for TRC library.
+ *
+ * Replay a large log over a TRC database with a test having a lot of
+ * iterations, check that the walker finds the same iterations with and
+ * without the index of iterations and print mean lookup times.
+ *
+ * Usage: walker_perf [number of iterations]
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+#include "te_config.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "te_defs.h"
+#include "te_alloc.h"
+#include "te_sleep.h"
+#include "te_trc.h"
+#include "trc_db.h"
+
+/** Default number of iterations of the test */
+#define WALKER_PERF_N_ITERS 20000
+
+/**
+ * Every iteration with such a number is matched by a wildcard record
+ * in TRC database (with a unique value of the second argument so that
+ * it is not matched by other records).
+ */
+#define WALKER_PERF_WILD_EVERY 97
+
+/** Number of distinct values of the first argument */
+#define WALKER_PERF_N_VALUES 1000
+
+/*
+ * Passing a user-defined matching function makes the walker check
+ * every iteration as it did before the index was introduced.
+ */
+static int
+linear_args_match(const void *iter, unsigned int n_args,
+                  trc_report_argument *args, bool is_strict)
+{
+    UNUSED(is_strict);
+
+    return test_iter_args_match(NULL, &((const trc_test_iter *)iter)->args,
+                                n_args, args, true);
+}
+
+/*
+ * Fill arguments of an iteration. Values from log are formatted with
+ * different spaces, wildcards are used only in TRC database.
+ */
+static void
+fill_args(trc_report_argument *args, char *a, char *b, unsigned int i,
+          bool from_log)
+{
+    bool wild = (i % WALKER_PERF_WILD_EVERY == 0);
+
+    memset(args, 0, 2 * sizeof(*args));
+
+    sprintf(a, from_log ? "%u value " : " %u  value",
+            i % WALKER_PERF_N_VALUES);
+    if (wild)
+        sprintf(b, "wild%u", i);
+    else
+        sprintf(b, "%u", i / WALKER_PERF_N_VALUES);
+
+    args[0].name = "b";
+    args[0].value = b;
+    args[1].name = "a";
+    args[1].value = (wild && !from_log) ? "" : a;
+}
+
+/* Replay the log of all iterations, return mean lookup time in us */
+static double
+replay_log(te_trc_db *db, trc_test *test, unsigned int n_iters,
+           func_args_match_ptr func, trc_test_iter **found)
+{
+    te_trc_db_walker *walker = trc_db_new_walker(db);
+    trc_report_argument args[2];
+    struct timeval tv_start;
+    struct timeval tv_end;
+    char a[32];
+    char b[32];
+    unsigned int i;
+
+    gettimeofday(&tv_start, NULL);
+    for (i = 0; i < n_iters; i++)
+    {
+        fill_args(args, a, b, i, true);
+        trc_db_walker_go_to_test(walker, test);
+        if (trc_db_walker_step_iter(walker, TE_ARRAY_LEN(args), args,
+                                    0, 0, func))
+            found[i] = trc_db_walker_get_iter(walker);
+        else
+            found[i] = NULL;
+        trc_db_walker_step_back(walker);
+    }
+    gettimeofday(&tv_end, NULL);
+
+    trc_db_free_walker(walker);
+
+    return (double)TIMEVAL_SUB(tv_end, tv_start) / n_iters;
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned int n_iters = WALKER_PERF_N_ITERS;
+    te_trc_db *db;
+    trc_test *test;
+    trc_test_iter **indexed;
+    trc_test_iter **linear;
+    trc_report_argument args[2];
+    char a[32];
+    char b[32];
+    double indexed_us;
+    double linear_us;
+    unsigned int i;
+    int result = 0;
+
+    if (argc > 1)
+        n_iters = strtoul(argv[1], NULL, 0);
+    if (n_iters == 0)
+    {
+        printf("Wrong number of iterations\n");
+        return 1;
+    }
+
+    if (trc_db_init(&db) != 0)
+    {
+        printf("Failed to initialize TRC database\n");
+        return 1;
+    }
+
+    test = trc_db_new_test(&db->tests, NULL, "walker_perf");
+    if (test == NULL)
+    {
+        printf("Failed to create a test\n");
+        return 1;
+    }
+
+    for (i = 0; i < n_iters; i++)
+    {
+        fill_args(args, a, b, i, false);
+        if (trc_db_new_test_iter(test, TE_ARRAY_LEN(args), args,
+                                 NULL) == NULL)
+        {
+            printf("Failed to create an iteration\n");
+            return 1;
+        }
+    }
+
+    indexed = TE_ALLOC(n_iters * sizeof(*indexed));
+    linear = TE_ALLOC(n_iters * sizeof(*linear));
+
+    indexed_us = replay_log(db, test, n_iters, NULL, indexed);
+    linear_us = replay_log(db, test, n_iters, linear_args_match, linear);
+    printf("Mean iteration lookup time among %u iterations: %.1f us "
+           "(indexed), %.1f us (linear)\n",
+           n_iters, indexed_us, linear_us);
+
+    for (i = 0; i < n_iters; i++)
+    {
+        if (indexed[i] == NULL)
+        {
+            printf("Iteration %u is not found\n", i);
+            result = 1;
+        }
+        else if (indexed[i] != linear[i])
+        {
+            printf("Different iterations are found for iteration %u\n", i);
+            result = 1;
+        }
+    }
+
+    free(indexed);
+    free(linear);
+    trc_db_close(db);
+
+    return result;
+}
@@ -105,6 +105,10 @@ typedef struct trc_test_iters {
 
     TAILQ_HEAD(, trc_test_iter) head;   /**< Head of the list */
 
+    struct trc_test_iters_index *index; /**< Index of iterations by
+                                             arguments built by TRC DB
+                                             walker on demand */
+
 } trc_test_iters;
 
 
@@ -296,6 +300,13 @@ typedef enum {
                                          xmlXIncludeProcess(). See
                                          trc_xinclude_process()
                                          description for more details. */
+    TRC_OPEN_KEEP_DOM     = 0x2,    /**< Load XML document of the
+                                         database and keep it to be
+                                         updated on saving. By default
+                                         the database is loaded in
+                                         streaming mode without XML
+                                         document (it is always kept
+                                         with TRC_OPEN_FIX_XINCLUDE) */
 } trc_open_flags;
 
 /** TRC DB saving options */
@@ -532,6 +543,15 @@ extern void trc_free_trc_tests(trc_tests *tests);
  */
 extern void trc_free_test_iters(trc_test_iters *iters);
 
+/**
+ * Drop the index of test iterations by arguments. It must be called
+ * whenever iterations are added to or removed from the queue or
+ * arguments of iterations in the queue are changed.
+ *
+ * @param iters     Queue of test iterations
+ */
+extern void trc_test_iters_changed(trc_test_iters *iters);
+
 /**
  * Free resources allocated for the test iteration.
  *
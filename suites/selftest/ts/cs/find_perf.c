@@ -0,0 +1,118 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/* Copyright (C) 2026 OKTET Labs Ltd. All rights reserved. */
+/** @file
+ * @brief Configurator lookup performance test
+ *
+ * Measure instance lookup time on a large configuration tree.
+ */
+
+/** @page cs-find_perf Configurator lookup performance
+ *
+ * @objective Measure how long it takes to find an instance by OID
+ *            when its father has a lot of sons.
+ *
+ * @param n_instances   Number of instances to add (may be overridden
+ *                      by @c TE_CS_FIND_PERF_N_INSTANCES environment
+ *                      variable to run the test on a larger tree)
+ *
+ * @par Scenario:
+ */
+
+#define TE_TEST_NAME "cs/find_perf"
+
+#include "te_config.h"
+
+#include "tapi_test.h"
+#include "conf_api.h"
+#include "te_str.h"
+#include "te_time.h"
+#include "te_mi_log.h"
+
+/** Object registered in cs.conf for the test */
+#define FIND_PERF_OID "/local:/cs_find_perf:"
+
+/**
+ * Find all the instances and get the mean lookup time.
+ *
+ * @param n_instances   Number of instances
+ *
+ * @return Mean lookup time in microseconds.
+ */
+static double
+find_all(unsigned int n_instances)
+{
+    struct timeval tv_start;
+    struct timeval tv_end;
+    cfg_handle handle;
+    unsigned int i;
+
+    CHECK_RC(te_gettimeofday(&tv_start, NULL));
+    for (i = 0; i < n_instances; i++)
+        CHECK_RC(cfg_find_fmt(&handle, FIND_PERF_OID "inst%06u", i));
+    CHECK_RC(te_gettimeofday(&tv_end, NULL));
+
+    return (double)TIMEVAL_SUB(tv_end, tv_start) / n_instances;
+}
+
+int
+main(int argc, char **argv)
+{
+    unsigned int n_instances;
+    unsigned int n_added = 0;
+    unsigned int i;
+    char n_instances_str[16];
+    const char *n_instances_env;
+    double cold_us;
+    double warm_us;
+    cfg_handle handle;
+
+    TEST_START;
+    TEST_GET_UINT_PARAM(n_instances);
+
+    n_instances_env = getenv("TE_CS_FIND_PERF_N_INSTANCES");
+    if (n_instances_env != NULL &&
+        te_strtoui(n_instances_env, 0, &n_instances) != 0)
+    {
+        TEST_FAIL("Invalid TE_CS_FIND_PERF_N_INSTANCES: '%s'",
+                  n_instances_env);
+    }
+
+    TEST_STEP("Add %u instances of the same object", n_instances);
+    for (n_added = 0; n_added < n_instances; n_added++)
+    {
+        CHECK_RC(cfg_add_instance_fmt(NULL, CFG_VAL(NONE, NULL),
+                                      FIND_PERF_OID "inst%06u", n_added));
+    }
+
+    TEST_STEP("Find every instance twice and measure the mean time "
+              "of a lookup");
+    cold_us = find_all(n_instances);
+    warm_us = find_all(n_instances);
+    RING("Mean lookup time among %u brothers: %.1f us (first pass), "
+         "%.1f us (second pass)", n_instances, cold_us, warm_us);
+
+    TE_SPRINTF(n_instances_str, "%u", n_instances);
+    te_mi_log_meas("cfg_find",
+                   TE_MI_MEAS_V(TE_MI_MEAS(LATENCY, "first pass", MEAN,
+                                           cold_us, MICRO),
+                                TE_MI_MEAS(LATENCY, "second pass", MEAN,
+                                           warm_us, MICRO)),
+                   TE_MI_MEAS_KEYS({"n_instances", n_instances_str}),
+                   NULL);
+
+    TEST_STEP("Check that a missing instance is not found");
+    if (cfg_find_fmt(&handle, FIND_PERF_OID "inst%06u", n_instances) == 0)
+        TEST_VERDICT("Not added instance is found");
+
+    TEST_SUCCESS;
+
+cleanup:
+
+    for (i = 0; i < n_added; i++)
+    {
+        CLEANUP_CHECK_RC(cfg_del_instance_fmt(false, FIND_PERF_OID "inst%06u",
+                                              i));
+    }
+
+    TEST_END;
+}
@@ -26,6 +26,8 @@
  *                      accepted by traffic pattern
  * @param llc_snap      Whether any/Ethernet2/LLC+SNAP frames should be
  *                      accepted by traffic pattern
+ * @param binary        Whether received frames should be reported in
+ *                      binary records
  *
  * @par Scenario:
  *
@@ -35,7 +37,7 @@
  * -# Prepare eth layer traffic pattern with one unit using @p tagged
  *    and @p llc_snap parameters.
  * -# Start to receive on corresponding CSAP using prepared pattern and
- *    1 second timeout.
+ *    1 second timeout. Request binary reports if @p binary is @c TRUE.
  * -# Send four 802.3 frames:
  *      - untagged with Ethernet2 encapsulation;
  *      - tagged with Ethernet2 encapsulation;
@@ -48,6 +50,8 @@
  *      - If either @p tagged or @p llc_snap parameter is @c any,
  *        two frames should be received;
  *      - Otherwise, only one frame should be received.
+ * -# If @p binary is @c TRUE, check that every reported frame is sent
+ *    from @p hwaddr_send.
  * -# Destroy created CSAPs.
  *
  */
@@ -72,6 +76,32 @@
 static const uint16_t tst_eth_type = 0xf0f0;
 static const uint8_t  tst_priority = 1;
 
+/** Context of frames check in binary mode */
+typedef struct test_bin_ctx {
+    const void     *hwaddr_send;    /**< Expected source address */
+    unsigned int    n_frames;       /**< Number of reported frames */
+    unsigned int    n_bad;          /**< Number of unexpected frames */
+} test_bin_ctx;
+
+static void
+test_bin_frame_cb(tapi_tad_bin_pkt *pkt, void *user_data)
+{
+    test_bin_ctx   *ctx = user_data;
+    const uint8_t  *frame;
+    size_t          len;
+
+    frame = tapi_tad_bin_pkt_frame(pkt, &len);
+    ctx->n_frames++;
+    if (len < 2 * ETHER_ADDR_LEN ||
+        memcmp(frame + ETHER_ADDR_LEN, ctx->hwaddr_send,
+               ETHER_ADDR_LEN) != 0)
+    {
+        ERROR("Frame of %zu bytes is not sent from the expected address",
+              len);
+        ctx->n_bad++;
+    }
+}
+
 static void
 test_send_eth_frame(const char *ta, csap_handle_t csap,
                     te_bool3 tagged, te_bool3 llc_snap)
@@ -105,6 +135,13 @@ main(int argc, char **argv)
 
     te_bool3    tagged;
     te_bool3    llc_snap;
+    bool        binary;
+
+    test_bin_ctx             bin_ctx = { NULL, 0, 0 };
+    tapi_tad_trrecv_cb_data  bin_cb_data = {
+        .bin_callback = test_bin_frame_cb,
+        .user_data = &bin_ctx,
+    };
 
     csap_handle_t   send_csap = CSAP_INVALID_HANDLE;
     csap_handle_t   recv_csap = CSAP_INVALID_HANDLE;
@@ -125,6 +162,9 @@ main(int argc, char **argv)
     TEST_GET_LINK_ADDR(hwaddr_recv);
     TEST_GET_BOOL3_PARAM(tagged);
     TEST_GET_BOOL3_PARAM(llc_snap);
+    TEST_GET_BOOL_PARAM(binary);
+
+    bin_ctx.hwaddr_send = hwaddr_send;
 
     /* Create send CSAP */
     CHECK_RC(tapi_eth_add_csap_layer(&csap_spec, if_send->if_name,
@@ -155,7 +195,9 @@ main(int argc, char **argv)
         CHECK_RC(tapi_eth_pdu_llc_snap(pdu));
 
     CHECK_RC(tapi_tad_trrecv_start(host_recv->ta, 0, recv_csap,
-                                   pattern, 1000, 0, RCF_TRRECV_PACKETS));
+                                   pattern, 1000, 0,
+                                   RCF_TRRECV_PACKETS |
+                                   (binary ? RCF_TRRECV_BINARY : 0)));
 
     /* Send various frames */
     test_send_eth_frame(host_send->ta, send_csap,
@@ -167,7 +209,8 @@ main(int argc, char **argv)
     test_send_eth_frame(host_send->ta, send_csap,
                         TE_BOOL3_TRUE, TE_BOOL3_TRUE);
 
-    rc = tapi_tad_trrecv_wait(host_recv->ta, 0, recv_csap, NULL, &num);
+    rc = tapi_tad_trrecv_wait(host_recv->ta, 0, recv_csap,
+                              binary ? &bin_cb_data : NULL, &num);
     if (TE_RC_GET_ERROR(rc) != TE_ETIMEDOUT)
         TEST_FAIL("Unexpected status of wait operation: %r", rc);
 
@@ -178,6 +221,17 @@ main(int argc, char **argv)
         TEST_FAIL("Unexpected number of packets is received");
     }
 
+    if (binary)
+    {
+        if (bin_ctx.n_frames != num)
+        {
+            TEST_FAIL("%u frames are reported for %u received packets",
+                      bin_ctx.n_frames, num);
+        }
+        if (bin_ctx.n_bad != 0)
+            TEST_FAIL("Unexpected frames are reported");
+    }
+
     TEST_SUCCESS;
 
 cleanup:
@@ -4,13 +4,15 @@ use strict;
 use warnings;
 
 use Mojolicious::Lite;
-use Mojo::JSON qw(true false);
+use Mojo::JSON qw(true false decode_json);
 use JSON qw(to_json);
+use IO::Uncompress::Gunzip qw(gunzip $GunzipError);
 
 my @clients;
 
 my $current_plan;
 my $stop = false;
+my $last_seq;
 
 open my $log, ">", "weblog";
 
@@ -26,6 +28,7 @@ post '/init' => sub {
 
     $current_plan = to_json($json->{plan});
     $stop = false;
+    undef $last_seq;
 
     $_->write("event: plan\ndata: $current_plan\n\n") for @clients;
     $c->render(json => {runid => 0});
@@ -35,11 +38,31 @@ post '/feed' => sub {
     my ($c) = @_;
     my $run = $c->param('run');
 
+    my $seq = $c->param('seq');
+
     my $data = $c->req->body;
+    my $encoding = $c->req->headers->header('Content-Encoding') // '';
+    if ($encoding eq 'gzip') {
+        my $plain;
+        unless (gunzip(\$data => \$plain)) {
+            $c->render(text => "gunzip failed: $GunzipError", status => 400);
+            return;
+        }
+        $data = $plain;
+    }
+
+    # Feeds are retried with the same sequence number, skip duplicates
+    if (defined $seq && defined $last_seq && $seq <= $last_seq) {
+        app->log->debug("skipping duplicate feed $seq for run $run");
+        $c->render(json => { stop => $stop});
+        return;
+    }
+    $last_seq = $seq;
+
     app->log->debug("got some feed for run $run:\n", $data);
 
     print $log "FEED\n";
-    print $log to_json($c->req->json, {utf8 => 1, pretty => 1});
+    print $log to_json(decode_json($data), {utf8 => 1, pretty => 1});
     print $log "\n";
 
     $_->write("event: feed\ndata: $data\n\n") for @clients;
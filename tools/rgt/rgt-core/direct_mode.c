@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: Direct output of the log report.
+ *
+ * The log report is generated by postponed mode routines as usual,
+ * but it is written to a custom stream which passes it to a sink
+ * chunk by chunk. So format tools may feed it to their XML parser
+ * incrementally without an intermediate XML file.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include "rgt_common.h"
+
+#include "direct_mode.h"
+
+/** Write callback of the stream */
+static ssize_t
+direct_write(void *cookie, const char *buf, size_t size)
+{
+    const rgt_core_sink *sink = cookie;
+
+    if (sink->write(sink->user_data, buf, size) != 0)
+        return -1;
+
+    return size;
+}
+
+/* See description in direct_mode.h */
+FILE *
+direct_mode_open(const rgt_core_sink *sink)
+{
+    cookie_io_functions_t  funcs = {
+        .read = NULL,
+        .write = direct_write,
+        .seek = NULL,
+        .close = NULL,
+    };
+    FILE                  *f;
+
+    f = fopencookie((void *)sink, "w", funcs);
+    if (f == NULL)
+        return NULL;
+    setvbuf(f, NULL, _IOFBF, RGT_DIRECT_BUF_SIZE);
+
+    return f;
+}
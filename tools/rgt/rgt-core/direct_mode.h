@@ -0,0 +1,39 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: Direct output of the log report.
+ *
+ * Interface for passing XML log report generated in postponed mode
+ * to a sink without writing it to a file.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#ifndef __TE_RGT_DIRECT_MODE_H__
+#define __TE_RGT_DIRECT_MODE_H__
+
+#include "rgt_core.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Size of the buffer of the output stream */
+#define RGT_DIRECT_BUF_SIZE 0x10000
+
+/**
+ * Open an output stream which passes written XML to a sink. The sink
+ * is called when the stream buffer is full or flushed; all remaining
+ * data are passed on closing the stream.
+ *
+ * @param sink      Receiver of the log report (it should be valid
+ *                  until the stream is closed)
+ *
+ * @return Stream to be used as rgt-core output or @c NULL on failure.
+ */
+extern FILE *direct_mode_open(const rgt_core_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TE_RGT_DIRECT_MODE_H__ */
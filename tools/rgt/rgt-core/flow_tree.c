@@ -68,6 +68,11 @@ static uint32_t last_offload_ts[2];
  */
 #define OFFLOAD_INTERVAL   3
 
+/** Regular messages waiting to be passed to reg_msgs_proc */
+static log_msg *msg_batch[REG_MSGS_BATCH_MAX];
+/** Number of messages in msg_batch */
+static unsigned int msg_batch_len;
+
 #ifdef RGT_PROF_STAT
 /** Counter for the number of messages added into the queue tail. */
 static unsigned long msg_put_to_tail;
@@ -1447,6 +1452,26 @@ flow_tree_attach_message(log_msg *msg)
         free_log_msg(msg);
 }
 
+/**
+ * Process regular messages collected in the batch and release them.
+ * It should be called before any other output.
+ */
+static void
+flush_regular_msgs(void)
+{
+    if (msg_batch_len == 0)
+        return;
+
+    reg_msgs_proc(msg_batch, msg_batch_len);
+
+    /*
+     * Messages are allocated on the same obstack one after another,
+     * so release them in the reverse order.
+     */
+    while (msg_batch_len > 0)
+        free_log_msg(msg_batch[--msg_batch_len]);
+}
+
 static void
 wrapper_process_regular_msg(gpointer data, gpointer user_data)
 {
@@ -1501,9 +1526,21 @@ wrapper_process_regular_msg(gpointer data, gpointer user_data)
             }
         }
 
-        if (msg_visible)
+        if (!msg_visible)
+        {
+            free_log_msg(msg);
+        }
+        else if (reg_msgs_proc != NULL)
+        {
+            msg_batch[msg_batch_len++] = msg;
+            if (msg_batch_len == REG_MSGS_BATCH_MAX)
+                flush_regular_msgs();
+        }
+        else
+        {
             reg_msg_proc(msg);
-        free_log_msg(msg);
+            free_log_msg(msg);
+        }
     }
 }
 
@@ -1533,6 +1570,7 @@ flow_tree_wander_aux(node_t *cur_node)
         if (duration_filter_res == NFMODE_INCLUDE)
 #endif
         {
+            flush_regular_msgs();
             if (ctrl_msg_proc[CTRL_EVT_START][cur_node->type] != NULL)
                 ctrl_msg_proc[CTRL_EVT_START][cur_node->type](
                     cur_node->user_data, &cur_node->ctrl_data);
@@ -1554,6 +1592,7 @@ flow_tree_wander_aux(node_t *cur_node)
             if (cur_node->fmode == NFMODE_INCLUDE &&
                 cur_node->user_data != NULL)
             {
+                flush_regular_msgs();
                 if (ctrl_msg_proc[CTRL_EVT_START][NT_BRANCH] != NULL)
                     ctrl_msg_proc[CTRL_EVT_START][NT_BRANCH](
                         cur_node->user_data, &cur_node->ctrl_data);
@@ -1565,6 +1604,7 @@ flow_tree_wander_aux(node_t *cur_node)
             if (cur_node->fmode == NFMODE_INCLUDE &&
                 cur_node->user_data != NULL)
             {
+                flush_regular_msgs();
                 if (ctrl_msg_proc[CTRL_EVT_END][NT_BRANCH] != NULL)
                     ctrl_msg_proc[CTRL_EVT_END][NT_BRANCH](
                         cur_node->user_data, &cur_node->ctrl_data);
@@ -1576,6 +1616,7 @@ flow_tree_wander_aux(node_t *cur_node)
         cur_node->user_data != NULL &&
         duration_filter_res == NFMODE_INCLUDE)
     {
+        flush_regular_msgs();
         if (ctrl_msg_proc[CTRL_EVT_END][cur_node->type] != NULL)
             ctrl_msg_proc[CTRL_EVT_END][cur_node->type](
                 cur_node->user_data, &cur_node->ctrl_data);
@@ -1655,6 +1696,8 @@ flow_tree_trace(void)
         msg_queue_foreach(&root->msg_after_att,
                           wrapper_process_regular_msg, NULL);
     }
+
+    flush_regular_msgs();
 }
 
 static gint
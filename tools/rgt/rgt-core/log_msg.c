@@ -31,6 +31,7 @@
 f_process_ctrl_log_msg ctrl_msg_proc[CTRL_EVT_LAST][NT_LAST] = { NULL };
 f_process_reg_log_msg  reg_msg_proc = NULL;
 f_process_log_root     log_root_proc[CTRL_EVT_LAST] = { NULL };
+f_process_reg_log_msgs reg_msgs_proc = NULL;
 
 /* External declaration */
 static node_info_t *create_node_by_msg_json(json_t *json, uint32_t *ts);
@@ -219,6 +219,16 @@ typedef int (* f_process_ctrl_log_msg)(node_info_t *node,
 /* Type of callback function used for processing regular messages */
 typedef int (* f_process_reg_log_msg)(log_msg *);
 
+/** Maximum number of messages passed to f_process_reg_log_msgs at once */
+#define REG_MSGS_BATCH_MAX 1024
+
+/*
+ * Type of callback function used for processing a batch of regular
+ * messages in the order they are passed.
+ */
+typedef void (* f_process_reg_log_msgs)(log_msg **msgs,
+                                        unsigned int n_msgs);
+
 /* Type of callback function used for processing start and end of log. */
 typedef int (* f_process_log_root)(void);
 
@@ -235,6 +245,13 @@ extern f_process_ctrl_log_msg ctrl_msg_proc[CTRL_EVT_LAST][NT_LAST];
 extern f_process_reg_log_msg  reg_msg_proc;
 extern f_process_log_root     log_root_proc[CTRL_EVT_LAST];
 
+/**
+ * Optional function processing regular messages in batches when
+ * the flow tree is traced. If it is set, it is used instead of
+ * reg_msg_proc.
+ */
+extern f_process_reg_log_msgs reg_msgs_proc;
+
 /**
  * The list of events that can be generated from the flow tree
  * for a particular node
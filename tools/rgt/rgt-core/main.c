@@ -0,0 +1,14 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: rgt-core program.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include "rgt_core.h"
+
+int
+main(int argc, char **argv)
+{
+    return rgt_core_main(argc, argv);
+}
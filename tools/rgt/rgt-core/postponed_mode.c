@@ -18,6 +18,8 @@
 #include <ctype.h>
 #endif
 
+#include <pthread.h>
+
 #include "log_msg.h"
 #include "postponed_mode.h"
 #include "memory.h"
@@ -47,11 +49,51 @@ static int postponed_process_branch_start(node_info_t *node,
 static int postponed_process_branch_end(node_info_t *node,
                                         ctrl_msg_data *data);
 static int postponed_process_regular_msg(log_msg *msg);
+static void postponed_process_regular_msgs(log_msg **msgs,
+                                           unsigned int n_msgs);
 
 static int postponed_process_open(void);
 static int postponed_process_close(void);
 
-static void output_regular_log_msg(log_msg *msg);
+static void output_regular_log_msg(struct obstack *obstk, log_msg *msg);
+static void start_msg_workers(void);
+static void stop_msg_workers(void);
+
+/** Thread formatting regular messages */
+typedef struct msg_worker {
+    pthread_t       thread; /**< Thread handle */
+    struct obstack *obstk;  /**< Obstack for formatted messages */
+    char           *first;  /**< The first message formatted in
+                                 the current batch or @c NULL */
+} msg_worker;
+
+/**
+ * Batch of regular messages formatted by several threads.
+ * All the fields are protected by the lock.
+ */
+static struct {
+    pthread_mutex_t lock;       /**< Lock */
+    pthread_cond_t  start;      /**< Signalled when a batch is posted */
+    pthread_cond_t  done;       /**< Signalled when a batch is formatted */
+    unsigned int    gen;        /**< Number of posted batches */
+    bool            stop;       /**< Workers should terminate */
+    bool            failed;     /**< Some message cannot be formatted */
+
+    log_msg       **msgs;       /**< Messages to format */
+    unsigned int    n_msgs;     /**< Number of messages */
+    unsigned int    next;       /**< The next message to format */
+    unsigned int    n_busy;     /**< Number of threads formatting
+                                     the current batch */
+    char          **out;        /**< Formatted messages */
+    size_t         *out_len;    /**< Lengths of formatted messages */
+} msg_batch = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .start = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+};
+
+/** Formatting threads, the last one is the main thread */
+static msg_worker *msg_workers = NULL;
 
 void
 postponed_mode_init(f_process_ctrl_log_msg
@@ -69,27 +111,36 @@ postponed_mode_init(f_process_ctrl_log_msg
     ctrl_proc[CTRL_EVT_END][NT_BRANCH] = postponed_process_branch_end;
 
     *reg_proc = postponed_process_regular_msg;
+    if (rgt_ctx.n_workers > 1)
+        reg_msgs_proc = postponed_process_regular_msgs;
 
     root_proc[CTRL_EVT_START] = postponed_process_open;
     root_proc[CTRL_EVT_END] = postponed_process_close;
 }
 
-static void
-print_ts(FILE *fd, uint32_t *ts)
+/** Size of a buffer for a formatted timestamp */
+#define TS_BUF_LEN 48
+
+/**
+ * Format time of a timestamp. It may be called from any thread.
+ *
+ * @param buf     buffer of TS_BUF_LEN bytes
+ * @param ts      timestamp
+ *
+ * @return @c false if the timestamp is incorrect.
+ */
+static bool
+format_ts(char *buf, const uint32_t *ts)
 {
 #define TIME_BUF_LEN 40
     time_t     time_block;
     char       time_buf[TIME_BUF_LEN];
-    struct tm  tm, *tm_tmp;
+    struct tm  tm;
     size_t     res;
 
     time_block = ts[0];
-    if ((tm_tmp = localtime(&time_block)) == NULL)
-    {
-        fprintf(stderr, "Incorrect timestamp specified\n");
-        THROW_EXCEPTION;
-    }
-    memcpy(&tm, tm_tmp, sizeof(tm));
+    if (localtime_r(&time_block, &tm) == NULL)
+        return false;
 #if 0
     /* Long date/time format (date & time) */
     res = strftime(time_buf, TIME_BUF_LEN, "%b %d %T", &tm);
@@ -99,11 +150,25 @@ print_ts(FILE *fd, uint32_t *ts)
 #endif
 
     assert(res > 0);
-    fprintf(fd, "%s.%03u", time_buf, ts[1] / 1000);
+    snprintf(buf, TS_BUF_LEN, "%s.%03u", time_buf, ts[1] / 1000);
 
+    return true;
 #undef TIME_BUF_LEN
 }
 
+static void
+print_ts(FILE *fd, uint32_t *ts)
+{
+    char buf[TS_BUF_LEN];
+
+    if (!format_ts(buf, ts))
+    {
+        fprintf(stderr, "Incorrect timestamp specified\n");
+        THROW_EXCEPTION;
+    }
+    fputs(buf, fd);
+}
+
 static void
 print_ts_info(node_info_t *node)
 {
@@ -137,15 +202,39 @@ print_ts_info(node_info_t *node)
  * @note Space is inserted before attribute name, but not
  *       after its value.
  *
+ * @param obstk     Obstack to append to (if @c NULL, it is written
+ *                  to rgt_ctx.out_fd).
  * @param name      Name of the attribute.
  * @param value     Value of the attribute.
  */
 static void
-append_attr(const char *name, const char *value)
+append_attr(struct obstack *obstk, const char *name, const char *value)
 {
-    fprintf(rgt_ctx.out_fd, " %s=\"", name);
-    write_xml_string(NULL, value, true);
-    fprintf(rgt_ctx.out_fd, "\"");
+    if (obstk != NULL)
+        obstack_printf(obstk, " %s=\"", name);
+    else
+        fprintf(rgt_ctx.out_fd, " %s=\"", name);
+    write_xml_string(obstk, value, true);
+    if (obstk != NULL)
+        obstack_1grow(obstk, '"');
+    else
+        fprintf(rgt_ctx.out_fd, "\"");
+}
+
+/**
+ * Write the current object of an obstack to the output file
+ * and release it.
+ *
+ * @param obstk     Obstack.
+ */
+static void
+flush_obstack(struct obstack *obstk)
+{
+    size_t  len = obstack_object_size(obstk);
+    char   *str = obstack_finish(obstk);
+
+    fwrite(str, 1, len, rgt_ctx.out_fd);
+    obstack_free(obstk, str);
 }
 
 int
@@ -154,6 +243,9 @@ postponed_process_open()
     if (log_obstk == NULL)
         log_obstk = obstack_initialize();
 
+    if (rgt_ctx.n_workers > 1)
+        start_msg_workers();
+
     fprintf(rgt_ctx.out_fd, "<?xml version=\"1.0\"?>\n");
     fprintf(rgt_ctx.out_fd, "<proteos:log_report "
             "xmlns:proteos=\"http://www.oktetlabs.ru/proteos\">\n");
@@ -167,6 +259,9 @@ postponed_process_close()
     if (log_obstk != NULL)
         obstack_destroy(log_obstk);
 
+    if (msg_workers != NULL)
+        stop_msg_workers();
+
     if (!logs_closed)
     {
         fprintf(rgt_ctx.out_fd, "</logs>\n");
@@ -189,12 +284,12 @@ print_params(node_info_t *node)
         while (prm != NULL)
         {
             fprintf(rgt_ctx.out_fd, "<param");
-            append_attr("name", prm->name);
+            append_attr(NULL, "name", prm->name);
             if (prm->stem != NULL)
-                append_attr("stem", prm->stem);
+                append_attr(NULL, "stem", prm->stem);
             if (prm->field != NULL)
-                append_attr("field", prm->field);
-            append_attr("value", prm->val);
+                append_attr(NULL, "field", prm->field);
+            append_attr(NULL, "value", prm->val);
             fprintf(rgt_ctx.out_fd, "/>\n");
             prm = prm->next;
         }
@@ -213,7 +308,7 @@ print_reqs(node_info_t *node)
         while (p != NULL)
         {
             fprintf(rgt_ctx.out_fd, "<req");
-            append_attr("id", p->id);
+            append_attr(NULL, "id", p->id);
             fprintf(rgt_ctx.out_fd, "/>\n");
             p = p->next;
         }
@@ -241,7 +336,8 @@ process_result_msg(gpointer data, gpointer user_data,
     if (~msg->level & TE_LL_MI || rgt_ctx.mi_meta)
     {
         fprintf(rgt_ctx.out_fd, "<%s level=\"%s\">", tag, msg->level_str);
-        output_regular_log_msg(msg);
+        output_regular_log_msg(log_obstk, msg);
+        flush_obstack(log_obstk);
         fprintf(rgt_ctx.out_fd, "</%s>\n", tag);
     }
     free_log_msg(msg);
@@ -285,9 +381,9 @@ postponed_process_start_event(node_info_t *node, const char *node_name,
         fprintf(rgt_ctx.out_fd, " plan_id=\"%d\"", node->plan_id);
 
     if (node->descr.name)
-        append_attr("name", node->descr.name);
+        append_attr(NULL, "name", node->descr.name);
     if (node->descr.hash != NULL)
-        append_attr("hash", node->descr.hash);
+        append_attr(NULL, "hash", node->descr.hash);
 
     switch (node->result.status)
     {
@@ -311,7 +407,7 @@ postponed_process_start_event(node_info_t *node, const char *node_name,
     }
 
     if (node->result.err)
-        append_attr("err", node->result.err);
+        append_attr(NULL, "err", node->result.err);
 
     fprintf(rgt_ctx.out_fd, ">\n");
 
@@ -483,8 +579,9 @@ postponed_process_branch_end(node_info_t *node, ctrl_msg_data *data)
     return 1;
 }
 
-static int
-postponed_process_regular_msg(log_msg *msg)
+/** Open logs of the current node if they are not opened yet */
+static void
+open_logs(void)
 {
     if (!logs_opened)
     {
@@ -492,58 +589,247 @@ postponed_process_regular_msg(log_msg *msg)
         logs_opened = 1;
         logs_closed = 0;
     }
+}
+
+/**
+ * Format a regular message as XML. It may be called from any thread.
+ * The message is added to the current object of the obstack.
+ *
+ * @param obstk     Obstack.
+ * @param msg       Message.
+ *
+ * @return @c false if the message cannot be formatted.
+ */
+static bool
+format_regular_msg(struct obstack *obstk, log_msg *msg)
+{
+    char ts_buf[TS_BUF_LEN];
+
+    if (!format_ts(ts_buf, msg->timestamp))
+    {
+        fprintf(stderr, "Incorrect timestamp specified\n");
+        return false;
+    }
+
+    obstack_printf(obstk, "<msg level=\"%s\"", msg->level_str);
+    append_attr(obstk, "entity", msg->entity);
+    append_attr(obstk, "user", msg->user);
+    obstack_printf(obstk, " ts_val=\"%u.%06u\" ts=\"%s\" nl=\"%d\">",
+                   msg->timestamp[0], msg->timestamp[1], ts_buf,
+                   msg->nest_lvl);
+    output_regular_log_msg(obstk, msg);
+    obstack_grow(obstk, "</msg>\n", strlen("</msg>\n"));
+
+    return true;
+}
+
+static int
+postponed_process_regular_msg(log_msg *msg)
+{
+    open_logs();
 
-    fprintf(rgt_ctx.out_fd, "<msg level=\"%s\"",
-            msg->level_str);
-    append_attr("entity", msg->entity);
-    append_attr("user", msg->user);
-    fprintf(rgt_ctx.out_fd, " ts_val=\"%u.%06u\" ts=\"",
-            msg->timestamp[0], msg->timestamp[1]);
-    print_ts(rgt_ctx.out_fd, msg->timestamp);
-    fprintf(rgt_ctx.out_fd, "\" nl=\"%d\">", msg->nest_lvl);
-    output_regular_log_msg(msg);
-    fprintf(rgt_ctx.out_fd, "</msg>\n");
+    if (!format_regular_msg(log_obstk, msg))
+        THROW_EXCEPTION;
+    flush_obstack(log_obstk);
 
     return 1;
 }
 
+/**
+ * Format messages of the current batch until there are no more
+ * messages to take. It is called with the batch lock held.
+ *
+ * @param worker    Formatting thread.
+ */
+static void
+format_batch_msgs(msg_worker *worker)
+{
+    unsigned int    i;
+    size_t          len;
+    char           *str;
+    bool            ok;
+
+    /* Messages of the previous batch are already written */
+    if (worker->first != NULL)
+    {
+        obstack_free(worker->obstk, worker->first);
+        worker->first = NULL;
+    }
+
+    while (msg_batch.next < msg_batch.n_msgs)
+    {
+        i = msg_batch.next++;
+        pthread_mutex_unlock(&msg_batch.lock);
+
+        ok = format_regular_msg(worker->obstk, msg_batch.msgs[i]);
+        len = obstack_object_size(worker->obstk);
+        str = obstack_finish(worker->obstk);
+        if (worker->first == NULL)
+            worker->first = str;
+
+        pthread_mutex_lock(&msg_batch.lock);
+        msg_batch.out[i] = str;
+        msg_batch.out_len[i] = ok ? len : 0;
+        if (!ok)
+            msg_batch.failed = true;
+    }
+}
+
+/**
+ * Main routine of a formatting thread.
+ *
+ * @param arg       Formatting thread context.
+ *
+ * @return @c NULL.
+ */
+static void *
+msg_worker_thread(void *arg)
+{
+    msg_worker     *worker = arg;
+    unsigned int    gen = 0;
+
+    pthread_mutex_lock(&msg_batch.lock);
+    while (true)
+    {
+        while (!msg_batch.stop && msg_batch.gen == gen)
+            pthread_cond_wait(&msg_batch.start, &msg_batch.lock);
+        if (msg_batch.stop)
+            break;
+
+        gen = msg_batch.gen;
+        format_batch_msgs(worker);
+        if (--msg_batch.n_busy == 0)
+            pthread_cond_signal(&msg_batch.done);
+    }
+    pthread_mutex_unlock(&msg_batch.lock);
+
+    return NULL;
+}
+
+/**
+ * Process a batch of regular messages: format them in parallel by
+ * all the threads (including the calling one) and write them in
+ * the original order, so that the output is the same as produced by
+ * postponed_process_regular_msg() for each message.
+ *
+ * @param msgs      Messages.
+ * @param n_msgs    Number of messages.
+ */
+static void
+postponed_process_regular_msgs(log_msg **msgs, unsigned int n_msgs)
+{
+    msg_worker     *self = &msg_workers[rgt_ctx.n_workers - 1];
+    unsigned int    i;
+
+    open_logs();
+
+    pthread_mutex_lock(&msg_batch.lock);
+    msg_batch.msgs = msgs;
+    msg_batch.n_msgs = n_msgs;
+    msg_batch.next = 0;
+    msg_batch.n_busy = rgt_ctx.n_workers - 1;
+    msg_batch.gen++;
+    pthread_cond_broadcast(&msg_batch.start);
+
+    format_batch_msgs(self);
+    while (msg_batch.n_busy > 0)
+        pthread_cond_wait(&msg_batch.done, &msg_batch.lock);
+    pthread_mutex_unlock(&msg_batch.lock);
+
+    if (msg_batch.failed)
+        THROW_EXCEPTION;
+
+    for (i = 0; i < n_msgs; i++)
+        fwrite(msg_batch.out[i], 1, msg_batch.out_len[i], rgt_ctx.out_fd);
+}
+
+/** Start threads formatting regular messages */
+static void
+start_msg_workers(void)
+{
+    unsigned int i;
+
+    msg_workers = calloc(rgt_ctx.n_workers, sizeof(*msg_workers));
+    msg_batch.out = calloc(REG_MSGS_BATCH_MAX, sizeof(*msg_batch.out));
+    msg_batch.out_len = calloc(REG_MSGS_BATCH_MAX, sizeof(*msg_batch.out_len));
+    if (msg_workers == NULL || msg_batch.out == NULL ||
+        msg_batch.out_len == NULL)
+    {
+        fprintf(stderr, "%s\n", "Out of memory");
+        THROW_EXCEPTION;
+    }
+
+    /* Initialize time conversion data before threads are started */
+    tzset();
+
+    for (i = 0; i < rgt_ctx.n_workers; i++)
+    {
+        msg_workers[i].obstk = obstack_initialize();
+        if (msg_workers[i].obstk == NULL)
+            THROW_EXCEPTION;
+
+        /* The last worker is the main thread */
+        if (i + 1 < rgt_ctx.n_workers &&
+            pthread_create(&msg_workers[i].thread, NULL, msg_worker_thread,
+                           &msg_workers[i]) != 0)
+        {
+            fprintf(stderr, "Failed to create a thread\n");
+            THROW_EXCEPTION;
+        }
+    }
+}
+
+/** Stop threads formatting regular messages */
+static void
+stop_msg_workers(void)
+{
+    unsigned int i;
+
+    pthread_mutex_lock(&msg_batch.lock);
+    msg_batch.stop = true;
+    pthread_cond_broadcast(&msg_batch.start);
+    pthread_mutex_unlock(&msg_batch.lock);
+
+    for (i = 0; i < rgt_ctx.n_workers; i++)
+    {
+        if (i + 1 < rgt_ctx.n_workers)
+            pthread_join(msg_workers[i].thread, NULL);
+        obstack_destroy(msg_workers[i].obstk);
+    }
+
+    free(msg_workers);
+    msg_workers = NULL;
+    free(msg_batch.out);
+    free(msg_batch.out_len);
+}
+
 static void
 print_message_info(log_msg *msg)
 {
-    fprintf(stderr, "entity name: %s\nuser name: %s\ntimestmp: ",
-            msg->entity, msg->user);
-    print_ts(stderr, msg->timestamp);
-    fprintf(stderr, "\nformat string: %s\n", msg->fmt_str);
-    fprintf(stderr, "\n");
+    char ts_buf[TS_BUF_LEN];
+
+    fprintf(stderr, "entity name: %s\nuser name: %s\ntimestmp: %s\n"
+            "format string: %s\n\n", msg->entity, msg->user,
+            format_ts(ts_buf, msg->timestamp) ? ts_buf : "<incorrect>",
+            msg->fmt_str);
 }
 
 static void
-output_regular_log_msg(log_msg *msg)
+output_regular_log_msg(struct obstack *obstk, log_msg *msg)
 {
     msg_arg *arg;
     int      i;
-    void    *obstk_base;
+    int      body_start;
+    int      body_len;
+    int      br_len = strlen("<br/>");
 
 /* @todo - It should be removed in the future! */
-#define OBSTACK_FLUSH() \
-    do {                                              \
-        char *out_str;                                \
-                                                      \
-        obstack_1grow(log_obstk, '\0');               \
-        out_str = (char *)obstack_finish(log_obstk);  \
-        fprintf(rgt_ctx.out_fd, "%s", out_str);            \
-        obstack_free(log_obstk, out_str);             \
-    } while (0)
-
-    if (log_obstk == NULL)
-        return;
-
-    obstk_base = obstack_base(log_obstk);
+    body_start = obstack_object_size(obstk);
     log_msg_init_arg(msg);
 
     if (msg->txt_msg != NULL)
     {
-        write_xml_string(log_obstk, msg->txt_msg, false);
+        write_xml_string(obstk, msg->txt_msg, false);
     }
     else
     {
@@ -553,7 +839,7 @@ output_regular_log_msg(log_msg *msg)
             {
                 if (msg->fmt_str[i + 1] == '%')
                 {
-                    obstack_1grow(log_obstk, '%');
+                    obstack_1grow(obstk, '%');
                     i++;
                     continue;
                 }
@@ -562,7 +848,7 @@ output_regular_log_msg(log_msg *msg)
                 {
                     /* Too few arguments in the message */
                     /* Simply write the rest of format string to the log */
-                    write_xml_string(log_obstk, msg->fmt_str + i, false);
+                    write_xml_string(obstk, msg->fmt_str + i, false);
                     break;
                 }
 
@@ -577,13 +863,13 @@ output_regular_log_msg(log_msg *msg)
                         val = ntohl(*(uint32_t *)arg->val);
                         if (val > UCHAR_MAX)
                         {
-                            obstack_printf(log_obstk, "&lt;0x%08x&gt;",
+                            obstack_printf(obstk, "&lt;0x%08x&gt;",
                                            val);
                         }
                         else
                         {
                             c_buf[0] = (char)val;
-                            write_xml_string(log_obstk, c_buf, false);
+                            write_xml_string(obstk, c_buf, false);
                         }
 
                         i++;
@@ -602,7 +888,7 @@ output_regular_log_msg(log_msg *msg)
                         *((uint32_t *)arg->val) =
                         ntohl(*(uint32_t *)arg->val);
 
-                        obstack_printf(log_obstk, format,
+                        obstack_printf(obstk, format,
                                        *((uint32_t *)arg->val));
                         i++;
 
@@ -617,7 +903,7 @@ output_regular_log_msg(log_msg *msg)
                         /* Address should be 4 bytes aligned */
                         assert(arg->len % 4 == 0);
 
-                        obstack_grow(log_obstk, "0x", strlen("0x"));
+                        obstack_grow(obstk, "0x", strlen("0x"));
                         for (j = 0; j < arg->len / 4; j++)
                         {
                             val = *(((uint32_t *)arg->val) + j);
@@ -629,7 +915,7 @@ output_regular_log_msg(log_msg *msg)
                             }
                             val = ntohl(val);
 
-                            obstack_printf(log_obstk, "%08x", val);
+                            obstack_printf(obstk, "%08x", val);
                         }
 
                         i++;
@@ -639,7 +925,7 @@ output_regular_log_msg(log_msg *msg)
 
                     case 's':
                     {
-                        write_xml_string(log_obstk, (const char *)arg->val,
+                        write_xml_string(obstk, (const char *)arg->val,
                                          false);
                         i++;
 
@@ -657,10 +943,10 @@ output_regular_log_msg(log_msg *msg)
                         src = te_rc_mod2str(err);
                         if (strlen(src) > 0)
                         {
-                            write_xml_string(log_obstk, src, false);
-                            obstack_1grow(log_obstk, '-');
+                            write_xml_string(obstk, src, false);
+                            obstack_1grow(obstk, '-');
                         }
-                        write_xml_string(log_obstk, te_rc_err2str(err),
+                        write_xml_string(obstk, te_rc_err2str(err),
                                          false);
                         i++;
 
@@ -682,12 +968,12 @@ output_regular_log_msg(log_msg *msg)
                             (msg->fmt_str + i))
                         {
                             /* Start file tag */
-                            obstack_printf(log_obstk,
+                            obstack_printf(obstk,
                                            "<file name=\"%s\">", "TODO");
-                            write_xml_string(log_obstk,
+                            write_xml_string(obstk,
                                              (const char *)arg->val, false);
                             /* End file tag */
-                            obstack_grow(log_obstk, "</file>",
+                            obstack_grow(obstk, "</file>",
                                          strlen("</file>"));
 
                             /* shift to the end of "%Tf" */
@@ -711,7 +997,7 @@ output_regular_log_msg(log_msg *msg)
                             break;
                         }
 
-                        obstack_grow(log_obstk,
+                        obstack_grow(obstk,
                                      "<mem-dump>", strlen("<mem-dump>"));
                         if (sscanf(msg->fmt_str + i, "%%Tm[[%d].[%d]]",
                                    &n_tuples, &tuple_width) != 2)
@@ -723,7 +1009,7 @@ output_regular_log_msg(log_msg *msg)
 
                         while (cur_pos < arg->len)
                         {
-                            obstack_grow(log_obstk, "<row>",
+                            obstack_grow(obstk, "<row>",
                                          strlen("<row>"));
                             /* Start a memory table row */
                             for (j = 0;
@@ -731,7 +1017,7 @@ output_regular_log_msg(log_msg *msg)
                                  j++)
                             {
                                 /* Start a block in a row */
-                                obstack_grow(log_obstk, "<elem>",
+                                obstack_grow(obstk, "<elem>",
                                              strlen("<elem>"));
                                 for (k = 0;
                                      k < tuple_width && cur_pos < arg->len;
@@ -740,18 +1026,18 @@ output_regular_log_msg(log_msg *msg)
                                     snprintf(one_byte_str,
                                              sizeof(one_byte_str),
                                              "%02X", *(arg->val + cur_pos));
-                                    obstack_grow(log_obstk,
+                                    obstack_grow(obstk,
                                                  one_byte_str, 2);
                                 }
                                 /* End a block in a row */
-                                obstack_grow(log_obstk, "</elem>",
+                                obstack_grow(obstk, "</elem>",
                                              strlen("</elem>"));
                             }
                             /* End a memory table row */
-                            obstack_grow(log_obstk, "</row>",
+                            obstack_grow(obstk, "</row>",
                                          strlen("</row>"));
                         }
-                        obstack_grow(log_obstk, "</mem-dump>",
+                        obstack_grow(obstk, "</mem-dump>",
                                      strlen("</mem-dump>"));
 
                         /* shift to the end of "%Tm" */
@@ -788,29 +1074,29 @@ output_regular_log_msg(log_msg *msg)
                     /* FALLTHROUGH */
 
                 case '\n':
-                    obstack_grow(log_obstk, "<br/>", 5);
+                    obstack_grow(obstk, "<br/>", 5);
                     break;
 
                 case '<':
-                    obstack_grow(log_obstk, "&lt;", 4);
+                    obstack_grow(obstk, "&lt;", 4);
                     break;
 
                 case '>':
-                    obstack_grow(log_obstk, "&gt;", 4);
+                    obstack_grow(obstk, "&gt;", 4);
                     break;
 
                 case '&':
-                    obstack_grow(log_obstk, "&amp;", 5);
+                    obstack_grow(obstk, "&amp;", 5);
                     break;
 
                 default:
                     if (msg->fmt_str[i] == '\t' || isprint(msg->fmt_str[i]))
                     {
-                        obstack_1grow(log_obstk, msg->fmt_str[i]);
+                        obstack_1grow(obstk, msg->fmt_str[i]);
                     }
                     else
                     {
-                        obstack_printf(log_obstk, "&lt;0x%02x&gt;",
+                        obstack_printf(obstk, "&lt;0x%02x&gt;",
                                        (unsigned char)msg->fmt_str[i]);
                     }
                     break;
@@ -819,31 +1105,19 @@ output_regular_log_msg(log_msg *msg)
         } /* for */
     } /* if (msg->txt_msg != NULL) */
 
-    if (obstack_next_free(log_obstk) != obstk_base)
+    /*
+     * Truncate trailing end of line characters:
+     * @todo - maybe it's better not to make this by default.
+     */
+    body_len = obstack_object_size(obstk) - body_start;
+    while (body_len >= br_len &&
+           strncmp((char *)obstack_base(obstk) + body_start + body_len -
+                   br_len, "<br/>", br_len) == 0)
     {
-        char *out_str;
-        int   str_len;
-        int   br_len = strlen("<br/>");
-
-        obstack_1grow(log_obstk, '\0');
-        str_len = obstack_object_size(log_obstk);
-        out_str = (char *)obstack_finish(log_obstk);
-
-        /*
-         * Truncate trailing end of line characters:
-         * @todo - maybe it's better not to make this by default.
-         */
-        i = br_len + 1;
-        while ((str_len >= i) &&
-                strncmp((out_str + str_len - i), "<br/>", br_len) == 0)
-        {
-            i += br_len;
-        }
-        *(out_str + str_len + br_len - i) = '\0';
-
-        fprintf(rgt_ctx.out_fd, "%s", out_str);
-        obstack_free(log_obstk, out_str);
+        body_len -= br_len;
     }
+    obstack_blank_fast(obstk, body_start + body_len -
+                              (int)obstack_object_size(obstk));
 
     return;
 }
@@ -220,6 +220,12 @@ typedef struct rgt_gen_ctx {
 
     bool verb; /**< Whether to use verbose output or not */
     int             current_nest_lvl;  /**< Current nesting level */
+
+    /**
+     * Number of threads formatting regular messages in postponed mode
+     * (@c 1 means that messages are formatted by the main thread only)
+     */
+    unsigned int    n_workers;
 } rgt_gen_ctx_t;
 
 
@@ -3,7 +3,7 @@
 /** @file
  * @brief Test Environment: rgt-core implementation.
  *
- * Implementation of main and usage/help functions.
+ * Implementation of rgt-core entry points and usage/help functions.
  */
 
 #include "rgt_common.h"
@@ -30,6 +30,8 @@
 #include "index_mode.h"
 #include "junit_mode.h"
 #include "mi_mode.h"
+#include "direct_mode.h"
+#include "rgt_core.h"
 
 /*
  * Define PACKAGE, VERSION and TE_COPYRIGHT just for the case it's build
@@ -60,6 +62,8 @@ rgt_gen_ctx_t rgt_ctx;
  */
 jmp_buf rgt_mainjmp;
 
+/** Receiver of the log report if it is not written to a file */
+static const rgt_core_sink *direct_sink = NULL;
 
 /**
  * Print "usage" how to.
@@ -122,6 +126,7 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
 {
     poptContext  optCon; /* context for parsing command-line options */
     int          rc;
+    int          n_workers = 1;
 
     const char *rawlog_fname = NULL;
     const char *out_fname = NULL;
@@ -135,6 +140,7 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
         RGT_OPT_INCOMPLETE_LOG,
         RGT_OPT_TMPDIR,
         RGT_OPT_STOP_AT_ENTITY,
+        RGT_OPT_JOBS,
         RGT_OPT_VERBOSE,
         RGT_OPT_VERSION,
     };
@@ -176,6 +182,10 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
           "Stop processing at the first message with a given entity.",
           "ENTITY" },
 
+        { "jobs", 'j', POPT_ARG_INT, &n_workers, RGT_OPT_JOBS,
+          "Number of threads formatting log messages in postponed mode. "
+          "Output does not depend on it.", "NUM" },
+
         { NULL, 'V', POPT_ARG_NONE, NULL, RGT_OPT_VERBOSE,
           "Verbose trace.", NULL },
 
@@ -280,6 +290,13 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
 
                 break;
 
+            case RGT_OPT_JOBS:
+                if (n_workers < 1)
+                    usage(optCon, 1, "Number of jobs must be positive", NULL);
+
+                ctx->n_workers = n_workers;
+                break;
+
             case RGT_OPT_VERBOSE:
                 ctx->verb = true;
                 break;
@@ -300,6 +317,12 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
         exit(1);
     }
 
+    if (direct_sink != NULL && ctx->op_mode != RGT_OP_MODE_POSTPONED)
+    {
+        usage(optCon, 1, "Direct output is supported only in mode",
+              RGT_OP_MODE_POSTPONED_STR);
+    }
+
     /* Get <raw log file> name */
     if ((rawlog_fname = poptGetArg(optCon)) == NULL)
     {
@@ -322,7 +345,18 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
     }
 
     ctx->out_fd = stdout;
-    if ((out_fname = poptGetArg(optCon)) != NULL)
+    if (direct_sink != NULL)
+    {
+        /* Output file name is not expected */
+        if ((ctx->out_fd = direct_mode_open(direct_sink)) == NULL)
+        {
+            perror("Cannot open direct output");
+            fclose(ctx->rawlog_fd);
+            poptFreeContext(optCon);
+            exit(1);
+        }
+    }
+    else if ((out_fname = poptGetArg(optCon)) != NULL)
     {
         /* Try to open file */
         if ((ctx->out_fd = fopen(out_fname, "w")) == NULL)
@@ -336,7 +370,7 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
 
     if (poptPeekArg(optCon) != NULL)
     {
-        if (ctx->out_fd != stdout)
+        if (out_fname != NULL)
             unlink(out_fname);
         usage(optCon, 1, "Too many parameters specified", NULL);
     }
@@ -394,34 +428,54 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
  *   Destroys flow tree module;
  *   Destroys filter module;
  *   Closes all file descriptors.
- * This function can be called explicitly or as a callback function on
- * arriving SIGINT signal to the program.
  *
- * @param  signo  Signal number by which the program is terminated.
- *                If signo is equal to zero it means an error was occurred
- *                during the program operation. We use an assertion that
- *                no one signal has code equal to zero.
+ * @param  completed  Whether the log report is completed, if not,
+ *                    the output file is removed.
  *
- * @return  Nothing.
+ * @return  @c 0 on success, @c 1 if the output cannot be completed.
  */
-static void free_resources(int signo)
+static int
+release_resources(bool completed)
 {
+    int rc = 0;
+
     /* log_parser_free_resources(); */
     flow_tree_destroy();
     rgt_filter_destroy();
     destroy_node_info_pool();
     destroy_log_msg_pool();
     fclose(rgt_ctx.rawlog_fd);
-    fclose(rgt_ctx.out_fd);
+    if (fclose(rgt_ctx.out_fd) != 0)
+        rc = 1;
 
-    if (signo == 0)
+    if (!completed && rgt_ctx.out_fname != NULL)
     {
         unlink(rgt_ctx.out_fname);
     }
 
     free(rgt_ctx.tmp_dir);
 
-    /* Exit 0 in the case of CTRL^C or normal completion */
+    return rc;
+}
+
+/**
+ * Frees all global resources and terminates the program.
+ * This function is called on errors or as a callback function on
+ * arriving SIGINT signal to the program.
+ *
+ * @param  signo  Signal number by which the program is terminated.
+ *                If signo is equal to zero it means an error was occurred
+ *                during the program operation. We use an assertion that
+ *                no one signal has code equal to zero.
+ *
+ * @return  Nothing.
+ */
+static void
+free_resources(int signo)
+{
+    release_resources(signo != 0);
+
+    /* Exit 0 in the case of CTRL^C */
     exit(!signo);
 }
 
@@ -434,20 +488,26 @@ static void free_resources(int signo)
  * @param argc  Number of arguments passed in command line
  * @param argv  Array of command line arguments
  *
+ * @return Exit status of the program.
  */
 int
-main(int argc, char **argv)
+rgt_core_main(int argc, char **argv)
 {
     log_msg       *msg = NULL;
     char          *err_msg;
     uint32_t       latest_ts[2] = { 0, 0 };
+    int            rc = 0;
 
     rgt_ctx_set_defaults(&rgt_ctx);
     process_cmd_line_opts(argc, argv, &rgt_ctx);
 
 #ifdef HAVE_SIGNAL_H
-    /* Set signal handler for catching CTRL^C interruption */
-    signal(SIGINT, free_resources);
+    /*
+     * Set signal handler for catching CTRL^C interruption
+     * (the program using direct output handles it itself).
+     */
+    if (direct_sink == NULL)
+        signal(SIGINT, free_resources);
 #endif
 
     if (rgt_filter_init(rgt_ctx.fltr_fname) < 0)
@@ -543,7 +603,7 @@ main(int argc, char **argv)
             log_root_proc[CTRL_EVT_END]();
 
         /* Successful completion */
-        free_resources(SIGINT);
+        rc = release_resources(true);
     }
     else
     {
@@ -553,7 +613,16 @@ main(int argc, char **argv)
     free(rgt_ctx.rawlog_fname);
     free(rgt_ctx.out_fname);
 
-    return 0;
+    return rc;
+}
+
+/* See description in rgt_core.h */
+int
+rgt_core_direct(int argc, char **argv, const rgt_core_sink *sink)
+{
+    direct_sink = sink;
+
+    return rgt_core_main(argc, argv);
 }
 
 /**
@@ -602,6 +671,7 @@ rgt_ctx_set_defaults(rgt_gen_ctx_t *ctx)
     ctx->verb = false;
     ctx->tmp_dir = NULL;
     ctx->current_nest_lvl = 0;
+    ctx->n_workers = 1;
 }
 
 /**
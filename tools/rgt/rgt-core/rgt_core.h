@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: rgt-core library interface.
+ *
+ * Entry points which allow log format tools to process a raw log
+ * with rgt-core in the same process and get the XML log report
+ * chunk by chunk instead of an XML file.
+ *
+ * The header is intentionally independent from rgt_common.h since
+ * format tools have their own definition of RGT context.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#ifndef __TE_RGT_CORE_H__
+#define __TE_RGT_CORE_H__
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Receiver of the XML log report generated in postponed mode.
+ * The report is passed in order, a chunk may end at any byte, so
+ * it is to be fed to an incremental XML parser.
+ */
+typedef struct rgt_core_sink {
+    /** Opaque data passed to callbacks */
+    void *user_data;
+
+    /**
+     * Chunk of the XML log report.
+     *
+     * @param user_data     Opaque data
+     * @param buf           Data
+     * @param len           Length of data
+     *
+     * @return @c 0 on success, @c -1 if the report cannot be processed.
+     */
+    int (*write)(void *user_data, const char *buf, size_t len);
+} rgt_core_sink;
+
+/**
+ * Run rgt-core with given command line arguments.
+ *
+ * @param argc      Number of arguments
+ * @param argv      Arguments (including program name)
+ *
+ * @return Exit status of the program.
+ */
+extern int rgt_core_main(int argc, char **argv);
+
+/**
+ * Process a raw log in postponed mode passing the log report to
+ * a sink instead of writing it to a file.
+ *
+ * @param argc      Number of arguments
+ * @param argv      rgt-core command line arguments (including program
+ *                  name) without output file name
+ * @param sink      Receiver of the log report
+ *
+ * @return Exit status of rgt-core, on errors the process may be
+ *         terminated as rgt-core does.
+ */
+extern int rgt_core_direct(int argc, char **argv,
+                           const rgt_core_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TE_RGT_CORE_H__ */
@@ -17,10 +17,12 @@
 #include <string.h>
 #include <assert.h>
 #include <ctype.h>
+#include <limits.h>
 
 #include <popt.h>
 
 #include "xml2gen.h"
+#include "rgt_core.h"
 
 #define UTILITY_NAME "xml-processor"
 
@@ -911,6 +913,167 @@ rgt_parse_file(rgt_gen_ctx_t *gen_ctx)
 }
 #endif
 
+#if (defined WITH_LIBXML)
+/** Sink callback feeding a chunk of XML log report to the parser */
+static int
+rgt_direct_write(void *user_data, const char *buf, size_t len)
+{
+    xmlParserCtxtPtr ctxt = user_data;
+
+    while (len > 0)
+    {
+        int chunk = MIN(len, INT_MAX);
+
+        if (xmlParseChunk(ctxt, buf, chunk, 0) != 0 && !ctxt->wellFormed)
+            return -1;
+        buf += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+#elif (defined WITH_EXPAT)
+/** Sink callback feeding a chunk of XML log report to the parser */
+static int
+rgt_direct_write(void *user_data, const char *buf, size_t len)
+{
+    XML_Parser p = user_data;
+
+    while (len > 0)
+    {
+        int chunk = MIN(len, INT_MAX);
+
+        if (XML_Parse(p, buf, chunk, 0) == 0)
+        {
+            fprintf(stderr, "Parse error at line %d:\n%s\n",
+                    (int)XML_GetCurrentLineNumber(p),
+                    XML_ErrorString(XML_GetErrorCode(p)));
+            return -1;
+        }
+        buf += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+#endif
+
+/**
+ * Processes raw log specified in context with rgt-core and feeds
+ * the XML log report to the parser chunk by chunk, so that it is not
+ * written to a file. The parser and SAX callbacks are the same as for
+ * an XML file, so the result is the same.
+ *
+ * @param gen_ctx  Context set up by main() entry point
+ *
+ * @return Status of the operation
+ * @retval 0  A raw log has been successfully processed
+ * @retval 1  An error has happened during raw log processing
+ */
+static int
+rgt_parse_raw_log(rgt_gen_ctx_t *gen_ctx)
+{
+    rgt_core_sink   sink = { .write = rgt_direct_write };
+    char          **argv;
+    int             argc = 0;
+    unsigned int    i;
+    int             rc;
+#if (defined WITH_LIBXML)
+    xmlParserCtxtPtr ctxt;
+#elif (defined WITH_EXPAT)
+    XML_Parser       p;
+#endif
+
+    argv = calloc(gen_ctx->core_opts->len + 4, sizeof(*argv));
+    if (argv == NULL)
+    {
+        fprintf(stderr, "Cannot allocate memory\n");
+        return 1;
+    }
+
+    argv[argc++] = (char *)"rgt-core";
+    argv[argc++] = (char *)"--mode=postponed";
+    for (i = 0; i < gen_ctx->core_opts->len; i++)
+        argv[argc++] = g_ptr_array_index(gen_ctx->core_opts, i);
+    argv[argc++] = gen_ctx->rawlog_fname;
+
+#if (defined WITH_LIBXML)
+    ctxt = xmlCreatePushParserCtxt(NULL, NULL, NULL, 0, NULL);
+    if (ctxt == NULL)
+    {
+        free(argv);
+        return 1;
+    }
+
+    /* The same options and callbacks as in rgt_parse_file() */
+    xmlCtxtUseOptions(ctxt, XML_PARSE_OLDSAX);
+
+    if (ctxt->sax != (xmlSAXHandlerPtr) &xmlDefaultSAXHandler)
+        xmlFree(ctxt->sax);
+    ctxt->sax = &sax_handler;
+    ctxt->userData = (void *)gen_ctx;
+
+    sink.user_data = ctxt;
+    rc = rgt_core_direct(argc, argv, &sink);
+    if (rc == 0)
+    {
+        xmlParseChunk(ctxt, NULL, 0, 1);
+        if (!ctxt->wellFormed)
+            rc = 1;
+    }
+
+    ctxt->sax = NULL;
+    if (ctxt->myDoc != NULL)
+    {
+        xmlFreeDoc(ctxt->myDoc);
+        ctxt->myDoc = NULL;
+    }
+
+    xmlFreeParserCtxt(ctxt);
+    xmlCleanupParser();
+#elif (defined WITH_EXPAT)
+    if ((p = XML_ParserCreate(NULL)) == NULL)
+    {
+        fprintf(stderr, "Cannot create parser\n");
+        free(argv);
+        return 1;
+    }
+
+    /* The same callbacks as in rgt_parse_file() */
+    XML_SetUserData(p, gen_ctx);
+    XML_SetElementHandler(p, rgt_log_start_element, rgt_log_end_element);
+    if (proc_expand_entities())
+        XML_SetCharacterDataHandler(p, rgt_log_characters);
+    else
+        XML_SetDefaultHandler(p, rgt_log_characters);
+
+    rgt_log_start_document(gen_ctx);
+
+    sink.user_data = p;
+    rc = rgt_core_direct(argc, argv, &sink);
+    if (rc == 0)
+    {
+        if (XML_Parse(p, NULL, 0, 1) == 0)
+        {
+            fprintf(stderr, "Parse error at line %d:\n%s\n",
+                    (int)XML_GetCurrentLineNumber(p),
+                    XML_ErrorString(XML_GetErrorCode(p)));
+            rc = 1;
+        }
+        else
+        {
+            rgt_log_end_document(gen_ctx);
+        }
+    }
+
+    XML_ParserFree(p);
+#endif
+
+    free(argv);
+
+    return rc == 0 ? 0 : 1;
+}
+
 /**
  * Print "usage" how to.
  *
@@ -971,13 +1134,23 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
     int          rc;
 
     const char *xml_fname = NULL;
+    const char *rawlog_fname = NULL;
     const char *out_fname = NULL;
+    const char *core_opt;
 
     /* Option Table */
     struct poptOption optionsTable[] = {
         { "xml-report-file", 'f', POPT_ARG_STRING, NULL, 'f',
           "XML report file name.", "FILE" },
 
+        { "raw-log", 'r', POPT_ARG_STRING, NULL, 'r',
+          "Raw log file name: process it with rgt-core directly "
+          "instead of XML report file.", "FILE" },
+
+        { "core-opt", '\0', POPT_ARG_STRING, NULL, 'C',
+          "Option passed to rgt-core processing raw log "
+          "(may be specified several times).", "OPT" },
+
         { "output", 'o', POPT_ARG_STRING, NULL, 'o',
           "Output file name.", "FILE" },
 
@@ -1007,6 +1180,21 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
                 usage(optCon, 1, "Specify XML report file", NULL);
             }
         }
+        else if (rc == 'r')
+        {
+            if ((rawlog_fname = poptGetOptArg(optCon)) == NULL)
+            {
+                usage(optCon, 1, "Specify raw log file", NULL);
+            }
+        }
+        else if (rc == 'C')
+        {
+            if ((core_opt = poptGetOptArg(optCon)) == NULL)
+            {
+                usage(optCon, 1, "Specify rgt-core option", NULL);
+            }
+            g_ptr_array_add(ctx->core_opts, strdup(core_opt));
+        }
         else if (rc == 'o')
         {
             if ((opt_out_file_name = poptGetOptArg(optCon)) == NULL)
@@ -1035,8 +1223,16 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
         exit(1);
     }
 
-    if (xml_fname == NULL &&
-        (xml_fname = poptGetArg(optCon)) == NULL)
+    if (rawlog_fname != NULL)
+    {
+        if (xml_fname != NULL)
+        {
+            usage(optCon, 1, "Specify either XML report file "
+                  "or raw log file", NULL);
+        }
+    }
+    else if (xml_fname == NULL &&
+             (xml_fname = poptGetArg(optCon)) == NULL)
     {
         usage(optCon, 1, "Specify XML report file", NULL);
     }
@@ -1062,7 +1258,10 @@ process_cmd_line_opts(int argc, char **argv, rgt_gen_ctx_t *ctx)
      * poptGetArg() returns an internal pointer that
      * becomes invalid after calling poptFreeContext().
      */
-    ctx->xml_fname = strdup(xml_fname);
+    if (xml_fname != NULL)
+        ctx->xml_fname = strdup(xml_fname);
+    if (rawlog_fname != NULL)
+        ctx->rawlog_fname = strdup(rawlog_fname);
 
     if (out_fname != NULL)
         ctx->out_fname = strdup(out_fname);
@@ -1214,6 +1413,7 @@ main(int argc, char **argv)
     prog_name += strlen(prog_prefix);
 
     memset(&gen_ctx, 0, sizeof(gen_ctx));
+    gen_ctx.core_opts = g_ptr_array_new_with_free_func(free);
 
     process_cmd_line_opts(argc, argv, &gen_ctx);
 
@@ -1252,14 +1452,19 @@ main(int argc, char **argv)
     }
     rgt_attr_settings_init(rgt_line_separator, rgt_max_attribute_length);
 
-    rc = rgt_parse_file(&gen_ctx);
+    if (gen_ctx.rawlog_fname != NULL)
+        rc = rgt_parse_raw_log(&gen_ctx);
+    else
+        rc = rgt_parse_file(&gen_ctx);
 
-    assert(gen_ctx.depth == 0);
+    assert(rc != 0 || gen_ctx.depth == 0);
 
     rgt_tmpls_free(xml2fmt_tmpls, xml2fmt_tmpls_num);
 
     free(gen_ctx.xml_fname);
+    free(gen_ctx.rawlog_fname);
     free(gen_ctx.out_fname);
+    g_ptr_array_free(gen_ctx.core_opts, true);
 
     g_array_free(gen_ctx.depth_info, true);
 
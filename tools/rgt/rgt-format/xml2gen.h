@@ -129,6 +129,9 @@ typedef enum {
  */
 typedef struct rgt_gen_ctx {
     char           *xml_fname; /**< XML file name */
+    char           *rawlog_fname; /**< Raw log file name (processed by
+                                       rgt-core instead of XML file) */
+    GPtrArray      *core_opts; /**< Options passed to rgt-core */
     char           *out_fname; /**< Output file name */
     bool expand_entities; /**< Whether to expand standard
                                           XML entities
@@ -0,0 +1,745 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: seekable raw log bundle.
+ *
+ * Implementation of reading and creating raw log bundles in
+ * native format.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <endian.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <lzma.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "te_config.h"
+#include "te_defs.h"
+#include "logger_api.h"
+#include "te_string.h"
+
+#include "rgt_log_bundle_common.h"
+#include "rgt_bundle.h"
+
+/** Size of the bundle header */
+#define RGT_BUNDLE_HDR_LEN 16
+/** Size of the bundle trailer */
+#define RGT_BUNDLE_TRAILER_LEN 24
+/** Size of the fixed part of an index entry */
+#define RGT_BUNDLE_ENTRY_LEN 28
+
+/** Size of buffers used for (de)compression */
+#define RGT_BUNDLE_BUF_SIZE 0x10000
+
+/** Get little-endian 32-bit number from a buffer */
+static inline uint32_t
+get_le32(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return le32toh(v);
+}
+
+/** Get little-endian 64-bit number from a buffer */
+static inline uint64_t
+get_le64(const uint8_t *p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return le64toh(v);
+}
+
+/** Put little-endian 32-bit number to a buffer */
+static inline void
+put_le32(uint8_t *p, uint32_t v)
+{
+    v = htole32(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+/** Put little-endian 64-bit number to a buffer */
+static inline void
+put_le64(uint8_t *p, uint64_t v)
+{
+    v = htole64(v);
+    memcpy(p, &v, sizeof(v));
+}
+
+/* See the description in rgt_bundle.h */
+bool
+rgt_bundle_is_native(const char *path)
+{
+    char magic[RGT_BUNDLE_MAGIC_LEN];
+    FILE *f;
+    bool result;
+
+    f = fopen(path, "rb");
+    if (f == NULL)
+        return false;
+
+    result = (fread(magic, sizeof(magic), 1, f) == 1 &&
+              memcmp(magic, RGT_BUNDLE_MAGIC, sizeof(magic)) == 0);
+
+    fclose(f);
+    return result;
+}
+
+/** Compare index entries by file name */
+static int
+entry_cmp(const void *a, const void *b)
+{
+    const rgt_bundle_entry *ea = a;
+    const rgt_bundle_entry *eb = b;
+
+    return strcmp(ea->name, eb->name);
+}
+
+/* See the description in rgt_bundle.h */
+int
+rgt_bundle_open(const char *path, rgt_bundle **bundle)
+{
+    uint8_t hdr[RGT_BUNDLE_HDR_LEN];
+    uint8_t trailer[RGT_BUNDLE_TRAILER_LEN];
+    uint8_t *idx = NULL;
+    rgt_bundle *b = NULL;
+    off_t file_len;
+    uint64_t idx_offset;
+    uint64_t idx_len;
+    uint64_t entries_num;
+    uint64_t pos;
+    char *name;
+    unsigned int i;
+
+    RGT_ERROR_INIT;
+
+    CHECK_OS_NOT_NULL(b = calloc(1, sizeof(*b)));
+    CHECK_OS_NOT_NULL(b->in_buf = malloc(RGT_BUNDLE_BUF_SIZE));
+    CHECK_OS_NOT_NULL(b->out_buf = malloc(RGT_BUNDLE_BUF_SIZE));
+    CHECK_FOPEN(b->f, path, "rb");
+
+    CHECK_FREAD(hdr, sizeof(hdr), 1, b->f);
+    if (memcmp(hdr, RGT_BUNDLE_MAGIC, RGT_BUNDLE_MAGIC_LEN) != 0)
+    {
+        ERROR("'%s' is not a raw log bundle in native format", path);
+        RGT_ERROR_JUMP;
+    }
+    if (get_le32(hdr + RGT_BUNDLE_MAGIC_LEN) != RGT_BUNDLE_VERSION)
+    {
+        ERROR("Unsupported version %u of raw log bundle '%s'",
+              get_le32(hdr + RGT_BUNDLE_MAGIC_LEN), path);
+        RGT_ERROR_JUMP;
+    }
+
+    CHECK_OS_RC(fseeko(b->f, 0, SEEK_END));
+    CHECK_OS_RC(file_len = ftello(b->f));
+    if (file_len < RGT_BUNDLE_HDR_LEN + RGT_BUNDLE_TRAILER_LEN)
+    {
+        ERROR("Raw log bundle '%s' is truncated", path);
+        RGT_ERROR_JUMP;
+    }
+
+    CHECK_OS_RC(fseeko(b->f, file_len - RGT_BUNDLE_TRAILER_LEN, SEEK_SET));
+    CHECK_FREAD(trailer, sizeof(trailer), 1, b->f);
+
+    idx_offset = get_le64(trailer);
+    entries_num = get_le64(trailer + 8);
+    if (memcmp(trailer + 16, RGT_BUNDLE_IDX_MAGIC,
+               RGT_BUNDLE_MAGIC_LEN) != 0 ||
+        idx_offset < RGT_BUNDLE_HDR_LEN ||
+        idx_offset > (uint64_t)file_len - RGT_BUNDLE_TRAILER_LEN ||
+        entries_num > UINT_MAX)
+    {
+        ERROR("Raw log bundle '%s' has no valid index", path);
+        RGT_ERROR_JUMP;
+    }
+
+    idx_len = file_len - RGT_BUNDLE_TRAILER_LEN - idx_offset;
+    if (entries_num > idx_len / RGT_BUNDLE_ENTRY_LEN)
+    {
+        ERROR("Index of raw log bundle '%s' is truncated", path);
+        RGT_ERROR_JUMP;
+    }
+
+    /*
+     * Every name in the index is preceded by a fixed-size header,
+     * so the index size is enough to store null-terminated names.
+     */
+    CHECK_OS_NOT_NULL(idx = malloc(idx_len + 1));
+    CHECK_OS_NOT_NULL(b->names = malloc(idx_len + 1));
+    CHECK_OS_NOT_NULL(b->entries = calloc(entries_num + 1,
+                                          sizeof(*b->entries)));
+    b->entries_num = entries_num;
+
+    CHECK_OS_RC(fseeko(b->f, idx_offset, SEEK_SET));
+    if (idx_len > 0)
+        CHECK_FREAD(idx, idx_len, 1, b->f);
+
+    name = b->names;
+    for (i = 0, pos = 0; i < entries_num; i++)
+    {
+        rgt_bundle_entry *e = &b->entries[i];
+        uint32_t name_len;
+
+        if (idx_len - pos < RGT_BUNDLE_ENTRY_LEN)
+        {
+            ERROR("Index of raw log bundle '%s' is truncated", path);
+            RGT_ERROR_JUMP;
+        }
+
+        e->offset = get_le64(idx + pos);
+        e->frame_len = get_le64(idx + pos + 8);
+        e->len = get_le64(idx + pos + 16);
+        name_len = get_le32(idx + pos + 24);
+        pos += RGT_BUNDLE_ENTRY_LEN;
+
+        if (idx_len - pos < name_len ||
+            e->offset < RGT_BUNDLE_HDR_LEN || e->offset > idx_offset ||
+            idx_offset - e->offset < e->frame_len)
+        {
+            ERROR("Index of raw log bundle '%s' is corrupted", path);
+            RGT_ERROR_JUMP;
+        }
+
+        memcpy(name, idx + pos, name_len);
+        name[name_len] = '\0';
+        e->name = name;
+
+        if (i > 0 && strcmp(b->entries[i - 1].name, e->name) >= 0)
+        {
+            ERROR("Index of raw log bundle '%s' is not sorted", path);
+            RGT_ERROR_JUMP;
+        }
+
+        name += name_len + 1;
+        pos += name_len;
+    }
+
+    *bundle = b;
+
+    RGT_ERROR_SECTION;
+
+    free(idx);
+    if (RGT_ERROR)
+        rgt_bundle_close(b);
+
+    return RGT_ERROR_VAL;
+}
+
+/* See the description in rgt_bundle.h */
+void
+rgt_bundle_close(rgt_bundle *bundle)
+{
+    if (bundle == NULL)
+        return;
+
+    if (bundle->f != NULL)
+        fclose(bundle->f);
+
+    free(bundle->entries);
+    free(bundle->names);
+    free(bundle->in_buf);
+    free(bundle->out_buf);
+    free(bundle);
+}
+
+/* See the description in rgt_bundle.h */
+const rgt_bundle_entry *
+rgt_bundle_find(const rgt_bundle *bundle, const char *name)
+{
+    rgt_bundle_entry key = { .name = name };
+
+    if (bundle->entries_num == 0)
+        return NULL;
+
+    return bsearch(&key, bundle->entries, bundle->entries_num,
+                   sizeof(*bundle->entries), entry_cmp);
+}
+
+/* See the description in rgt_bundle.h */
+int
+rgt_bundle_read(rgt_bundle *bundle, const rgt_bundle_entry *entry,
+                FILE *out)
+{
+    uint8_t *in_buf = bundle->in_buf;
+    uint8_t *out_buf = bundle->out_buf;
+    lzma_stream strm = LZMA_STREAM_INIT;
+    lzma_ret ret;
+    uint64_t left = entry->frame_len;
+
+    RGT_ERROR_INIT;
+
+    ret = lzma_stream_decoder(&strm, UINT64_MAX, 0);
+    if (ret != LZMA_OK)
+    {
+        ERROR("Failed to initialize xz decoder, rc=%d", ret);
+        RGT_ERROR_JUMP;
+    }
+
+    CHECK_OS_RC(fseeko(bundle->f, entry->offset, SEEK_SET));
+
+    strm.next_out = out_buf;
+    strm.avail_out = RGT_BUNDLE_BUF_SIZE;
+
+    do {
+        if (strm.avail_in == 0 && left > 0)
+        {
+            size_t len = MIN(left, RGT_BUNDLE_BUF_SIZE);
+
+            CHECK_FREAD(in_buf, len, 1, bundle->f);
+            left -= len;
+            strm.next_in = in_buf;
+            strm.avail_in = len;
+        }
+
+        ret = lzma_code(&strm, left == 0 ? LZMA_FINISH : LZMA_RUN);
+
+        if (strm.avail_out == 0 || ret == LZMA_STREAM_END)
+        {
+            size_t len = RGT_BUNDLE_BUF_SIZE - strm.avail_out;
+
+            if (len > 0)
+                CHECK_FWRITE(out_buf, len, 1, out);
+            strm.next_out = out_buf;
+            strm.avail_out = RGT_BUNDLE_BUF_SIZE;
+        }
+    } while (ret == LZMA_OK);
+
+    if (ret != LZMA_STREAM_END || strm.total_out != entry->len)
+    {
+        ERROR("Failed to decompress '%s' from raw log bundle, rc=%d",
+              entry->name, ret);
+        RGT_ERROR_JUMP;
+    }
+
+    RGT_ERROR_SECTION;
+
+    lzma_end(&strm);
+
+    return RGT_ERROR_VAL;
+}
+
+/* See the description in rgt_bundle.h */
+int
+rgt_bundle_extract(rgt_bundle *bundle, const char *name, const char *dir)
+{
+    const rgt_bundle_entry *entry;
+    FILE *f = NULL;
+
+    RGT_ERROR_INIT;
+
+    entry = rgt_bundle_find(bundle, name);
+    if (entry == NULL)
+    {
+        ERROR("There is no '%s' in raw log bundle", name);
+        RGT_ERROR_JUMP;
+    }
+
+    CHECK_FOPEN_FMT(f, "w", "%s/%s", dir, name);
+    CHECK_RC(rgt_bundle_read(bundle, entry, f));
+
+    RGT_ERROR_SECTION;
+
+    CHECK_FCLOSE(f);
+
+    return RGT_ERROR_VAL;
+}
+
+/** File to be packed into a bundle */
+typedef struct pack_file {
+    char *name;             /**< File name */
+    uint8_t *frame;         /**< Compressed frame */
+    size_t frame_len;       /**< Length of compressed frame */
+    uint64_t len;           /**< Length of the file */
+    bool done;              /**< Whether compression is finished */
+} pack_file;
+
+/** State shared by threads creating a bundle */
+typedef struct pack_ctx {
+    const char *dir;            /**< Directory with files */
+    uint32_t preset;            /**< Compression preset */
+
+    pack_file *files;           /**< Files sorted by name */
+    unsigned int files_num;     /**< Number of files */
+
+    unsigned int next_file;     /**< The next file to be compressed */
+    unsigned int next_write;    /**< The next file to be written */
+    unsigned int window;        /**< How many compressed frames may wait
+                                     for writing */
+    bool failed;                /**< Whether some thread failed */
+
+    pthread_mutex_t lock;       /**< Lock protecting this structure */
+    pthread_cond_t cond;        /**< Signalled when some file is
+                                     compressed or written */
+} pack_ctx;
+
+/**
+ * Compress a file into a single xz stream.
+ *
+ * @param ctx       Packing context
+ * @param strm      Encoder (reused for all files compressed by a thread)
+ * @param file      File to compress
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+compress_file(pack_ctx *ctx, lzma_stream *strm, pack_file *file)
+{
+    uint8_t in_buf[RGT_BUNDLE_BUF_SIZE];
+    size_t frame_size = RGT_BUNDLE_BUF_SIZE;
+    FILE *f = NULL;
+    lzma_action action = LZMA_RUN;
+    lzma_ret ret;
+
+    RGT_ERROR_INIT;
+
+    ret = lzma_easy_encoder(strm, ctx->preset, LZMA_CHECK_CRC64);
+    if (ret != LZMA_OK)
+    {
+        ERROR("Failed to initialize xz encoder, rc=%d", ret);
+        RGT_ERROR_JUMP;
+    }
+
+    CHECK_FOPEN_FMT(f, "r", "%s/%s", ctx->dir, file->name);
+    CHECK_OS_NOT_NULL(file->frame = malloc(frame_size));
+
+    strm->next_out = file->frame;
+    strm->avail_out = frame_size;
+
+    do {
+        if (strm->avail_in == 0 && action == LZMA_RUN)
+        {
+            strm->next_in = in_buf;
+            strm->avail_in = fread(in_buf, 1, RGT_BUNDLE_BUF_SIZE, f);
+            if (ferror(f))
+            {
+                ERROR("Failed to read '%s/%s'", ctx->dir, file->name);
+                RGT_ERROR_JUMP;
+            }
+            if (feof(f))
+                action = LZMA_FINISH;
+        }
+
+        ret = lzma_code(strm, action);
+
+        if (strm->avail_out == 0)
+        {
+            uint8_t *frame;
+
+            CHECK_OS_NOT_NULL(frame = realloc(file->frame, frame_size * 2));
+            file->frame = frame;
+            strm->next_out = frame + frame_size;
+            strm->avail_out = frame_size;
+            frame_size *= 2;
+        }
+    } while (ret == LZMA_OK);
+
+    if (ret != LZMA_STREAM_END)
+    {
+        ERROR("Failed to compress '%s/%s', rc=%d", ctx->dir, file->name,
+              ret);
+        RGT_ERROR_JUMP;
+    }
+
+    file->frame_len = strm->total_out;
+    file->len = strm->total_in;
+
+    RGT_ERROR_SECTION;
+
+    CHECK_FCLOSE(f);
+
+    return RGT_ERROR_VAL;
+}
+
+/**
+ * Thread compressing files. Files are taken in order, but no more than
+ * ctx->window frames may be waiting to be written.
+ *
+ * @param arg       Packing context
+ *
+ * @return @c NULL
+ */
+static void *
+pack_worker(void *arg)
+{
+    pack_ctx *ctx = arg;
+    lzma_stream strm = LZMA_STREAM_INIT;
+    unsigned int i;
+    int rc;
+
+    pthread_mutex_lock(&ctx->lock);
+    while (true)
+    {
+        while (!ctx->failed && ctx->next_file < ctx->files_num &&
+               ctx->next_file >= ctx->next_write + ctx->window)
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+
+        if (ctx->failed || ctx->next_file >= ctx->files_num)
+            break;
+
+        i = ctx->next_file++;
+        pthread_mutex_unlock(&ctx->lock);
+
+        rc = compress_file(ctx, &strm, &ctx->files[i]);
+
+        pthread_mutex_lock(&ctx->lock);
+        if (rc != 0)
+            ctx->failed = true;
+        ctx->files[i].done = true;
+        pthread_cond_broadcast(&ctx->cond);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+
+    lzma_end(&strm);
+
+    return NULL;
+}
+
+/** Compare directory entries by name in the order used in index */
+static int
+dirent_cmp(const struct dirent **a, const struct dirent **b)
+{
+    return strcmp((*a)->d_name, (*b)->d_name);
+}
+
+/**
+ * Get names of regular files in a directory sorted by strcmp().
+ *
+ * @param ctx       Packing context
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+pack_get_files(pack_ctx *ctx)
+{
+    struct dirent **entries = NULL;
+    int entries_num;
+    int i;
+    te_string path = TE_STRING_INIT;
+
+    RGT_ERROR_INIT;
+
+    CHECK_OS_RC(entries_num = scandir(ctx->dir, &entries, NULL,
+                                      dirent_cmp));
+    CHECK_OS_NOT_NULL(ctx->files = calloc(entries_num + 1,
+                                          sizeof(*ctx->files)));
+
+    for (i = 0; i < entries_num; i++)
+    {
+        struct stat st;
+
+        te_string_reset(&path);
+        te_string_append(&path, "%s/%s", ctx->dir, entries[i]->d_name);
+        CHECK_OS_RC(stat(path.ptr, &st));
+        if (!S_ISREG(st.st_mode))
+            continue;
+
+        CHECK_OS_NOT_NULL(ctx->files[ctx->files_num].name =
+                                        strdup(entries[i]->d_name));
+        ctx->files_num++;
+    }
+
+    RGT_ERROR_SECTION;
+
+    if (entries != NULL)
+    {
+        for (i = 0; i < entries_num; i++)
+            free(entries[i]);
+        free(entries);
+    }
+    te_string_free(&path);
+
+    return RGT_ERROR_VAL;
+}
+
+/**
+ * Write compressed frames of all the files to a bundle as soon as
+ * they are ready.
+ *
+ * @param ctx       Packing context
+ * @param f         Bundle file
+ * @param offsets   Where to save offsets of frames
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+pack_write_frames(pack_ctx *ctx, FILE *f, uint64_t *offsets)
+{
+    pack_file *file;
+    off_t offset;
+    unsigned int i;
+    bool failed;
+
+    RGT_ERROR_INIT;
+
+    for (i = 0; i < ctx->files_num; i++)
+    {
+        file = &ctx->files[i];
+
+        pthread_mutex_lock(&ctx->lock);
+        while (!file->done && !ctx->failed)
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        failed = ctx->failed;
+        pthread_mutex_unlock(&ctx->lock);
+
+        if (failed)
+            RGT_ERROR_JUMP;
+
+        CHECK_OS_RC(offset = ftello(f));
+        offsets[i] = offset;
+        CHECK_FWRITE(file->frame, file->frame_len, 1, f);
+
+        free(file->frame);
+        file->frame = NULL;
+
+        pthread_mutex_lock(&ctx->lock);
+        ctx->next_write = i + 1;
+        pthread_cond_broadcast(&ctx->cond);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+
+    RGT_ERROR_SECTION;
+
+    if (RGT_ERROR)
+    {
+        pthread_mutex_lock(&ctx->lock);
+        ctx->failed = true;
+        pthread_cond_broadcast(&ctx->cond);
+        pthread_mutex_unlock(&ctx->lock);
+    }
+
+    return RGT_ERROR_VAL;
+}
+
+/**
+ * Write index and trailer of a bundle.
+ *
+ * @param ctx       Packing context
+ * @param f         Bundle file
+ * @param offsets   Offsets of frames
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+pack_write_index(pack_ctx *ctx, FILE *f, const uint64_t *offsets)
+{
+    uint8_t entry[RGT_BUNDLE_ENTRY_LEN];
+    uint8_t trailer[RGT_BUNDLE_TRAILER_LEN];
+    off_t idx_offset;
+    unsigned int i;
+
+    RGT_ERROR_INIT;
+
+    CHECK_OS_RC(idx_offset = ftello(f));
+
+    for (i = 0; i < ctx->files_num; i++)
+    {
+        pack_file *file = &ctx->files[i];
+        size_t name_len = strlen(file->name);
+
+        put_le64(entry, offsets[i]);
+        put_le64(entry + 8, file->frame_len);
+        put_le64(entry + 16, file->len);
+        put_le32(entry + 24, name_len);
+
+        CHECK_FWRITE(entry, sizeof(entry), 1, f);
+        CHECK_FWRITE(file->name, name_len, 1, f);
+    }
+
+    put_le64(trailer, idx_offset);
+    put_le64(trailer + 8, ctx->files_num);
+    memcpy(trailer + 16, RGT_BUNDLE_IDX_MAGIC, RGT_BUNDLE_MAGIC_LEN);
+    CHECK_FWRITE(trailer, sizeof(trailer), 1, f);
+
+    RGT_ERROR_SECTION;
+
+    return RGT_ERROR_VAL;
+}
+
+/* See the description in rgt_bundle.h */
+int
+rgt_bundle_pack(const char *path, const char *dir, uint32_t preset,
+                unsigned int jobs)
+{
+    pack_ctx ctx = {
+        .dir = dir,
+        .preset = preset,
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .cond = PTHREAD_COND_INITIALIZER,
+    };
+    pthread_t *threads = NULL;
+    unsigned int threads_num = 0;
+    uint64_t *offsets = NULL;
+    uint8_t hdr[RGT_BUNDLE_HDR_LEN] = { 0, };
+    FILE *f = NULL;
+    unsigned int i;
+    int rc;
+
+    RGT_ERROR_INIT;
+
+    if (jobs == 0)
+        jobs = 1;
+    ctx.window = jobs * 2;
+
+    CHECK_RC(pack_get_files(&ctx));
+    CHECK_OS_NOT_NULL(offsets = calloc(ctx.files_num + 1,
+                                       sizeof(*offsets)));
+
+    CHECK_FOPEN(f, path, "w");
+    memcpy(hdr, RGT_BUNDLE_MAGIC, RGT_BUNDLE_MAGIC_LEN);
+    put_le32(hdr + RGT_BUNDLE_MAGIC_LEN, RGT_BUNDLE_VERSION);
+    CHECK_FWRITE(hdr, sizeof(hdr), 1, f);
+
+    CHECK_OS_NOT_NULL(threads = calloc(jobs, sizeof(*threads)));
+    for (i = 0; i < jobs; i++)
+    {
+        rc = pthread_create(&threads[i], NULL, pack_worker, &ctx);
+        if (rc != 0)
+        {
+            ERROR("Failed to create compressing thread: %s",
+                  strerror(rc));
+            pthread_mutex_lock(&ctx.lock);
+            ctx.failed = true;
+            pthread_cond_broadcast(&ctx.cond);
+            pthread_mutex_unlock(&ctx.lock);
+            RGT_ERROR_JUMP;
+        }
+        threads_num++;
+    }
+
+    CHECK_RC(pack_write_frames(&ctx, f, offsets));
+    CHECK_RC(pack_write_index(&ctx, f, offsets));
+
+    RGT_ERROR_SECTION;
+
+    for (i = 0; i < threads_num; i++)
+        pthread_join(threads[i], NULL);
+
+    CHECK_FCLOSE(f);
+    if (RGT_ERROR)
+        unlink(path);
+
+    if (ctx.files != NULL)
+    {
+        for (i = 0; i < ctx.files_num; i++)
+        {
+            free(ctx.files[i].name);
+            free(ctx.files[i].frame);
+        }
+        free(ctx.files);
+    }
+    free(offsets);
+    free(threads);
+
+    return RGT_ERROR_VAL;
+}
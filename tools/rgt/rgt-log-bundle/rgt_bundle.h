@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: seekable raw log bundle.
+ *
+ * Raw log bundle in native format is a container of fragment files
+ * produced by rgt-log-split. Every file is compressed into a separate
+ * xz stream (frame), so that it can be decompressed without touching
+ * the rest of the bundle. An index of frames sorted by file name is
+ * stored at the end of the bundle.
+ *
+ * Layout of the bundle (all numbers are little-endian):
+ *
+ * | Field                          | Size                  |
+ * __________________________________________________________
+ * | Magic "TELOGBND"               | 8 bytes               |
+ * | Format version                 | 4 bytes               |
+ * | Reserved                       | 4 bytes               |
+ * | Frames                         | variable              |
+ * | Index entries                  | variable              |
+ * | Index offset                   | 8 bytes               |
+ * | Number of index entries        | 8 bytes               |
+ * | Magic "TELOGIDX"               | 8 bytes               |
+ *
+ * Index entry:
+ *
+ * | Field                          | Size                  |
+ * __________________________________________________________
+ * | Frame offset                   | 8 bytes               |
+ * | Frame length                   | 8 bytes               |
+ * | Length of uncompressed file    | 8 bytes               |
+ * | Length of file name            | 4 bytes               |
+ * | File name                      | variable              |
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#ifndef __TE_RGT_BUNDLE_H__
+#define __TE_RGT_BUNDLE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic at the beginning of a bundle in native format */
+#define RGT_BUNDLE_MAGIC "TELOGBND"
+/** Magic at the end of a bundle in native format */
+#define RGT_BUNDLE_IDX_MAGIC "TELOGIDX"
+/** Length of magic strings */
+#define RGT_BUNDLE_MAGIC_LEN 8
+/** Current version of the bundle format */
+#define RGT_BUNDLE_VERSION 1
+
+/** Default xz compression preset (the same as te_pixz_wrapper uses) */
+#define RGT_BUNDLE_DEF_PRESET 6
+
+/** Index entry of a file stored in a bundle */
+typedef struct rgt_bundle_entry {
+    const char *name;       /**< File name */
+    uint64_t offset;        /**< Offset of compressed frame */
+    uint64_t frame_len;     /**< Length of compressed frame */
+    uint64_t len;           /**< Length of uncompressed file */
+} rgt_bundle_entry;
+
+/**
+ * Bundle opened for reading. Different bundles may be read in parallel,
+ * but a bundle may be used by one thread at a time only.
+ */
+typedef struct rgt_bundle {
+    FILE *f;                        /**< Bundle file */
+    rgt_bundle_entry *entries;      /**< Index sorted by file name */
+    unsigned int entries_num;       /**< Number of index entries */
+    char *names;                    /**< Storage of file names */
+    uint8_t *in_buf;                /**< Buffer for compressed data */
+    uint8_t *out_buf;               /**< Buffer for decompressed data */
+} rgt_bundle;
+
+/**
+ * Check whether a file is a bundle in native format.
+ *
+ * @param path        Path to the file
+ *
+ * @return @c true if the file starts with native format magic.
+ */
+extern bool rgt_bundle_is_native(const char *path);
+
+/**
+ * Open a bundle and load its index. Only the index is read,
+ * frames are read on request.
+ *
+ * @param path        Path to the bundle
+ * @param bundle      Where to save pointer to the opened bundle
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+extern int rgt_bundle_open(const char *path, rgt_bundle **bundle);
+
+/**
+ * Close a bundle and release memory allocated for it.
+ *
+ * @param bundle      Bundle (may be @c NULL)
+ */
+extern void rgt_bundle_close(rgt_bundle *bundle);
+
+/**
+ * Find a file in a bundle (binary search in the index).
+ *
+ * @param bundle      Bundle
+ * @param name        File name
+ *
+ * @return Index entry or @c NULL if there is no such file.
+ */
+extern const rgt_bundle_entry *rgt_bundle_find(const rgt_bundle *bundle,
+                                               const char *name);
+
+/**
+ * Decompress a file stored in a bundle.
+ *
+ * @param bundle      Bundle
+ * @param entry       Index entry of the file
+ * @param out         Where to write decompressed data
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+extern int rgt_bundle_read(rgt_bundle *bundle,
+                           const rgt_bundle_entry *entry, FILE *out);
+
+/**
+ * Decompress a file stored in a bundle to a directory.
+ *
+ * @param bundle      Bundle
+ * @param name        File name
+ * @param dir         Directory where to create the file
+ *
+ * @return @c 0 on success, @c -1 on failure (including the case
+ *         when there is no such file in the bundle).
+ */
+extern int rgt_bundle_extract(rgt_bundle *bundle, const char *name,
+                              const char *dir);
+
+/**
+ * Create a bundle from all regular files of a directory (subdirectories
+ * are not processed). Files are compressed in parallel.
+ *
+ * @param path        Path to the bundle to be created
+ * @param dir         Directory with files
+ * @param preset      xz compression preset
+ * @param jobs        Number of compressing threads
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+extern int rgt_bundle_pack(const char *path, const char *dir,
+                           uint32_t preset, unsigned int jobs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TE_RGT_BUNDLE_H__ */
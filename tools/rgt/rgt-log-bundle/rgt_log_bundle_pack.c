@@ -0,0 +1,140 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: creating raw log bundle in native format.
+ *
+ * This program packs fragments produced by rgt-log-split into
+ * a seekable raw log bundle, compressing fragment files in parallel.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <popt.h>
+
+#include "te_config.h"
+#include "te_defs.h"
+#include "logger_api.h"
+#include "logger_file.h"
+#include "rgt_log_bundle_common.h"
+#include "rgt_bundle.h"
+
+/** Path to the bundle to be created */
+static char *bundle_path = NULL;
+/** Directory with fragment files */
+static char *split_log_path = NULL;
+/** Compression preset */
+static int preset = RGT_BUNDLE_DEF_PRESET;
+/** Number of compressing threads (if @c 0, number of CPUs is used) */
+static int jobs = 0;
+
+/**
+ * Parse command line.
+ *
+ * @param argc    Number of arguments
+ * @param argv    Array of command line arguments
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+process_cmd_line_opts(int argc, char **argv)
+{
+    poptContext optCon = NULL;
+    int rc;
+
+    RGT_ERROR_INIT;
+
+    struct poptOption optionsTable[] = {
+        { "bundle", 'b', POPT_ARG_STRING, &bundle_path, 0,
+          "Path to raw log bundle to be created.", NULL },
+
+        { "split-log", 's', POPT_ARG_STRING, &split_log_path, 0,
+          "Path to split raw log.", NULL },
+
+        { "level", 'l', POPT_ARG_INT, &preset, 0,
+          "Compression level (0-9, 6 by default).", NULL },
+
+        { "jobs", 'j', POPT_ARG_INT, &jobs, 0,
+          "Number of compressing threads (number of CPUs by default).",
+          NULL },
+
+        POPT_AUTOHELP
+        POPT_TABLEEND
+    };
+
+    CHECK_NOT_NULL(optCon = poptGetContext(NULL, argc,
+                                           (const char **)argv,
+                                           optionsTable, 0));
+
+    while ((rc = poptGetNextOpt(optCon)) >= 0);
+
+    if (rc < -1)
+    {
+        ERROR("%s: %s",
+              poptBadOption(optCon, POPT_BADOPTION_NOALIAS),
+              poptStrerror(rc));
+        RGT_ERROR_JUMP;
+    }
+
+    if (bundle_path == NULL || split_log_path == NULL)
+    {
+        ERROR("Specify all the required parameters");
+        RGT_ERROR_JUMP;
+    }
+
+    if (preset < 0 || preset > 9 || jobs < 0)
+    {
+        ERROR("Wrong compression level or number of jobs");
+        RGT_ERROR_JUMP;
+    }
+
+    if (poptPeekArg(optCon) != NULL)
+    {
+        ERROR("Too many parameters were specified");
+        RGT_ERROR_JUMP;
+    }
+
+    RGT_ERROR_SECTION;
+
+    if (optCon != NULL)
+    {
+        if (RGT_ERROR)
+            poptPrintUsage(optCon, stderr, 0);
+
+        poptFreeContext(optCon);
+    }
+
+    return RGT_ERROR_VAL;
+}
+
+int
+main(int argc, char **argv)
+{
+    RGT_ERROR_INIT;
+
+    te_log_init("RGT LOG BUNDLE PACK", te_log_message_file);
+
+    CHECK_RC(process_cmd_line_opts(argc, argv));
+
+    if (jobs == 0)
+    {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        jobs = cpus > 0 ? cpus : 1;
+    }
+
+    CHECK_RC(rgt_bundle_pack(bundle_path, split_log_path, preset, jobs));
+
+    RGT_ERROR_SECTION;
+
+    free(bundle_path);
+    free(split_log_path);
+
+    if (RGT_ERROR)
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+/** @file
+ * @brief Test Environment: extracting files from raw log bundle.
+ *
+ * This program extracts fragment files from raw log bundle. Bundles
+ * in native format are read directly; for old bundles (tar archives
+ * compressed with pixz) pixz and tar are invoked.
+ *
+ * Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include <popt.h>
+
+#include "te_config.h"
+#include "te_defs.h"
+#include "logger_api.h"
+#include "logger_file.h"
+#include "te_string.h"
+#include "rgt_log_bundle_common.h"
+#include "rgt_bundle.h"
+
+/** Path to raw log bundle */
+static char *bundle_path = NULL;
+/** Where to extract files */
+static char *split_log_path = NULL;
+/** If not zero, list files instead of extracting them */
+static int list_files = 0;
+/** Names of files to extract (all files if empty) */
+static const char **names = NULL;
+
+/**
+ * Parse command line.
+ *
+ * @param argc      Number of arguments
+ * @param argv      Array of command line arguments
+ * @param opt_con   Where to save popt context (it owns the array of
+ *                  file names)
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+process_cmd_line_opts(int argc, char **argv, poptContext *opt_con)
+{
+    poptContext optCon = NULL;
+    int rc;
+
+    RGT_ERROR_INIT;
+
+    struct poptOption optionsTable[] = {
+        { "bundle", 'b', POPT_ARG_STRING, &bundle_path, 0,
+          "Path to raw log bundle.", NULL },
+
+        { "split-log", 's', POPT_ARG_STRING, &split_log_path, 0,
+          "Where to extract files.", NULL },
+
+        { "list", 'l', POPT_ARG_NONE, &list_files, 0,
+          "List files stored in raw log bundle in native format.",
+          NULL },
+
+        POPT_AUTOHELP
+        POPT_TABLEEND
+    };
+
+    CHECK_NOT_NULL(optCon = poptGetContext(NULL, argc,
+                                           (const char **)argv,
+                                           optionsTable, 0));
+    poptSetOtherOptionHelp(optCon, "[OPTIONS] [file names]");
+
+    while ((rc = poptGetNextOpt(optCon)) >= 0);
+
+    if (rc < -1)
+    {
+        ERROR("%s: %s",
+              poptBadOption(optCon, POPT_BADOPTION_NOALIAS),
+              poptStrerror(rc));
+        RGT_ERROR_JUMP;
+    }
+
+    if (bundle_path == NULL || (split_log_path == NULL && !list_files))
+    {
+        ERROR("Specify all the required parameters");
+        RGT_ERROR_JUMP;
+    }
+
+    names = poptGetArgs(optCon);
+
+    RGT_ERROR_SECTION;
+
+    if (optCon != NULL && RGT_ERROR)
+    {
+        poptPrintUsage(optCon, stderr, 0);
+        poptFreeContext(optCon);
+        optCon = NULL;
+    }
+
+    *opt_con = optCon;
+
+    return RGT_ERROR_VAL;
+}
+
+/**
+ * Extract files from a bundle in native format.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+unpack_native(void)
+{
+    rgt_bundle *bundle = NULL;
+    unsigned int i;
+
+    RGT_ERROR_INIT;
+
+    CHECK_RC(rgt_bundle_open(bundle_path, &bundle));
+
+    if (list_files)
+    {
+        for (i = 0; i < bundle->entries_num; i++)
+        {
+            printf("%s %" PRIu64 " %" PRIu64 "\n",
+                   bundle->entries[i].name, bundle->entries[i].len,
+                   bundle->entries[i].frame_len);
+        }
+    }
+    else if (names != NULL)
+    {
+        for (i = 0; names[i] != NULL; i++)
+            CHECK_RC(rgt_bundle_extract(bundle, names[i], split_log_path));
+    }
+    else
+    {
+        for (i = 0; i < bundle->entries_num; i++)
+        {
+            CHECK_RC(rgt_bundle_extract(bundle, bundle->entries[i].name,
+                                        split_log_path));
+        }
+    }
+
+    RGT_ERROR_SECTION;
+
+    rgt_bundle_close(bundle);
+
+    return RGT_ERROR_VAL;
+}
+
+/**
+ * Extract files from a tar archive compressed with pixz.
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+unpack_tpxz(void)
+{
+    te_string cmd = TE_STRING_INIT;
+    unsigned int i;
+
+    RGT_ERROR_INIT;
+
+    if (list_files)
+    {
+        ERROR("Listing is supported for bundles in native format only");
+        RGT_ERROR_JUMP;
+    }
+
+    te_string_append(&cmd, "pixz -x");
+    for (i = 0; names != NULL && names[i] != NULL; i++)
+        te_string_append(&cmd, " \"%s\"", names[i]);
+    te_string_append(&cmd, " <\"%s\" | tar x -C \"%s/\"",
+                     bundle_path, split_log_path);
+
+    if (system(cmd.ptr) != 0)
+    {
+        ERROR("Failed to extract files from '%s'", bundle_path);
+        RGT_ERROR_JUMP;
+    }
+
+    RGT_ERROR_SECTION;
+
+    te_string_free(&cmd);
+
+    return RGT_ERROR_VAL;
+}
+
+int
+main(int argc, char **argv)
+{
+    poptContext optCon = NULL;
+
+    RGT_ERROR_INIT;
+
+    te_log_init("RGT LOG BUNDLE UNPACK", te_log_message_file);
+
+    CHECK_RC(process_cmd_line_opts(argc, argv, &optCon));
+
+    if (rgt_bundle_is_native(bundle_path))
+        CHECK_RC(unpack_native());
+    else
+        CHECK_RC(unpack_tpxz());
+
+    RGT_ERROR_SECTION;
+
+    if (optCon != NULL)
+        poptFreeContext(optCon);
+
+    free(bundle_path);
+    free(split_log_path);
+
+    if (RGT_ERROR)
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
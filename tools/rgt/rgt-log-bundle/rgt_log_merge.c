@@ -9,6 +9,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
+#include <errno.h>
+
+#include <sys/stat.h>
 
 #include "te_config.h"
 #include "te_defs.h"
@@ -18,6 +21,7 @@
 #include "te_str.h"
 #include "te_file.h"
 #include "rgt_log_bundle_common.h"
+#include "rgt_bundle.h"
 
 /** If @c true, find log messages to be merged by TIN */
 static bool use_tin = false;
@@ -508,6 +512,67 @@ process_cmd_line_opts(int argc, char **argv)
     return RGT_ERROR_VAL;
 }
 
+/**
+ * Extract files from raw log bundle.
+ *
+ * @param bundle          Opened bundle in native format or @c NULL
+ *                        if bundle is a tar archive compressed with pixz
+ * @param names           Space-separated names of files
+ *
+ * @return @c 0 on success, @c -1 on failure.
+ */
+static int
+extract_files(rgt_bundle *bundle, const char *names)
+{
+    te_string cmd = TE_STRING_INIT;
+    char *names_dup = NULL;
+    char *saveptr = NULL;
+    char *name;
+
+    RGT_ERROR_INIT;
+
+    if (bundle == NULL)
+    {
+        te_string_append(&cmd,
+                         "mkdir -p \"%s/\" && "
+                         "pixz -x %s <\"%s\" | tar x -C \"%s/\"",
+                         split_log_path, names, bundle_path,
+                         split_log_path);
+        if (system(cmd.ptr) != 0)
+        {
+            ERROR("Failed to extract %s", names);
+            RGT_ERROR_JUMP;
+        }
+    }
+    else
+    {
+        /*
+         * Only the requested frames are decompressed, the rest of
+         * the bundle is not read.
+         */
+        if (mkdir(split_log_path, 0777) != 0 && errno != EEXIST)
+        {
+            ERROR("Failed to create '%s', errno=%d ('%s')",
+                  split_log_path, errno, strerror(errno));
+            RGT_ERROR_JUMP;
+        }
+
+        CHECK_OS_NOT_NULL(names_dup = strdup(names));
+        for (name = strtok_r(names_dup, " ", &saveptr); name != NULL;
+             name = strtok_r(NULL, " ", &saveptr))
+        {
+            CHECK_RC(rgt_bundle_extract(bundle, name, split_log_path));
+        }
+    }
+
+    RGT_ERROR_SECTION;
+
+    te_string_free(&cmd);
+    free(names_dup);
+
+    return RGT_ERROR_VAL;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -518,7 +583,8 @@ main(int argc, char **argv)
 
     unsigned int i;
 
-    te_string cmd = TE_STRING_INIT;
+    rgt_bundle *bundle = NULL;
+    te_string needed_frags = TE_STRING_INIT;
     int res;
 
     RGT_ERROR_INIT;
@@ -534,17 +600,10 @@ main(int argc, char **argv)
          * these are always needed, from frags_list it will be determined
          * which log fragment files should be unpacked.
          */
-        te_string_append(&cmd,
-                         "mkdir -p \"%s/\" && "
-                         "pixz -x log_gist.raw frags_list <\"%s\" | "
-                         "tar x -C \"%s/\"", split_log_path,
-                         bundle_path, split_log_path);
-        res = system(cmd.ptr);
-        if (res != 0)
-        {
-            ERROR("Failed to extract log_gist.raw and frags_list");
-            RGT_ERROR_JUMP;
-        }
+        if (rgt_bundle_is_native(bundle_path))
+            CHECK_RC(rgt_bundle_open(bundle_path, &bundle));
+
+        CHECK_RC(extract_files(bundle, "log_gist.raw frags_list"));
     }
 
     CHECK_FOPEN_FMT(f_raw_gist, "r", "%s/log_gist.raw", split_log_path);
@@ -561,23 +620,12 @@ main(int argc, char **argv)
          * from raw long bundle.
          */
 
-        te_string_reset(&cmd);
-        te_string_append(&cmd, "pixz -x ");
         CHECK_RC(res = merge(split_log_path, sniff_path, f_raw_gist,
-                             f_frags_list, f_result, NULL, true, &cmd));
+                             f_frags_list, f_result, NULL, true,
+                             &needed_frags));
 
         if (res > 0)
-        {
-            te_string_append(&cmd, " <\"%s\" | tar x -C \"%s/\"",
-                             bundle_path, split_log_path);
-
-            res = system(cmd.ptr);
-            if (res != 0)
-            {
-                ERROR("Failed to extract required fragments");
-                RGT_ERROR_JUMP;
-            }
-        }
+            CHECK_RC(extract_files(bundle, needed_frags.ptr));
     }
 
     CHECK_RC(merge(split_log_path, sniff_path, f_raw_gist, f_frags_list,
@@ -603,7 +651,8 @@ main(int argc, char **argv)
     free(bundle_path);
     free(frags_count_path);
 
-    te_string_free(&cmd);
+    te_string_free(&needed_frags);
+    rgt_bundle_close(bundle);
 
     free(caps_idx);
     free(caps_files);
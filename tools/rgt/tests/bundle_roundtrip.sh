@@ -0,0 +1,63 @@
+#!/bin/bash
+# SPDX-License-Identifier: Apache-2.0
+#
+# Check that files packed into a raw log bundle in native format are
+# extracted unchanged: all at once, one by one and when the bundle
+# is listed. Files include an empty one, many small ones and ones
+# larger than (de)compression buffers.
+#
+# Usage: bundle_roundtrip.sh
+#
+# rgt-log-bundle-pack and rgt-log-bundle-unpack are taken from
+# RGT_BINDIR (if set) or from PATH.
+#
+# Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+
+set -e
+
+bindir="${RGT_BINDIR:+${RGT_BINDIR}/}"
+
+tmp_dir="$(mktemp -d "${TMPDIR:-/tmp}/rgt_bundle_roundtrip_XXXXXX")"
+trap 'rm -rf "${tmp_dir}"' EXIT
+
+src="${tmp_dir}/src"
+bundle="${tmp_dir}/bundle.rlb"
+
+mkdir "${src}" "${tmp_dir}/all" "${tmp_dir}/one"
+
+: >"${src}/empty"
+for i in $(seq 1 500) ; do
+    echo "fragment ${i}" >"${src}/${i}_frag_${i}"
+done
+head -c 1000000 /dev/urandom >"${src}/random"
+yes "log message text" | head -c 3000000 >"${src}/text"
+
+function check() {
+    local what="$1"
+    shift
+
+    if "$@" ; then
+        echo "${what}: OK"
+    else
+        echo "${what}: FAILED"
+        exit 1
+    fi
+}
+
+check "pack" "${bindir}rgt-log-bundle-pack" --bundle="${bundle}" \
+    --split-log="${src}" --jobs=4
+
+check "unpack all" "${bindir}rgt-log-bundle-unpack" --bundle="${bundle}" \
+    --split-log="${tmp_dir}/all"
+check "compare all" diff -r "${src}" "${tmp_dir}/all"
+
+check "unpack some" "${bindir}rgt-log-bundle-unpack" --bundle="${bundle}" \
+    --split-log="${tmp_dir}/one" empty random 250_frag_250
+for f in empty random 250_frag_250 ; do
+    check "compare ${f}" cmp "${src}/${f}" "${tmp_dir}/one/${f}"
+done
+
+"${bindir}rgt-log-bundle-unpack" --bundle="${bundle}" --list \
+    | cut -d ' ' -f 1 | sort >"${tmp_dir}/listed"
+ls "${src}" | sort >"${tmp_dir}/expected"
+check "list" cmp "${tmp_dir}/expected" "${tmp_dir}/listed"
@@ -0,0 +1,50 @@
+#!/bin/bash
+# SPDX-License-Identifier: Apache-2.0
+#
+# Compare time and peak memory of converting a RAW log to XML log
+# in postponed mode with serial (-j 1) and parallel (-j N) formatting
+# of log messages, check that the results are the same.
+#
+# Usage: jobs_perf.sh <raw log> [number of jobs]
+#
+# The number of jobs is the number of CPUs by default.
+# rgt-core is taken from RGT_BINDIR (if set) or from PATH.
+#
+# Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+
+set -e
+
+raw_log="$1"
+jobs="${2:-$(nproc)}"
+bindir="${RGT_BINDIR:+${RGT_BINDIR}/}"
+
+if [[ -z "${raw_log}" ]] ; then
+    echo "Usage: $0 <raw log> [number of jobs]" >&2
+    exit 1
+fi
+
+tmp_dir="$(mktemp -d "${TMPDIR:-/tmp}/rgt_jobs_perf_XXXXXX")"
+trap 'rm -rf "${tmp_dir}"' EXIT
+
+# Run a command and print its wall time and peak RSS
+function measure() {
+    local name="$1"
+    shift
+
+    /usr/bin/time -f "${name}: %e s, peak RSS %M KiB" "$@"
+}
+
+for j in 1 "${jobs}" ; do
+    measure "rgt-core -m postponed -j ${j}" "${bindir}rgt-core" \
+        -m postponed -j "${j}" --tmpdir="${tmp_dir}" \
+        "${raw_log}" "${tmp_dir}/log_${j}.xml"
+done
+
+echo "XML log size: $(stat -c %s "${tmp_dir}/log_1.xml") bytes"
+
+if cmp -s "${tmp_dir}/log_1.xml" "${tmp_dir}/log_${jobs}.xml" ; then
+    echo "Results are the same"
+else
+    echo "Results differ"
+    exit 1
+fi
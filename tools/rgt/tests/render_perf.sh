@@ -0,0 +1,56 @@
+#!/bin/bash
+# SPDX-License-Identifier: Apache-2.0
+#
+# Compare time and peak memory of rendering a RAW log to HTML or JSON
+# via intermediate XML log (rgt-core + rgt-xml2<format>) and directly
+# (rgt-xml2<format> --raw-log), check that the results are the same.
+#
+# Usage: render_perf.sh <raw log> [html-multi|json]
+#
+# Tools are taken from RGT_BINDIR (if set) or from PATH.
+#
+# Copyright (C) 2026 OKTET Labs Ltd. All rights reserved.
+
+set -e
+
+raw_log="$1"
+format="${2:-html-multi}"
+bindir="${RGT_BINDIR:+${RGT_BINDIR}/}"
+
+if [[ -z "${raw_log}" ]] ; then
+    echo "Usage: $0 <raw log> [html-multi|json]" >&2
+    exit 1
+fi
+
+tmp_dir="$(mktemp -d "${TMPDIR:-/tmp}/rgt_render_perf_XXXXXX")"
+trap 'rm -rf "${tmp_dir}"' EXIT
+
+# Run a command and print its wall time and peak RSS
+function measure() {
+    local name="$1"
+    shift
+
+    /usr/bin/time -f "${name}: %e s, peak RSS %M KiB" "$@"
+}
+
+mkdir "${tmp_dir}/two_stage" "${tmp_dir}/direct"
+
+echo "Two-stage pipeline:"
+measure "  rgt-core" "${bindir}rgt-core" -m postponed \
+    --tmpdir="${tmp_dir}" "${raw_log}" "${tmp_dir}/log.xml"
+measure "  rgt-xml2${format}" "${bindir}rgt-xml2${format}" \
+    "${tmp_dir}/log.xml" "${tmp_dir}/two_stage"
+echo "  XML log size: $(stat -c %s "${tmp_dir}/log.xml") bytes"
+rm "${tmp_dir}/log.xml"
+
+echo "Direct rendering:"
+measure "  rgt-xml2${format} --raw-log" "${bindir}rgt-xml2${format}" \
+    --raw-log="${raw_log}" --core-opt=--tmpdir="${tmp_dir}" \
+    "${tmp_dir}/direct"
+
+if diff -r "${tmp_dir}/two_stage" "${tmp_dir}/direct" >/dev/null ; then
+    echo "Results are the same"
+else
+    echo "Results differ"
+    exit 1
+fi
@@ -2114,6 +2114,7 @@ simplify_log_exprs(trc_exp_results *results,
 
                 trc_db_set_user_data(iter, true, 0, iter_data);
                 TAILQ_INSERT_TAIL(&test->iters.head, iter, links);
+                trc_test_iters_changed(&test->iters);
             }
 
             logic_expr_free(array[i]);
@@ -4359,6 +4360,7 @@ trc_update_generate_test_wilds(te_trc_db *db,
             trc_free_test_iter(iter);
             free(iter);
         } while ((iter = TAILQ_FIRST(&test->iters.head)) != NULL);
+        trc_test_iters_changed(&test->iters);
     }
 
     /* Insert generated wildcards in TRC DB */
@@ -4388,6 +4390,7 @@ trc_update_generate_test_wilds(te_trc_db *db,
 
             TAILQ_INSERT_TAIL(&test->iters.head, iter, links);
         }
+        trc_test_iters_changed(&test->iters);
         trc_update_args_groups_free(&wildcards);
     }
     else
@@ -4930,6 +4933,7 @@ trc_update_gen_test_wilds_fss(te_trc_db *db,
             free(iter);
         } while ((iter =
                     TAILQ_FIRST(&test_entry->test->iters.head)) != NULL);
+        trc_test_iters_changed(&test_entry->test->iters);
     }
 
     /* Insert generated wildcards in TRC DB */
@@ -4981,6 +4985,7 @@ trc_update_gen_test_wilds_fss(te_trc_db *db,
 
                 TAILQ_INSERT_TAIL(&test_entry->test->iters.head,
                                   iter, links);
+                trc_test_iters_changed(&test_entry->test->iters);
             }
         }
         problem_free(&wild_prbs[i]);
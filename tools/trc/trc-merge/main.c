@@ -168,7 +168,7 @@ main(int argc, char *argv[])
 
         if (first)
         {
-            rc = trc_db_open(db_path, &db);
+            rc = trc_db_open_ext(db_path, &db, TRC_OPEN_KEEP_DOM);
             if (rc != 0)
             {
                 ERROR("Failed to open TRC database %s: %r",
@@ -615,7 +615,9 @@ main(int argc, char *argv[])
             goto exit;
         }
     }
-    else if (trc_db_open(db_fn, &ctx.db) != 0)
+    else if (trc_db_open_ext(db_fn, &ctx.db,
+                             (ctx.flags & TRC_REPORT_UPDATE_DB) ?
+                                TRC_OPEN_KEEP_DOM : 0) != 0)
     {
         ERROR("Failed to open TRC database '%s'", db_fn);
         goto exit;